@@ -1,34 +1,198 @@
 #include "Application.h"
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Corrade/Utility/String.h>
 #include <Magnum/GL/PixelFormat.h>
+#include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/Renderer.h>
 #include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
 #include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Packing.h>
 #include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
 #include <Magnum/Trade/MeshData.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
 
 using namespace Magnum;
 
+namespace
+{
+
+/* ImGui only reflects an input event in the frame after it has seen it (e.g., hover highlights), so input asks for one
+   extra frame */
+constexpr Int InputFrames = 2;
+
+/* GPU memory the panes may hold before cached resources are evicted, adjustable in the UI */
+constexpr std::size_t DefaultGpuMemoryBudget = std::size_t{1024} << 20;
+
+/* Grid points labelled with their coordinates in each direction from the origin, to have plenty of labels */
+constexpr Int GridLabelExtent = 50;
+
+/* Points of the demo cloud drawn per frame, shared by all the panes */
+constexpr std::size_t DefaultPointBudget = 4'000'000;
+
+/* Image files next to the shown one are decoded ahead, for browsing through them without waiting */
+constexpr std::size_t PrefetchedImages = 1;
+
+/* Files the image pane decodes through the importer plugins, told apart from point clouds by the extension */
+bool isImageFile(const Containers::StringView path)
+{
+    const Containers::String extension = Utility::String::lowercase(Utility::Path::splitExtension(path).second());
+    for (const char* image : {".png", ".jpg", ".jpeg", ".tif", ".tiff", ".tga", ".bmp"})
+        if (extension == image)
+            return true;
+    return false;
+}
+
+/* Image files of a directory in name order, e.g. the frames of a recording */
+std::vector<std::string> listImageFiles(const Containers::StringView directory)
+{
+    using Utility::Path::ListFlag;
+
+    std::vector<std::string> files;
+    const Containers::Optional<Containers::Array<Containers::String>> names = Utility::Path::list(
+        directory, ListFlag::SkipDirectories | ListFlag::SkipDotAndDotDot | ListFlag::SortAscending);
+    if (!names)
+        return files;
+
+    for (const Containers::String& name : *names)
+        if (isImageFile(name))
+            files.push_back(Utility::Path::join(directory, name));
+    return files;
+}
+
+/* Samples per side of the height field the demo cloud is made of */
+constexpr Int TerrainResolution = 1024;
+
+/* A rolling height field on the XY plane around the origin, Z up, colored by height, to have a cloud with a million
+   points */
+void generateTerrain(std::vector<Vector3>& positions, std::vector<Color4ub>& colors)
+{
+    positions.reserve(std::size_t(TerrainResolution) * TerrainResolution);
+    colors.reserve(positions.capacity());
+    for (Int y = 0; y != TerrainResolution; ++y)
+        for (Int x = 0; x != TerrainResolution; ++x)
+        {
+            const Vector2 position = Vector2{Float(x), Float(y)} / Float(TerrainResolution - 1) * 20.0f;
+            const Float   height   = 0.8f * std::sin(position.x() * 0.7f) * std::cos(position.y() * 0.5f) +
+                                 0.2f * std::sin(position.x() * 3.1f + position.y() * 2.3f);
+            const Color3  color    = Math::lerp(Color3{0.16f, 0.36f, 0.18f}, Color3{0.85f, 0.8f, 0.7f},
+                                                Math::clamp(height * 0.5f + 0.5f, 0.0f, 1.0f));
+            positions.emplace_back(position.x() - 10.0f, position.y() - 10.0f, height);
+            colors.push_back(Math::pack<Color4ub>(Color4{color}));
+        }
+}
+
+/* Size of the demo image, about two gigapixels */
+constexpr Vector2i DemoImageSize{65536, 32768};
+
+/* Pixels of a tile of the demo image, generated instead of decoded: a hue gradient across and a brightness gradient
+   down the image, with a checkerboard of 16 pixel squares and lines every 1024 pixels, so that every level of the
+   pyramid shows something */
+std::optional<Image2D> generateTile(const TilePyramid& pyramid, const TilePyramid::Tile& tile)
+{
+    using namespace Math::Literals;
+
+    const Range2Di pixels = pyramid.tilePixels(tile);
+    const Int      scale  = 1 << tile.level;
+    const Int      lines  = scale < 64 ? 1024 : 16384;
+
+    Image2D image{PixelFormat::RGBA8Unorm, pixels.size(),
+                  Containers::Array<char>{NoInit, std::size_t(pixels.size().product()) * 4}};
+    const Containers::StridedArrayView2D<Color4ub> rows = image.pixels<Color4ub>();
+    for (Int y = 0; y != pixels.sizeY(); ++y)
+    {
+        // Rows are bottom-up
+        const Int imageY = (pixels.max().y() - 1 - y) * scale;
+        for (Int x = 0; x != pixels.sizeX(); ++x)
+        {
+            const Int    imageX  = (pixels.min().x() + x) * scale;
+            const bool   checker = ((imageX >> 4) ^ (imageY >> 4)) & 1;
+            const Float  value   = 0.45f + 0.4f * Float(imageY) / Float(DemoImageSize.y()) + (checker ? 0.1f : 0.0f);
+            const Color3 color   = imageX % lines < scale || imageY % lines < scale
+                                       ? Color3{1.0f}
+                                       : Color3::fromHsv({360.0_degf * Float(imageX) / Float(DemoImageSize.x()),
+                                                          0.6f, Math::min(value, 1.0f)});
+            rows[y][x] = Math::pack<Color4ub>(Color4{color});
+        }
+    }
+    return image;
+}
+
+/* The PLY or PCD file at @p path, mapped. The point cloud reads the points straight out of the mapping. */
+std::optional<PointCloudFile> openPointFile(Containers::StringView path)
+{
+    std::optional<PointCloudFile> file = PointCloudFile::open(path);
+    if (file && file->positions().isEmpty() && file->size())
+    {
+        Error{} << path << "has no float x, y and z";
+        return std::nullopt;
+    }
+    return file;
+}
+
+/* Framebuffer pixels per ImGui unit. ImGui rasterizes its font at this scale and again whenever it changes. */
+Vector2 uiPixelScale(const Vector2i& windowSize, const Vector2i& framebufferSize, const Vector2& dpiScaling)
+{
+    return Vector2{framebufferSize} / (Vector2{windowSize} / dpiScaling);
+}
+
+/* The labels in the panes use the glyphs ImGui already rasterized into its font atlas */
+GlyphAtlas imguiGlyphAtlas()
+{
+    const ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+
+    GlyphAtlas atlas{font->FontSize, -font->Descent};
+    for (char c = ' '; c != 127; ++c)
+    {
+        const ImFontGlyph* glyph = font->FindGlyphNoFallback(ImWchar(c));
+        if (!glyph)
+            continue;
+
+        /* ImGui has Y down from the top of the line, the atlas Y up from the baseline. The texture isn't flipped. */
+        atlas.add(c, {{{glyph->X0, font->Ascent - glyph->Y1}, {glyph->X1, font->Ascent - glyph->Y0}},
+                      {{glyph->U0, glyph->V1}, {glyph->U1, glyph->V0}},
+                      glyph->AdvanceX});
+    }
+    return atlas;
+}
+
+} // namespace
+
 CVDev::CVDev(const Arguments& arguments)
 : Platform::Application{arguments, NoCreate}
+, frameScheduler_{[] { glfwPostEmptyEvent(); }}
 {
-    /* Try 8x MSAA, fall back to zero samples if not possible. Enable only 2x
-       MSAA if we have enough DPI. */
+    /* The panes are rendered offscreen and blitted into the default
+       framebuffer, which therefore has to be single-sampled. Multisampling is
+       done in the pane render targets instead: 8x MSAA, or only 2x if we have
+       enough DPI, clamped to what the driver supports. Panes drop to fewer
+       samples while their camera moves, see ViewportManager::setSampleCounts(). */
+    Int paneSamples;
     {
         const Vector2 dpiScaling = this->dpiScaling({});
         Configuration conf;
         conf.setTitle("CVDev").setWindowFlags(Configuration::WindowFlag::Resizable).setSize({1280, 720}, dpiScaling);
         GLConfiguration glConf;
-        glConf.setSampleCount(dpiScaling.max() < 2.0f ? 8 : 2);
-        if (!tryCreate(conf, glConf))
-            create(conf, glConf.setSampleCount(0));
+        glConf.setSampleCount(0);
+        create(conf, glConf);
+
+        paneSamples = Math::min(dpiScaling.max() < 2.0f ? 8 : 2, GL::Renderbuffer::maxSamples());
     }
 
     using namespace Math::Literals;
-    imgui_ = ImGuiIntegration::Context(Vector2{windowSize()} / dpiScaling(), windowSize(), framebufferSize());
-
-    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
-    GL::Renderer::enable(GL::Renderer::Feature::FaceCulling);
+    imgui_        = ImGuiIntegration::Context(Vector2{windowSize()} / dpiScaling(), windowSize(), framebufferSize());
+    uiPixelScale_ = uiPixelScale(windowSize(), framebufferSize(), dpiScaling());
 
     /* Set up proper blending to be used by ImGui. There's a great chance
        you'll need this exact behavior for the rest of your scene. If not, set
@@ -37,14 +201,73 @@ CVDev::CVDev(const Arguments& arguments)
     GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::SourceAlpha,
                                    GL::Renderer::BlendFunction::OneMinusSourceAlpha);
 
+    /* Linked shader binaries are kept across runs, so that our own shaders are only compiled on the first start with a
+       driver */
+    if (ProgramBinaryCache::isSupported())
+    {
+        if (const Containers::Optional<Containers::String> directory = Utility::Path::configurationDirectory("cvdev"))
+        {
+            programBinaryCache_.emplace(Utility::Path::join(*directory, "shaders"));
+            gpuResources_.setProgramBinaryCache(&*programBinaryCache_);
+        }
+    }
+
+    gpuResources_.memory().setBudget(DefaultGpuMemoryBudget);
+
     threeDView_  = std::make_unique<ThreeDView>(*this, scene_);
     threeDView1_ = std::make_unique<ThreeDView>(*this, scene_);
-    grid_        = std::make_unique<Grid>(*scene_, drawables_);
-
-    imagePreview_ = std::make_unique<ImagePreview>();
+    grid_        = std::make_unique<Grid>(*scene_, drawables_, gpuResources_);
+    grid_->setObjectId(picking_.add(*grid_));
 
-    viewportManager_ = std::make_unique<ViewportManager>(*this, scene_);
+    // Image files given on the command line are shown in the image pane and the first directory is played back as an
+    // image sequence. The first other file is taken as a point cloud, otherwise there's a generated one.
+    std::vector<std::string> sequence;
+    for (Int i = 1; i < arguments.argc; ++i)
+    {
+        if (Utility::Path::isDirectory(arguments.argv[i]))
+        {
+            if (sequence.empty())
+                sequence = listImageFiles(arguments.argv[i]);
+        }
+        else if (isImageFile(arguments.argv[i]))
+            imageFiles_.emplace_back(arguments.argv[i]);
+        else if (!pointFile_)
+            pointFile_ = openPointFile(arguments.argv[i]);
+    }
+    if (pointFile_)
+        pointCloud_ = std::make_unique<PointCloud>(*scene_, drawables_, gpuResources_, pointFile_->positions(),
+                                                   pointFile_->colors());
+    else
+    {
+        generateTerrain(terrainPositions_, terrainColors_);
+        // The red, green and blue channel of every color
+        const Containers::StridedArrayView2D<const UnsignedByte> colors{
+            Containers::arrayView(terrainColors_.data(), terrainColors_.size()), terrainColors_.front().data(),
+            {terrainColors_.size(), 3}, {std::ptrdiff_t(sizeof(Color4ub)), 1}};
+        pointCloud_ = std::make_unique<PointCloud>(
+            *scene_, drawables_, gpuResources_,
+            Containers::arrayView(terrainPositions_.data(), terrainPositions_.size()), colors);
+    }
+    // One ID per point, so that picking resolves to single points
+    pointCloud_->setObjectId(picking_.add(*pointCloud_, UnsignedInt(pointCloud_->pointCount())));
+    pointBudget_ = DefaultPointBudget;
+
+    for (Int y = -GridLabelExtent; y <= GridLabelExtent; ++y)
+        for (Int x = -GridLabelExtent; x <= GridLabelExtent; ++x)
+            labels_.push_back({{Float(x), Float(y), 0.0f},
+                               std::to_string(x) + ", " + std::to_string(y),
+                               0xdddddd_rgbf,
+                               -Float(Math::abs(x) + Math::abs(y)), // The ones near the origin win
+                               grid_->objectId()});
+
+    image_ = std::make_shared<TiledImage>(gpuResources_, DemoImageSize,
+                                          [pyramid = TilePyramid{DemoImageSize}](const TilePyramid::Tile& tile)
+                                          { return generateTile(pyramid, tile); });
+
+    viewportManager_ = std::make_unique<ViewportManager>(*this, gpuResources_, scene_, paneSamples);
     viewportManager_->createNewViewport({1, 1}, ThreeDView::EBorder::LEFT);
+    if (LabelShader::isSupported())
+        viewportManager_->setLabels(labels_, imguiGlyphAtlas(), imgui_.atlasTexture());
 
     viewportManager_->createNewViewport({1, 1}, ThreeDView::EBorder::BOTTOM);
 
@@ -52,14 +275,152 @@ CVDev::CVDev(const Arguments& arguments)
 
     viewportManager_->createNewViewport({1, 600}, ThreeDView::EBorder::TOP);
 
-    viewportManager_->createNewViewport({1, 600}, ThreeDView::EBorder::RIGHT);
+    viewportManager_->createImageViewport({1, 600}, image_, ThreeDView::EBorder::RIGHT);
 
     // viewportManager_->createNewViewport({1200, 1});
+
+    /* The player needs a loader of its own, so with image files as well the cores left to decoding are split between
+       the two instead of each of them starting a thread per core. Playback has to keep up with the frame rate and gets
+       the larger half. */
+    const std::size_t decodeThreads   = ImageLoader::defaultThreadCount();
+    const bool        splitThreads    = !sequence.empty() && !imageFiles_.empty();
+    const std::size_t imageThreads    = splitThreads ? Math::max(decodeThreads / 2, std::size_t{1}) : decodeThreads;
+    const std::size_t playbackThreads = splitThreads ? decodeThreads - decodeThreads / 2 : decodeThreads;
+
+    if (!sequence.empty())
+    {
+        auto loader = std::make_unique<ImageLoader>(playbackThreads, ImageLoader::importerDecoder(),
+                                                    [this] { frameScheduler_.requestFrame(); });
+        player_     = std::make_shared<FramePlayer>(gpuResources_, std::move(sequence), std::move(loader));
+        viewportManager_->createPlaybackViewport({1, 1}, player_, ThreeDView::EBorder::RIGHT);
+    }
+
+    // The generated image stays until the first file is decoded
+    if (!imageFiles_.empty())
+    {
+        imageLoader_ = std::make_unique<ImageLoader>(imageThreads, ImageLoader::importerDecoder(),
+                                                     [this] { frameScheduler_.requestFrame(); });
+        showImageFile(0);
+    }
+}
+
+void CVDev::showImageFile(const std::size_t index)
+{
+    CORRADE_INTERNAL_ASSERT(imageLoader_ && index < imageFiles_.size());
+    currentImage_ = index;
+    requestImageFiles();
+
+    if (const auto found = decodedImages_.find(index); found != decodedImages_.end())
+        showDecodedImage(found->second);
+}
+
+void CVDev::requestImageFiles()
+{
+    const std::size_t index = currentImage_;
+    imagePanesVisible_      = viewportManager_->imagePaneArea() != 0;
+
+    // The shown file first, then the ones around it. Wrapping around, a short list can name a file twice; it keeps the
+    // priority it was named with first.
+    const std::size_t                          count = imageFiles_.size();
+    std::vector<std::pair<std::size_t, Float>> wanted{{index, 2.0f}};
+    for (std::size_t distance = 1; distance <= PrefetchedImages; ++distance)
+        for (const std::size_t file : {(index + distance) % count, (index + count - distance % count) % count})
+            if (std::none_of(wanted.begin(), wanted.end(), [&](const auto& w) { return w.first == file; }))
+                wanted.emplace_back(file, 1.0f / Float(distance));
+    const auto isWanted = [&](const std::size_t file)
+    { return std::any_of(wanted.begin(), wanted.end(), [&](const auto& w) { return w.first == file; }); };
+
+    // Whatever was decoded or requested for files out of reach now is outdated
+    std::erase_if(imageRequests_,
+                  [&](const auto& request)
+                  {
+                      if (isWanted(request.first))
+                          return false;
+                      imageLoader_->cancel(request.second);
+                      return true;
+                  });
+    std::erase_if(decodedImages_, [&](const auto& image) { return !isWanted(image.first); });
+
+    for (const auto& [file, priority] : wanted)
+    {
+        if (decodedImages_.contains(file))
+            continue;
+
+        // Nobody browses panes that aren't visible, so they only get the shown file. What's decoded already stays.
+        const auto found = imageRequests_.find(file);
+        if (!imagePanesVisible_ && file != index)
+        {
+            if (found != imageRequests_.end())
+            {
+                imageLoader_->cancel(found->second);
+                imageRequests_.erase(found);
+            }
+            continue;
+        }
+
+        if (found != imageRequests_.end())
+            imageLoader_->setPriority(found->second, priority);
+        else
+            imageRequests_.emplace(file, imageLoader_->request(imageFiles_[file], priority));
+    }
+}
+
+void CVDev::showDecodedImage(std::shared_ptr<const Image2D> image)
+{
+    const Vector2i size = image->size();
+    image_              = std::make_shared<TiledImage>(gpuResources_, size, TiledImage::imageLoader(std::move(image)));
+    viewportManager_->showImage(image_);
+}
+
+void CVDev::takeDecodedImages()
+{
+    while (std::optional<ImageLoader::Result> result = imageLoader_->take())
+    {
+        // Cancelled requests never come back, so everything taken is still requested
+        const auto request = std::find_if(imageRequests_.begin(), imageRequests_.end(),
+                                          [&](const auto& r) { return r.second == result->id; });
+        CORRADE_INTERNAL_ASSERT(request != imageRequests_.end());
+        const std::size_t file = request->first;
+        imageRequests_.erase(request);
+
+        if (!result->image)
+        {
+            Error{} << "CVDev: can't show" << result->path.c_str();
+            continue;
+        }
+
+        auto image = std::make_shared<const Image2D>(*std::move(result->image));
+        decodedImages_.emplace(file, image);
+        if (file == currentImage_)
+            showDecodedImage(std::move(image));
+    }
+}
+
+int CVDev::run()
+{
+    /* Unlike exec(), the loop doesn't redraw unconditionally: mainLoopIteration() blocks in the event queue until there
+       is input or a frame request wakes it up, and frames are only drawn when requested, at most at the maximum frame
+       rate */
+    while (mainLoopIteration())
+    {
+        if (!frameScheduler_.takeFrameRequest())
+            continue;
+
+        std::this_thread::sleep_until(frameScheduler_.nextFrameTime());
+        redraw();
+    }
+
+    return 0;
 }
 
 void CVDev::drawEvent()
 {
-    GL::defaultFramebuffer.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth);
+    frameScheduler_.frameStarted();
+
+    applyPendingResize();
+
+    /* Depth is only needed inside the pane render targets */
+    GL::defaultFramebuffer.clear(GL::FramebufferClear::Color);
 
     imgui_.newFrame();
 
@@ -74,6 +435,165 @@ void CVDev::drawEvent()
     const ImGuiIO& io = ImGui::GetIO();
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", static_cast<double>(1000.0f / io.Framerate),
                 static_cast<double>(io.Framerate));
+
+    bool continuous = frameScheduler_.mode() == FrameScheduler::RedrawMode::CONTINUOUS;
+    if (ImGui::Checkbox("Redraw continuously", &continuous))
+        frameScheduler_.setMode(continuous ? FrameScheduler::RedrawMode::CONTINUOUS
+                                           : FrameScheduler::RedrawMode::EVENT_DRIVEN);
+    Float maxFramesPerSecond = frameScheduler_.maxFramesPerSecond();
+    if (ImGui::SliderFloat("Max FPS (0 = vsync)", &maxFramesPerSecond, 0.0f, 240.0f, "%.0f"))
+        frameScheduler_.setMaxFramesPerSecond(maxFramesPerSecond);
+    ImGui::Text("Frames drawn: %zu", frameScheduler_.frameCount());
+    ImGui::Text("Shared GPU resources: %zu (%zu created)", gpuResources_.count(), gpuResources_.creationCount());
+    if (firstFrameTime_)
+        ImGui::Text("First frame after %.1f ms", std::chrono::duration<double, std::milli>{*firstFrameTime_}.count());
+    if (programBinaryCache_)
+        ImGui::Text("Shader binaries: %zu loaded, %zu compiled, %zu rejected", programBinaryCache_->loadedCount(),
+                    programBinaryCache_->savedCount(), programBinaryCache_->rejectedCount());
+
+    const GpuMemoryRegistry& memory = gpuResources_.memory();
+    ImGui::Text("GPU memory: %zu MB (textures %zu, buffers %zu, targets %zu), %zu evicted, %zu reloaded",
+                memory.used() >> 20, memory.used(GpuMemoryRegistry::Kind::TEXTURE) >> 20,
+                memory.used(GpuMemoryRegistry::Kind::BUFFER) >> 20,
+                memory.used(GpuMemoryRegistry::Kind::FRAMEBUFFER) >> 20, memory.evictionCount(), memory.reloadCount());
+    Int memoryBudget = Int(memory.budget() >> 20);
+    if (ImGui::SliderInt("GPU memory budget (MB, 0 = unlimited)", &memoryBudget, 0, 8192))
+        gpuResources_.memory().setBudget(std::size_t(memoryBudget) << 20);
+
+    ImGui::BeginDisabled(!ViewportManager::isMultiViewSupported());
+    bool multiView = viewportManager_->isMultiViewEnabled();
+    if (ImGui::Checkbox("Render all panes in one pass", &multiView))
+        viewportManager_->setMultiViewEnabled(multiView);
+    ImGui::EndDisabled();
+
+    ImGui::BeginDisabled(!ViewportManager::isBatchingSupported());
+    bool batching = viewportManager_->isBatchingEnabled();
+    if (ImGui::Checkbox("Batch draws in uniform buffers", &batching))
+        viewportManager_->setBatchingEnabled(batching);
+    ImGui::EndDisabled();
+    if (const BatchRenderer* batch = viewportManager_->batchRenderer())
+    {
+        ImGui::Text("Last pane: %zu batched draws in %zu draw calls", batch->batchedCount(), batch->drawCallCount());
+        if (const StreamBuffer* stream = batch->streamBuffer())
+            ImGui::Text("Streamed uniforms: %zu of %zu kB in flight, %zu stalls", stream->used() / 1024,
+                        stream->capacity() / 1024, stream->waitCount());
+    }
+
+    ImGui::BeginDisabled(!LabelShader::isSupported());
+    bool labels = viewportManager_->labelRenderer();
+    if (ImGui::Checkbox("Grid coordinate labels", &labels))
+    {
+        if (labels)
+            viewportManager_->setLabels(labels_, imguiGlyphAtlas(), imgui_.atlasTexture());
+        else
+            viewportManager_->resetLabels();
+    }
+    ImGui::EndDisabled();
+    if (const LabelRenderer* labelRenderer = viewportManager_->labelRenderer())
+        ImGui::Text("Last pane: %zu labels drawn, %zu decluttered, %zu culled",
+                    labelRenderer->instances().stats().drawn, labelRenderer->instances().stats().decluttered,
+                    labelRenderer->instances().stats().culled);
+
+    bool octreeBounds = bool(octreeBounds_);
+    if (ImGui::Checkbox("Point cloud octree bounds", &octreeBounds))
+    {
+        if (octreeBounds)
+            octreeBounds_ =
+                std::make_unique<OctreeBounds>(*pointCloud_, drawables_, gpuResources_, pointCloud_->octree());
+        else
+            octreeBounds_.reset();
+        viewportManager_->markDirty();
+    }
+
+    Int pointBudget = Int(pointBudget_ / 1000);
+    if (ImGui::SliderInt("Point budget (thousands)", &pointBudget, 100, 20000))
+    {
+        pointBudget_ = std::size_t(pointBudget) * 1000;
+        viewportManager_->markDirty();
+    }
+    ImGui::Text("Last pane: %zu points in %zu nodes, %zu nodes loading; %zu of %zu nodes on the GPU",
+                pointCloud_->stats().drawnPoints, pointCloud_->stats().drawnNodes, pointCloud_->stats().pendingNodes,
+                pointCloud_->residentNodeCount(), pointCloud_->octree().nodes().size());
+
+    ImGui::Text("Image: %zu tiles drawn, %zu from coarser tiles, %zu loading; %zu of %zu tiles on the GPU",
+                image_->stats().drawnTiles, image_->stats().fallbackTiles, image_->stats().pendingTiles,
+                image_->residentTileCount(), image_->cacheCapacity());
+    if (imageLoader_)
+        ImGui::Text("Image file %zu of %zu (Page Up/Down): %s; %zu decoding on %zu threads, %zu decoded, %zu cancelled",
+                    currentImage_ + 1, imageFiles_.size(), imageFiles_[currentImage_].c_str(),
+                    imageLoader_->pendingCount(), imageLoader_->threadCount(), imageLoader_->decodedCount(),
+                    imageLoader_->cancelledCount() + imageLoader_->droppedCount());
+
+    if (player_)
+    {
+        Playhead& playhead = player_->playhead();
+        if (ImGui::Button(player_->isPlaying() ? "Pause" : "Play"))
+        {
+            if (player_->isPlaying())
+                player_->pause();
+            else
+                player_->play();
+        }
+        ImGui::SameLine();
+        bool backward = playhead.direction() == Playhead::Direction::BACKWARD;
+        if (ImGui::Checkbox("Backward", &backward))
+            playhead.setDirection(backward ? Playhead::Direction::BACKWARD : Playhead::Direction::FORWARD);
+        ImGui::SameLine();
+        bool looping = playhead.isLooping();
+        if (ImGui::Checkbox("Loop", &looping))
+            playhead.setLooping(looping);
+        Float framesPerSecond = playhead.framesPerSecond();
+        if (ImGui::SliderFloat("Playback FPS", &framesPerSecond, 1.0f, 120.0f, "%.0f"))
+            playhead.setFramesPerSecond(framesPerSecond);
+        Int frame = Int(playhead.frame());
+        if (ImGui::SliderInt("Frame", &frame, 0, Int(playhead.frameCount()) - 1))
+            player_->seek(std::size_t(frame));
+        const FramePlayer::Stats& stats = player_->stats();
+        ImGui::Text("Playback: %zu frames ahead decoded, %zu on the GPU (ring of %zu), %zu decoding; %zu stalls, "
+                    "%zu failed",
+                    stats.decodedAhead, stats.uploadedAhead, player_->ringCapacity(), stats.decoding,
+                    playhead.stallCount(), player_->failedCount());
+    }
+
+    bool culling = viewportManager_->isFrustumCullingEnabled();
+    if (ImGui::Checkbox("Frustum culling", &culling))
+        viewportManager_->setFrustumCulling(culling);
+    const auto cullingStats = viewportManager_->cullingStats();
+    for (std::size_t i = 0; i != cullingStats.size(); ++i)
+        ImGui::Text("Pane %zu: %zu drawn, %zu culled", i, cullingStats[i].drawn, cullingStats[i].culled);
+    bool dynamicResolution = viewportManager_->isDynamicResolutionEnabled();
+    if (ImGui::Checkbox("Dynamic resolution", &dynamicResolution))
+        viewportManager_->setDynamicResolution(dynamicResolution);
+    Float budget = std::chrono::duration<Float, std::milli>{viewportManager_->gpuTimeBudget()}.count();
+    if (ImGui::SliderFloat("GPU budget (ms)", &budget, 1.0f, 33.0f, "%.1f"))
+        viewportManager_->setGpuTimeBudget(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<Float, std::milli>{budget}));
+    Int idleSamples        = viewportManager_->idleSampleCount();
+    Int interactingSamples = viewportManager_->interactingSampleCount();
+    if (ImGui::SliderInt("MSAA when idle", &idleSamples, 0, 8) |
+        ImGui::SliderInt("MSAA while moving", &interactingSamples, 0, 8))
+        viewportManager_->setSampleCounts(idleSamples, interactingSamples);
+    bool resolveOnlyChanged = viewportManager_->isResolveOnlyChanged();
+    if (ImGui::Checkbox("Render and resolve only changed panes", &resolveOnlyChanged))
+        viewportManager_->setResolveOnlyChanged(resolveOnlyChanged);
+    const auto scales  = viewportManager_->resolutionScales();
+    const auto samples = viewportManager_->sampleCounts();
+    for (std::size_t i = 0; i != scales.size() && i != samples.size(); ++i)
+        ImGui::Text("Pane %zu: %.0f%% resolution, %dx MSAA", i, static_cast<double>(scales[i] * 100.0f), samples[i]);
+    ImGui::Text("Render commands: %zu, state changes: %zu (%zu saved)", commands_.stats().commands,
+                commands_.stats().stateChanges, commands_.stats().stateChangesSaved);
+    if (selection_ && selection_->drawable == pointCloud_.get())
+    {
+        const Vector3& position = pointCloud_->positions()[selection_->index];
+        ImGui::Text("Selected: point %u of the point cloud at %.3f, %.3f, %.3f", selection_->index,
+                    static_cast<double>(position.x()), static_cast<double>(position.y()),
+                    static_cast<double>(position.z()));
+    }
+    else if (selection_)
+        ImGui::Text("Selected: %s, element %u", selection_->drawable == grid_.get() ? "grid" : "object",
+                    selection_->index);
+    else
+        ImGui::Text("Selected: nothing");
     ImGui::End();
 
     // threeDView1_->setViewport(Range2Di({0, 0}, {windowSize().x()/2, windowSize().y()}));
@@ -82,49 +602,135 @@ void CVDev::drawEvent()
     // threeDView_->setViewport(Range2Di({windowSize().x()/2, 0}, {windowSize()}));
     // threeDView_->draw(drawables_);
 
-    viewportManager_->draw(drawables_);
+    // Decoded image files replace the image of the panes and the playback moves on before the panes are drawn. The
+    // files around the shown one are only decoded while an image pane is visible.
+    if (imageLoader_)
+    {
+        if ((viewportManager_->imagePaneArea() != 0) != imagePanesVisible_)
+            requestImageFiles();
+        takeDecodedImages();
+    }
+    if (player_)
+        player_->update(std::chrono::steady_clock::now());
+
+    image_->update();
 
-    // imagePreview_->draw();
+    pointCloud_->nextFrame();
+    pointCloud_->setPointBudget(pointBudget_ / Math::max(viewportManager_->scenePaneCount(), std::size_t{1}));
+    viewportManager_->draw(drawables_, commands_, renderState_);
 
     imgui_.updateApplicationCursor(*this);
 
-    GL::Renderer::enable(GL::Renderer::Feature::Blending);
-    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
-    GL::Renderer::disable(GL::Renderer::Feature::FaceCulling);
-    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+    commands_.submit(CommandList::key(CommandList::Pass::UI), RenderFeature::BLENDING | RenderFeature::SCISSOR_TEST,
+                     [this] { imgui_.drawFrame(); });
+
+    commands_.execute(renderState_);
+
+    // Everything drawn in this frame is submitted, so what doesn't fit the budget anymore can go
+    gpuResources_.memory().enforceBudget();
 
-    imgui_.drawFrame();
+    // The point cloud uploads a few nodes per frame, keep drawing until the panes show all they picked
+    if (pointCloud_->isStreaming())
+    {
+        viewportManager_->markDirty();
+        frameScheduler_.requestFrame();
+    }
 
-    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
-    GL::Renderer::enable(GL::Renderer::Feature::FaceCulling);
-    GL::Renderer::disable(GL::Renderer::Feature::ScissorTest);
-    GL::Renderer::disable(GL::Renderer::Feature::Blending);
+    // Clicking on the background clears the selection. The UI of this frame is already drawn, so show it in the next.
+    if (const auto picked = viewportManager_->takePick())
+    {
+        selection_ = picking_.find(*picked);
+        frameScheduler_.requestFrame();
+    }
 
     swapBuffers();
-    redraw();
+
+    if (!firstFrameTime_)
+    {
+        firstFrameTime_ = std::chrono::steady_clock::now() - startTime_;
+        const bool warm = programBinaryCache_ && programBinaryCache_->loadedCount() != 0;
+        Debug{} << "First frame after" << std::chrono::duration<Float, std::milli>{*firstFrameTime_}.count() << "ms"
+                << (!programBinaryCache_ ? "without a shader cache" : warm ? "with a warm shader cache"
+                                                                            : "with a cold shader cache");
+    }
+
+    /* Keep drawing while something is still changing without input: a widget being dragged, a blinking text cursor or
+       a pane waiting for an asynchronous depth readback */
+    if (ImGui::IsAnyItemActive() || io.WantTextInput || viewportManager_->needsRedraw())
+        frameScheduler_.requestFrame();
 }
 
 void CVDev::viewportEvent(ViewportEvent& event)
 {
-    GL::defaultFramebuffer.setViewport({{}, event.framebufferSize()});
+    /* A live window drag emits many resize events per frame. Only remember the last one and apply it once at the
+       beginning of the next frame so that the panes (and their render targets) are resized at most once per frame. */
+    pendingResize_ = PendingResize{event.windowSize(), event.framebufferSize(), event.dpiScaling()};
+    frameScheduler_.requestFrame();
+}
+
+void CVDev::applyPendingResize()
+{
+    if (!pendingResize_)
+        return;
+
+    const PendingResize resize = *pendingResize_;
+    pendingResize_.reset();
+
+    GL::defaultFramebuffer.setViewport({{}, resize.framebufferSize});
+
+    imgui_.relayout(Vector2{resize.windowSize} / resize.dpiScaling, resize.windowSize, resize.framebufferSize);
+
+    viewportManager_->setWindowSize(resize.windowSize);
+
+    /* A new font atlas has the glyphs somewhere else, the labels are only set up again then. A plain resize keeps the
+       atlas. */
+    const Vector2 pixelScale = uiPixelScale(resize.windowSize, resize.framebufferSize, resize.dpiScaling);
+    if (pixelScale == uiPixelScale_)
+        return;
 
-    imgui_.relayout(Vector2{event.windowSize()} / event.dpiScaling(), event.windowSize(), event.framebufferSize());
+    uiPixelScale_ = pixelScale;
+    if (viewportManager_->labelRenderer())
+        viewportManager_->setLabels(labels_, imguiGlyphAtlas(), imgui_.atlasTexture());
 }
 
 void CVDev::keyPressEvent(KeyEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handleKeyPressEvent(event))
         return;
+
+    // Space plays and pauses the image sequence
+    if (player_ && event.key() == Key::Space)
+    {
+        if (player_->isPlaying())
+            player_->pause();
+        else
+            player_->play();
+        event.setAccepted();
+    }
+
+    // Page Up and Page Down browse the image files given on the command line
+    if (imageLoader_ && (event.key() == Key::PageDown || event.key() == Key::PageUp))
+    {
+        const std::size_t count = imageFiles_.size();
+        showImageFile(event.key() == Key::PageDown ? (currentImage_ + 1) % count : (currentImage_ + count - 1) % count);
+        event.setAccepted();
+    }
 }
 
 void CVDev::keyReleaseEvent(KeyEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handleKeyReleaseEvent(event))
         return;
 }
 
 void CVDev::pointerPressEvent(PointerEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handlePointerPressEvent(event))
         return;
 
@@ -135,6 +741,8 @@ void CVDev::pointerPressEvent(PointerEvent& event)
 
 void CVDev::pointerReleaseEvent(PointerEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handlePointerReleaseEvent(event))
         return;
 
@@ -145,6 +753,8 @@ void CVDev::pointerReleaseEvent(PointerEvent& event)
 
 void CVDev::pointerMoveEvent(PointerMoveEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handlePointerMoveEvent(event))
         return;
 
@@ -155,6 +765,8 @@ void CVDev::pointerMoveEvent(PointerMoveEvent& event)
 
 void CVDev::scrollEvent(ScrollEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handleScrollEvent(event))
     {
         /* Prevent scrolling the page */
@@ -169,8 +781,14 @@ void CVDev::scrollEvent(ScrollEvent& event)
 
 void CVDev::textInputEvent(TextInputEvent& event)
 {
+    frameScheduler_.requestFrame(InputFrames);
+
     if (imgui_.handleTextInputEvent(event))
         return;
 }
 
-MAGNUM_APPLICATION_MAIN(CVDev)
+int main(int argc, char** argv)
+{
+    CVDev app({argc, argv});
+    return app.run();
+}
@@ -1,7 +1,19 @@
+#include "io/ImageLoader.h"
+#include "io/PointCloudFile.h"
 #include "objects/Camera.h"
 #include "objects/Grid.h"
+#include "objects/OctreeBounds.h"
+#include "objects/PointCloud.h"
 #include "panels/3DView.h"
 #include "panels/ImagePreview.h"
+#include "render/CommandList.h"
+#include "render/FramePlayer.h"
+#include "render/FrameScheduler.h"
+#include "render/GpuResources.h"
+#include "render/PickingRegistry.h"
+#include "render/ProgramBinaryCache.h"
+#include "render/RenderState.h"
+#include "render/TiledImage.h"
 #include "traits/traits.h"
 #include "viewports/ViewportManager.h"
 
@@ -10,7 +22,12 @@
 #include <Magnum/Platform/GlfwApplication.h>
 #include <Magnum/SceneGraph/Camera.h>
 #include <Magnum/SceneGraph/Drawable.h>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace Magnum;
 
@@ -19,10 +36,22 @@ class CVDev : public Platform::Application
 public:
     explicit CVDev(const Arguments& arguments);
 
+    /// Runs the event loop, drawing frames only when the frame scheduler asks for them.
+    int run();
+
+    /// Background producers call requestFrame() on it when they have new data to show.
+    FrameScheduler& frameScheduler() { return frameScheduler_; }
+
 private:
     void drawEvent() override;
 
+    void showImageFile(std::size_t index);
+    void requestImageFiles();
+    void showDecodedImage(std::shared_ptr<const Image2D> image);
+    void takeDecodedImages();
+
     void viewportEvent(ViewportEvent& event) override;
+    void applyPendingResize();
 
     void keyPressEvent(KeyEvent& event) override;
     void keyReleaseEvent(KeyEvent& event) override;
@@ -33,14 +62,53 @@ private:
     void scrollEvent(ScrollEvent& event) override;
     void textInputEvent(TextInputEvent& event) override;
 
-    ImGuiIntegration::Context     imgui_{NoCreate};
-    std::unique_ptr<ImagePreview> imagePreview_;
+    struct PendingResize
+    {
+        Vector2i windowSize;
+        Vector2i framebufferSize;
+        Vector2  dpiScaling;
+    };
+
+    std::chrono::steady_clock::time_point   startTime_{std::chrono::steady_clock::now()};
+    std::optional<std::chrono::nanoseconds> firstFrameTime_; ///< From the start of the application.
+
+    FrameScheduler               frameScheduler_;
+    CommandList                  commands_;
+    StateTracker                 renderState_;
+    ImGuiIntegration::Context    imgui_{NoCreate};
+    Vector2                      uiPixelScale_; ///< Framebuffer pixels per ImGui unit the font is rasterized at.
+    std::optional<PendingResize> pendingResize_;
+
+    /* Declared before everything holding resources from them, so that they're destroyed after them */
+    std::optional<ProgramBinaryCache> programBinaryCache_;
+    GpuResources                      gpuResources_;
 
     std::shared_ptr<Scene3D>    scene_ = std::make_shared<Scene3D>();
     SceneGraph::DrawableGroup3D drawables_;
 
+    /* Read in place by the point cloud, so declared before it */
+    std::optional<PointCloudFile> pointFile_;        ///< Given on the command line.
+    std::vector<Vector3>          terrainPositions_; ///< Generated if there's no point file.
+    std::vector<Color4ub>         terrainColors_;
+
     std::unique_ptr<Grid>            grid_;
+    std::unique_ptr<PointCloud>      pointCloud_;
+    std::unique_ptr<OctreeBounds>    octreeBounds_; ///< Child of the point cloud, shown on demand.
+    std::shared_ptr<TiledImage>      image_; ///< Shown by the image panes.
+    std::unique_ptr<ImageLoader>     imageLoader_;
+    std::shared_ptr<FramePlayer>     player_; ///< Plays the image sequence given on the command line.
     std::unique_ptr<ThreeDView>      threeDView_;
     std::unique_ptr<ThreeDView>      threeDView1_;
     std::unique_ptr<ViewportManager> viewportManager_;
+
+    PickingRegistry                     picking_;
+    std::optional<PickingRegistry::Hit> selection_;
+    std::vector<Label>                  labels_;
+    std::size_t                         pointBudget_; ///< Shared by all the 3D panes.
+
+    std::vector<std::string> imageFiles_; ///< Given on the command line, browsed with Page Up and Page Down.
+    std::size_t              currentImage_{0};
+    bool                     imagePanesVisible_{false}; ///< As of the last requestImageFiles().
+    std::unordered_map<std::size_t, ImageLoader::Id>                imageRequests_; ///< By index in imageFiles_.
+    std::unordered_map<std::size_t, std::shared_ptr<const Image2D>> decodedImages_;
 };
@@ -0,0 +1,148 @@
+#ifndef CONTAINERS_BVH_H
+#define CONTAINERS_BVH_H
+
+#include <Corrade/Utility/Assert.h>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Range.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Bounding volume hierarchy over a set of axis-aligned boxes, identified by their index.
+ *
+ * build() splits the boxes at the median of the longest axis until at most LeafSize are left. When the boxes move but
+ * the set stays the same, refit() only recomputes the node bounds bottom-up, which is much cheaper than a rebuild but
+ * makes the tree looser over time.
+ */
+class BVH
+{
+public:
+    static constexpr std::size_t LeafSize = 4;
+
+    void build(const std::vector<Range3D>& bounds)
+    {
+        nodes_.clear();
+        indices_.resize(bounds.size());
+        std::iota(indices_.begin(), indices_.end(), std::size_t{0});
+
+        if (bounds.empty())
+            return;
+
+        nodes_.push_back({});
+        buildNode(bounds, 0, 0, bounds.size());
+    }
+
+    /// @p bounds has to have as many boxes as the ones the tree was built from.
+    void refit(const std::vector<Range3D>& bounds)
+    {
+        CORRADE_INTERNAL_ASSERT(bounds.size() == indices_.size());
+
+        // Children are always stored after their parent
+        for (auto node = nodes_.rbegin(); node != nodes_.rend(); ++node)
+        {
+            if (node->isLeaf())
+            {
+                node->bounds = bounds[indices_[node->first]];
+                for (std::size_t i = node->first + 1; i != node->first + node->count; ++i)
+                    node->bounds = Math::join(node->bounds, bounds[indices_[i]]);
+            }
+            else
+                node->bounds = Math::join(nodes_[node->left].bounds, nodes_[node->left + 1].bounds);
+        }
+    }
+
+    /**
+     * Calls @p visit with the index of every box for which @p test is true. Subtrees whose bounds fail @p test are
+     * skipped as a whole.
+     */
+    template <class Test, class Visit>
+    void query(Test&& test, Visit&& visit) const
+    {
+        if (nodes_.empty())
+            return;
+
+        std::size_t stack[64];
+        std::size_t depth = 0;
+        stack[depth++]    = 0;
+        while (depth)
+        {
+            const Node& node = nodes_[stack[--depth]];
+            if (!test(node.bounds))
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (std::size_t i = node.first; i != node.first + node.count; ++i)
+                    visit(indices_[i]);
+            }
+            else
+            {
+                stack[depth++] = node.left;
+                stack[depth++] = node.left + 1;
+            }
+        }
+    }
+
+    std::size_t size() const { return indices_.size(); }
+    std::size_t nodeCount() const { return nodes_.size(); }
+    Range3D     bounds() const { return nodes_.empty() ? Range3D{} : nodes_.front().bounds; }
+
+private:
+    struct Node
+    {
+        Range3D     bounds;
+        std::size_t left{0};  ///< Index of the left child, the right one follows it. Unused in leaves.
+        std::size_t first{0}; ///< First index in indices_ of a leaf.
+        std::size_t count{0}; ///< Number of boxes of a leaf, 0 for inner nodes.
+
+        bool isLeaf() const { return count != 0; }
+    };
+
+    std::vector<Node>        nodes_;
+    std::vector<std::size_t> indices_;
+
+    // Fills the already allocated node at @p index with the boxes in [first, last) of indices_
+    void buildNode(const std::vector<Range3D>& bounds, const std::size_t index, const std::size_t first,
+                   const std::size_t last)
+    {
+        Range3D nodeBounds   = bounds[indices_[first]];
+        Range3D centerBounds = Range3D::fromCenter(nodeBounds.center(), {});
+        for (std::size_t i = first + 1; i != last; ++i)
+        {
+            nodeBounds   = Math::join(nodeBounds, bounds[indices_[i]]);
+            centerBounds = Math::join(centerBounds, Range3D::fromCenter(bounds[indices_[i]].center(), {}));
+        }
+        nodes_[index].bounds = nodeBounds;
+
+        // Boxes with identical centers can't be split any further
+        const Vector3 extent = centerBounds.size();
+        if (last - first <= LeafSize || extent.max() <= 0.0f)
+        {
+            nodes_[index].first = first;
+            nodes_[index].count = last - first;
+            return;
+        }
+
+        const std::size_t axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0
+                                 : extent.y() >= extent.z()                           ? 1
+                                                                                      : 2;
+        const std::size_t middle = first + (last - first) / 2;
+        std::nth_element(indices_.begin() + first, indices_.begin() + middle, indices_.begin() + last,
+                         [&](const std::size_t a, const std::size_t b)
+                         { return bounds[a].center()[axis] < bounds[b].center()[axis]; });
+
+        // Siblings are stored next to each other, after their parent
+        const std::size_t left = nodes_.size();
+        nodes_.resize(nodes_.size() + 2);
+        nodes_[index].left  = left;
+        nodes_[index].count = 0;
+        buildNode(bounds, left, first, middle);
+        buildNode(bounds, left + 1, middle, last);
+    }
+};
+
+#endif // CONTAINERS_BVH_H
@@ -0,0 +1,140 @@
+#ifndef CONTAINERS_BUCKETEDPOOL_H
+#define CONTAINERS_BUCKETEDPOOL_H
+
+#include <Corrade/Utility/Assert.h>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Vector2.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Pool of size-dependent resources (e.g., render targets) whose storage is allocated in size buckets.
+ *
+ * The pooled type has to provide setSize() for the area that is actually in use and is created from its capacity
+ * (the bucket size), either through its constructor or a custom factory. A resource whose new size still fits its
+ * bucket is reused in place, so dragging a window or a pane border only allocates when a bucket boundary is crossed.
+ */
+template <class T>
+class BucketedPool
+{
+public:
+    using Factory = std::function<std::unique_ptr<T>(const Vector2i& capacity)>;
+
+    explicit BucketedPool(const Vector2i& granularity = Vector2i{256}, Factory factory = nullptr)
+    : granularity_(granularity)
+    , factory_(std::move(factory))
+    {
+        CORRADE_INTERNAL_ASSERT((granularity_ > Vector2i{0}).all());
+
+        if (!factory_)
+            factory_ = [](const Vector2i& capacity) { return std::make_unique<T>(capacity); };
+    }
+
+    BucketedPool(const BucketedPool<T>&)            = delete;
+    BucketedPool(BucketedPool<T>&&)                 = default;
+    BucketedPool& operator=(const BucketedPool<T>&) = delete;
+    BucketedPool& operator=(BucketedPool<T>&&)      = default;
+
+    /// Smallest bucket that can hold a resource of @p size.
+    Vector2i bucket(const Vector2i& size) const
+    {
+        const Vector2i clamped = Math::max(size, Vector2i{1});
+        return ((clamped + granularity_ - Vector2i{1}) / granularity_) * granularity_;
+    }
+
+    T& acquire(const Vector2i& size)
+    {
+        const auto found = std::find_if(entries_.begin(), entries_.end(),
+                                        [&](const Entry& e) { return !e.inUse && fits(e.capacity, size); });
+        if (found != entries_.end())
+        {
+            found->inUse = true;
+            found->resource->setSize(size);
+            return *found->resource;
+        }
+
+        const Vector2i capacity = bucket(size);
+        Entry&         entry    = entries_.emplace_back(Entry{factory_(capacity), capacity, true});
+        ++allocationCount_;
+
+        entry.resource->setSize(size);
+        return *entry.resource;
+    }
+
+    /// Returns either @p resource itself if @p size still fits its bucket or another pooled resource.
+    T& resize(T& resource, const Vector2i& size)
+    {
+        Entry& entry = find(resource);
+        if (fits(entry.capacity, size))
+        {
+            entry.resource->setSize(size);
+            return resource;
+        }
+
+        entry.inUse = false;
+        return acquire(size);
+    }
+
+    void release(T& resource) { find(resource).inUse = false; }
+
+    /// Frees @p resource unless it is in use. Returns whether it was freed.
+    bool erase(const T& resource)
+    {
+        if (find(resource).inUse)
+            return false;
+
+        std::erase_if(entries_, [&](const Entry& e) { return e.resource.get() == &resource; });
+        return true;
+    }
+
+    /// Frees all the resources that are not in use. Returns how many were freed.
+    std::size_t trim()
+    {
+        const auto removed = std::erase_if(entries_, [](const Entry& e) { return !e.inUse; });
+        return static_cast<std::size_t>(removed);
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    std::size_t inUse() const
+    {
+        return static_cast<std::size_t>(
+            std::count_if(entries_.begin(), entries_.end(), [](const Entry& e) { return e.inUse; }));
+    }
+    std::size_t allocationCount() const { return allocationCount_; }
+
+private:
+    struct Entry
+    {
+        std::unique_ptr<T> resource;
+        Vector2i           capacity;
+        bool               inUse;
+    };
+
+    Vector2i           granularity_;
+    Factory            factory_;
+    std::vector<Entry> entries_;
+    std::size_t        allocationCount_{0};
+
+    /* A resource is reused as long as the size fits and the resource is at most one bucket step larger than needed,
+       i.e., it is shrunk in place instead of being reallocated */
+    bool fits(const Vector2i& capacity, const Vector2i& size) const
+    {
+        return (size <= capacity).all() && (capacity - bucket(size) <= granularity_).all();
+    }
+
+    Entry& find(const T& resource)
+    {
+        const auto found = std::find_if(entries_.begin(), entries_.end(),
+                                        [&](const Entry& e) { return e.resource.get() == &resource; });
+        CORRADE_INTERNAL_ASSERT(found != entries_.end());
+        return *found;
+    }
+};
+
+#endif // CONTAINERS_BUCKETEDPOOL_H
@@ -0,0 +1,104 @@
+#ifndef CONTAINERS_LRUSLOTS_H
+#define CONTAINERS_LRUSLOTS_H
+
+#include <Corrade/Utility/Assert.h>
+
+#include <Magnum/Magnum.h>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Fixed number of slots (e.g., layers of a texture array) assigned to keys, reusing the least recently used slot when
+ * all of them are taken.
+ *
+ * Slots used since the last nextFrame() are never reused, so everything drawn in a frame stays valid until the frame
+ * is done; insert() fails instead when there's no other slot left.
+ */
+class LruSlots
+{
+public:
+    using Key = UnsignedLong;
+
+    explicit LruSlots(std::size_t capacity)
+    : slots_(capacity)
+    {
+        CORRADE_INTERNAL_ASSERT(capacity != 0);
+    }
+
+    /// Slot of @p key, marked as used. Empty if the key doesn't have one.
+    std::optional<std::size_t> find(const Key key)
+    {
+        const auto found = entries_.find(key);
+        if (found == entries_.end())
+            return std::nullopt;
+
+        use(found->second);
+        return found->second;
+    }
+
+    /**
+     * Assigns a slot to @p key, which must not have one, and marks it as used. The slot is a free one or the least
+     * recently used one, whose key loses it. Empty if all the slots were used in the current frame.
+     */
+    std::optional<std::size_t> insert(const Key key)
+    {
+        CORRADE_INTERNAL_ASSERT(!entries_.count(key));
+
+        std::size_t slot;
+        if (entries_.size() != slots_.size())
+            slot = entries_.size();
+        else
+        {
+            slot = order_.back();
+            if (slots_[slot].lastUsed == frame_)
+                return std::nullopt;
+
+            entries_.erase(slots_[slot].key);
+            order_.pop_back();
+            ++evictionCount_;
+        }
+
+        order_.push_front(slot);
+        slots_[slot].position = order_.begin();
+        slots_[slot].key      = key;
+        slots_[slot].lastUsed = frame_;
+        entries_.emplace(key, slot);
+        return slot;
+    }
+
+    /// Whether insert() would succeed.
+    bool canInsert() const { return entries_.size() != slots_.size() || slots_[order_.back()].lastUsed != frame_; }
+
+    void nextFrame() { ++frame_; }
+
+    std::size_t capacity() const { return slots_.size(); }
+    std::size_t size() const { return entries_.size(); }
+    /// Keys that lost their slot to another one.
+    std::size_t evictionCount() const { return evictionCount_; }
+
+private:
+    struct Slot
+    {
+        std::list<std::size_t>::iterator position;
+        Key                              key{0};
+        std::size_t                      lastUsed{0};
+    };
+
+    void use(const std::size_t slot)
+    {
+        order_.splice(order_.begin(), order_, slots_[slot].position);
+        slots_[slot].lastUsed = frame_;
+    }
+
+    std::vector<Slot>                    slots_;
+    std::list<std::size_t>               order_; ///< Most recently used first.
+    std::unordered_map<Key, std::size_t> entries_;
+    std::size_t                          frame_{1};
+    std::size_t                          evictionCount_{0};
+};
+
+#endif // CONTAINERS_LRUSLOTS_H
@@ -0,0 +1,71 @@
+#ifndef CONTAINERS_SPSCQUEUE_H
+#define CONTAINERS_SPSCQUEUE_H
+
+#include <Corrade/Utility/Assert.h>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * Bounded queue handing values from one producer thread to one consumer thread without locks.
+ *
+ * push() is called only by the producer and pop() only by the consumer; neither ever blocks, a full queue makes push()
+ * fail instead. The two indices are on separate cache lines so that the threads don't invalidate each other's line on
+ * every operation.
+ */
+template <class T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity)
+    : slots_(capacity + 1)
+    {
+        CORRADE_INTERNAL_ASSERT(capacity != 0);
+    }
+
+    SpscQueue(const SpscQueue<T>&)            = delete;
+    SpscQueue& operator=(const SpscQueue<T>&) = delete;
+
+    /// Producer only. Returns false, leaving @p value alone, if the queue is full.
+    bool push(T&& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t next = (tail + 1) % slots_.size();
+        if (next == head_.load(std::memory_order_acquire))
+            return false;
+
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Empty if the queue is.
+    std::optional<T> pop()
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> value = std::move(slots_[head]);
+        slots_[head].reset();
+        head_.store((head + 1) % slots_.size(), std::memory_order_release);
+        return value;
+    }
+
+    /// Only a snapshot when called while the other thread is using the queue.
+    bool isEmpty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    std::size_t capacity() const { return slots_.size() - 1; }
+
+private:
+    std::vector<std::optional<T>> slots_; ///< One more than the capacity, to tell a full queue from an empty one.
+
+    alignas(64) std::atomic<std::size_t> head_{0}; ///< Next slot to pop.
+    alignas(64) std::atomic<std::size_t> tail_{0}; ///< Next slot to push to.
+};
+
+#endif // CONTAINERS_SPSCQUEUE_H
@@ -0,0 +1,279 @@
+#include "ImageLoader.h"
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+#include <algorithm>
+
+namespace
+{
+
+/* Channel count and bytes per channel of the formats the decoder takes, zero channels for the ones it doesn't */
+std::pair<Int, Int> channelLayout(const PixelFormat format)
+{
+    switch (format)
+    {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::R8Srgb:      return {1, 1};
+        case PixelFormat::RG8Unorm:
+        case PixelFormat::RG8Srgb:     return {2, 1};
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGB8Srgb:    return {3, 1};
+        case PixelFormat::RGBA8Unorm:
+        case PixelFormat::RGBA8Srgb:   return {4, 1};
+        case PixelFormat::R16Unorm:    return {1, 2};
+        case PixelFormat::RG16Unorm:   return {2, 2};
+        case PixelFormat::RGB16Unorm:  return {3, 2};
+        case PixelFormat::RGBA16Unorm: return {4, 2};
+        default:                       return {0, 0};
+    }
+}
+
+} // namespace
+
+std::optional<Image2D> ImageLoader::toRgba8(const ImageView2D& image)
+{
+    const std::pair<Int, Int> layout   = channelLayout(image.format());
+    const Int                 channels = layout.first;
+    const Int                 bytes    = layout.second;
+    if (!channels)
+    {
+        Error{} << "ImageLoader: can't convert" << image.format() << "to RGBA8";
+        return std::nullopt;
+    }
+
+    Image2D rgba{PixelFormat::RGBA8Unorm, image.size(),
+                 Containers::Array<char>{NoInit, std::size_t(image.size().product()) * 4}};
+    const Containers::StridedArrayView3D<const char> source      = image.pixels();
+    const Containers::StridedArrayView2D<Color4ub>   destination = rgba.pixels<Color4ub>();
+    for (std::size_t y = 0; y != source.size()[0]; ++y)
+        for (std::size_t x = 0; x != source.size()[1]; ++x)
+        {
+            const Containers::StridedArrayView1D<const char> pixel = source[y][x];
+            // Little-endian, like everything the importers run on
+            const auto channel = [&](const Int i) { return UnsignedByte(pixel[std::size_t(i * bytes + bytes - 1)]); };
+
+            Color4ub& out = destination[y][x];
+            if (channels < 3)
+                out = {channel(0), channel(0), channel(0), channels == 2 ? channel(1) : UnsignedByte(255)};
+            else
+                out = {channel(0), channel(1), channel(2), channels == 4 ? channel(3) : UnsignedByte(255)};
+        }
+
+    return rgba;
+}
+
+ImageLoader::DecoderFactory ImageLoader::importerDecoder()
+{
+    return []
+    {
+        // Importers aren't thread-safe, so every worker has its own. The importer goes before its manager.
+        struct Importer
+        {
+            PluginManager::Manager<Trade::AbstractImporter> manager;
+            Containers::Pointer<Trade::AbstractImporter>    importer;
+        };
+        auto importer      = std::make_shared<Importer>();
+        importer->importer = importer->manager.loadAndInstantiate("AnyImageImporter");
+
+        return Decoder{[importer](const std::string& path) -> std::optional<Image2D>
+                       {
+                           Trade::AbstractImporter* const instance = importer->importer.get();
+                           if (!instance || !instance->openFile(path))
+                               return std::nullopt;
+
+                           const Containers::Optional<Trade::ImageData2D> image = instance->image2D(0);
+                           instance->close();
+                           if (!image)
+                               return std::nullopt;
+                           if (image->isCompressed())
+                           {
+                               Error{} << "ImageLoader: can't convert a compressed image to RGBA8";
+                               return std::nullopt;
+                           }
+
+                           return toRgba8(*image);
+                       }};
+    };
+}
+
+std::size_t ImageLoader::defaultThreadCount()
+{
+    return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+ImageLoader::ImageLoader(const std::size_t threadCount, DecoderFactory decoderFactory, std::function<void()> wake,
+                         const std::size_t queueCapacity)
+: decoderFactory_(std::move(decoderFactory))
+, wake_(std::move(wake))
+{
+    CORRADE_INTERNAL_ASSERT(threadCount != 0 && decoderFactory_);
+
+    // All the workers exist before the first one starts looking at them
+    for (std::size_t i = 0; i != threadCount; ++i)
+        workers_.push_back(std::make_unique<Worker>(queueCapacity));
+    for (const std::unique_ptr<Worker>& worker : workers_)
+        worker->thread = std::thread{[this, &target = *worker] { run(target); }};
+}
+
+ImageLoader::~ImageLoader()
+{
+    cancelAll();
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    wakeWorkers();
+
+    for (const std::unique_ptr<Worker>& worker : workers_)
+        worker->thread.join();
+}
+
+void ImageLoader::wakeWorkers()
+{
+    for (const std::unique_ptr<Worker>& worker : workers_)
+    {
+        worker->progress.fetch_add(1, std::memory_order_release);
+        worker->progress.notify_one();
+    }
+}
+
+void ImageLoader::run(Worker& worker)
+{
+    const Decoder decode = decoderFactory_();
+
+    for (;;)
+    {
+        Id      id;
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            condition_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+            if (stopping_)
+                return;
+
+            id = queue_.begin()->second;
+            queue_.erase(queue_.begin());
+            const auto found = waiting_.find(id);
+            request          = std::move(found->second);
+            waiting_.erase(found);
+        }
+
+        Decoded decoded{{id, request.path, decode(request.path)}, std::move(request.cancelled)};
+        decodedCount_.fetch_add(1, std::memory_order_relaxed);
+
+        /* Wait for the render thread to take earlier results, unless nobody wants this one anymore. The progress is
+           read before trying, so that a take() in between makes the wait return right away. */
+        for (;;)
+        {
+            const UnsignedInt progress = worker.progress.load(std::memory_order_acquire);
+            if (worker.results.push(std::move(decoded)))
+                break;
+            if (stopping_ || decoded.cancelled->load(std::memory_order_relaxed))
+            {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            worker.progress.wait(progress, std::memory_order_acquire);
+        }
+
+        if (wake_)
+            wake_();
+    }
+}
+
+ImageLoader::Id ImageLoader::request(std::string path, const Float priority)
+{
+    const Id id        = next_++;
+    auto     cancelled = std::make_shared<std::atomic<bool>>(false);
+    cancelled_.emplace(id, cancelled);
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        queue_.insert({priority, id});
+        waiting_.emplace(id, Request{std::move(path), priority, std::move(cancelled)});
+    }
+    condition_.notify_one();
+
+    return id;
+}
+
+bool ImageLoader::setPriority(const Id id, const Float priority)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    const auto                  found = waiting_.find(id);
+    if (found == waiting_.end())
+        return false;
+
+    queue_.erase({found->second.priority, id});
+    queue_.insert({priority, id});
+    found->second.priority = priority;
+    return true;
+}
+
+void ImageLoader::cancel(const Id id)
+{
+    const auto found = cancelled_.find(id);
+    if (found == cancelled_.end())
+        return;
+
+    // If a worker has it already, its result is dropped in take() or, if the worker waits for room, right away
+    found->second->store(true, std::memory_order_relaxed);
+    cancelled_.erase(found);
+    wakeWorkers();
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    const auto                  waiting = waiting_.find(id);
+    if (waiting != waiting_.end())
+    {
+        queue_.erase({waiting->second.priority, id});
+        waiting_.erase(waiting);
+        ++cancelledCount_;
+    }
+}
+
+void ImageLoader::cancelAll()
+{
+    for (const auto& [id, cancelled] : cancelled_)
+        cancelled->store(true, std::memory_order_relaxed);
+    cancelled_.clear();
+    wakeWorkers();
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    cancelledCount_ += waiting_.size();
+    queue_.clear();
+    waiting_.clear();
+}
+
+std::optional<ImageLoader::Result> ImageLoader::take()
+{
+    for (std::size_t i = 0; i != workers_.size(); ++i)
+    {
+        Worker& worker = *workers_[(nextWorker_ + i) % workers_.size()];
+        while (std::optional<Decoded> decoded = worker.results.pop())
+        {
+            // There's room in the queue again
+            worker.progress.fetch_add(1, std::memory_order_release);
+            worker.progress.notify_one();
+
+            if (decoded->cancelled->load(std::memory_order_relaxed))
+            {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            cancelled_.erase(decoded->result.id);
+            nextWorker_ = (nextWorker_ + i + 1) % workers_.size();
+            return std::move(decoded->result);
+        }
+    }
+
+    return std::nullopt;
+}
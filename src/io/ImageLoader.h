@@ -0,0 +1,154 @@
+#ifndef IO_IMAGELOADER_H
+#define IO_IMAGELOADER_H
+
+#include "../containers/SpscQueue.h"
+
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Magnum.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Decodes image files on a pool of worker threads, so that the render thread never waits for a PNG or a TIFF.
+ *
+ * Requests are decoded highest priority first, e.g. images shown in a pane before the ones prefetched around them.
+ * Requests that became outdated are cancelled: if they're still waiting they're never decoded, otherwise their result
+ * is dropped. Every worker hands its results to the render thread through its own lock-free queue, so take() never
+ * blocks; a worker waits with the next decode while its queue is full, which bounds the decoded memory in flight, and
+ * is woken by take() or cancel() instead of polling.
+ */
+class ImageLoader
+{
+public:
+    using Id = UnsignedLong;
+
+    /// Decodes the file at a path into RGBA8 pixels with rows bottom-up. Empty if it can't.
+    using Decoder = std::function<std::optional<Image2D>(const std::string& path)>;
+    /// Called once on every worker thread, so that decoders don't need to be thread-safe.
+    using DecoderFactory = std::function<Decoder()>;
+
+    struct Result
+    {
+        Id                     id;
+        std::string            path;
+        std::optional<Image2D> image; ///< Empty if decoding failed.
+    };
+
+    static constexpr std::size_t DefaultQueueCapacity = 4;
+
+    /**
+     * Decodes through Trade::AnyImageImporter, which picks the importer plugin by the file extension. Formats other
+     * than 8 or 16 bits per channel or compressed ones are refused.
+     */
+    static DecoderFactory importerDecoder();
+    /**
+     * Converts 8 or 16 bits per channel with one to four channels to RGBA8 the way importerDecoder() does: gray is
+     * spread to all three color channels and 16-bit channels keep their most significant byte. Empty for other
+     * formats.
+     */
+    static std::optional<Image2D> toRgba8(const ImageView2D& image);
+    /// All the cores but the one of the render thread, at least one.
+    static std::size_t defaultThreadCount();
+
+    /// @p wake is called from the workers when a result is ready, e.g. FrameScheduler::requestFrame().
+    explicit ImageLoader(std::size_t threadCount = defaultThreadCount(),
+                         DecoderFactory decoderFactory = importerDecoder(), std::function<void()> wake = nullptr,
+                         std::size_t queueCapacity = DefaultQueueCapacity);
+    /// Cancels everything and waits for the decodes in progress.
+    ~ImageLoader();
+
+    ImageLoader(const ImageLoader&)            = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    /// Higher @p priority is decoded first, the same one in request order.
+    Id   request(std::string path, Float priority = 0.0f);
+    /// Returns false if @p id isn't waiting anymore.
+    bool setPriority(Id id, Float priority);
+    /// Does nothing if @p id was already taken.
+    void cancel(Id id);
+    void cancelAll();
+
+    /// Next finished request that wasn't cancelled. Render thread only.
+    std::optional<Result> take();
+
+    std::size_t threadCount() const { return workers_.size(); }
+    /// Requests neither taken nor cancelled yet.
+    std::size_t pendingCount() const { return cancelled_.size(); }
+    std::size_t decodedCount() const { return decodedCount_.load(std::memory_order_relaxed); }
+    /// Requests cancelled before a worker picked them up.
+    std::size_t cancelledCount() const { return cancelledCount_; }
+    /// Requests decoded in vain because they were cancelled meanwhile, or because the loader was destroyed.
+    std::size_t droppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+private:
+    struct Request
+    {
+        std::string                        path;
+        Float                              priority;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct Decoded
+    {
+        Result                             result;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct Worker
+    {
+        explicit Worker(std::size_t queueCapacity)
+        : results{queueCapacity}
+        {
+        }
+
+        SpscQueue<Decoded> results;
+        /// Bumped when the render thread took a result or cancelled something, to wake the worker if results is full.
+        std::atomic<UnsignedInt> progress{0};
+        std::thread              thread;
+    };
+
+    using QueueEntry = std::pair<Float, Id>;
+    struct QueueOrder
+    {
+        bool operator()(const QueueEntry& a, const QueueEntry& b) const
+        {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+
+    void run(Worker& worker);
+    void wakeWorkers();
+
+    DecoderFactory        decoderFactory_;
+    std::function<void()> wake_;
+
+    std::mutex                           mutex_;
+    std::condition_variable              condition_;
+    std::set<QueueEntry, QueueOrder>     queue_; ///< Waiting requests, next first.
+    std::unordered_map<Id, Request>      waiting_;
+    std::atomic<bool>                    stopping_{false};
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /* Render thread only */
+    std::unordered_map<Id, std::shared_ptr<std::atomic<bool>>> cancelled_; ///< Of the requests not taken yet.
+    Id                                                         next_{1};
+    std::size_t                                                nextWorker_{0}; ///< Queue take() looks at first.
+    std::size_t                                                cancelledCount_{0};
+
+    std::atomic<std::size_t> decodedCount_{0};
+    std::atomic<std::size_t> droppedCount_{0};
+};
+
+#endif // IO_IMAGELOADER_H
@@ -0,0 +1,418 @@
+#include "PointCloudFile.h"
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Debug.h>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+
+/* Splits the header into lines and the lines into words, without copying anything */
+class HeaderReader
+{
+public:
+    explicit HeaderReader(Containers::ArrayView<const char> data)
+    : data_{data.data(), data.size()}
+    {
+    }
+
+    /// Reads the next line. Returns false if there's no complete line left.
+    bool next(std::vector<std::string_view>& words)
+    {
+        const std::size_t end = data_.find('\n', position_);
+        if (end == std::string_view::npos)
+            return false;
+
+        std::string_view line = data_.substr(position_, end - position_);
+        position_             = end + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        words.clear();
+        while (!line.empty())
+        {
+            const std::size_t begin = line.find_first_not_of(" \t");
+            if (begin == std::string_view::npos)
+                break;
+            line.remove_prefix(begin);
+
+            const std::size_t length = std::min(line.find_first_of(" \t"), line.size());
+            words.push_back(line.substr(0, length));
+            line.remove_prefix(length);
+        }
+        return true;
+    }
+
+    /// Offset of the line after the last one read.
+    std::size_t position() const { return position_; }
+
+private:
+    std::string_view data_;
+    std::size_t      position_{0};
+};
+
+Containers::StringView stringView(std::string_view word)
+{
+    return {word.data(), word.size()};
+}
+
+std::nullopt_t fail(const char* message)
+{
+    Error{} << "PointCloudFile:" << message;
+    return std::nullopt;
+}
+
+std::nullopt_t fail(const char* message, std::string_view word)
+{
+    Error{} << "PointCloudFile:" << message << stringView(word);
+    return std::nullopt;
+}
+
+bool parseNumber(std::string_view word, std::size_t& number)
+{
+    const auto result = std::from_chars(word.data(), word.data() + word.size(), number);
+    return result.ec == std::errc{} && result.ptr == word.data() + word.size();
+}
+
+std::optional<PointCloudFile::Type> plyType(std::string_view name)
+{
+    using Type = PointCloudFile::Type;
+
+    if (name == "char" || name == "int8")
+        return Type::INT8;
+    if (name == "uchar" || name == "uint8")
+        return Type::UINT8;
+    if (name == "short" || name == "int16")
+        return Type::INT16;
+    if (name == "ushort" || name == "uint16")
+        return Type::UINT16;
+    if (name == "int" || name == "int32")
+        return Type::INT32;
+    if (name == "uint" || name == "uint32")
+        return Type::UINT32;
+    if (name == "float" || name == "float32")
+        return Type::FLOAT32;
+    if (name == "double" || name == "float64")
+        return Type::FLOAT64;
+    return std::nullopt;
+}
+
+std::optional<PointCloudFile::Type> pcdType(std::string_view type, std::size_t size)
+{
+    using Type = PointCloudFile::Type;
+
+    if (type == "F")
+        return size == 4 ? std::optional{Type::FLOAT32} : size == 8 ? std::optional{Type::FLOAT64} : std::nullopt;
+    if (type == "I")
+        return size == 1 ? std::optional{Type::INT8}
+             : size == 2 ? std::optional{Type::INT16}
+             : size == 4 ? std::optional{Type::INT32}
+                         : std::nullopt;
+    if (type == "U")
+        return size == 1 ? std::optional{Type::UINT8}
+             : size == 2 ? std::optional{Type::UINT16}
+             : size == 4 ? std::optional{Type::UINT32}
+                         : std::nullopt;
+    return std::nullopt;
+}
+
+} // namespace
+
+std::size_t PointCloudFile::typeSize(const Type type)
+{
+    switch (type)
+    {
+    case Type::INT8:
+    case Type::UINT8:
+        return 1;
+    case Type::INT16:
+    case Type::UINT16:
+        return 2;
+    case Type::INT32:
+    case Type::UINT32:
+    case Type::FLOAT32:
+        return 4;
+    case Type::FLOAT64:
+        return 8;
+    }
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+}
+
+std::optional<PointCloudFile> PointCloudFile::open(const Containers::StringView path)
+{
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapping =
+        Utility::Path::mapRead(path);
+    if (!mapping)
+    {
+        Error{} << "PointCloudFile: can't map" << path;
+        return std::nullopt;
+    }
+
+    std::optional<PointCloudFile> file = parse(*mapping);
+    if (!file)
+        return std::nullopt;
+
+    // The views point into the mapping, which doesn't move with the array
+    file->mapping_ = std::move(*mapping);
+    return file;
+}
+
+std::optional<PointCloudFile> PointCloudFile::parse(const Containers::ArrayView<const char> data)
+{
+    const std::string_view start{data.data(), std::min(data.size(), std::size_t{4})};
+    if (start == "ply\n" || start == "ply\r")
+        return parsePly(data);
+    return parsePcd(data);
+}
+
+std::optional<PointCloudFile> PointCloudFile::parsePly(const Containers::ArrayView<const char> data)
+{
+    HeaderReader                  reader{data};
+    std::vector<std::string_view> words;
+    if (!reader.next(words) || !reader.next(words) || words.size() != 3 || words[0] != "format")
+        return fail("missing PLY format");
+    if (words[1] == "ascii")
+        return fail("text PLY files are not supported");
+    if (words[1] == "binary_big_endian")
+        return fail("big-endian PLY files are not supported");
+    if (words[1] != "binary_little_endian")
+        return fail("unknown PLY format", words[1]);
+
+    PointCloudFile file;
+    file.format_ = Format::PLY;
+
+    /* Elements before the vertices are skipped, which needs their size */
+    struct Element
+    {
+        std::size_t count{0};
+        std::size_t stride{0};
+        bool        hasList{false};
+    };
+    std::optional<Element> element;
+    bool                   inVertices    = false;
+    bool                   foundVertices = false;
+    std::size_t            skipped       = 0;
+    const auto             endElement    = [&]
+    {
+        if (element && !foundVertices)
+        {
+            // Elements with lists have a size per item, which would need a pass over all of them
+            if (element->hasList && element->count)
+                return false;
+            skipped += element->count * element->stride;
+        }
+        element.reset();
+        return true;
+    };
+
+    while (true)
+    {
+        if (!reader.next(words))
+            return fail("incomplete PLY header");
+        if (words.empty() || words[0] == "comment" || words[0] == "obj_info")
+            continue;
+
+        if (words[0] == "end_header")
+        {
+            if (!endElement())
+                return fail("PLY elements with lists before the vertices are not supported");
+            break;
+        }
+
+        if (words[0] == "element")
+        {
+            if (!endElement())
+                return fail("PLY elements with lists before the vertices are not supported");
+
+            std::size_t count;
+            if (words.size() != 3 || !parseNumber(words[2], count))
+                return fail("invalid PLY element");
+
+            inVertices    = words[1] == "vertex";
+            foundVertices = foundVertices || inVertices;
+            if (inVertices)
+                file.size_ = count;
+            element = Element{count};
+            continue;
+        }
+
+        if (words[0] == "property" && element)
+        {
+            if (words.size() >= 2 && words[1] == "list")
+            {
+                if (inVertices)
+                    return fail("PLY vertex lists are not supported");
+                element->hasList = true;
+                continue;
+            }
+
+            if (words.size() != 3)
+                return fail("invalid PLY property");
+            const std::optional<Type> type = plyType(words[1]);
+            if (!type)
+                return fail("unknown PLY type", words[1]);
+
+            if (inVertices)
+            {
+                file.attributes_.push_back({std::string{words[2]}, *type, 1, file.stride_});
+                file.stride_ += typeSize(*type);
+            }
+            else
+                element->stride += typeSize(*type);
+            continue;
+        }
+
+        return fail("unexpected PLY header line", words[0]);
+    }
+
+    if (!foundVertices)
+        return fail("no vertices in the PLY file");
+    if (file.attributes_.empty())
+        return fail("PLY vertices without properties");
+
+    const std::size_t begin = reader.position() + skipped;
+    if (begin > data.size() || file.size_ > (data.size() - begin) / file.stride_)
+        return fail("truncated PLY file");
+
+    file.data_ = data.slice(begin, begin + file.size_ * file.stride_);
+    return file;
+}
+
+std::optional<PointCloudFile> PointCloudFile::parsePcd(const Containers::ArrayView<const char> data)
+{
+    HeaderReader                  reader{data};
+    std::vector<std::string_view> words;
+    std::vector<std::string_view> fields;
+    std::vector<std::string_view> sizes;
+    std::vector<std::string_view> types;
+    std::vector<std::string_view> counts;
+    std::size_t                   width  = 0;
+    std::size_t                   height = 1;
+    std::optional<std::size_t>    points;
+
+    while (true)
+    {
+        if (!reader.next(words))
+            return fail("not a PLY or PCD file");
+        if (words.empty() || words[0].front() == '#')
+            continue;
+
+        const std::string_view              key = words[0];
+        const std::vector<std::string_view> values{words.begin() + 1, words.end()};
+        if (key == "FIELDS")
+            fields = values;
+        else if (key == "SIZE")
+            sizes = values;
+        else if (key == "TYPE")
+            types = values;
+        else if (key == "COUNT")
+            counts = values;
+        else if (key == "WIDTH" || key == "HEIGHT" || key == "POINTS")
+        {
+            std::size_t number;
+            if (values.size() != 1 || !parseNumber(values[0], number))
+                return fail("invalid PCD header line", key);
+            if (key == "WIDTH")
+                width = number;
+            else if (key == "HEIGHT")
+                height = number;
+            else
+                points = number;
+        }
+        else if (key == "DATA")
+        {
+            if (values.size() == 1 && values[0] == "binary")
+                break;
+            if (values.size() == 1 && values[0] == "ascii")
+                return fail("text PCD files are not supported");
+            if (values.size() == 1 && values[0] == "binary_compressed")
+                return fail("compressed PCD files are not supported");
+            return fail("unknown PCD data format");
+        }
+        else if (key != "VERSION" && key != "VIEWPOINT")
+            return fail("unexpected PCD header line", key);
+    }
+
+    if (fields.empty() || sizes.size() != fields.size() || types.size() != fields.size() ||
+        (!counts.empty() && counts.size() != fields.size()))
+        return fail("PCD fields, sizes, types and counts don't match");
+
+    PointCloudFile file;
+    file.format_ = Format::PCD;
+    file.size_   = points ? *points : width * height;
+    for (std::size_t i = 0; i != fields.size(); ++i)
+    {
+        std::size_t size;
+        std::size_t count = 1;
+        if (!parseNumber(sizes[i], size) || (!counts.empty() && !parseNumber(counts[i], count)) || !count)
+            return fail("invalid PCD field", fields[i]);
+
+        const std::optional<Type> type = pcdType(types[i], size);
+        if (!type)
+            return fail("unknown PCD type of field", fields[i]);
+
+        file.attributes_.push_back({std::string{fields[i]}, *type, UnsignedInt(count), file.stride_});
+        file.stride_ += size * count;
+    }
+
+    const std::size_t begin = reader.position();
+    if (file.size_ > (data.size() - begin) / file.stride_)
+        return fail("truncated PCD file");
+
+    file.data_ = data.slice(begin, begin + file.size_ * file.stride_);
+    return file;
+}
+
+const PointCloudFile::Attribute* PointCloudFile::attribute(const Containers::StringView name) const
+{
+    for (const Attribute& attribute : attributes_)
+        if (Containers::StringView{attribute.name.data(), attribute.name.size()} == name)
+            return &attribute;
+    return nullptr;
+}
+
+Containers::StridedArrayView1D<const Vector3> PointCloudFile::positions() const
+{
+    const Attribute* x = attribute("x");
+    const Attribute* y = attribute("y");
+    const Attribute* z = attribute("z");
+    if (!x || !y || !z)
+        return {};
+
+    for (const Attribute* component : {x, y, z})
+        if (component->type != Type::FLOAT32 || component->count != 1)
+            return {};
+    if (y->offset != x->offset + 4 || z->offset != x->offset + 8)
+        return {};
+
+    return strided<Vector3>(x->offset);
+}
+
+Containers::StridedArrayView2D<const UnsignedByte> PointCloudFile::colors() const
+{
+    const auto channels = [&](std::size_t offset)
+    {
+        return Containers::StridedArrayView2D<const UnsignedByte>{
+            data_, reinterpret_cast<const UnsignedByte*>(data_.data() + offset), {size_, 3},
+            {std::ptrdiff_t(stride_), 1}};
+    };
+
+    const Attribute* red   = attribute("red");
+    const Attribute* green = attribute("green");
+    const Attribute* blue  = attribute("blue");
+    if (red && green && blue && red->type == Type::UINT8 && green->type == Type::UINT8 && blue->type == Type::UINT8 &&
+        green->offset == red->offset + 1 && blue->offset == red->offset + 2)
+        return channels(red->offset);
+
+    /* PCD packs the colors into a 32-bit 0x00RRGGBB (or AARRGGBB) value, which is B, G, R in a little-endian file */
+    const Attribute* packed = attribute("rgb");
+    if (!packed)
+        packed = attribute("rgba");
+    if (packed && packed->count == 1 && typeSize(packed->type) == 4)
+        return channels(packed->offset).flipped<1>();
+
+    return {};
+}
@@ -0,0 +1,140 @@
+#ifndef IO_POINTCLOUDFILE_H
+#define IO_POINTCLOUDFILE_H
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector3.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Binary PLY or PCD point cloud, memory-mapped and read in place.
+ *
+ * Only the header is parsed. The points stay in the mapping and the attributes are exposed as strided views over it,
+ * so opening a file of any size costs about as much as its header, and the pages are read by the OS as the views are
+ * accessed. data() can be uploaded to a GPU buffer as a whole, with the attribute offsets and stride() as the vertex
+ * layout. Text files and compressed PCD files are refused, as are big-endian PLY files.
+ *
+ * The attributes are packed in the file, so the elements of a view aren't necessarily aligned for their type.
+ */
+class PointCloudFile
+{
+public:
+    enum class Format : uint8_t
+    {
+        PLY = 0,
+        PCD
+    };
+
+    enum class Type : uint8_t
+    {
+        INT8 = 0,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        FLOAT32,
+        FLOAT64
+    };
+
+    struct Attribute
+    {
+        std::string name;
+        Type        type;
+        UnsignedInt count;  ///< Components, PCD fields can have more than one.
+        std::size_t offset; ///< From the start of a point.
+    };
+
+    static std::size_t typeSize(Type type);
+
+    /// Maps the file at @p path. Prints an error and returns std::nullopt if it can't be mapped or read.
+    static std::optional<PointCloudFile> open(Containers::StringView path);
+
+    /// Like open(), but over @p data, which has to outlive the returned file.
+    static std::optional<PointCloudFile> parse(Containers::ArrayView<const char> data);
+
+    Format                        format() const { return format_; }
+    std::size_t                   size() const { return size_; }
+    std::size_t                   stride() const { return stride_; }
+    const std::vector<Attribute>& attributes() const { return attributes_; }
+    /// Null if there's no attribute called @p name.
+    const Attribute* attribute(Containers::StringView name) const;
+
+    /// The points as they are in the file, size() times stride() bytes.
+    Containers::ArrayView<const char> data() const { return data_; }
+    bool                              isMapped() const { return !mapping_.isEmpty(); }
+
+    /// Values of the single-component attribute @p name, which has to exist and be of the type matching @p T.
+    template <class T>
+    Containers::StridedArrayView1D<const T> view(Containers::StringView name) const
+    {
+        const Attribute* found = attribute(name);
+        CORRADE_INTERNAL_ASSERT(found && found->count == 1 && found->type == typeOf<T>());
+        return strided<T>(found->offset);
+    }
+
+    /// Positions if there are consecutive float x, y and z attributes, otherwise an empty view.
+    Containers::StridedArrayView1D<const Vector3> positions() const;
+
+    /**
+     * Red, green and blue channels of every point, as a point × channel view. Comes from consecutive uchar red, green
+     * and blue attributes of a PLY file, or from the packed rgb or rgba field of a PCD file, whose bytes are in BGR
+     * order and thus viewed backwards. Empty if there's neither.
+     */
+    Containers::StridedArrayView2D<const UnsignedByte> colors() const;
+
+private:
+    explicit PointCloudFile() = default;
+
+    static std::optional<PointCloudFile> parsePly(Containers::ArrayView<const char> data);
+    static std::optional<PointCloudFile> parsePcd(Containers::ArrayView<const char> data);
+
+    template <class T>
+    static constexpr Type typeOf()
+    {
+        if constexpr (std::is_same_v<T, Byte>)
+            return Type::INT8;
+        else if constexpr (std::is_same_v<T, UnsignedByte>)
+            return Type::UINT8;
+        else if constexpr (std::is_same_v<T, Short>)
+            return Type::INT16;
+        else if constexpr (std::is_same_v<T, UnsignedShort>)
+            return Type::UINT16;
+        else if constexpr (std::is_same_v<T, Int>)
+            return Type::INT32;
+        else if constexpr (std::is_same_v<T, UnsignedInt>)
+            return Type::UINT32;
+        else if constexpr (std::is_same_v<T, Float>)
+            return Type::FLOAT32;
+        else
+        {
+            static_assert(std::is_same_v<T, Double>, "unsupported attribute type");
+            return Type::FLOAT64;
+        }
+    }
+
+    template <class T>
+    Containers::StridedArrayView1D<const T> strided(std::size_t offset) const
+    {
+        return {data_, reinterpret_cast<const T*>(data_.data() + offset), size_, std::ptrdiff_t(stride_)};
+    }
+
+    Containers::Array<const char, Utility::Path::MapDeleter> mapping_;
+    Containers::ArrayView<const char>                        data_;
+    Format                                                   format_{Format::PLY};
+    std::size_t                                              size_{0};
+    std::size_t                                              stride_{0};
+    std::vector<Attribute>                                   attributes_;
+};
+
+#endif // IO_POINTCLOUDFILE_H
@@ -1,25 +1,55 @@
 #include "Grid.h"
 
+#include "../shaders/MultiViewFlatShader.h"
+
 #include <Magnum/Math/Color.h>
-#include <Magnum/MeshTools/Compile.h>
 #include <Magnum/Primitives/Grid.h>
 #include <Magnum/Trade/MeshData.h>
 
-Grid::Grid(Object3D& parent, SceneGraph::DrawableGroup3D& drawables)
-: SceneGraph::Drawable3D(parent, &drawables)
+namespace
 {
-    using namespace Math::Literals;
+constexpr const char* MeshName = "grid3DWireframe-15x15";
+// Half the extent of the mesh the multi-view fallback draws, in world units
+constexpr Float MeshExtent = 8.0f;
 
-    grid_ = MeshTools::compile(Primitives::grid3DWireframe({15, 15}));
+Trade::MeshData generateMesh()
+{
+    return Primitives::grid3DWireframe({15, 15});
+}
+} // namespace
 
-    rotateX(90.0_degf).scale(Vector3{8.0f});
+Grid::Grid(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources)
+: SceneDrawable(parent, &drawables)
+, shader_(resources.infiniteGrid())
+, fullScreen_(InfiniteGridShader::fullScreenTriangle())
+, grid_(resources.mesh(MeshName, generateMesh))
+{
 }
 
 void Grid::draw(const Matrix4& transformation, SceneGraph::Camera3D& camera)
 {
     using namespace Math::Literals;
 
-    shader_.setColor(0x747474_rgbf)
+    shader_->setColor(0x747474_rgbf)
+        .setMajorColor(0x9a9a9a_rgbf)
+        .setObjectId(objectId())
         .setTransformationProjectionMatrix(camera.projectionMatrix() * transformation)
-        .draw(grid_);
+        .draw(fullScreen_);
+}
+
+RenderState Grid::renderState() const
+{
+    // The lines fade out
+    return {RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING | RenderFeature::BLENDING};
+}
+
+bool Grid::drawMultiView(const Matrix4& worldTransformation, MultiViewShaders& shaders)
+{
+    using namespace Math::Literals;
+
+    shaders.lines.setColor(0x747474_rgbf)
+        .setObjectId(objectId())
+        .setTransformationMatrix(worldTransformation * Matrix4::scaling(Vector3{MeshExtent}))
+        .draw(*grid_);
+    return true;
 }
@@ -1,24 +1,33 @@
 #ifndef OBJECTS_GRID_H
 #define OBJECTS_GRID_H
 
+#include "../render/GpuResources.h"
 #include "../traits/traits.h"
+#include "SceneDrawable.h"
 
-#include <Magnum/GL/Mesh.h>
 #include <Magnum/SceneGraph/Camera.h>
-#include <Magnum/SceneGraph/Drawable.h>
-#include <Magnum/Shaders/FlatGL.h>
 
 using namespace Magnum;
 
-class Grid : public Object3D, public SceneGraph::Drawable3D
+/**
+ * Ground grid on the XY plane of the Z-up scene, drawn with an InfiniteGridShader so that it reaches the horizon at any
+ * zoom level.
+ *
+ * It has no bounding box and is thus never culled. Multi-view rendering can't draw it procedurally and falls back to a
+ * finite wireframe mesh.
+ */
+class Grid : public Object3D, public SceneDrawable
 {
 public:
-    explicit Grid(Object3D& parent, SceneGraph::DrawableGroup3D& drawables);
+    explicit Grid(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources);
     void draw(const Matrix4& transformation, SceneGraph::Camera3D& camera);
+    bool drawMultiView(const Matrix4& worldTransformation, MultiViewShaders& shaders) override;
+    RenderState renderState() const override;
 
 private:
-    Shaders::FlatGL3D shader_;
-    GL::Mesh          grid_;
+    Resource<InfiniteGridShader> shader_;
+    GL::Mesh                     fullScreen_;
+    Resource<GL::Mesh>           grid_;
 };
 
 #endif // OBJECTS_GRID_H
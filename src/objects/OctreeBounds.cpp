@@ -0,0 +1,71 @@
+#include "OctreeBounds.h"
+
+#include "../render/BatchRenderer.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Trade/MeshData.h>
+
+namespace
+{
+constexpr const char* MeshName = "cubeWireframe";
+
+Trade::MeshData generateMesh()
+{
+    return Primitives::cubeWireframe();
+}
+
+// The unit cube spans -1 to 1 on every axis
+Matrix4 boxTransformation(const Range3D& bounds)
+{
+    return Matrix4::translation(bounds.center()) * Matrix4::scaling(bounds.size() * 0.5f);
+}
+
+// Coarse nodes are warm, fine nodes cold, repeating past the last color
+Color4 depthColor(const UnsignedInt depth)
+{
+    using namespace Math::Literals;
+
+    constexpr Color3 Colors[]{0xff5252_rgbf, 0xffab40_rgbf, 0xffff00_rgbf, 0x69f0ae_rgbf,
+                              0x40c4ff_rgbf, 0x536dfe_rgbf, 0xe040fb_rgbf, 0x9e9e9e_rgbf};
+    return Color4{Colors[depth % Containers::arraySize(Colors)]};
+}
+} // namespace
+
+OctreeBounds::OctreeBounds(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources,
+                           const PointOctree& octree)
+: Object3D(&parent)
+, SceneDrawable(*this, &drawables)
+, octree_(octree)
+, shader_(resources.flat3D(Shaders::FlatGL3D::Flag::ObjectId))
+, box_(resources.mesh(MeshName, generateMesh))
+{
+    setBoundingBox(octree_.nodes().front().bounds);
+}
+
+void OctreeBounds::draw(const Matrix4& transformation, SceneGraph::Camera3D& camera)
+{
+    const Matrix4 transformationProjection = camera.projectionMatrix() * transformation;
+    // The lines cover what is behind them in the object ID buffer too, zero unless they were registered for picking
+    shader_->setObjectId(objectId());
+    for (const PointOctree::Node& node : octree_.nodes())
+        shader_->setColor(depthColor(node.depth))
+            .setTransformationProjectionMatrix(transformationProjection * boxTransformation(node.bounds))
+            .draw(*box_);
+}
+
+bool OctreeBounds::drawBatched(const Matrix4& transformation, BatchRenderer& batch)
+{
+    const UnsignedInt mesh = batch.mesh(MeshName, generateMesh);
+    for (const PointOctree::Node& node : octree_.nodes())
+        batch.add(mesh, transformation * boxTransformation(node.bounds), batch.material(depthColor(node.depth)),
+                  objectId());
+    return true;
+}
+
+RenderState OctreeBounds::renderState() const
+{
+    // Lines have no faces to cull
+    return {RenderFeature::DEPTH_TEST};
+}
@@ -0,0 +1,36 @@
+#ifndef OBJECTS_OCTREEBOUNDS_H
+#define OBJECTS_OCTREEBOUNDS_H
+
+#include "../render/GpuResources.h"
+#include "../render/PointOctree.h"
+#include "../traits/traits.h"
+#include "SceneDrawable.h"
+
+#include <Magnum/SceneGraph/Camera.h>
+
+using namespace Magnum;
+
+/**
+ * Wireframe boxes around the nodes of a PointOctree, colored by depth, to see how a point cloud is split up.
+ *
+ * Every node is its own box, so a large octree means thousands of small draws. They're queued on the BatchRenderer
+ * when batching is enabled and drawn one by one otherwise. Not drawn in multi-view mode.
+ */
+class OctreeBounds : public Object3D, public SceneDrawable
+{
+public:
+    /// Boxes of @p octree, which has to outlive them, in the space of @p parent, usually the point cloud.
+    explicit OctreeBounds(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources,
+                          const PointOctree& octree);
+
+    void        draw(const Matrix4& transformation, SceneGraph::Camera3D& camera);
+    bool        drawBatched(const Matrix4& transformation, BatchRenderer& batch) override;
+    RenderState renderState() const override;
+
+private:
+    const PointOctree&          octree_;
+    Resource<Shaders::FlatGL3D> shader_;
+    Resource<GL::Mesh>          box_;
+};
+
+#endif // OBJECTS_OCTREEBOUNDS_H
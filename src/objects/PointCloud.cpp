@@ -0,0 +1,132 @@
+#include "PointCloud.h"
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/Math/Color.h>
+#include <algorithm>
+#include <utility>
+
+PointCloud::PointCloud(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources,
+                       const Containers::StridedArrayView1D<const Vector3>      positions,
+                       const Containers::StridedArrayView2D<const UnsignedByte> colors)
+: Object3D(&parent)
+, SceneDrawable(*this, &drawables)
+, positions_(positions)
+, colors_(colors)
+, octree_(positions)
+, shader_(resources.flat3D(Shaders::FlatGL3D::Flag::VertexColor | Shaders::FlatGL3D::Flag::InstancedObjectId))
+, memory_(resources.memory())
+, gpuNodes_(octree_.nodes().size())
+, parentPending_(octree_.nodes().size())
+{
+    setBoundingBox(octree_.nodes().front().bounds);
+}
+
+PointCloud::~PointCloud()
+{
+    for (const GpuNode& node : gpuNodes_)
+        if (node.memoryId)
+            memory_.remove(node.memoryId);
+}
+
+std::size_t PointCloud::residentNodeCount() const
+{
+    return std::size_t(std::count_if(gpuNodes_.begin(), gpuNodes_.end(), [&](const GpuNode& node)
+                                     { return node.memoryId && memory_.isResident(node.memoryId); }));
+}
+
+void PointCloud::upload(const UnsignedInt node)
+{
+    /* Only the points of the node are gathered, into a buffer that is reused for every upload */
+    const Containers::ArrayView<const UnsignedInt> indices = octree_.indices(node);
+    vertices_.resize(indices.size());
+    const bool hasColors = !colors_.isEmpty();
+    for (std::size_t i = 0; i != indices.size(); ++i)
+    {
+        const UnsignedInt index = indices[i];
+        vertices_[i].position   = positions_[index];
+        vertices_[i].color      = hasColors ? Color4ub{colors_[index][0], colors_[index][1], colors_[index][2], 255}
+                                            : Color4ub{255};
+        vertices_[i].index      = index;
+    }
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Array};
+    buffer.setData(Containers::arrayView(vertices_.data(), vertices_.size()), GL::BufferUsage::StaticDraw);
+
+    GpuNode& gpuNode = gpuNodes_[node];
+    gpuNode.mesh     = GL::Mesh{GL::MeshPrimitive::Points};
+    gpuNode.mesh.setCount(Int(indices.size()))
+        .addVertexBuffer(std::move(buffer), 0, Shaders::FlatGL3D::Position{},
+                         Shaders::FlatGL3D::Color4{Shaders::FlatGL3D::Color4::DataType::UnsignedByte,
+                                                   Shaders::FlatGL3D::Color4::DataOption::Normalized},
+                         Shaders::FlatGL3D::ObjectId{});
+    ++uploadCount_;
+
+    const std::size_t bytes = indices.size() * sizeof(Vertex);
+    if (gpuNode.memoryId)
+    {
+        memory_.reload(gpuNode.memoryId, bytes);
+        return;
+    }
+
+    // The registry never evicts a node drawn in the current frame, so this doesn't pull a mesh from under a draw
+    gpuNode.memoryId = memory_.add(GpuMemoryRegistry::Kind::BUFFER, bytes,
+                                   [this, node]
+                                   {
+                                       gpuNodes_[node].mesh = GL::Mesh{NoCreate};
+                                       return true;
+                                   });
+}
+
+void PointCloud::draw(const Matrix4& transformation, SceneGraph::Camera3D& camera)
+{
+    stats_ = {};
+    octree_.select(transformation, camera.projectionMatrix(), Float(camera.viewport().y()), pointBudget_, selected_);
+
+    // Added to the index of every point, see PickingRegistry
+    shader_->setTransformationProjectionMatrix(camera.projectionMatrix() * transformation).setObjectId(objectId());
+
+    /* The nodes are picked coarse to fine, so a node is uploaded before its children are, and the children of a node
+       that isn't drawn are known to be left out by the time they come */
+    std::size_t uploaded = 0;
+    for (const UnsignedInt node : selected_)
+    {
+        GpuNode&                 gpuNode    = gpuNodes_[node];
+        const PointOctree::Node& octreeNode = octree_.nodes()[node];
+        bool                     drawn      = !parentPending_[node];
+        if (drawn && (!gpuNode.memoryId || !memory_.touch(gpuNode.memoryId)))
+        {
+            drawn = uploaded == 0 || uploaded + octreeNode.count <= uploadBudget_;
+            if (drawn)
+            {
+                upload(node);
+                uploaded += octreeNode.count;
+            }
+        }
+
+        if (!drawn)
+        {
+            ++stats_.pendingNodes;
+            for (const Int child : octreeNode.children)
+                if (child != -1)
+                    parentPending_[child] = true;
+            continue;
+        }
+
+        shader_->draw(gpuNode.mesh);
+        ++stats_.drawnNodes;
+        stats_.drawnPoints += octreeNode.count;
+    }
+
+    // Only children of picked nodes were marked
+    for (const UnsignedInt node : selected_)
+        for (const Int child : octree_.nodes()[node].children)
+            if (child != -1)
+                parentPending_[child] = false;
+
+    framePendingNodes_ += stats_.pendingNodes;
+}
+
+RenderState PointCloud::renderState() const
+{
+    return {RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING, pointSize_};
+}
@@ -0,0 +1,120 @@
+#ifndef OBJECTS_POINTCLOUD_H
+#define OBJECTS_POINTCLOUD_H
+
+#include "../render/GpuResources.h"
+#include "../render/PointOctree.h"
+#include "../traits/traits.h"
+#include "SceneDrawable.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Point cloud drawn level of detail by level of detail from a PointOctree.
+ *
+ * The points are read in place, e.g. from the mapping of a PointCloudFile, both to build the octree and to upload its
+ * nodes, so there's no copy of the whole cloud in memory.
+ *
+ * Every draw picks the octree nodes to show through the camera of the pane within a point budget, and draws the ones
+ * already on the GPU. The missing ones are uploaded a few at a time, so a large cloud appears coarse first and gets
+ * refined over the next frames without a hitch; isStreaming() tells when more frames are needed for that. A node is
+ * only drawn together with its parent, so that a missing parent doesn't leave a hole under its children. Uploaded
+ * nodes are shared by all the panes and accounted in the GpuMemoryRegistry as buffers, which evicts the ones no pane
+ * drew for the longest time when memory gets tight. They're uploaded again when they're needed.
+ *
+ * Every point writes objectId() plus its index in the cloud into the object ID buffer, so registering the cloud with a
+ * range of pointCount() IDs in the PickingRegistry resolves a pick to the point under the cursor.
+ *
+ * Not drawn in multi-view mode.
+ */
+class PointCloud : public Object3D, public SceneDrawable
+{
+public:
+    struct Stats
+    {
+        std::size_t drawnNodes{0};
+        std::size_t drawnPoints{0};
+        std::size_t pendingNodes{0}; ///< Picked but not drawn, because they or their parent aren't uploaded yet.
+    };
+
+    /// Default points drawn per pane.
+    static constexpr std::size_t DefaultPointBudget = 2'000'000;
+    /// Default points uploaded per draw.
+    static constexpr std::size_t DefaultUploadBudget = 262'144;
+
+    /**
+     * Points at @p positions, colored by the red, green and blue channels of @p colors, a point × channel view, or
+     * white if it's empty. Both have to outlive the cloud.
+     */
+    explicit PointCloud(Object3D& parent, SceneGraph::DrawableGroup3D& drawables, GpuResources& resources,
+                        Containers::StridedArrayView1D<const Vector3>      positions,
+                        Containers::StridedArrayView2D<const UnsignedByte> colors = {});
+    ~PointCloud() override;
+
+    void        draw(const Matrix4& transformation, SceneGraph::Camera3D& camera);
+    RenderState renderState() const override;
+
+    /// Starts a frame, call once per frame before the panes are drawn. isStreaming() covers the draws since.
+    void nextFrame() { framePendingNodes_ = 0; }
+
+    /// Points drawn by one draw at most, i.e. per pane.
+    void        setPointBudget(std::size_t points) { pointBudget_ = points; }
+    std::size_t pointBudget() const { return pointBudget_; }
+    /// Points uploaded by one draw at most, at least one node is uploaded regardless.
+    void        setUploadBudget(std::size_t points) { uploadBudget_ = points; }
+    std::size_t uploadBudget() const { return uploadBudget_; }
+    void        setPointSize(Float size) { pointSize_ = size; }
+    Float       pointSize() const { return pointSize_; }
+
+    /// Whether a draw since nextFrame() left picked nodes out because they weren't uploaded yet.
+    bool isStreaming() const { return framePendingNodes_ != 0; }
+
+    std::size_t                                   pointCount() const { return positions_.size(); }
+    Containers::StridedArrayView1D<const Vector3> positions() const { return positions_; }
+
+    const PointOctree& octree() const { return octree_; }
+    /// Of the last draw.
+    const Stats& stats() const { return stats_; }
+    /// Nodes currently on the GPU.
+    std::size_t residentNodeCount() const;
+    std::size_t uploadCount() const { return uploadCount_; }
+
+private:
+    struct GpuNode
+    {
+        GL::Mesh              mesh{NoCreate}; ///< Owns the vertex buffer.
+        GpuMemoryRegistry::Id memoryId{0};    ///< Zero if never uploaded.
+    };
+
+    struct Vertex
+    {
+        Vector3     position;
+        Color4ub    color;
+        UnsignedInt index; ///< In the cloud, the object ID relative to objectId().
+    };
+
+    void upload(UnsignedInt node);
+
+    Containers::StridedArrayView1D<const Vector3>      positions_;
+    Containers::StridedArrayView2D<const UnsignedByte> colors_;
+    PointOctree                                        octree_;
+    Resource<Shaders::FlatGL3D>                        shader_;
+    GpuMemoryRegistry&                                 memory_;
+    std::vector<GpuNode>                               gpuNodes_;
+    std::vector<Vertex>                                vertices_; ///< Of the node being uploaded.
+    std::vector<UnsignedInt>                           selected_;
+    std::vector<bool>                                  parentPending_; ///< By node, set during a draw.
+    std::size_t                                        pointBudget_{DefaultPointBudget};
+    std::size_t                                        uploadBudget_{DefaultUploadBudget};
+    Float                                              pointSize_{2.0f};
+    Stats                                              stats_;
+    std::size_t                                        framePendingNodes_{0};
+    std::size_t                                        uploadCount_{0};
+};
+
+#endif // OBJECTS_POINTCLOUD_H
@@ -0,0 +1,58 @@
+#include "SceneDrawable.h"
+
+#include <Magnum/Math/Functions.h>
+#include <Magnum/SceneGraph/AbstractObject.h>
+
+SceneDrawable::SceneDrawable(SceneGraph::AbstractObject3D& object, SceneGraph::DrawableGroup3D* drawables)
+: SceneGraph::Drawable3D(object, drawables)
+{
+    setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+}
+
+SceneDrawable& SceneDrawable::setBoundingBox(const Range3D& box)
+{
+    boundingBox_    = box;
+    hasBoundingBox_ = true;
+
+    // The world box is only updated when the object gets cleaned
+    object().setDirty();
+
+    return *this;
+}
+
+bool SceneDrawable::drawMultiView(const Matrix4&, MultiViewShaders&)
+{
+    return false;
+}
+
+bool SceneDrawable::drawBatched(const Matrix4&, BatchRenderer&)
+{
+    return false;
+}
+
+RenderState SceneDrawable::renderState() const
+{
+    return {RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING};
+}
+
+void SceneDrawable::clean(const Matrix4& absoluteTransformationMatrix)
+{
+    worldTransformation_ = absoluteTransformationMatrix;
+
+    if (!hasBoundingBox_)
+        return;
+
+    Vector3 min{Constants::inf()};
+    Vector3 max{-Constants::inf()};
+    for (UnsignedInt corner = 0; corner != 8; ++corner)
+    {
+        const Vector3 point{corner & 1 ? boundingBox_.max().x() : boundingBox_.min().x(),
+                            corner & 2 ? boundingBox_.max().y() : boundingBox_.min().y(),
+                            corner & 4 ? boundingBox_.max().z() : boundingBox_.min().z()};
+        const Vector3 transformed = absoluteTransformationMatrix.transformPoint(point);
+
+        min = Math::min(min, transformed);
+        max = Math::max(max, transformed);
+    }
+    worldBoundingBox_ = {min, max};
+}
@@ -0,0 +1,74 @@
+#ifndef OBJECTS_SCENEDRAWABLE_H
+#define OBJECTS_SCENEDRAWABLE_H
+
+#include "../render/RenderState.h"
+#include "../traits/traits.h"
+
+#include <Magnum/Math/Range.h>
+#include <Magnum/SceneGraph/Drawable.h>
+
+using namespace Magnum;
+
+class BatchRenderer;
+struct MultiViewShaders;
+
+/**
+ * Drawable whose world transformation is cached on its object.
+ *
+ * The transformation is only recomputed when the object (or one of its parents) was moved, see TransformCache, so
+ * drawing the scene from several cameras doesn't walk the hierarchy once per camera. Drawables with a bounding box
+ * are culled against the frustum of every camera, the others are always drawn.
+ */
+class SceneDrawable : public SceneGraph::Drawable3D
+{
+public:
+    explicit SceneDrawable(SceneGraph::AbstractObject3D& object, SceneGraph::DrawableGroup3D* drawables = nullptr);
+
+    /// Absolute transformation of the object as of the last TransformCache::update().
+    const Matrix4& worldTransformation() const { return worldTransformation_; }
+
+    /// Bounding box in object space.
+    SceneDrawable& setBoundingBox(const Range3D& box);
+    bool           hasBoundingBox() const { return hasBoundingBox_; }
+
+    /// Axis-aligned box around the transformed bounding box, as of the last TransformCache::update().
+    const Range3D& worldBoundingBox() const { return worldBoundingBox_; }
+
+    /**
+     * Base of the ID range the drawable writes into the object ID buffer, see PickingRegistry. Zero, the default,
+     * makes the drawable not pickable.
+     */
+    SceneDrawable& setObjectId(UnsignedInt id)
+    {
+        objectId_ = id;
+        return *this;
+    }
+    UnsignedInt objectId() const { return objectId_; }
+
+    /**
+     * Draws the drawable into all the views set up on @p shaders at once, see MultiViewRenderer. Returns false if the
+     * drawable can't be drawn this way, which is the default.
+     */
+    virtual bool drawMultiView(const Matrix4& worldTransformation, MultiViewShaders& shaders);
+
+    /**
+     * Queues the drawable on @p batch instead of drawing it right away, see BatchRenderer. Returns false if the
+     * drawable can't be batched, which is the default.
+     */
+    virtual bool drawBatched(const Matrix4& transformation, BatchRenderer& batch);
+
+    /// State draw() expects, set through the StateTracker before it's called. Depth test and face culling by default.
+    virtual RenderState renderState() const;
+
+private:
+    void clean(const Matrix4& absoluteTransformationMatrix) override;
+
+    Matrix4 worldTransformation_;
+    Range3D boundingBox_;
+    Range3D worldBoundingBox_;
+    bool    hasBoundingBox_{false};
+
+    UnsignedInt objectId_{0};
+};
+
+#endif // OBJECTS_SCENEDRAWABLE_H
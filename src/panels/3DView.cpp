@@ -1,16 +1,12 @@
 #include "3DView.h"
 
 #include <Magnum/GL/DefaultFramebuffer.h>
-#include <Magnum/GL/PixelFormat.h>
-#include <Magnum/Image.h>
 #include <Magnum/Math/Color.h>
-#include <Magnum/Math/FunctionsBatch.h>
-#include <Magnum/MeshTools/Compile.h>
-#include <Magnum/Primitives/Square.h>
-#include <Magnum/Trade/MeshData.h>
+#include <Magnum/Math/Functions.h>
 
 ThreeDView::ThreeDView(const Platform::Application& applicationContext, const std::shared_ptr<Scene3D> scene)
-: applicationContext_(applicationContext)
+: AbstractViewport(applicationContext.windowSize())
+, applicationContext_(applicationContext)
 , scene_(scene)
 {
     using namespace Math::Literals;
@@ -21,35 +17,71 @@ ThreeDView::ThreeDView(const Platform::Application& applicationContext, const st
 
     lastDepth_ = ((camera_->projectionMatrix() * camera_->cameraMatrix()).transformPoint({}).z() + 1.0f) * 0.5f;
     setRelativeViewport({Vector2{0.0f, 0.0f}, Vector2{1.0f, 1.0f}});
+}
+
+Vector2i ThreeDView::targetPosition(const Vector2& windowPosition) const
+{
+    /* First make the position relative to the pane and scale it to the size
+       of its area in the render target, which can differ from the pane size
+       on HiDPI systems */
+    const Range2Di viewport = getViewport();
+    const Range2Di region   = targetRegion();
+    const Vector2i position{(windowPosition - Vector2{viewport.min()}) * Vector2{region.size()} /
+                            Vector2{Math::max(viewport.size(), Vector2i{1})}};
+    return region.min() + Vector2i{position.x(), region.sizeY() - position.y() - 1};
+}
+
+std::optional<Float> ThreeDView::depthAt(const Vector2& windowPosition)
+{
+    if (!renderTarget_)
+        return std::nullopt;
+
+    /* The readback is asynchronous, so if the depth around this position is
+       not cached yet the result arrives in updatePivot() a frame later */
+    return depthReader_.depthAt(renderTarget_->resolvedFramebuffer(), targetPosition(windowPosition));
+}
+
+void ThreeDView::queryPivot(const Vector2& windowPosition)
+{
+    pivotPosition_ = windowPosition;
+
+    if (const auto depth = depthAt(windowPosition))
+    {
+        updatePivot(*depth);
+        pivotPending_ = false;
+        return;
+    }
 
-    // Setup the borders of the viewport
-    mesh_ = MeshTools::compile(Primitives::squareWireframe());
+    /* Until the depth arrives, pan against the last known depth */
+    translationPoint_ = unproject(windowPosition, lastDepth_);
+    pivotPending_     = true;
 }
 
-Float ThreeDView::depthAt(const Vector2& windowPosition) const
+void ThreeDView::updatePivot(const Float currentDepth)
 {
-    /* First scale the position from being relative to window size to being
-       relative to framebuffer size as those two can be different on HiDPI
-       systems */
-    const Vector2i position =
-        windowPosition * applicationContext_.framebufferSize() / Vector2{applicationContext_.windowSize()};
-    const Vector2i fbPosition{position.x(), GL::defaultFramebuffer.viewport().sizeY() - position.y() - 1};
-
-    GL::defaultFramebuffer.mapForRead(GL::DefaultFramebuffer::ReadAttachment::Front);
-    Image2D data = GL::defaultFramebuffer.read(Range2Di::fromSize(fbPosition, Vector2i{1}).padded(Vector2i{2}),
-                                               {GL::PixelFormat::DepthComponent, GL::PixelType::Float});
-
-    /* TODO: change to just Math::min<Float>(data.pixels<Float>() when the
-       batch functions in Math can handle 2D views */
-    return Math::min<Float>(data.pixels<Float>().asContiguous());
+    const Float depth = currentDepth == 1.0f ? lastDepth_ : currentDepth;
+    const auto  p     = unproject(pivotPosition_, depth);
+    if (!pivotPending_)
+        translationPoint_ = p;
+
+    /* Update the rotation point only if we're not zooming against infinite
+       depth or if the original rotation point is not yet initialized */
+    if (currentDepth != 1.0f || rotationPoint_.isZero())
+    {
+        rotationPoint_ = p;
+        lastDepth_     = depth;
+    }
 }
 
 Vector3 ThreeDView::unproject(const Vector2& windowPosition, Float depth) const
 {
-    /* We have to take window size, not framebuffer size, since the position is
-       in window coordinates and the two can be different on HiDPI systems */
-    const Vector2i viewSize = applicationContext_.windowSize();
-    const Vector2  viewPosition{windowPosition.x(), viewSize.y() - windowPosition.y() - 1};
+    /* We have to take the pane size in window coordinates, not the render
+       target size, since the position is in window coordinates and the two
+       can be different on HiDPI systems */
+    const Range2Di viewport      = getViewport();
+    const Vector2i viewSize      = Math::max(viewport.size(), Vector2i{1});
+    const Vector2  localPosition = windowPosition - Vector2{viewport.min()};
+    const Vector2  viewPosition{localPosition.x(), viewSize.y() - localPosition.y() - 1};
     const Vector3  in{2.0f * viewPosition / Vector2{viewSize} - Vector2{1.0f}, depth * 2.0f - 1.0f};
 
     return camera_->projectionMatrix().inverted().transformPoint(in);
@@ -62,7 +94,7 @@ void ThreeDView::handlePointerPressEvent(Platform::Application::PointerEvent& ev
     if (!event.isPrimary() || !(event.pointer() & (Pointer::MouseLeft)))
         return;
 
-    const auto viewport = calculateViewport(relativeViewport_, applicationContext_.windowSize());
+    const auto viewport = getViewport();
     if (!viewport.contains(Vector2i{event.position()}))
         return;
 
@@ -72,23 +104,27 @@ void ThreeDView::handlePointerPressEvent(Platform::Application::PointerEvent& ev
 
     /* Update the move position on press as well so touch movement (that emits
        no hover pointerMoveEvent()) works without jumps */
-    lastPosition_ = event.position();
+    lastPosition_  = event.position();
+    pressPosition_ = event.position();
 
-    const Float currentDepth = depthAt(event.position());
-    const Float depth        = currentDepth == 1.0f ? lastDepth_ : currentDepth;
-    translationPoint_        = unproject(event.position(), depth);
-    /* Update the rotation point only if we're not zooming against infinite
-       depth or if the original rotation point is not yet initialized */
-    if (currentDepth != 1.0f || rotationPoint_.isZero())
-    {
-        rotationPoint_ = translationPoint_;
-        lastDepth_     = depth;
-    }
+    queryPivot(event.position());
 }
 
-void ThreeDView::handlePointerReleaseEvent([[maybe_unused]] Platform::Application::PointerEvent& event)
+void ThreeDView::handlePointerReleaseEvent(Platform::Application::PointerEvent& event)
 {
-    viewportActive_ = false;
+    using Pointer = Platform::Application::Pointer;
+
+    const bool wasActive = std::exchange(viewportActive_, false);
+    if (!wasActive || !renderTarget_ || !event.isPrimary() || !(event.pointer() & (Pointer::MouseLeft)))
+        return;
+
+    /* Only a click selects, dragging moves the camera. The IDs arrive in
+       draw() a frame or so later, like the depth. */
+    if ((Math::abs(event.position() - pressPosition_) > Vector2{2.0f}).any())
+        return;
+
+    objectIdReader_.pick(renderTarget_->resolvedFramebuffer(), targetPosition(event.position()));
+    pick_ = std::nullopt;
 }
 
 void ThreeDView::handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event)
@@ -103,7 +139,7 @@ void ThreeDView::handlePointerMoveEvent(Platform::Application::PointerMoveEvent&
     if (!viewportActive_)
         return;
 
-    const auto viewport = calculateViewport(relativeViewport_, applicationContext_.windowSize());
+    const auto viewport = getViewport();
     if (!viewportActive_ && !viewport.contains(Vector2i{event.position()}))
         return;
 
@@ -126,92 +162,127 @@ void ThreeDView::handlePointerMoveEvent(Platform::Application::PointerMoveEvent&
                                 Matrix4::rotationX(-0.01_radf * delta.y()) *
                                 Matrix4::rotationY(-0.01_radf * delta.x()) *
                                 Matrix4::translation(-rotationPoint_));
+
+    resolution_.interact();
+    markDirty();
 }
 
 void ThreeDView::handleScrollEvent(Platform::Application::ScrollEvent& event)
 {
-    const auto viewport = calculateViewport(relativeViewport_, applicationContext_.windowSize());
+    const auto viewport = getViewport();
     if (!viewport.contains(Vector2i{event.position()}))
         return;
     Debug{} << "Event position is " << event.position() << " at viewport " << viewport;
 
-    const Float   currentDepth = depthAt(event.position());
-    const Float   depth        = currentDepth == 1.0f ? lastDepth_ : currentDepth;
-    const Vector3 p            = unproject(event.position(), depth);
-    /* Update the rotation point only if we're not zooming against infinite
-       depth or if the original rotation point is not yet initialized */
-    if (currentDepth != 1.0f || rotationPoint_.isZero())
-    {
-        rotationPoint_ = p;
-        lastDepth_     = depth;
-    }
+    /* Zooming repeatedly at the same cursor position keeps the same pivot, so
+       only ask for the depth when the cursor moved */
+    if ((Math::abs(event.position() - pivotPosition_) > Vector2{2.0f}).any() || Math::isNan(pivotPosition_).any())
+        queryPivot(event.position());
 
     const Float direction = event.offset().y();
     if (!direction)
         return;
 
     /* Move towards/backwards the rotation point in cam coords */
-    camera_->translateLocal(rotationPoint_ * direction * 0.1f);
-
-    event.setAccepted();
-}
+    const Vector3 translation = rotationPoint_ * direction * 0.1f;
+    camera_->translateLocal(translation);
+    /* ... which keeps the rotation point in place in the world */
+    rotationPoint_ -= translation;
 
-void ThreeDView::setRelativeViewport(const Range2D& relativeViewport)
-{
-    CORRADE_INTERNAL_ASSERT((relativeViewport.min() >= Vector2{0.0f}).all());
-    CORRADE_INTERNAL_ASSERT((relativeViewport.max() <= Vector2{1.0f}).all());
+    resolution_.interact();
+    markDirty();
 
-    relativeViewport_ = relativeViewport;
-    viewport_         = calculateViewport(relativeViewport, applicationContext_.windowSize());
-}
-
-void ThreeDView::setViewport(const Range2Di& viewport)
-{
-    CORRADE_INTERNAL_ASSERT((viewport.min() >= Vector2i{0}).all());
-    CORRADE_INTERNAL_ASSERT((viewport.max() <= applicationContext_.windowSize()).all());
-
-    viewport_         = viewport;
-    relativeViewport_ = calculateRelativeViewport(viewport, applicationContext_.windowSize());
-}
-
-Range2Di ThreeDView::getViewport() const
-{
-    return viewport_;
+    event.setAccepted();
 }
 
-Range2D ThreeDView::calculateRelativeViewport(const Range2Di& absoluteViewport, const Vector2i& windowSize)
+void ThreeDView::markDirty()
 {
-    CORRADE_INTERNAL_ASSERT((absoluteViewport.min() >= Vector2i{0}).all());
-    CORRADE_INTERNAL_ASSERT((absoluteViewport.max() <= applicationContext_.windowSize()).all());
-
-    return Range2D{Vector2{absoluteViewport.min()} / Vector2{windowSize},
-                   Vector2{absoluteViewport.max()} / Vector2{windowSize}};
+    dirty_ = true;
+    depthReader_.invalidate();
 }
 
-Range2Di ThreeDView::calculateViewport(const Range2D& relativeViewport, const Vector2i& windowSize)
-{
-    CORRADE_INTERNAL_ASSERT((relativeViewport_.min() >= Vector2{0.0f}).all());
-    CORRADE_INTERNAL_ASSERT((relativeViewport_.max() <= Vector2{1.0f}).all());
-
-    return Range2Di{relativeViewport.min() * windowSize, relativeViewport.max() * windowSize};
-}
-
-void ThreeDView::draw(SceneGraph::DrawableGroup3D& drawables)
+void ThreeDView::draw(const TransformCache& frame)
 {
     using namespace Math::Literals;
 
-    const auto originalViewport = GL::defaultFramebuffer.viewport();
+    if (!renderTarget_)
+        return;
 
-    // Convert between TL origin to BL origin (default clip space in OpenGL)
-    const auto newCenter               = Vector2(relativeViewport_.center().x(), 1.0f - relativeViewport_.center().y());
-    const auto flippedRelativeViewport = Range2D::fromCenter(newCenter, relativeViewport_.size() / 2.0f);
+    depthReader_.update();
+    if (pivotPending_)
+    {
+        if (const auto depth = depthReader_.takeResult())
+        {
+            updatePivot(*depth);
+            pivotPending_ = false;
+        }
+    }
 
-    const auto viewport = calculateViewport(flippedRelativeViewport, applicationContext_.windowSize());
-    GL::defaultFramebuffer.setViewport(viewport);
+    objectIdReader_.update();
+    if (const auto picked = objectIdReader_.takeResult())
+        pick_ = picked;
+
+    // GPU times of earlier renders decide the resolution of the next ones
+    while (const auto measured = gpuTimer_.takeResult())
+        resolution_.addSample(measured->time, measuredScales_[measured->slot]);
+    const bool wasInteracting = resolution_.isInteracting();
+    resolution_.nextFrame();
+    // The ViewportManager goes back to full quality in the next frame, which has to be drawn
+    if (wasInteracting && !resolution_.isInteracting())
+        markDirty();
+
+    const Range2Di region = targetRegion();
+    if (renderTarget_->samples() != renderedSamples_)
+    {
+        renderedSamples_ = renderTarget_->samples();
+        markDirty();
+    }
+    if (renderTarget_ != renderedTarget_ || region != renderedRegion_)
+    {
+        camera_->setProjectionMatrix(
+            Matrix4::perspectiveProjection(45.0_degf, Vector2{region.size()}.aspectRatio(), 0.01f, 100.0f));
+        // Level of detail selection of the drawables needs the size in pixels
+        camera_->setViewport(region.size());
+        renderedTarget_ = renderTarget_;
+        renderedRegion_ = region;
+        markDirty();
+    }
 
-    camera_->draw(drawables);
+    /* Rendered and composited together with the other panes */
+    if (sharedTarget_)
+        return;
+
+    const auto viewport = calculateFramebufferViewport(GL::defaultFramebuffer.viewport().size());
 
-    shader_.setColor(Color3::fromHsv({35.0_degf, 1.0f, 1.0f})).draw(mesh_);
+    /* Only re-render the pane if something changed, otherwise the cached
+       image from the previous frame is composited again */
+    if (dirty_)
+    {
+        const Float scale = Float(region.sizeX()) / Float(Math::max(viewport.sizeX(), 1));
+        if (const auto slot = gpuTimer_.begin())
+            measuredScales_[*slot] = scale;
+
+        renderTarget_->clear().framebuffer().bind();
+
+        cullingStats_ = batch_ ? batch_->draw(frame, *camera_, state_) : frame.draw(*camera_, state_);
+
+        // Labels keep their size on screen when the pane renders at a lower resolution
+        if (labelRenderer_ && labels_)
+        {
+            if (state_)
+                state_->set(LabelRenderer::Features);
+            labelRenderer_->draw(*labels_, camera_->projectionMatrix() * camera_->cameraMatrix(), region.size(),
+                                 scale);
+        }
+
+        renderTarget_->resolve();
+        gpuTimer_.end();
+        dirty_ = false;
+    }
 
-    GL::defaultFramebuffer.setViewport(originalViewport);
+    /* A pane rendered at a lower resolution is upscaled */
+    GL::AbstractFramebuffer::blit(renderTarget_->resolvedFramebuffer(), GL::defaultFramebuffer,
+                                  renderTarget_->viewport(), viewport, GL::FramebufferBlit::Color,
+                                  renderTarget_->size() == viewport.size() ? GL::FramebufferBlitFilter::Nearest
+                                                                           : GL::FramebufferBlitFilter::Linear);
 }
@@ -2,16 +2,26 @@
 #define PANELS_3DVIEW_H
 
 #include "../objects/Camera.h"
+#include "../render/BatchRenderer.h"
+#include "../render/DepthReader.h"
+#include "../render/GpuTimer.h"
+#include "../render/LabelRenderer.h"
+#include "../render/ObjectIdReader.h"
+#include "../render/RenderTarget.h"
+#include "../render/ResolutionController.h"
+#include "../render/TransformCache.h"
+#include "../viewports/AbstractViewport.h"
 
-#include <Magnum/GL/Mesh.h>
 #include <Magnum/Math/Range.h>
 #include <Magnum/Platform/GlfwApplication.h>
 #include <Magnum/SceneGraph/Drawable.h>
-#include <Magnum/Shaders/FlatGL.h>
+#include <array>
 #include <memory>
+#include <optional>
+#include <utility>
 
 using namespace Magnum;
-class ThreeDView
+class ThreeDView : public AbstractViewport
 {
 public:
     enum class EBorder : uint8_t
@@ -33,6 +43,8 @@ public:
         }
     }
 
+    static constexpr RenderFeatures Features = RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING;
+
     explicit ThreeDView(const Platform::Application&   applicationContext,
                         const std::shared_ptr<Scene3D> scene = std::make_shared<Scene3D>());
     // ~ThreeDView() = default;
@@ -46,33 +58,127 @@ public:
     void handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event);
     void handleScrollEvent(Platform::Application::ScrollEvent& event);
 
-    void     setRelativeViewport(const Range2D& viewport);
-    void     setViewport(const Range2Di& viewport);
-    Range2D  getRelativeViewport() const;
-    Range2Di getViewport() const;
+    /**
+     * Renders the pane into its render target if it is dirty and composites the target into the default framebuffer.
+     */
+    void draw(const TransformCache& frame);
+
+    /// Forces the pane to be re-rendered in the next draw(), e.g. because the scene changed.
+    void markDirty();
+
+    /// Whether another frame is needed without further input, e.g. to pick up an asynchronous depth readback.
+    bool needsRedraw() const
+    {
+        return dirty_ || pivotPending_ || objectIdReader_.isPending() || resolution_.isInteracting();
+    }
+
+    /**
+     * Object ID under the cursor the last time the pane was clicked without dragging, once the asynchronous readback
+     * finished. Zero if nothing was hit. Returns it only once; resolve it with a PickingRegistry.
+     */
+    std::optional<UnsignedInt> takePick() { return std::exchange(pick_, std::nullopt); }
+
+    /**
+     * Picks the fraction of the pane size the pane renders at from its measured GPU time. The ViewportManager sizes
+     * the render target accordingly and the image is upscaled when composited.
+     */
+    ResolutionController&       resolution() { return resolution_; }
+    const ResolutionController& resolution() const { return resolution_; }
+
+    /// Whether the camera of the pane is moving, in which case it may render at a lower quality.
+    bool isInteracting() const { return resolution_.isInteracting(); }
+
+    /// Drawn and culled drawables the last time the pane was rendered.
+    const TransformCache::CullingStats& cullingStats() const { return cullingStats_; }
+
+    /// The target is owned by the ViewportManager's pool, which resizes it at most once per frame.
+    void setRenderTarget(RenderTarget& target)
+    {
+        renderTarget_ = &target;
+        sharedTarget_ = false;
+    }
+
+    /**
+     * Makes the pane occupy @p region (in framebuffer pixels) of a target shared by all the panes. The ViewportManager
+     * then renders and composites all of them at once, draw() only keeps the camera and the depth queries up to date.
+     */
+    void setSharedRenderTarget(RenderTarget& target, const Range2Di& region)
+    {
+        renderTarget_ = &target;
+        sharedRegion_ = region;
+        sharedTarget_ = true;
+    }
 
-    void draw(SceneGraph::DrawableGroup3D& drawables);
+    void resetRenderTarget()
+    {
+        renderTarget_ = nullptr;
+        sharedTarget_ = false;
+    }
+
+    RenderTarget* renderTarget() const { return renderTarget_; }
+
+    /// Drawables set the state they need through @p state, the one the pane command is executed with.
+    void setStateTracker(StateTracker* state) { state_ = state; }
+    /// Renders the pane through @p batch if it isn't null, see BatchRenderer. Owned by the ViewportManager.
+    void setBatchRenderer(BatchRenderer* batch) { batch_ = batch; }
+    /// Draws @p labels on top of the scene through @p renderer if neither is null. Owned by the ViewportManager.
+    void setLabels(LabelRenderer* renderer, const std::vector<Label>* labels)
+    {
+        labelRenderer_ = renderer;
+        labels_        = labels;
+    }
+    bool          hasSharedRenderTarget() const { return sharedTarget_; }
+
+    /// Area of the render target the pane is rendered into.
+    Range2Di targetRegion() const { return sharedTarget_ ? sharedRegion_ : renderTarget_->viewport(); }
+
+    bool                  isDirty() const { return dirty_; }
+    SceneGraph::Camera3D& camera() { return *camera_; }
+
+    /// Called by the ViewportManager after it rendered the pane into its shared target.
+    void markRendered(const TransformCache::CullingStats& stats)
+    {
+        dirty_        = false;
+        cullingStats_ = stats;
+    }
 
 private:
     Float   lastDepth_;
     Vector2 lastPosition_{Constants::nan()};
     Vector3 rotationPoint_, translationPoint_;
+    Vector2 pivotPosition_{Constants::nan()}; ///< Window position the rotation point was last queried at.
+    bool    pivotPending_{false};
+    Vector2 pressPosition_{Constants::nan()};
 
     const Platform::Application& applicationContext_;
     std::shared_ptr<Scene3D>     scene_;
     std::unique_ptr<Camera>      camera_;
-    Range2Di                     viewport_;
-    Range2D                      relativeViewport_; ///< Viewport relative to the current window size.
     bool                         viewportActive_{false};
+    RenderTarget*                renderTarget_{nullptr};
+    StateTracker*                state_{nullptr};
+    BatchRenderer*               batch_{nullptr};
+    LabelRenderer*               labelRenderer_{nullptr};
+    const std::vector<Label>*    labels_{nullptr};
+    const RenderTarget*          renderedTarget_{nullptr}; ///< Target the cached image lives in.
+    Range2Di                     renderedRegion_;
+    Int                          renderedSamples_{0};
+    Range2Di                     sharedRegion_;
+    bool                         sharedTarget_{false};
+    bool                         dirty_{true};
+    DepthReader                  depthReader_;
+    ObjectIdReader               objectIdReader_;
+    std::optional<UnsignedInt>   pick_;
+    TransformCache::CullingStats cullingStats_;
+    ResolutionController         resolution_;
+    GpuTimer                     gpuTimer_;
 
-    // TODO: convert this into its own FlatShader class?
-    GL::Mesh          mesh_;
-    Shaders::FlatGL2D shader_;
+    std::array<Float, GpuTimer::QueryCount> measuredScales_{}; ///< Render scale of every GpuTimer slot.
 
-    [[nodiscard]] Float    depthAt(const Vector2& windowPosition) const;
-    [[nodiscard]] Vector3  unproject(const Vector2& windowPosition, Float depth) const;
-    [[nodiscard]] Range2D  calculateRelativeViewport(const Range2Di& absoluteViewport, const Vector2i& windowSize);
-    [[nodiscard]] Range2Di calculateViewport(const Range2D& relativeViewport, const Vector2i& windowSize);
+    [[nodiscard]] Vector2i             targetPosition(const Vector2& windowPosition) const;
+    [[nodiscard]] std::optional<Float> depthAt(const Vector2& windowPosition);
+    [[nodiscard]] Vector3              unproject(const Vector2& windowPosition, Float depth) const;
+    void                               queryPivot(const Vector2& windowPosition);
+    void                               updatePivot(Float currentDepth);
 };
 
 #endif // PANELS_3DVIEW_H
@@ -1,17 +1,119 @@
 #include "ImagePreview.h"
 
-ImagePreview::ImagePreview() {}
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/Math/Functions.h>
 
-void ImagePreview::draw()
+ImagePreview::ImagePreview(const Vector2i& windowSize, std::shared_ptr<TiledImage> image)
+: AbstractViewport(windowSize)
+, image_(std::move(image))
 {
-    const ImGuiWindowFlags windowFlags = {
-        ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize};
-    ImGui::SetNextWindowPos(ImVec2(0, 0));
-    ImGui::SetNextWindowSize(ImVec2(1280, 720));
+    CORRADE_INTERNAL_ASSERT(image_);
+    setRelativeViewport({Vector2{0.0f, 0.0f}, Vector2{1.0f, 1.0f}});
+}
+
+void ImagePreview::setImage(std::shared_ptr<TiledImage> image)
+{
+    CORRADE_INTERNAL_ASSERT(image);
+    image_       = std::move(image);
+    fitToWindow_ = true;
+}
+
+Float ImagePreview::fitZoom() const
+{
+    const Vector2 ratio = Vector2{Math::max(getViewport().size(), Vector2i{1})} / Vector2{image_->imageSize()};
+    return ratio.min();
+}
+
+Float ImagePreview::zoom() const
+{
+    return fitToWindow_ ? fitZoom() : zoom_;
+}
+
+Vector2 ImagePreview::center() const
+{
+    return fitToWindow_ ? Vector2{image_->imageSize()} / 2.0f : center_;
+}
+
+Range2D ImagePreview::visibleArea() const
+{
+    return Range2D::fromCenter(center(), Vector2{getViewport().size()} / zoom() / 2.0f);
+}
+
+void ImagePreview::zoomAt(const Vector2& windowPosition, const Float factor)
+{
+    // The image pixel under the cursor stays there
+    const Vector2 offset   = windowPosition - Vector2{getViewport().center()};
+    const Vector2 position = center() + offset / zoom();
+
+    zoom_        = Math::clamp(zoom() * factor, Math::min(fitZoom(), 1.0f) / 2.0f, MaxZoom);
+    center_      = position - offset / zoom_;
+    fitToWindow_ = false;
+}
+
+void ImagePreview::handlePointerPressEvent(Platform::Application::PointerEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
+
+    if (!event.isPrimary() || !(event.pointer() & (Pointer::MouseLeft)))
+        return;
+
+    if (!getViewport().contains(Vector2i{event.position()}))
+        return;
+
+    viewportActive_ = true;
+    lastPosition_   = event.position();
+}
+
+void ImagePreview::handlePointerReleaseEvent(Platform::Application::PointerEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
+
+    if (event.isPrimary() && (event.pointer() & (Pointer::MouseLeft)))
+        viewportActive_ = false;
+}
+
+void ImagePreview::handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
 
-    ImGui::Begin("Image preview", nullptr, windowFlags);
+    if (!viewportActive_ || !event.isPrimary() || !(event.pointers() & (Pointer::MouseLeft)))
+        return;
 
-    ImGui::Text("This is a test window. Here there should be an image");
+    const Vector2 delta = event.position() - lastPosition_;
+    lastPosition_       = event.position();
+
+    // The image follows the cursor
+    center_      = center() - delta / zoom();
+    zoom_        = zoom();
+    fitToWindow_ = false;
+}
+
+void ImagePreview::handleScrollEvent(Platform::Application::ScrollEvent& event)
+{
+    if (!getViewport().contains(Vector2i{event.position()}))
+        return;
+
+    const Float direction = event.offset().y();
+    if (!direction)
+        return;
+
+    zoomAt(event.position(), Math::pow(1.1f, direction));
+
+    event.setAccepted();
+}
+
+void ImagePreview::draw(const TransformCache&)
+{
+    const Range2Di framebufferViewport = GL::defaultFramebuffer.viewport();
+    const Range2Di viewport            = calculateFramebufferViewport(framebufferViewport.size());
+    if ((viewport.size() <= Vector2i{0}).any())
+        return;
 
-    ImGui::End();
+    /* The pane draws into its area of the default framebuffer, which keeps covering the whole window for the panes
+       drawn after it */
+    GL::defaultFramebuffer.bind();
+    GL::defaultFramebuffer.setViewport(viewport);
+    image_->draw(visibleArea(), viewport.size());
+    GL::defaultFramebuffer.setViewport(framebufferViewport);
 }
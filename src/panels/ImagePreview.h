@@ -1,13 +1,68 @@
-#include <Magnum/ImGuiIntegration/Context.hpp>
+#ifndef PANELS_IMAGEPREVIEW_H
+#define PANELS_IMAGEPREVIEW_H
+
+#include "../render/TiledImage.h"
+#include "../render/TransformCache.h"
+#include "../viewports/AbstractViewport.h"
+
+#include <Magnum/Math/Range.h>
+#include <Magnum/Platform/GlfwApplication.h>
+#include <memory>
 
 using namespace Magnum;
-class ImagePreview
-{
-private:
-    bool fitToWindow_{false};
 
+/**
+ * Pane showing a TiledImage, panned by dragging and zoomed with the scroll wheel around the cursor.
+ *
+ * The image fits the pane until it's panned or zoomed, also when the pane is resized. The pane draws straight into its
+ * area of the default framebuffer, only the tiles in view are on the GPU.
+ */
+class ImagePreview : public AbstractViewport
+{
 public:
-    explicit ImagePreview();
+    /// Screen pixels per image pixel the pane can zoom in to.
+    static constexpr Float MaxZoom = 64.0f;
+
+    static constexpr RenderFeatures Features{};
+
+    explicit ImagePreview(const Vector2i& windowSize, std::shared_ptr<TiledImage> image);
+
+    void handlePointerPressEvent(Platform::Application::PointerEvent& event);
+    void handlePointerReleaseEvent(Platform::Application::PointerEvent& event);
+    void handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event);
+    void handleScrollEvent(Platform::Application::ScrollEvent& event);
 
-    void draw();
+    void draw(const TransformCache& frame);
+
+    /// Whether the image still misses tiles it would show in another frame.
+    bool needsRedraw() const { return image_->isStreaming(); }
+
+    /// Shows the whole image centered in the pane from now on.
+    void fitToWindow() { fitToWindow_ = true; }
+    bool isFitToWindow() const { return fitToWindow_; }
+
+    /// Window pixels per image pixel.
+    Float   zoom() const;
+    /// Image pixel in the center of the pane, with Y down.
+    Vector2 center() const;
+    /// Part of the image in the pane, in image pixels with Y down.
+    Range2D visibleArea() const;
+
+    /// Shows @p image instead, fitted to the pane.
+    void              setImage(std::shared_ptr<TiledImage> image);
+    TiledImage&       image() { return *image_; }
+    const TiledImage& image() const { return *image_; }
+
+private:
+    Float fitZoom() const;
+    void  zoomAt(const Vector2& windowPosition, Float factor);
+
+    std::shared_ptr<TiledImage> image_;
+    Vector2                     center_;
+    Float                       zoom_{1.0f};
+    bool                        fitToWindow_{true};
+    bool                        viewportActive_{false};
+    Vector2                     lastPosition_{Constants::nan()};
 };
+
+#endif // PANELS_IMAGEPREVIEW_H
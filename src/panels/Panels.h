@@ -0,0 +1,14 @@
+#ifndef PANELS_PANELS_H
+#define PANELS_PANELS_H
+
+#include "../viewports/Panel.h"
+#include "3DView.h"
+#include "ImagePreview.h"
+#include "PlaybackView.h"
+
+/**
+ * All the panel types the ViewportManager can lay out. Add new panels here.
+ */
+using AnyPanel = PanelVariant<ThreeDView, ImagePreview, PlaybackView>;
+
+#endif // PANELS_PANELS_H
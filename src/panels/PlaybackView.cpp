@@ -0,0 +1,91 @@
+#include "PlaybackView.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/Math/Functions.h>
+
+PlaybackView::PlaybackView(const Vector2i& windowSize, std::shared_ptr<FramePlayer> player)
+: AbstractViewport(windowSize)
+, player_(std::move(player))
+{
+    CORRADE_INTERNAL_ASSERT(player_);
+    setRelativeViewport({Vector2{0.0f, 0.0f}, Vector2{1.0f, 1.0f}});
+}
+
+void PlaybackView::scrubTo(const Float windowX)
+{
+    const Range2Di    viewport = getViewport();
+    const std::size_t count    = player_->playhead().frameCount();
+    const Float       position = Math::clamp((windowX - Float(viewport.left())) / Float(Math::max(viewport.sizeX(), 1)),
+                                             0.0f, 1.0f);
+
+    player_->pause();
+    player_->seek(Math::min(std::size_t(position * Float(count)), count - 1));
+}
+
+void PlaybackView::handlePointerPressEvent(Platform::Application::PointerEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
+
+    if (!event.isPrimary() || !(event.pointer() & (Pointer::MouseLeft)))
+        return;
+
+    if (!getViewport().contains(Vector2i{event.position()}))
+        return;
+
+    scrubbing_ = true;
+    scrubTo(event.position().x());
+}
+
+void PlaybackView::handlePointerReleaseEvent(Platform::Application::PointerEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
+
+    if (event.isPrimary() && (event.pointer() & (Pointer::MouseLeft)))
+        scrubbing_ = false;
+}
+
+void PlaybackView::handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event)
+{
+    using Pointer = Platform::Application::Pointer;
+
+    if (!scrubbing_ || !event.isPrimary() || !(event.pointers() & (Pointer::MouseLeft)))
+        return;
+
+    scrubTo(event.position().x());
+}
+
+void PlaybackView::handleScrollEvent(Platform::Application::ScrollEvent& event)
+{
+    if (!getViewport().contains(Vector2i{event.position()}))
+        return;
+
+    const Float direction = event.offset().y();
+    if (!direction)
+        return;
+
+    // Scrolling up steps forward, stopping at the ends unless the playhead loops
+    player_->pause();
+    if (const std::optional<std::size_t> frame = player_->playhead().frameAt(direction > 0.0f ? 1 : -1))
+        player_->seek(*frame);
+
+    event.setAccepted();
+}
+
+void PlaybackView::draw(const TransformCache&)
+{
+    const Range2Di framebufferViewport = GL::defaultFramebuffer.viewport();
+    const Range2Di viewport            = calculateFramebufferViewport(framebufferViewport.size());
+    if ((viewport.size() <= Vector2i{0}).any() || player_->frameSize() == Vector2i{})
+        return;
+
+    // The whole frame centered in the pane, with bars on the sides that don't fit its aspect ratio
+    const Vector2 frameSize{player_->frameSize()};
+    const Float   zoom = (Vector2{viewport.size()} / frameSize).min();
+    const Range2D area = Range2D::fromCenter(frameSize / 2.0f, Vector2{viewport.size()} / zoom / 2.0f);
+
+    GL::defaultFramebuffer.bind();
+    GL::defaultFramebuffer.setViewport(viewport);
+    player_->draw(area, viewport.size());
+    GL::defaultFramebuffer.setViewport(framebufferViewport);
+}
@@ -0,0 +1,48 @@
+#ifndef PANELS_PLAYBACKVIEW_H
+#define PANELS_PLAYBACKVIEW_H
+
+#include "../render/FramePlayer.h"
+#include "../render/TransformCache.h"
+#include "../viewports/AbstractViewport.h"
+
+#include <Magnum/Math/Range.h>
+#include <Magnum/Platform/GlfwApplication.h>
+#include <memory>
+
+using namespace Magnum;
+
+/**
+ * Pane playing back a FramePlayer, with the frame fitted into the pane.
+ *
+ * Dragging across the pane scrubs through the sequence, from the first frame at the left edge to the last one at the
+ * right edge, and the scroll wheel steps frame by frame. Both pause playback. Like ImagePreview, the pane draws
+ * straight into its area of the default framebuffer.
+ */
+class PlaybackView : public AbstractViewport
+{
+public:
+    static constexpr RenderFeatures Features{};
+
+    explicit PlaybackView(const Vector2i& windowSize, std::shared_ptr<FramePlayer> player);
+
+    void handlePointerPressEvent(Platform::Application::PointerEvent& event);
+    void handlePointerReleaseEvent(Platform::Application::PointerEvent& event);
+    void handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event);
+    void handleScrollEvent(Platform::Application::ScrollEvent& event);
+
+    void draw(const TransformCache& frame);
+
+    /// Whether the player is playing or still getting the frames around the playhead ready.
+    bool needsRedraw() const { return player_->isPlaying() || player_->isStreaming(); }
+
+    FramePlayer&       player() { return *player_; }
+    const FramePlayer& player() const { return *player_; }
+
+private:
+    void scrubTo(Float windowX);
+
+    std::shared_ptr<FramePlayer> player_;
+    bool                         scrubbing_{false};
+};
+
+#endif // PANELS_PLAYBACKVIEW_H
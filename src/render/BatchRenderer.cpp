@@ -0,0 +1,224 @@
+#include "BatchRenderer.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/StringStlView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/Math/Frustum.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/MeshTools/Concatenate.h>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+bool BatchRenderer::isSupported()
+{
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>();
+}
+
+bool BatchRenderer::isMultiDrawSupported()
+{
+    return isSupported() && GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>();
+}
+
+BatchRenderer::BatchRenderer(GpuMemoryRegistry* const memory)
+: multiDraw_(isMultiDrawSupported())
+, shader_{Shaders::FlatGL3D::Configuration{}
+              .setFlags((multiDraw_ ? Shaders::FlatGL3D::Flag::MultiDraw : Shaders::FlatGL3D::Flag::UniformBuffers) |
+                        Shaders::FlatGL3D::Flag::ObjectId)
+              .setMaterialCount(MaterialCount)
+              .setDrawCount(DrawCount)}
+{
+    // Chunks are bound at multiples of DrawCount elements
+    CORRADE_INTERNAL_ASSERT(DrawCount * sizeof(Shaders::FlatDrawUniform) % GL::Buffer::uniformOffsetAlignment() == 0);
+
+    materials_.reserve(MaterialCount);
+
+    if (StreamBuffer::isSupported())
+        stream_.emplace(StreamCapacity, memory);
+}
+
+UnsignedInt BatchRenderer::mesh(const Containers::StringView name, const std::function<Trade::MeshData()>& generate)
+{
+    const auto found = meshIds_.find(std::string_view{name});
+    if (found != meshIds_.end())
+        return found->second;
+
+    Trade::MeshData data = generate();
+    const auto group = std::find_if(groups_.begin(), groups_.end(),
+                                    [&](const Group& g) { return g.primitive == data.primitive(); });
+    Group& g = group != groups_.end() ? *group : groups_.emplace_back(Group{data.primitive()});
+
+    const UnsignedInt count = data.isIndexed() ? data.indexCount() : data.vertexCount();
+    meshes_.push_back({UnsignedInt(&g - groups_.data()), g.count, count});
+    g.count += count;
+    g.data.push_back(std::move(data));
+    g.dirty = true;
+
+    const auto id = UnsignedInt(meshes_.size() - 1);
+    meshIds_.emplace(std::string_view{name}, id);
+    return id;
+}
+
+UnsignedInt BatchRenderer::material(const Color4& color)
+{
+    const auto found = std::find_if(materials_.begin(), materials_.end(),
+                                    [&](const Shaders::FlatMaterialUniform& m) { return m.color == color; });
+    if (found != materials_.end())
+        return UnsignedInt(found - materials_.begin());
+
+    CORRADE_INTERNAL_ASSERT(materials_.size() < MaterialCount);
+    materials_.push_back(Shaders::FlatMaterialUniform{}.setColor(color));
+    materialsDirty_ = true;
+    return UnsignedInt(materials_.size() - 1);
+}
+
+void BatchRenderer::add(const UnsignedInt mesh, const Matrix4& transformation, const UnsignedInt material,
+                        const UnsignedInt objectId)
+{
+    CORRADE_INTERNAL_ASSERT(mesh < meshes_.size() && material < materials_.size());
+    groups_[meshes_[mesh].group].queue.push_back({transformation, mesh, material, objectId});
+}
+
+void BatchRenderer::compile(Group& group)
+{
+    // Concatenation offsets the indices of every mesh, so draws only need an index (or vertex) offset
+    group.mesh  = MeshTools::compile(MeshTools::concatenate(group.data));
+    group.dirty = false;
+}
+
+BatchRenderer::Upload BatchRenderer::upload(GL::Buffer& fallback, const Containers::ArrayView<const void> data)
+{
+    if (stream_ && data.size() <= StreamCapacity / StreamFrames)
+    {
+        const StreamBuffer::Allocation allocation =
+            stream_->allocate(data.size(), GL::Buffer::uniformOffsetAlignment());
+        std::memcpy(allocation.data.data(), data.data(), data.size());
+        return {&stream_->buffer(), allocation.offset};
+    }
+
+    fallback.setData(data, GL::BufferUsage::StreamDraw);
+    return {&fallback, 0};
+}
+
+void BatchRenderer::draw(const Matrix4& projectionMatrix)
+{
+    batchedCount_  = 0;
+    drawCallCount_ = 0;
+    transformations_.clear();
+    drawUniforms_.clear();
+    views_.clear();
+    chunks_.clear();
+
+    for (UnsignedInt g = 0; g != groups_.size(); ++g)
+    {
+        Group& group = groups_[g];
+        if (group.queue.empty())
+            continue;
+        if (group.dirty)
+            compile(group);
+
+        for (std::size_t first = 0; first < group.queue.size(); first += DrawCount)
+        {
+            const std::size_t count = std::min<std::size_t>(group.queue.size() - first, DrawCount);
+            chunks_.push_back({g, transformations_.size(), views_.size(), count});
+
+            for (std::size_t i = first; i != first + count; ++i)
+            {
+                const Draw& draw = group.queue[i];
+                const Mesh& mesh = meshes_[draw.mesh];
+                transformations_.push_back(
+                    Shaders::TransformationUniform3D{}.setTransformationMatrix(draw.transformation));
+                drawUniforms_.push_back(
+                    Shaders::FlatDrawUniform{}.setMaterialId(draw.material).setObjectId(draw.objectId));
+
+                GL::MeshView& view = views_.emplace_back(group.mesh);
+                view.setCount(Int(mesh.count));
+                if (group.mesh.isIndexed())
+                    view.setIndexOffset(Int(mesh.offset));
+                else
+                    view.setBaseVertex(Int(mesh.offset));
+            }
+
+            // The shader reads whole DrawCount-sized arrays, so every chunk starts aligned and is backed completely
+            transformations_.resize(transformations_.size() + DrawCount - count);
+            drawUniforms_.resize(drawUniforms_.size() + DrawCount - count);
+        }
+
+        batchedCount_ += group.queue.size();
+        group.queue.clear();
+    }
+
+    if (chunks_.empty())
+        return;
+
+    if (materialsDirty_)
+    {
+        // Always the whole array the shader declares
+        std::vector<Shaders::FlatMaterialUniform> materials{materials_};
+        materials.resize(MaterialCount);
+        materialBuffer_.setData(materials, GL::BufferUsage::StaticDraw);
+        materialsDirty_ = false;
+    }
+
+    const auto   projection           = Shaders::ProjectionUniform3D{}.setProjectionMatrix(projectionMatrix);
+    const Upload projectionUpload     = upload(projectionBuffer_, Containers::arrayView(&projection, 1));
+    const Upload transformationUpload = upload(transformationBuffer_, transformations_);
+    const Upload drawUpload           = upload(drawBuffer_, drawUniforms_);
+
+    shader_.bindProjectionBuffer(*projectionUpload.buffer, projectionUpload.offset, sizeof(projection))
+        .bindMaterialBuffer(materialBuffer_);
+    for (const Chunk& chunk : chunks_)
+    {
+        const std::size_t transformationOffset =
+            transformationUpload.offset + chunk.uniformOffset * sizeof(Shaders::TransformationUniform3D);
+        const std::size_t drawOffset = drawUpload.offset + chunk.uniformOffset * sizeof(Shaders::FlatDrawUniform);
+        shader_
+            .bindTransformationBuffer(*transformationUpload.buffer, transformationOffset,
+                                      DrawCount * sizeof(Shaders::TransformationUniform3D))
+            .bindDrawBuffer(*drawUpload.buffer, drawOffset, DrawCount * sizeof(Shaders::FlatDrawUniform));
+
+        const auto views = Containers::arrayView(views_).sliceSize(chunk.viewOffset, chunk.count);
+        if (multiDraw_)
+        {
+            shader_.draw(views);
+            ++drawCallCount_;
+            continue;
+        }
+
+        // gl_DrawID isn't available, so the draw offset picks the uniforms instead
+        for (std::size_t i = 0; i != views.size(); ++i)
+            shader_.setDrawOffset(UnsignedInt(i)).draw(views[i]);
+        drawCallCount_ += views.size();
+    }
+
+    // The uniforms of the next draw go to another part of the stream buffer until the GPU is done with these
+    if (stream_)
+        stream_->finishFrame();
+}
+
+TransformCache::CullingStats BatchRenderer::draw(const TransformCache& frame, SceneGraph::Camera3D& camera,
+                                                 StateTracker* const state)
+{
+    const Matrix4 cameraMatrix = camera.cameraMatrix();
+    const Frustum frustum      = Frustum::fromMatrix(camera.projectionMatrix() * cameraMatrix);
+
+    const auto visit = [&](SceneDrawable& drawable)
+    {
+        const Matrix4 transformation = cameraMatrix * drawable.worldTransformation();
+        if (drawable.drawBatched(transformation, *this))
+            return;
+        if (state)
+            state->set(drawable.renderState());
+        drawable.draw(transformation, camera);
+    };
+    const TransformCache::CullingStats stats = frame.forEachVisible({&frustum, 1}, visit);
+
+    if (state)
+        state->set(RenderState{RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING});
+    draw(camera.projectionMatrix());
+    return stats;
+}
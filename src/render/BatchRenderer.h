@@ -0,0 +1,161 @@
+#ifndef RENDER_BATCHRENDERER_H
+#define RENDER_BATCHRENDERER_H
+
+#include "GpuMemoryRegistry.h"
+#include "RenderState.h"
+#include "StreamBuffer.h"
+#include "TransformCache.h"
+
+#include <Corrade/Containers/StringView.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/MeshView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/Shaders/Flat.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Shaders/Generic.h>
+#include <Magnum/Trade/MeshData.h>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Draws many small meshes with a handful of draw calls.
+ *
+ * Meshes with the same primitive are concatenated into one GPU mesh, and the per-draw transformations and materials
+ * live in uniform buffers instead of being set uniform by uniform before every draw. Queued draws of the same mesh
+ * group then go out as one multidraw per DrawCount draws (GL_ARB_shader_draw_parameters), or as plain draws that only
+ * bump the draw offset where multidraw isn't available.
+ *
+ * The per-draw uniforms change every draw, so they are written into a StreamBuffer where buffer storage is supported
+ * instead of reallocating the uniform buffers.
+ */
+class BatchRenderer
+{
+public:
+    /// Draws per draw call, i.e. the size of the per-draw uniform arrays in the shader.
+    static constexpr UnsignedInt DrawCount = 256;
+    /// Distinct colors the renderer can hold.
+    static constexpr UnsignedInt MaterialCount = 64;
+    /// Bytes of the stream buffer for the per-draw uniforms.
+    static constexpr std::size_t StreamCapacity = 4 << 20;
+    /**
+     * Uniforms larger than a StreamFrames-th of the stream buffer go to regular buffers instead, so that the stream
+     * buffer always holds several draws in flight.
+     */
+    static constexpr std::size_t StreamFrames = 4;
+
+    /// Needs uniform buffers (core in GL 3.1).
+    static bool isSupported();
+    static bool isMultiDrawSupported();
+
+    /// The stream buffer is accounted in @p memory if it's not null, see GpuMemoryRegistry.
+    explicit BatchRenderer(GpuMemoryRegistry* memory = nullptr);
+
+    BatchRenderer(const BatchRenderer&)            = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    /**
+     * Id of the mesh called @p name, generated by @p generate the first time it's requested. Adding a mesh uploads its
+     * mesh group again in the next draw(), so this is meant to settle after the first frames.
+     */
+    UnsignedInt mesh(Containers::StringView name, const std::function<Trade::MeshData()>& generate);
+    /// Id of the material with @p color, at most MaterialCount distinct ones.
+    UnsignedInt material(const Color4& color);
+
+    /// Queues @p mesh with @p transformation relative to the camera, writing @p objectId into the object ID buffer.
+    void add(UnsignedInt mesh, const Matrix4& transformation, UnsignedInt material, UnsignedInt objectId = 0);
+
+    /// Draws and empties the queue.
+    void draw(const Matrix4& projectionMatrix);
+
+    /**
+     * Draws the drawables of @p frame visible from @p camera, the ones implementing SceneDrawable::drawBatched() in
+     * batches and the others one by one, like TransformCache::draw(). If @p state isn't null, the ones drawn one by one
+     * get their SceneDrawable::renderState() through it, and the batches depth test and face culling.
+     */
+    TransformCache::CullingStats draw(const TransformCache& frame, SceneGraph::Camera3D& camera,
+                                      StateTracker* state = nullptr);
+
+    /// Draws queued before the last draw().
+    std::size_t batchedCount() const { return batchedCount_; }
+    /// Draw calls the last draw() issued for them.
+    std::size_t drawCallCount() const { return drawCallCount_; }
+    /// The buffer the per-draw uniforms are streamed through, null if buffer storage isn't supported.
+    const StreamBuffer* streamBuffer() const { return stream_ ? &*stream_ : nullptr; }
+
+private:
+    struct Draw
+    {
+        Matrix4     transformation;
+        UnsignedInt mesh;
+        UnsignedInt material;
+        UnsignedInt objectId;
+    };
+
+    /// Meshes with the same primitive, concatenated into one GPU mesh.
+    struct Group
+    {
+        MeshPrimitive                primitive;
+        std::vector<Trade::MeshData> data;
+        GL::Mesh                     mesh{NoCreate};
+        UnsignedInt                  count{0}; ///< Indices, or vertices if none of the meshes is indexed.
+        bool                         dirty{true};
+        std::vector<Draw>            queue;
+    };
+
+    struct Mesh
+    {
+        UnsignedInt group;
+        UnsignedInt offset;
+        UnsignedInt count;
+    };
+
+    /// Draws of one group sharing a range of the uniform buffers, aligned to DrawCount.
+    struct Chunk
+    {
+        UnsignedInt group;
+        std::size_t uniformOffset;
+        std::size_t viewOffset;
+        std::size_t count;
+    };
+
+    /// Part of a buffer some uniforms were uploaded to.
+    struct Upload
+    {
+        GL::Buffer* buffer;
+        std::size_t offset;
+    };
+
+    void   compile(Group& group);
+    Upload upload(GL::Buffer& fallback, Containers::ArrayView<const void> data);
+
+    bool              multiDraw_;
+    Shaders::FlatGL3D shader_;
+    GL::Buffer        projectionBuffer_;
+    GL::Buffer        transformationBuffer_;
+    GL::Buffer        drawBuffer_;
+    GL::Buffer        materialBuffer_;
+
+    std::optional<StreamBuffer> stream_;
+
+    std::vector<Group>                               groups_;
+    std::vector<Mesh>                                meshes_;
+    std::map<std::string, UnsignedInt, std::less<>> meshIds_;
+    std::vector<Shaders::FlatMaterialUniform>        materials_;
+    bool                                             materialsDirty_{true};
+
+    std::vector<Shaders::TransformationUniform3D> transformations_;
+    std::vector<Shaders::FlatDrawUniform>         drawUniforms_;
+    std::vector<GL::MeshView>                     views_;
+    std::vector<Chunk>                            chunks_;
+    std::size_t                                   batchedCount_{0};
+    std::size_t                                   drawCallCount_{0};
+};
+
+#endif // RENDER_BATCHRENDERER_H
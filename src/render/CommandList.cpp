@@ -0,0 +1,62 @@
+#include "CommandList.h"
+
+#include <Magnum/Math/Functions.h>
+#include <algorithm>
+
+namespace
+{
+
+/* Target, shader and mesh switches between consecutive commands */
+std::size_t bindingSwitches(const CommandList::Key previous, const CommandList::Key next)
+{
+    return std::size_t(CommandList::target(previous) != CommandList::target(next)) +
+           std::size_t(CommandList::shader(previous) != CommandList::shader(next)) +
+           std::size_t(CommandList::mesh(previous) != CommandList::mesh(next));
+}
+
+} // namespace
+
+CommandList::Key CommandList::key(const Pass pass, const UnsignedInt target, const UnsignedInt shader,
+                                  const UnsignedInt mesh, const Float depth)
+{
+    const auto quantizedDepth = Key(Math::clamp(depth, 0.0f, 1.0f) * Float(0xffffff));
+    return Key(pass) << 60 | Key(target & 0xff) << 52 | Key(shader & 0xfff) << 40 | Key(mesh & 0xffff) << 24 |
+           quantizedDepth;
+}
+
+void CommandList::submit(const Key key, const RenderFeatures features, Command command)
+{
+    commands_.push_back({key, features, std::move(command)});
+}
+
+CommandList::Stats CommandList::execute(StateTracker& state)
+{
+    stats_ = {};
+    if (commands_.empty())
+        return stats_;
+
+    /* What submission order would have cost: every command setting all the features, plus the switches */
+    std::size_t unsorted = commands_.size() * StateTracker::FeatureCount;
+    for (std::size_t i = 1; i < commands_.size(); ++i)
+        unsorted += bindingSwitches(commands_[i - 1].key, commands_[i].key);
+
+    // Stable, so that commands with the same key keep their submission order
+    std::stable_sort(commands_.begin(), commands_.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    const std::size_t changesBefore = state.changeCount();
+    for (std::size_t i = 0; i != commands_.size(); ++i)
+    {
+        if (i != 0)
+            stats_.stateChanges += bindingSwitches(commands_[i - 1].key, commands_[i].key);
+
+        state.set(commands_[i].features);
+        commands_[i].command();
+    }
+
+    stats_.commands = commands_.size();
+    stats_.stateChanges += state.changeCount() - changesBefore;
+    stats_.stateChangesSaved = unsorted > stats_.stateChanges ? unsorted - stats_.stateChanges : 0;
+
+    commands_.clear();
+    return stats_;
+}
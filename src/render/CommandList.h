@@ -0,0 +1,77 @@
+#ifndef RENDER_COMMANDLIST_H
+#define RENDER_COMMANDLIST_H
+
+#include "RenderState.h"
+
+#include <Magnum/Magnum.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Draw commands of one frame, recorded by panes, overlays and the UI and executed in sort key order.
+ *
+ * The key orders commands by pass first, so the UI always ends up on top, then groups them by target, shader and mesh
+ * and finally sorts them by depth. Consecutive commands with the same target, shader or mesh then don't switch it,
+ * and the StateTracker only touches the features that differ from the previous command.
+ */
+class CommandList
+{
+public:
+    enum class Pass : uint8_t
+    {
+        SCENE = 0, ///< Rendering and compositing the panes.
+        OVERLAY,   ///< Flat 2D geometry on top of the panes.
+        UI
+    };
+
+    using Key     = uint64_t;
+    using Command = std::function<void()>;
+
+    /**
+     * Bit layout, from the most significant: pass (4), target (8), shader (12), mesh (16), depth (24). Ids wrap
+     * around, which only costs a missed grouping. @p depth is in [0, 1], pass 1 - depth to sort back to front.
+     */
+    static Key key(Pass pass, UnsignedInt target = 0, UnsignedInt shader = 0, UnsignedInt mesh = 0, Float depth = 0.0f);
+
+    static UnsignedInt target(Key key) { return UnsignedInt(key >> 52) & 0xff; }
+    static UnsignedInt shader(Key key) { return UnsignedInt(key >> 40) & 0xfff; }
+    static UnsignedInt mesh(Key key) { return UnsignedInt(key >> 24) & 0xffff; }
+
+    struct Stats
+    {
+        std::size_t commands{0};
+        /// Feature changes plus target, shader and mesh switches that were executed.
+        std::size_t stateChanges{0};
+        /**
+         * Compared to executing the commands in submission order with every command setting all its features, like
+         * code without a command list does.
+         */
+        std::size_t stateChangesSaved{0};
+    };
+
+    /// Records @p command, which runs with exactly @p features enabled.
+    void submit(Key key, RenderFeatures features, Command command);
+
+    /// Sorts and runs all recorded commands, then clears the list.
+    Stats execute(StateTracker& state);
+
+    std::size_t size() const { return commands_.size(); }
+    /// Statistics of the last execute().
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Entry
+    {
+        Key            key;
+        RenderFeatures features;
+        Command        command;
+    };
+
+    std::vector<Entry> commands_;
+    Stats              stats_;
+};
+
+#endif // RENDER_COMMANDLIST_H
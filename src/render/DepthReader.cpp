@@ -0,0 +1,107 @@
+#include "DepthReader.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/PixelFormat.h>
+#include <limits>
+#include <utility>
+
+DepthReader::DepthReader(const Int cacheRadius)
+: cacheRadius_(Math::max(cacheRadius, WindowRadius))
+, image_(GL::PixelFormat::DepthComponent, GL::PixelType::Float)
+{
+}
+
+std::optional<Float> DepthReader::depthAt(GL::AbstractFramebuffer& framebuffer, const Vector2i& position)
+{
+    result_ = std::nullopt;
+
+    if (const auto depth = lookup(position))
+        return depth;
+
+    // A readback of the same area is already on its way, no need to issue another one
+    if (pending_ && pendingRange_.contains(position))
+    {
+        pendingPosition_ = position;
+        return std::nullopt;
+    }
+
+    const Range2Di block =
+        Math::intersect(Range2Di::fromSize(position, Vector2i{1}).padded(Vector2i{cacheRadius_}), framebuffer.viewport());
+    if (block.sizeX() <= 0 || block.sizeY() <= 0)
+        return std::nullopt;
+
+    framebuffer.read(block, image_, GL::BufferUsage::StreamRead);
+    fence_.insert();
+
+    pending_            = true;
+    pendingStale_       = false;
+    pendingPosition_    = position;
+    pendingRange_       = block;
+    pendingFramebuffer_ = framebuffer.viewport();
+    ++readbackCount_;
+
+    return std::nullopt;
+}
+
+void DepthReader::update()
+{
+    if (!pending_ || !fence_.isSignaled())
+        return;
+
+    fence_.reset();
+    pending_ = false;
+
+    /* Depth as floats is 4 bytes per pixel, so the rows are tightly packed with the default alignment */
+    const Containers::Array<char>            data   = image_.buffer().data();
+    const Containers::ArrayView<const Float> depths = Containers::arrayCast<const Float>(Containers::arrayView(data));
+    cache_ = Containers::Array<Float>{Containers::NoInit, depths.size()};
+    Utility::copy(depths, cache_);
+    cacheRange_       = pendingRange_;
+    cacheFramebuffer_ = pendingFramebuffer_;
+    cacheValid_       = true;
+
+    result_ = lookup(pendingPosition_);
+
+    /* The query still gets its answer, but the contents changed since the readback was issued, so don't answer
+       further queries from it */
+    cacheValid_   = !pendingStale_;
+    pendingStale_ = false;
+}
+
+std::optional<Float> DepthReader::takeResult()
+{
+    return std::exchange(result_, std::nullopt);
+}
+
+void DepthReader::invalidate()
+{
+    cacheValid_ = false;
+    if (pending_)
+        pendingStale_ = true;
+}
+
+std::optional<Float> DepthReader::lookup(const Vector2i& position) const
+{
+    if (!cacheValid_)
+        return std::nullopt;
+
+    /* The window is clipped to the framebuffer the same way the cached block was */
+    const Range2Di window =
+        Math::intersect(Range2Di::fromSize(position, Vector2i{1}).padded(Vector2i{WindowRadius}), cacheFramebuffer_);
+    if (window.sizeX() <= 0 || window.sizeY() <= 0)
+        return std::nullopt;
+    if ((window.min() < cacheRange_.min()).any() || (window.max() > cacheRange_.max()).any())
+        return std::nullopt;
+
+    Float     depth  = std::numeric_limits<Float>::max();
+    const Int stride = cacheRange_.sizeX();
+    for (Int y = window.bottom(); y != window.top(); ++y)
+        for (Int x = window.left(); x != window.right(); ++x)
+            depth = Math::min(depth, cache_[std::size_t((y - cacheRange_.bottom()) * stride + x - cacheRange_.left())]);
+
+    return depth;
+}
@@ -0,0 +1,72 @@
+#ifndef RENDER_DEPTHREADER_H
+#define RENDER_DEPTHREADER_H
+
+#include "Fence.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Magnum/GL/AbstractFramebuffer.h>
+#include <Magnum/GL/BufferImage.h>
+#include <Magnum/Math/Range.h>
+#include <optional>
+
+using namespace Magnum;
+
+/**
+ * Asynchronous depth queries through a pixel buffer object.
+ *
+ * Instead of reading the depth buffer synchronously (which stalls until the GPU is done with the frame), a block of
+ * depth values around the queried position is copied into a PBO and guarded by a fence. Once update() sees the fence
+ * signaled, usually one frame later, the block is kept as a cache so that queries close to the last one are answered
+ * without touching the GPU until invalidate() is called.
+ */
+class DepthReader
+{
+public:
+    /// @p cacheRadius is the number of pixels cached around the queried position in every direction.
+    explicit DepthReader(Int cacheRadius = 16);
+
+    /**
+     * Minimum depth in a 5x5 pixel window around @p position (in framebuffer pixels, bottom-left origin).
+     *
+     * Returns the value straight from the cache if possible. Otherwise schedules a readback from the currently mapped
+     * read buffer of @p framebuffer and returns an empty optional; the result is then available through takeResult()
+     * after update() sees the readback finished.
+     */
+    std::optional<Float> depthAt(GL::AbstractFramebuffer& framebuffer, const Vector2i& position);
+
+    /// Collects a finished readback. Call once per frame; never blocks.
+    void update();
+
+    /// Result of the last query that had to be scheduled, once it is available. Returns it only once.
+    std::optional<Float> takeResult();
+
+    /// Drops the cache, e.g. because the camera moved and the depth buffer contents changed.
+    void invalidate();
+
+    bool isPending() const { return pending_; }
+
+    /// How many readbacks were issued, i.e., how many queries could not be answered from the cache.
+    std::size_t readbackCount() const { return readbackCount_; }
+
+private:
+    static constexpr Int WindowRadius = 2;
+
+    Int                      cacheRadius_;
+    GL::BufferImage2D        image_;
+    Fence                    fence_;
+    bool                     pending_{false};
+    bool                     pendingStale_{false};
+    Vector2i                 pendingPosition_;
+    Range2Di                 pendingRange_;
+    Range2Di                 pendingFramebuffer_;
+    Containers::Array<Float> cache_;
+    Range2Di                 cacheRange_;       ///< Cached block, in framebuffer pixels.
+    Range2Di                 cacheFramebuffer_; ///< Framebuffer viewport at the time the block was read.
+    bool                     cacheValid_{false};
+    std::optional<Float>     result_;
+    std::size_t              readbackCount_{0};
+
+    std::optional<Float> lookup(const Vector2i& position) const;
+};
+
+#endif // RENDER_DEPTHREADER_H
@@ -0,0 +1,57 @@
+#include "Fence.h"
+
+#include <utility>
+
+Fence::~Fence()
+{
+    reset();
+}
+
+Fence::Fence(Fence&& other) noexcept
+: sync_(std::exchange(other.sync_, nullptr))
+, flushed_(other.flushed_)
+{
+}
+
+Fence& Fence::operator=(Fence&& other) noexcept
+{
+    std::swap(sync_, other.sync_);
+    std::swap(flushed_, other.flushed_);
+    return *this;
+}
+
+void Fence::insert()
+{
+    reset();
+    sync_    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    flushed_ = false;
+}
+
+void Fence::reset()
+{
+    if (sync_)
+        glDeleteSync(sync_);
+    sync_ = nullptr;
+}
+
+bool Fence::isSignaled()
+{
+    if (!sync_)
+        return true;
+
+    /* The first check flushes the command stream, otherwise the fence might never reach the GPU */
+    const GLenum status = glClientWaitSync(sync_, flushed_ ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    flushed_            = true;
+
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void Fence::wait()
+{
+    if (!sync_)
+        return;
+
+    while (glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+    {
+    }
+}
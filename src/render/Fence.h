@@ -0,0 +1,37 @@
+#ifndef RENDER_FENCE_H
+#define RENDER_FENCE_H
+
+#include <Magnum/GL/OpenGL.h>
+
+/**
+ * RAII wrapper around a GL sync object, used to find out whether the GPU is done with some work without stalling.
+ */
+class Fence
+{
+public:
+    explicit Fence() = default;
+    ~Fence();
+    Fence(const Fence&) = delete;
+    Fence(Fence&& other) noexcept;
+    Fence& operator=(const Fence&) = delete;
+    Fence& operator=(Fence&& other) noexcept;
+
+    /// Inserts a new fence into the command stream, replacing the previous one.
+    void insert();
+    void reset();
+
+    /// Whether a fence was inserted and not reset since.
+    bool isActive() const { return sync_ != nullptr; }
+
+    /// Non-blocking check. An inactive fence counts as signaled.
+    bool isSignaled();
+
+    /// Blocks until the fence is signaled.
+    void wait();
+
+private:
+    GLsync sync_{nullptr};
+    bool   flushed_{false};
+};
+
+#endif // RENDER_FENCE_H
@@ -0,0 +1,234 @@
+#include "FramePlayer.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/GL/Sampler.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/PixelFormat.h>
+#include <algorithm>
+
+FramePlayer::FramePlayer(GpuResources& resources, std::vector<std::string> files, std::unique_ptr<ImageLoader> loader,
+                         const std::size_t ringCapacity, const std::size_t cacheCapacity)
+: resources_{resources}
+, shader_{resources.tile()}
+, files_{std::move(files)}
+, loader_{std::move(loader)}
+, playhead_{files_.size()}
+, cache_{cacheCapacity}
+, decoded_(cacheCapacity)
+, ring_{std::size_t(Math::clamp(Int(ringCapacity), 2, GL::Texture2DArray::maxSize().z()))}
+, stream_{resources.instanceStream()}
+, mesh_{TileShader::quad()}
+{
+    CORRADE_INTERNAL_ASSERT(loader_);
+
+    // Streamed instances are read from the start of the stream buffer, every draw picks its own by the base instance
+    mesh_.addVertexBufferInstanced(stream_ ? stream_->buffer() : instanceBuffer_, 1, 0, TileShader::Rectangle{},
+                                   TileShader::TextureCoordinates{}, TileShader::Layer{});
+}
+
+FramePlayer::~FramePlayer()
+{
+    if (memoryId_)
+        resources_.memory().remove(memoryId_);
+}
+
+void FramePlayer::play()
+{
+    // Time spent paused isn't playback time
+    playhead_.play();
+    lastUpdate_.reset();
+}
+
+void FramePlayer::createRing(const Vector2i& frameSize)
+{
+    frameSize_ = frameSize;
+
+    // Zoomed in beyond the full resolution, frame pixels are shown as squares
+    texture_ = GL::Texture2DArray{};
+    texture_.setStorage(1, GL::TextureFormat::RGBA8, {frameSize_, Int(ring_.capacity())})
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge);
+
+    // The ring is as large as it is regardless of the sequence, so there's nothing to evict
+    memoryId_ = resources_.memory().add(GpuMemoryRegistry::Kind::TEXTURE,
+                                        std::size_t(frameSize_.product()) * 4 * ring_.capacity());
+}
+
+void FramePlayer::takeDecoded()
+{
+    while (std::optional<ImageLoader::Result> result = loader_->take())
+    {
+        // Requests of frames that left the window were cancelled, so everything taken is still wanted
+        const auto requested = requestedFrames_.find(result->id);
+        CORRADE_INTERNAL_ASSERT(requested != requestedFrames_.end());
+        const std::size_t frame = requested->second;
+        requestedFrames_.erase(requested);
+        requests_.erase(frame);
+
+        if (result->image && frameSize_ != Vector2i{} && result->image->size() != frameSize_)
+        {
+            Error{} << "FramePlayer:" << result->path.c_str() << "is" << result->image->size() << "instead of"
+                    << frameSize_;
+            result->image.reset();
+        }
+        if (!result->image)
+        {
+            failed_.insert(frame);
+            continue;
+        }
+
+        if (frameSize_ == Vector2i{})
+            createRing(result->image->size());
+
+        // The decoded frames of the window were marked as used, so only frames outside of it make room
+        const std::optional<std::size_t> slot = cache_.insert(frame);
+        CORRADE_INTERNAL_ASSERT(slot);
+        decoded_[*slot] = std::move(result->image);
+    }
+}
+
+void FramePlayer::upload(const std::size_t frame, const Image2D& image)
+{
+    CORRADE_INTERNAL_ASSERT(image.format() == PixelFormat::RGBA8Unorm);
+
+    const std::optional<std::size_t> layer = ring_.insert(frame);
+    CORRADE_INTERNAL_ASSERT(layer);
+
+    texture_.setSubImage(0, {0, 0, Int(*layer)},
+                         ImageView3D{image.storage(), image.format(), {image.size(), 1}, image.data()});
+    ++uploadCount_;
+}
+
+void FramePlayer::showCurrentFrame()
+{
+    // The frame shown before stays until the one at the playhead is on the GPU, it's no use to keep it after that
+    if (ring_.find(playhead_.frame()))
+        shownFrame_ = playhead_.frame();
+}
+
+void FramePlayer::update(const std::chrono::steady_clock::time_point now)
+{
+    const std::chrono::nanoseconds elapsed = lastUpdate_ ? now - *lastUpdate_ : std::chrono::nanoseconds{};
+    lastUpdate_                            = now;
+
+    // The playhead only moves on to frames uploaded by earlier updates. Failed frames are skipped.
+    playhead_.advance(elapsed, [this](const std::size_t frame)
+                      { return ring_.find(frame) || failed_.contains(frame); });
+    showCurrentFrame();
+
+    // Most of the window is ahead, the rest is for going back a bit, e.g. when scrubbing
+    const std::size_t behind = cache_.capacity() / 4;
+    const std::size_t ahead  = cache_.capacity() - 1 - behind;
+    playhead_.prefetchOrder(ahead, behind, wanted_);
+    const Int step = playhead_.direction() == Playhead::Direction::FORWARD ? 1 : -1;
+
+    std::erase_if(requests_,
+                  [&](const auto& request)
+                  {
+                      if (std::find(wanted_.begin(), wanted_.end(), request.first) != wanted_.end())
+                          return false;
+                      loader_->cancel(request.second);
+                      requestedFrames_.erase(request.second);
+                      return true;
+                  });
+
+    // The window fits the cache, so what arrives since the last update doesn't push decoded frames of the window out
+    cache_.nextFrame();
+    for (const std::size_t frame : wanted_)
+        cache_.find(frame);
+    takeDecoded();
+
+    /* The shown frame stays on the GPU, then frames are uploaded in the order of the window until the ring is full of
+       it. Frames neither decoded nor on the GPU are requested, nearest first. */
+    ring_.nextFrame();
+    if (shownFrame_)
+        ring_.find(*shownFrame_);
+
+    stats_               = {};
+    std::size_t uploads  = 0;
+    bool        uploaded = true;
+    bool        decoded  = true;
+    for (std::size_t i = 0; i != wanted_.size(); ++i)
+    {
+        const std::size_t frame = wanted_[i];
+        if (failed_.contains(frame))
+            continue;
+
+        bool resident = bool(ring_.find(frame));
+        bool cached   = resident;
+        if (!resident)
+        {
+            if (const std::optional<std::size_t> slot = cache_.find(frame))
+            {
+                // Frames that don't fit a ring full of nearer ones aren't pending, they wait for the playhead
+                cached = true;
+                if (ring_.canInsert() && uploads != uploadBudget_)
+                {
+                    upload(frame, *decoded_[*slot]);
+                    ++uploads;
+                    resident = true;
+                }
+                else if (ring_.canInsert())
+                    ++stats_.pendingUploads;
+            }
+            else
+            {
+                const Float priority = Float(wanted_.size() - i);
+                if (const auto request = requests_.find(frame); request != requests_.end())
+                    loader_->setPriority(request->second, priority);
+                else
+                {
+                    const ImageLoader::Id id = loader_->request(files_[frame], priority);
+                    requests_.emplace(frame, id);
+                    requestedFrames_.emplace(id, frame);
+                }
+            }
+        }
+
+        // The frames ahead come right after the current one
+        if (i == 0 || i > ahead || playhead_.frameAt(step * Int(i)) != frame)
+            continue;
+        uploaded = uploaded && resident;
+        decoded  = decoded && cached;
+        stats_.uploadedAhead += uploaded ? 1 : 0;
+        stats_.decodedAhead += decoded ? 1 : 0;
+    }
+    stats_.decoding = requests_.size();
+
+    showCurrentFrame();
+}
+
+void FramePlayer::draw(const Range2D& area, const Vector2i& viewportSize)
+{
+    if (!shownFrame_ || (area.size() <= Vector2{0.0f}).any() || (viewportSize <= Vector2i{0}).any())
+        return;
+
+    resources_.memory().touch(memoryId_);
+    const std::optional<std::size_t> layer = ring_.find(*shownFrame_);
+    CORRADE_INTERNAL_ASSERT(layer);
+
+    // Rows are bottom-up in the layer
+    const Instance instance{{0.0f, 0.0f, Float(frameSize_.x()), Float(frameSize_.y())},
+                            {0.0f, 1.0f, 1.0f, 0.0f},
+                            Float(*layer)};
+    if (stream_)
+        mesh_.setBaseInstance(UnsignedInt(stream_->upload(Containers::arrayView(&instance, 1))));
+    else
+        instanceBuffer_.setData(Containers::arrayView(&instance, 1), GL::BufferUsage::StreamDraw);
+    mesh_.setInstanceCount(1);
+
+    // Frame pixels with Y down to clip space
+    const Matrix3 transformationProjection = Matrix3::translation({-1.0f, 1.0f}) *
+                                             Matrix3::scaling(Vector2{2.0f, -2.0f} / area.size()) *
+                                             Matrix3::translation(-area.min());
+
+    shader_->setTransformationProjectionMatrix(transformationProjection).bindTileTexture(texture_).draw(mesh_);
+
+    if (stream_)
+        stream_->finishFrame();
+}
@@ -0,0 +1,145 @@
+#ifndef RENDER_FRAMEPLAYER_H
+#define RENDER_FRAMEPLAYER_H
+
+#include "../containers/LruSlots.h"
+#include "../io/ImageLoader.h"
+#include "GpuResources.h"
+#include "Playhead.h"
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/TextureArray.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Range.h>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Plays back a sequence of image files, e.g. the frames of a camera recording, at their full rate.
+ *
+ * Frames are decoded on the workers of an ImageLoader ahead of the playhead in the playback direction, nearest first,
+ * and a few are kept behind it. Decoded frames wait in a cache in memory and are uploaded, a few per update, into a
+ * ring of layers of one texture array, so the GPU memory is a fixed number of frames however long the sequence is.
+ * Scrubbing and seeking within the cached frames don't decode anything again. Playback holds a frame rather than
+ * skipping one that isn't on the GPU yet, see Playhead.
+ *
+ * All frames have to be of the size of the first one decoded; frames of another size count as failed and are skipped.
+ */
+class FramePlayer
+{
+public:
+    static constexpr std::size_t DefaultRingCapacity  = 8;
+    static constexpr std::size_t DefaultCacheCapacity = 24;
+    static constexpr std::size_t DefaultUploadBudget  = 2;
+
+    struct Stats
+    {
+        std::size_t decodedAhead{0};   ///< Frames after the playhead in a row that are decoded or on the GPU.
+        std::size_t uploadedAhead{0};  ///< Frames after the playhead in a row that are on the GPU.
+        std::size_t decoding{0};       ///< Requested from the loader and not back yet.
+        std::size_t pendingUploads{0}; ///< Decoded, with room on the GPU, but over the upload budget.
+    };
+
+    /**
+     * Plays @p files in order. @p loader decodes them and shouldn't be shared, everything it delivers is taken to be a
+     * frame. Up to @p ringCapacity frames are on the GPU and up to @p cacheCapacity decoded ones in memory, which is
+     * also how far ahead frames are decoded.
+     */
+    explicit FramePlayer(GpuResources& resources, std::vector<std::string> files, std::unique_ptr<ImageLoader> loader,
+                         std::size_t ringCapacity = DefaultRingCapacity,
+                         std::size_t cacheCapacity = DefaultCacheCapacity);
+    ~FramePlayer();
+
+    FramePlayer(const FramePlayer&)            = delete;
+    FramePlayer& operator=(const FramePlayer&) = delete;
+
+    /**
+     * Moves the playhead on to @p now if playing, takes what was decoded, requests what's needed next and uploads a
+     * few frames. Call once per drawn frame, before draw().
+     */
+    void update(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Draws @p area of the current frame, in pixels with Y down, so that it fills the current viewport of
+     * @p viewportSize pixels. Until the frame at the playhead is on the GPU, the one shown before stays. Expects depth
+     * test and face culling to be disabled, like TiledImage::draw().
+     */
+    void draw(const Range2D& area, const Vector2i& viewportSize);
+
+    Playhead&       playhead() { return playhead_; }
+    const Playhead& playhead() const { return playhead_; }
+
+    void play();
+    void pause() { playhead_.pause(); }
+    bool isPlaying() const { return playhead_.isPlaying(); }
+    /// Goes on from @p frame, reusing the frames decoded around it already.
+    void seek(std::size_t frame) { playhead_.seek(frame); }
+
+    /// Frames uploaded per update at most, at least one.
+    void        setUploadBudget(std::size_t frames) { uploadBudget_ = Math::max(frames, std::size_t{1}); }
+    std::size_t uploadBudget() const { return uploadBudget_; }
+
+    /// Whether frames the playhead is about to need are still being decoded or uploaded.
+    bool isStreaming() const { return stats_.decoding != 0 || stats_.pendingUploads != 0; }
+
+    /// Zero until the first frame is decoded.
+    Vector2i                        frameSize() const { return frameSize_; }
+    const std::vector<std::string>& files() const { return files_; }
+    /// Frame draw() shows, empty before the first one is on the GPU.
+    std::optional<std::size_t>      shownFrame() const { return shownFrame_; }
+    /// Of the last update().
+    const Stats&                    stats() const { return stats_; }
+    const ImageLoader&              loader() const { return *loader_; }
+    std::size_t                     ringCapacity() const { return ring_.capacity(); }
+    std::size_t                     cacheCapacity() const { return cache_.capacity(); }
+    /// Number of frames uploaded so far.
+    std::size_t                     uploadCount() const { return uploadCount_; }
+    /// Number of frames that couldn't be decoded or had the wrong size.
+    std::size_t                     failedCount() const { return failed_.size(); }
+
+private:
+    struct Instance
+    {
+        Vector4 rectangle;
+        Vector4 textureCoordinates;
+        Float   layer;
+    };
+
+    void takeDecoded();
+    void createRing(const Vector2i& frameSize);
+    void showCurrentFrame();
+    void upload(std::size_t frame, const Image2D& image);
+
+    GpuResources&                                        resources_;
+    Resource<TileShader>                                 shader_;
+    std::vector<std::string>                             files_;
+    std::unique_ptr<ImageLoader>                         loader_;
+    Playhead                                             playhead_;
+    LruSlots                                             cache_; ///< Slots of decoded_.
+    std::vector<std::optional<Image2D>>                  decoded_;
+    LruSlots                                             ring_; ///< Layers of texture_.
+    GL::Texture2DArray                                   texture_{NoCreate};
+    GpuMemoryRegistry::Id                                memoryId_{0};
+    StreamBuffer*                                        stream_; ///< Null if the instance goes to instanceBuffer_.
+    GL::Buffer                                           instanceBuffer_;
+    GL::Mesh                                             mesh_;
+    Vector2i                                             frameSize_;
+    std::unordered_map<std::size_t, ImageLoader::Id>     requests_; ///< By frame.
+    std::unordered_map<ImageLoader::Id, std::size_t>     requestedFrames_;
+    std::unordered_set<std::size_t>                      failed_;
+    std::vector<std::size_t>                             wanted_; ///< Frames to have at hand, most urgent first.
+    std::optional<std::size_t>                           shownFrame_;
+    std::optional<std::chrono::steady_clock::time_point> lastUpdate_;
+    Stats                                                stats_;
+    std::size_t                                          uploadBudget_{DefaultUploadBudget};
+    std::size_t                                          uploadCount_{0};
+};
+
+#endif // RENDER_FRAMEPLAYER_H
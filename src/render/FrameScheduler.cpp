@@ -0,0 +1,71 @@
+#include "FrameScheduler.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <utility>
+
+FrameScheduler::FrameScheduler(std::function<void()> wakeUp, const RedrawMode mode, const Float maxFramesPerSecond)
+: wakeUp_(std::move(wakeUp))
+, mode_(mode)
+{
+    setMaxFramesPerSecond(maxFramesPerSecond);
+}
+
+FrameScheduler& FrameScheduler::setMode(const RedrawMode mode)
+{
+    mode_ = mode;
+    if (mode_ == RedrawMode::CONTINUOUS)
+        requestFrame();
+
+    return *this;
+}
+
+FrameScheduler& FrameScheduler::setMaxFramesPerSecond(const Float framesPerSecond)
+{
+    CORRADE_INTERNAL_ASSERT(framesPerSecond >= 0.0f);
+
+    using Seconds = std::chrono::duration<Float>;
+
+    maxFramesPerSecond_ = framesPerSecond;
+    minFrameTime_       = framesPerSecond > 0.0f
+                              ? std::chrono::duration_cast<Clock::duration>(Seconds{1.0f / framesPerSecond})
+                              : Clock::duration::zero();
+
+    return *this;
+}
+
+void FrameScheduler::requestFrame(const Int count)
+{
+    Int pending = pendingFrames_.load(std::memory_order_relaxed);
+    while (pending < count && !pendingFrames_.compare_exchange_weak(pending, count, std::memory_order_release,
+                                                                     std::memory_order_relaxed))
+    {
+    }
+
+    if (wakeUp_)
+        wakeUp_();
+}
+
+bool FrameScheduler::takeFrameRequest()
+{
+    Int pending = pendingFrames_.load(std::memory_order_acquire);
+    while (pending > 0 && !pendingFrames_.compare_exchange_weak(pending, pending - 1, std::memory_order_acquire,
+                                                                 std::memory_order_relaxed))
+    {
+    }
+
+    return pending > 0;
+}
+
+FrameScheduler::Clock::time_point FrameScheduler::nextFrameTime() const
+{
+    return lastFrameTime_ + minFrameTime_;
+}
+
+void FrameScheduler::frameStarted(const Clock::time_point time)
+{
+    lastFrameTime_ = time;
+    ++frameCount_;
+
+    if (mode_ == RedrawMode::CONTINUOUS)
+        requestFrame();
+}
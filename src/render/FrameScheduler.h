@@ -0,0 +1,71 @@
+#ifndef RENDER_FRAMESCHEDULER_H
+#define RENDER_FRAMESCHEDULER_H
+
+#include <Magnum/Magnum.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+using namespace Magnum;
+
+/**
+ * Decides when the application has to draw a frame.
+ *
+ * In event-driven mode frames are only drawn when requested, e.g. because of input, ImGui activity, an ongoing
+ * animation or data produced by a background thread. In continuous mode every frame requests the next one. Either way
+ * frames are rate-limited to a configurable maximum frame rate. requestFrame() may be called from any thread; it wakes
+ * up the (otherwise blocked) event loop through the wake-up function.
+ */
+class FrameScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class RedrawMode : uint8_t
+    {
+        CONTINUOUS = 0,
+        EVENT_DRIVEN
+    };
+
+    explicit FrameScheduler(std::function<void()> wakeUp = nullptr, RedrawMode mode = RedrawMode::EVENT_DRIVEN,
+                            Float maxFramesPerSecond = 60.0f);
+
+    FrameScheduler& setMode(RedrawMode mode);
+    RedrawMode      mode() const { return mode_; }
+
+    /// Zero means no limit (other than vsync).
+    FrameScheduler& setMaxFramesPerSecond(Float framesPerSecond);
+    Float           maxFramesPerSecond() const { return maxFramesPerSecond_; }
+
+    /**
+     * Asks for at least @p count more frames to be drawn. Thread-safe.
+     *
+     * More than one frame is useful after input, since ImGui only reflects the input state in the frame after it sees
+     * it.
+     */
+    void requestFrame(Int count = 1);
+
+    /// Whether a frame should be drawn, consuming one pending request. Main thread only.
+    bool takeFrameRequest();
+
+    /// Earliest time the next frame may start at with the current frame rate limit.
+    Clock::time_point nextFrameTime() const;
+
+    /// Records that a frame started at @p time, for the frame rate limit. In continuous mode it requests the next one.
+    void frameStarted(Clock::time_point time = Clock::now());
+
+    /// Number of frames drawn so far.
+    std::size_t frameCount() const { return frameCount_; }
+
+private:
+    std::function<void()> wakeUp_;
+    RedrawMode            mode_;
+    Float                 maxFramesPerSecond_{};
+    Clock::duration       minFrameTime_{};
+    Clock::time_point     lastFrameTime_{};
+    std::atomic<Int>      pendingFrames_{1}; // The very first frame is always drawn
+    std::size_t           frameCount_{0};
+};
+
+#endif // RENDER_FRAMESCHEDULER_H
@@ -0,0 +1,37 @@
+#include "GlyphAtlas.h"
+
+#include <Corrade/Utility/Assert.h>
+
+GlyphAtlas::GlyphAtlas(const Float lineHeight, const Float descent)
+: lineHeight_(lineHeight)
+, descent_(descent)
+{
+    CORRADE_INTERNAL_ASSERT(lineHeight_ > 0.0f && descent_ >= 0.0f);
+}
+
+GlyphAtlas& GlyphAtlas::add(const char character, const Glyph& glyph)
+{
+    const auto index = static_cast<unsigned char>(character);
+    CORRADE_INTERNAL_ASSERT(index < glyphs_.size());
+
+    glyphs_[index] = glyph;
+    return *this;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::glyph(const char character) const
+{
+    const auto index = static_cast<unsigned char>(character);
+    if (index >= glyphs_.size() || !glyphs_[index])
+        return nullptr;
+
+    return &*glyphs_[index];
+}
+
+Float GlyphAtlas::width(const std::string_view text) const
+{
+    Float width = 0.0f;
+    for (const char c : text)
+        if (const Glyph* g = glyph(c))
+            width += g->advance;
+    return width;
+}
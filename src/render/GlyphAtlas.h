@@ -0,0 +1,48 @@
+#ifndef RENDER_GLYPHATLAS_H
+#define RENDER_GLYPHATLAS_H
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Range.h>
+#include <array>
+#include <optional>
+#include <string_view>
+
+using namespace Magnum;
+
+/**
+ * Metrics of the glyphs rasterized into a texture, for laying out text without touching the GPU.
+ *
+ * Only ASCII is covered, which is what labels of IDs, keypoints and measurements need. The texture itself is owned by
+ * whoever rasterized the glyphs, e.g. the ImGui font atlas.
+ */
+class GlyphAtlas
+{
+public:
+    struct Glyph
+    {
+        Range2D rectangle;          ///< Quad relative to the pen position on the baseline, in pixels, Y up.
+        Range2D textureCoordinates; ///< At the bottom left and top right corner of the rectangle.
+        Float   advance;            ///< How far the pen moves after the glyph, in pixels.
+    };
+
+    /// @p lineHeight is the distance between two baselines, @p descent how far glyphs reach below the baseline.
+    explicit GlyphAtlas(Float lineHeight = 16.0f, Float descent = 4.0f);
+
+    GlyphAtlas& add(char character, const Glyph& glyph);
+
+    /// Null for characters that weren't added, which are skipped when laying out text.
+    const Glyph* glyph(char character) const;
+
+    Float lineHeight() const { return lineHeight_; }
+    Float descent() const { return descent_; }
+
+    /// Sum of the advances of @p text, in pixels.
+    Float width(std::string_view text) const;
+
+private:
+    Float                                 lineHeight_;
+    Float                                 descent_;
+    std::array<std::optional<Glyph>, 128> glyphs_;
+};
+
+#endif // RENDER_GLYPHATLAS_H
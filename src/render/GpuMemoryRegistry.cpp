@@ -0,0 +1,125 @@
+#include "GpuMemoryRegistry.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <algorithm>
+#include <vector>
+
+GpuMemoryRegistry::GpuMemoryRegistry(const std::size_t budget)
+: budget_(budget)
+{
+}
+
+GpuMemoryRegistry::Id GpuMemoryRegistry::add(const Kind kind, const std::size_t bytes, Evict evict)
+{
+    const Id id = next_++;
+    account(entries_.emplace(id, Entry{kind, bytes, frame_, true, std::move(evict)}).first->second, true);
+    return id;
+}
+
+void GpuMemoryRegistry::remove(const Id id)
+{
+    const Entry& entry = find(id);
+    if (entry.resident)
+        account(entry, false);
+    entries_.erase(id);
+}
+
+void GpuMemoryRegistry::setSize(const Id id, const std::size_t bytes)
+{
+    Entry& entry = find(id);
+    CORRADE_INTERNAL_ASSERT(entry.resident);
+    account(entry, false);
+    entry.bytes = bytes;
+    account(entry, true);
+}
+
+void GpuMemoryRegistry::setEvict(const Id id, Evict evict)
+{
+    find(id).evict = std::move(evict);
+}
+
+bool GpuMemoryRegistry::touch(const Id id)
+{
+    Entry& entry    = find(id);
+    entry.lastDrawn = frame_;
+    return entry.resident;
+}
+
+void GpuMemoryRegistry::reload(const Id id, const std::size_t bytes)
+{
+    Entry& entry = find(id);
+    CORRADE_INTERNAL_ASSERT(!entry.resident);
+    entry.bytes     = bytes;
+    entry.resident  = true;
+    entry.lastDrawn = frame_;
+    account(entry, true);
+    ++reloadCount_;
+}
+
+bool GpuMemoryRegistry::isResident(const Id id) const
+{
+    const auto found = entries_.find(id);
+    CORRADE_INTERNAL_ASSERT(found != entries_.end());
+    return found->second.resident;
+}
+
+std::size_t GpuMemoryRegistry::enforceBudget()
+{
+    const std::size_t frame = frame_++;
+    if (budget_ == 0 || used_ <= budget_)
+        return 0;
+
+    /* Oldest first. Resources drawn in this frame may still be referenced by commands in flight. */
+    std::vector<std::pair<std::size_t, Id>> candidates;
+    for (const auto& [id, entry] : entries_)
+        if (entry.resident && entry.evict && entry.lastDrawn < frame)
+            candidates.emplace_back(entry.lastDrawn, id);
+    std::sort(candidates.begin(), candidates.end());
+
+    const std::size_t usedBefore = used_;
+    for (const auto& [lastDrawn, id] : candidates)
+    {
+        if (used_ <= budget_)
+            break;
+
+        /* The callback may remove the resource, taking the callback with it, so call a copy */
+        const auto found = entries_.find(id);
+        if (found == entries_.end())
+            continue;
+        const Evict evict = found->second.evict;
+        if (!evict())
+            continue;
+
+        ++evictionCount_;
+        const auto evicted = entries_.find(id);
+        if (evicted != entries_.end())
+        {
+            account(evicted->second, false);
+            evicted->second.resident = false;
+        }
+    }
+
+    return usedBefore - used_;
+}
+
+GpuMemoryRegistry::Entry& GpuMemoryRegistry::find(const Id id)
+{
+    const auto found = entries_.find(id);
+    CORRADE_INTERNAL_ASSERT(found != entries_.end());
+    return found->second;
+}
+
+void GpuMemoryRegistry::account(const Entry& entry, const bool add)
+{
+    std::size_t& kind = usedByKind_[std::size_t(entry.kind)];
+    if (add)
+    {
+        used_ += entry.bytes;
+        kind += entry.bytes;
+    }
+    else
+    {
+        used_ -= entry.bytes;
+        kind -= entry.bytes;
+    }
+}
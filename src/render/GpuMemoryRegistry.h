@@ -0,0 +1,104 @@
+#ifndef RENDER_GPUMEMORYREGISTRY_H
+#define RENDER_GPUMEMORYREGISTRY_H
+
+#include <Magnum/Magnum.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+using namespace Magnum;
+
+/**
+ * Bookkeeping of the GPU memory held by textures, buffers and framebuffers, with a budget enforced by evicting the
+ * least recently drawn resources.
+ *
+ * Owners register a resource with its size and, if it can be recreated later (an off-screen pane cache, a far level of
+ * detail, ...), a callback that frees it. Every frame they touch() what they draw, and enforceBudget() evicts the
+ * resources that were drawn longest ago until the usage fits the budget again. A resource drawn in the current frame
+ * is never evicted. An evicted resource stays registered, touch() tells the owner to reload it on demand. The registry
+ * doesn't own any GL object, so it can be tested on its own.
+ */
+class GpuMemoryRegistry
+{
+public:
+    enum class Kind : uint8_t
+    {
+        TEXTURE = 0,
+        BUFFER,
+        FRAMEBUFFER
+    };
+    static constexpr std::size_t KindCount = 3;
+
+    using Id = UnsignedInt;
+    /// Frees the GPU memory of a resource. Returns false if it can't be evicted right now, e.g. because it's in use.
+    using Evict = std::function<bool()>;
+
+    /// Zero @p budget means unlimited.
+    explicit GpuMemoryRegistry(std::size_t budget = 0);
+
+    GpuMemoryRegistry(const GpuMemoryRegistry&)            = delete;
+    GpuMemoryRegistry& operator=(const GpuMemoryRegistry&) = delete;
+
+    /**
+     * Registers a resident resource of @p bytes, counted as drawn in the current frame. Without @p evict it's never
+     * evicted.
+     */
+    Id   add(Kind kind, std::size_t bytes, Evict evict = nullptr);
+    /// Unregisters a resource the owner deleted. Can be called from an Evict callback.
+    void remove(Id id);
+
+    /// Updates the size of a resident resource, e.g. after its storage was reallocated.
+    void setSize(Id id, std::size_t bytes);
+    void setEvict(Id id, Evict evict);
+
+    /**
+     * Marks the resource as drawn in the current frame. Returns false if it was evicted, the owner then has to recreate
+     * it and call reload().
+     */
+    bool touch(Id id);
+    /// Makes an evicted resource resident again with @p bytes.
+    void reload(Id id, std::size_t bytes);
+    bool isResident(Id id) const;
+
+    /**
+     * Evicts the least recently drawn resources until the usage fits the budget and starts a new frame. Call once per
+     * frame, after the commands drawing the resources were executed. Returns the number of bytes freed.
+     */
+    std::size_t enforceBudget();
+
+    void        setBudget(std::size_t bytes) { budget_ = bytes; }
+    std::size_t budget() const { return budget_; }
+
+    /// Bytes held by the resident resources.
+    std::size_t used() const { return used_; }
+    std::size_t used(Kind kind) const { return usedByKind_[std::size_t(kind)]; }
+    /// Registered resources, resident or not.
+    std::size_t count() const { return entries_.size(); }
+    std::size_t evictionCount() const { return evictionCount_; }
+    std::size_t reloadCount() const { return reloadCount_; }
+
+private:
+    struct Entry
+    {
+        Kind        kind;
+        std::size_t bytes;
+        std::size_t lastDrawn; ///< Frame the resource was drawn in the last time.
+        bool        resident;
+        Evict       evict;
+    };
+
+    Entry& find(Id id);
+    void   account(const Entry& entry, bool add);
+
+    std::unordered_map<Id, Entry>      entries_;
+    std::array<std::size_t, KindCount> usedByKind_{};
+    std::size_t                        budget_;
+    std::size_t                        used_{0};
+    std::size_t                        frame_{0};
+    std::size_t                        evictionCount_{0};
+    std::size_t                        reloadCount_{0};
+    Id                                 next_{1};
+};
+
+#endif // RENDER_GPUMEMORYREGISTRY_H
@@ -0,0 +1,78 @@
+#include "GpuResources.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/MeshTools/Compile.h>
+
+template <class T, class Create>
+Resource<T> GpuResources::getOrCreate(const ResourceKey key, Create&& create)
+{
+    /* Take the reference before setting the data, a reference-counted resource nobody refers to is deleted right
+       away */
+    Resource<T> resource = manager_.get<T>(key);
+    if (!resource)
+    {
+        manager_.set(key, create(), ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+        ++creationCount_;
+    }
+
+    return resource;
+}
+
+Resource<Shaders::FlatGL2D> GpuResources::flat2D(const Shaders::FlatGL2D::Flags flags)
+{
+    return getOrCreate<Shaders::FlatGL2D>(ResourceKey{Utility::format("FlatGL2D:{}", UnsignedInt(flags))},
+                                          [&]
+                                          {
+                                              return new Shaders::FlatGL2D{
+                                                  Shaders::FlatGL2D::Configuration{}.setFlags(flags)};
+                                          });
+}
+
+Resource<Shaders::FlatGL3D> GpuResources::flat3D(const Shaders::FlatGL3D::Flags flags)
+{
+    return getOrCreate<Shaders::FlatGL3D>(ResourceKey{Utility::format("FlatGL3D:{}", UnsignedInt(flags))},
+                                          [&]
+                                          {
+                                              return new Shaders::FlatGL3D{
+                                                  Shaders::FlatGL3D::Configuration{}.setFlags(flags)};
+                                          });
+}
+
+Resource<InfiniteGridShader> GpuResources::infiniteGrid()
+{
+    return getOrCreate<InfiniteGridShader>(ResourceKey{"InfiniteGrid"},
+                                           [&] { return new InfiniteGridShader{programBinaryCache_}; });
+}
+
+Resource<LabelShader> GpuResources::label()
+{
+    return getOrCreate<LabelShader>(ResourceKey{"Label"}, [&] { return new LabelShader{programBinaryCache_}; });
+}
+
+Resource<TileShader> GpuResources::tile()
+{
+    return getOrCreate<TileShader>(ResourceKey{"Tile"}, [&] { return new TileShader{programBinaryCache_}; });
+}
+
+Resource<GL::Mesh> GpuResources::mesh(const Containers::StringView name,
+                                      const std::function<Trade::MeshData()>& generate)
+{
+    return getOrCreate<GL::Mesh>(ResourceKey{name}, [&] { return new GL::Mesh{MeshTools::compile(generate())}; });
+}
+
+StreamBuffer* GpuResources::instanceStream()
+{
+    if (!instanceStreamChecked_)
+    {
+        instanceStreamChecked_ = true;
+        if (StreamBuffer::isSupported() &&
+            GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>())
+            instanceStream_.emplace(InstanceStreamCapacity, &memory_);
+    }
+
+    return instanceStream_ ? &*instanceStream_ : nullptr;
+}
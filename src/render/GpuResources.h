@@ -0,0 +1,92 @@
+#ifndef RENDER_GPURESOURCES_H
+#define RENDER_GPURESOURCES_H
+
+#include "../shaders/InfiniteGridShader.h"
+#include "../shaders/LabelShader.h"
+#include "../shaders/TileShader.h"
+#include "GpuMemoryRegistry.h"
+#include "ProgramBinaryCache.h"
+#include "StreamBuffer.h"
+
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/Resource.h>
+#include <Magnum/ResourceManager.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+#include <functional>
+#include <optional>
+
+using namespace Magnum;
+
+/**
+ * Cache of the GPU objects that panes and drawables can share: shader programs keyed by their configuration and
+ * meshes keyed by name.
+ *
+ * Resources are reference-counted, so a shader or mesh lives as long as some Resource handle refers to it and is
+ * compiled or uploaded again only when it's requested after that. The cache has to outlive all the handles.
+ *
+ * It also holds the GpuMemoryRegistry the panes account their own textures, buffers and render targets in, and the
+ * StreamBuffer per-frame instance data is uploaded through.
+ */
+class GpuResources
+{
+public:
+    using Manager =
+        ResourceManager<GL::Mesh, Shaders::FlatGL2D, Shaders::FlatGL3D, InfiniteGridShader, LabelShader, TileShader>;
+
+    explicit GpuResources() = default;
+
+    GpuResources(const GpuResources&)            = delete;
+    GpuResources& operator=(const GpuResources&) = delete;
+
+    Resource<Shaders::FlatGL2D>  flat2D(Shaders::FlatGL2D::Flags flags = {});
+    Resource<Shaders::FlatGL3D>  flat3D(Shaders::FlatGL3D::Flags flags = {});
+    Resource<InfiniteGridShader> infiniteGrid();
+    Resource<LabelShader>        label();
+    Resource<TileShader>         tile();
+
+    /**
+     * Shaders compiled by the repo itself are loaded from @p cache if possible, see ProgramBinaryCache. Null, the
+     * default, compiles them from source. The cache has to outlive this object.
+     */
+    void                setProgramBinaryCache(ProgramBinaryCache* cache) { programBinaryCache_ = cache; }
+    ProgramBinaryCache* programBinaryCache() const { return programBinaryCache_; }
+
+    /// Memory held by the panes, with the budget the application enforces every frame.
+    GpuMemoryRegistry&       memory() { return memory_; }
+    const GpuMemoryRegistry& memory() const { return memory_; }
+
+    /// Bytes of the instance stream, see instanceStream().
+    static constexpr std::size_t InstanceStreamCapacity = 4 << 20;
+
+    /**
+     * Stream buffer for instance data that changes every draw, e.g. labels and image tiles, so that it goes to a fresh
+     * range instead of reallocating a buffer. Draws read it from the beginning of the buffer and pick their range with
+     * the base instance, see StreamBuffer::upload(), and whoever uploads calls StreamBuffer::finishFrame() after the
+     * draw. Created on first use, null if buffer storage or base instances aren't supported.
+     */
+    StreamBuffer* instanceStream();
+
+    /// Mesh called @p name, compiled from the output of @p generate if it isn't in the cache.
+    Resource<GL::Mesh> mesh(Containers::StringView name, const std::function<Trade::MeshData()>& generate);
+
+    /// Number of shaders compiled and meshes uploaded so far, i.e. cache misses.
+    std::size_t creationCount() const { return creationCount_; }
+    /// Number of shaders and meshes currently alive.
+    std::size_t count() { return manager_.count(); }
+
+private:
+    Manager             manager_;
+    GpuMemoryRegistry   memory_;
+    std::size_t         creationCount_{0};
+    ProgramBinaryCache* programBinaryCache_{nullptr};
+
+    /* After the registry, it's accounted in */
+    std::optional<StreamBuffer> instanceStream_;
+    bool                        instanceStreamChecked_{false};
+
+    template <class T, class Create>
+    Resource<T> getOrCreate(ResourceKey key, Create&& create);
+};
+
+#endif // RENDER_GPURESOURCES_H
@@ -0,0 +1,46 @@
+#include "GpuTimer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+GpuTimer::GpuTimer() = default;
+
+std::optional<std::size_t> GpuTimer::begin()
+{
+    CORRADE_INTERNAL_ASSERT(!running_);
+
+    Query& query = queries_[next_];
+    if (query.pending)
+    {
+        ++skippedCount_;
+        return std::nullopt;
+    }
+
+    query.query.begin();
+    running_ = true;
+    return next_;
+}
+
+void GpuTimer::end()
+{
+    if (!running_)
+        return;
+
+    Query& query = queries_[next_];
+    query.query.end();
+    query.pending = true;
+    running_      = false;
+    next_         = (next_ + 1) % QueryCount;
+}
+
+std::optional<GpuTimer::Result> GpuTimer::takeResult()
+{
+    // Queries finish in the order they were issued, so only the oldest one needs to be checked
+    Query& query = queries_[oldest_];
+    if (!query.pending || !query.query.resultAvailable())
+        return std::nullopt;
+
+    const std::size_t slot = oldest_;
+    query.pending          = false;
+    oldest_                = (oldest_ + 1) % QueryCount;
+    return Result{slot, std::chrono::nanoseconds{query.query.result<UnsignedLong>()}};
+}
@@ -0,0 +1,55 @@
+#ifndef RENDER_GPUTIMER_H
+#define RENDER_GPUTIMER_H
+
+#include <Magnum/GL/TimeQuery.h>
+#include <array>
+#include <chrono>
+#include <optional>
+
+using namespace Magnum;
+
+/**
+ * Measures the GPU time of a block of commands without waiting for the GPU.
+ *
+ * Every begin()/end() pair uses its own query out of a small ring, so the result of a measurement is picked up by
+ * takeResult() a frame or two later. If all the queries are still in flight, the measurement is skipped. The slot
+ * returned by begin() comes back with the result, to match it with whatever was measured.
+ */
+class GpuTimer
+{
+public:
+    static constexpr std::size_t QueryCount = 3;
+
+    explicit GpuTimer();
+
+    struct Result
+    {
+        std::size_t              slot;
+        std::chrono::nanoseconds time;
+    };
+
+    /// Starts a measurement. Returns its slot, or nothing if it's skipped.
+    std::optional<std::size_t> begin();
+    void                       end();
+
+    /// Oldest finished measurement, if any. Never blocks.
+    std::optional<Result> takeResult();
+
+    /// Measurements that were skipped because no query was free.
+    std::size_t skippedCount() const { return skippedCount_; }
+
+private:
+    struct Query
+    {
+        GL::TimeQuery query{GL::TimeQuery::Target::TimeElapsed};
+        bool          pending{false};
+    };
+
+    std::array<Query, QueryCount> queries_;
+    std::size_t                   next_{0};
+    std::size_t                   oldest_{0};
+    bool                          running_{false};
+    std::size_t                   skippedCount_{0};
+};
+
+#endif // RENDER_GPUTIMER_H
@@ -0,0 +1,129 @@
+#include "LabelInstances.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+#include <algorithm>
+
+namespace
+{
+
+Vector4 corners(const Range2D& range)
+{
+    return {range.min().x(), range.min().y(), range.max().x(), range.max().y()};
+}
+
+} // namespace
+
+LabelInstances::LabelInstances(const Float cellSize)
+: cellSize_(cellSize)
+{
+    CORRADE_INTERNAL_ASSERT(cellSize_ > 0.0f);
+}
+
+void LabelInstances::update(const std::vector<Label>& labels, const GlyphAtlas& atlas,
+                            const Matrix4& transformationProjection, const Vector2i& viewportSize, const Float scale)
+{
+    CORRADE_INTERNAL_ASSERT((viewportSize > Vector2i{0}).all() && scale > 0.0f);
+
+    viewportSize_ = viewportSize;
+    stats_        = {};
+    instances_.clear();
+    candidates_.clear();
+    placed_.clear();
+
+    const Vector2 size{viewportSize};
+    const Range2D screen{{}, size};
+    const Float   height = atlas.lineHeight() * scale;
+    for (std::size_t i = 0; i != labels.size(); ++i)
+    {
+        const Label&  label = labels[i];
+        const Vector4 clip  = transformationProjection * Vector4{label.position, 1.0f};
+
+        // Behind the camera or beyond the far plane
+        if (clip.w() <= 0.0f || clip.z() > clip.w())
+        {
+            ++stats_.culled;
+            continue;
+        }
+
+        const Vector2 anchor = (clip.xy() / clip.w() * 0.5f + Vector2{0.5f}) * size;
+        const Float   width  = atlas.width(label.text) * scale;
+        const Vector2 min{anchor.x() - width * 0.5f, anchor.y() + AnchorOffset * scale};
+        const Range2D box{min, min + Vector2{width, height}};
+        if (!Math::intersects(box, screen))
+        {
+            ++stats_.culled;
+            continue;
+        }
+
+        candidates_.push_back({label.priority, clip.z() / clip.w(), i, box});
+    }
+
+    std::sort(candidates_.begin(), candidates_.end(),
+              [](const Candidate& a, const Candidate& b)
+              {
+                  if (a.priority != b.priority)
+                      return a.priority > b.priority;
+                  if (a.depth != b.depth)
+                      return a.depth < b.depth;
+                  return a.index < b.index;
+              });
+
+    cellCount_                  = Math::max(Vector2i{Math::ceil(size / cellSize_)}, Vector2i{1});
+    const std::size_t cellTotal = std::size_t(cellCount_.product());
+    if (cells_.size() < cellTotal)
+        cells_.resize(cellTotal);
+    for (std::size_t i = 0; i != cellTotal; ++i)
+        cells_[i].clear();
+
+    for (const Candidate& candidate : candidates_)
+    {
+        /* Only the part on screen can collide with anything that is visible */
+        const Range2D  visible = Math::intersect(candidate.box, screen);
+        const Vector2i first =
+            Math::clamp(Vector2i{Math::floor(visible.min() / cellSize_)}, Vector2i{0}, cellCount_ - Vector2i{1});
+        const Vector2i last =
+            Math::clamp(Vector2i{Math::floor(visible.max() / cellSize_)}, Vector2i{0}, cellCount_ - Vector2i{1});
+        if (overlaps(candidate.box, first, last))
+        {
+            ++stats_.decluttered;
+            continue;
+        }
+
+        const auto placedIndex = UnsignedInt(placed_.size());
+        placed_.push_back(candidate.box);
+        for (Int y = first.y(); y <= last.y(); ++y)
+            for (Int x = first.x(); x <= last.x(); ++x)
+                cells_[std::size_t(y * cellCount_.x() + x)].push_back(placedIndex);
+
+        const Label& label = labels[candidate.index];
+        Vector2      pen{candidate.box.min().x(), candidate.box.min().y() + atlas.descent() * scale};
+        for (const char c : label.text)
+        {
+            const GlyphAtlas::Glyph* glyph = atlas.glyph(c);
+            if (!glyph)
+                continue;
+
+            // Spaces only advance the pen
+            if (!glyph->rectangle.size().isZero())
+            {
+                const Range2D rectangle{pen + glyph->rectangle.min() * scale, pen + glyph->rectangle.max() * scale};
+                instances_.push_back(
+                    {corners(rectangle), corners(glyph->textureCoordinates), label.color, label.objectId});
+            }
+            pen.x() += glyph->advance * scale;
+        }
+        ++stats_.drawn;
+    }
+}
+
+bool LabelInstances::overlaps(const Range2D& box, const Vector2i& firstCell, const Vector2i& lastCell) const
+{
+    for (Int y = firstCell.y(); y <= lastCell.y(); ++y)
+        for (Int x = firstCell.x(); x <= lastCell.x(); ++x)
+            for (const UnsignedInt index : cells_[std::size_t(y * cellCount_.x() + x)])
+                if (Math::intersects(box, placed_[index]))
+                    return true;
+
+    return false;
+}
@@ -0,0 +1,96 @@
+#ifndef RENDER_LABELINSTANCES_H
+#define RENDER_LABELINSTANCES_H
+
+#include "GlyphAtlas.h"
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+#include <string>
+#include <vector>
+
+using namespace Magnum;
+
+/// Text anchored at a point of the scene, e.g. an object ID, a keypoint name or a measurement.
+struct Label
+{
+    Vector3     position;
+    std::string text;
+    Color4      color{1.0f};
+    Float       priority{0.0f}; ///< Labels with a higher priority win when they overlap.
+    UnsignedInt objectId{0};    ///< Written to the object ID buffer, so that clicking a label picks its object.
+};
+
+/**
+ * Per-instance data of the label renderer: every glyph of every visible label is one instance of a quad, placed in the
+ * pixels of the target the pane renders into.
+ *
+ * Labels keep their size in pixels regardless of the distance, centred above their anchor. Labels whose anchor is
+ * behind the camera, beyond the far plane or whose text is entirely outside of the viewport are culled. Overlapping
+ * labels are decluttered: the one with the higher priority, or the nearer one for equal priorities, is kept and the
+ * others are dropped, using a grid of screen cells so that the cost stays linear in the number of visible labels.
+ * Building the instances doesn't touch the GPU, LabelRenderer uploads and draws them in one call.
+ */
+class LabelInstances
+{
+public:
+    struct Instance
+    {
+        Vector4     rectangle;          ///< Min and max corner in pixels, origin at the bottom left.
+        Vector4     textureCoordinates; ///< At the min and max corner.
+        Color4      color;
+        UnsignedInt objectId;
+    };
+
+    struct Stats
+    {
+        std::size_t drawn{0};       ///< Labels with at least one glyph instance.
+        std::size_t culled{0};      ///< Behind the camera or off-screen.
+        std::size_t decluttered{0}; ///< Dropped because of a label that was placed before.
+    };
+
+    /// Gap between the anchor and the bottom of the text, in pixels at scale 1.
+    static constexpr Float AnchorOffset = 4.0f;
+
+    /// @p cellSize is the size of the declutter grid cells, in pixels.
+    explicit LabelInstances(Float cellSize = 32.0f);
+
+    /**
+     * Rebuilds the instances of @p labels as seen through @p transformationProjection in a viewport of @p viewportSize
+     * pixels, with the glyphs of @p atlas scaled by @p scale, e.g. for panes rendering at a lower resolution.
+     */
+    void update(const std::vector<Label>& labels, const GlyphAtlas& atlas, const Matrix4& transformationProjection,
+                const Vector2i& viewportSize, Float scale = 1.0f);
+
+    const std::vector<Instance>& instances() const { return instances_; }
+    std::size_t                  size() const { return instances_.size(); }
+    Vector2i                     viewportSize() const { return viewportSize_; }
+    const Stats&                 stats() const { return stats_; }
+
+    /// Screen rectangles of the placed labels, in placement order.
+    const std::vector<Range2D>& placed() const { return placed_; }
+
+private:
+    struct Candidate
+    {
+        Float       priority;
+        Float       depth;
+        std::size_t index;
+        Range2D     box;
+    };
+
+    Float    cellSize_;
+    Vector2i viewportSize_{1, 1};
+    Vector2i cellCount_;
+    Stats    stats_;
+
+    std::vector<Instance>                 instances_;
+    std::vector<Candidate>                candidates_;
+    std::vector<Range2D>                  placed_;
+    std::vector<std::vector<UnsignedInt>> cells_; ///< Indices into placed_ of the boxes overlapping every cell.
+
+    bool overlaps(const Range2D& box, const Vector2i& firstCell, const Vector2i& lastCell) const;
+};
+
+#endif // RENDER_LABELINSTANCES_H
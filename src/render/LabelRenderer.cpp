@@ -0,0 +1,37 @@
+#include "LabelRenderer.h"
+
+#include <Corrade/Containers/ArrayView.h>
+
+LabelRenderer::LabelRenderer(GpuResources& resources, const GlyphAtlas& atlas, GL::Texture2D& glyphs)
+: shader_{resources.label()}
+, atlas_{atlas}
+, glyphs_{glyphs}
+, stream_{resources.instanceStream()}
+, mesh_{LabelShader::quad()}
+{
+    // Streamed instances are read from the start of the stream buffer, every draw picks its own by the base instance
+    mesh_.addVertexBufferInstanced(stream_ ? stream_->buffer() : instanceBuffer_, 1, 0, LabelShader::Rectangle{},
+                                   LabelShader::TextureCoordinates{}, LabelShader::Color{}, LabelShader::ObjectId{});
+}
+
+void LabelRenderer::draw(const std::vector<Label>& labels, const Matrix4& transformationProjection,
+                         const Vector2i& viewportSize, const Float scale)
+{
+    instances_.update(labels, atlas_, transformationProjection, viewportSize, scale);
+    if (instances_.instances().empty())
+        return;
+
+    const auto instances = Containers::arrayView(instances_.instances().data(), instances_.size());
+    if (stream_)
+        mesh_.setBaseInstance(UnsignedInt(stream_->upload(instances)));
+    else
+        instanceBuffer_.setData(instances, GL::BufferUsage::StreamDraw);
+    mesh_.setInstanceCount(Int(instances_.size()));
+    shader_->setViewportSize(Vector2{viewportSize}).bindGlyphTexture(glyphs_).draw(mesh_);
+
+    // Every pane draws its own labels, so the next one goes to another part of the stream
+    if (stream_)
+        stream_->finishFrame();
+
+    ++drawCallCount_;
+}
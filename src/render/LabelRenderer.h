@@ -0,0 +1,59 @@
+#ifndef RENDER_LABELRENDERER_H
+#define RENDER_LABELRENDERER_H
+
+#include "GlyphAtlas.h"
+#include "GpuResources.h"
+#include "LabelInstances.h"
+#include "RenderState.h"
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Texture.h>
+
+using namespace Magnum;
+
+/**
+ * Draws scene labels on top of a pane with one instanced draw call, regardless of the number of labels.
+ *
+ * The glyphs of all the labels come from one shared texture, e.g. the font atlas ImGui already rasterized, and every
+ * glyph is an instance of a quad, see LabelInstances for the layout, culling and decluttering. One renderer is shared
+ * by all the panes; the instance buffer is refilled for every pane.
+ */
+class LabelRenderer
+{
+public:
+    /// Labels are on top of the scene and their glyphs are blended, so draw() expects exactly blending to be enabled.
+    static constexpr RenderFeatures Features = RenderFeature::BLENDING;
+
+    /// @p glyphs is the texture @p atlas describes, it has to outlive the renderer.
+    explicit LabelRenderer(GpuResources& resources, const GlyphAtlas& atlas, GL::Texture2D& glyphs);
+
+    LabelRenderer(const LabelRenderer&)            = delete;
+    LabelRenderer& operator=(const LabelRenderer&) = delete;
+
+    /**
+     * Lays out @p labels as seen through @p transformationProjection and draws them into the currently bound
+     * framebuffer, whose viewport is @p viewportSize pixels. @p scale scales the glyphs, e.g. for panes rendering at a
+     * lower resolution than they are shown at.
+     */
+    void draw(const std::vector<Label>& labels, const Matrix4& transformationProjection, const Vector2i& viewportSize,
+              Float scale = 1.0f);
+
+    const GlyphAtlas& atlas() const { return atlas_; }
+    /// Layout of the last draw().
+    const LabelInstances& instances() const { return instances_; }
+    /// Number of draw calls issued so far.
+    std::size_t drawCallCount() const { return drawCallCount_; }
+
+private:
+    Resource<LabelShader> shader_;
+    GlyphAtlas            atlas_;
+    GL::Texture2D&        glyphs_;
+    LabelInstances        instances_;
+    StreamBuffer*         stream_; ///< Null if the instances go to instanceBuffer_, see GpuResources::instanceStream().
+    GL::Buffer            instanceBuffer_;
+    GL::Mesh              mesh_;
+    std::size_t           drawCallCount_{0};
+};
+
+#endif // RENDER_LABELRENDERER_H
@@ -0,0 +1,34 @@
+#include "LayoutOverlay.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/Primitives/Square.h>
+#include <Magnum/Trade/MeshData.h>
+
+LayoutOverlay::LayoutOverlay(GpuResources& resources)
+: shader_{resources.flat2D(Shaders::FlatGL2D::Flag::VertexColor | Shaders::FlatGL2D::Flag::InstancedTransformation)}
+{
+    /* Not shared through the cache, the instance buffer is attached to the mesh */
+    mesh_ = MeshTools::compile(Primitives::squareSolid());
+    mesh_.addVertexBufferInstanced(instanceBuffer_, 1, 0, Shaders::FlatGL2D::TransformationMatrix{},
+                                   Shaders::FlatGL2D::Color4{});
+}
+
+void LayoutOverlay::draw(const OverlayInstances& instances)
+{
+    if (instances.instances().empty())
+        return;
+
+    if (instances.instances() != uploaded_)
+    {
+        uploaded_ = instances.instances();
+        instanceBuffer_.setData(Containers::arrayView(uploaded_.data(), uploaded_.size()),
+                                GL::BufferUsage::DynamicDraw);
+        ++uploadCount_;
+    }
+    mesh_.setInstanceCount(Int(uploaded_.size()));
+
+    shader_->draw(mesh_);
+
+    ++drawCallCount_;
+}
@@ -0,0 +1,43 @@
+#ifndef RENDER_LAYOUTOVERLAY_H
+#define RENDER_LAYOUTOVERLAY_H
+
+#include "GpuResources.h"
+#include "OverlayInstances.h"
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+
+using namespace Magnum;
+
+/**
+ * Draws the pane borders and the split edge highlights on top of the composited panes.
+ *
+ * All the rectangles are instances of a single unit square, so the whole overlay is one instanced draw call regardless
+ * of the number of panes. The instance buffer is only re-uploaded when the layout or the highlights change.
+ */
+class LayoutOverlay
+{
+public:
+    explicit LayoutOverlay(GpuResources& resources);
+
+    /**
+     * Draws @p instances into the currently bound framebuffer. The overlay is flat and always on top, so depth test is
+     * expected to be disabled.
+     */
+    void draw(const OverlayInstances& instances);
+
+    /// Number of draw calls issued so far.
+    std::size_t drawCallCount() const { return drawCallCount_; }
+    /// Number of times the instance buffer was uploaded.
+    std::size_t uploadCount() const { return uploadCount_; }
+
+private:
+    Resource<Shaders::FlatGL2D>             shader_;
+    GL::Buffer                              instanceBuffer_;
+    GL::Mesh                                mesh_;
+    std::vector<OverlayInstances::Instance> uploaded_;
+    std::size_t                             drawCallCount_{0};
+    std::size_t                             uploadCount_{0};
+};
+
+#endif // RENDER_LAYOUTOVERLAY_H
@@ -0,0 +1,63 @@
+#include "MultiViewRenderer.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/Math/Frustum.h>
+#include <algorithm>
+
+MultiViewRenderer::MultiViewRenderer(ProgramBinaryCache* const cache)
+: lineShader_{MultiViewFlatShader::Primitive::LINES, cache}
+, triangleShader_{MultiViewFlatShader::Primitive::TRIANGLES, cache}
+{
+}
+
+TransformCache::CullingStats MultiViewRenderer::draw(GL::AbstractFramebuffer& framebuffer,
+                                                     const TransformCache& frame, const std::vector<View>& views)
+{
+    passCount_        = 0;
+    unsupportedCount_ = 0;
+
+    MultiViewShaders             shaders{lineShader_, triangleShader_};
+    TransformCache::CullingStats stats;
+    for (std::size_t first = 0; first < views.size(); first += MultiViewFlatShader::MaxViews)
+    {
+        const std::size_t count = std::min<std::size_t>(views.size() - first, MultiViewFlatShader::MaxViews);
+
+        Float                viewports[MultiViewFlatShader::MaxViews * 4];
+        Matrix4              viewProjections[MultiViewFlatShader::MaxViews];
+        std::vector<Frustum> frusta;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            const View& view = views[first + i];
+            viewports[i * 4 + 0] = Float(view.viewport.left());
+            viewports[i * 4 + 1] = Float(view.viewport.bottom());
+            viewports[i * 4 + 2] = Float(view.viewport.sizeX());
+            viewports[i * 4 + 3] = Float(view.viewport.sizeY());
+            viewProjections[i]   = view.projectionMatrix * view.cameraMatrix;
+            frusta.push_back(Frustum::fromMatrix(viewProjections[i]));
+        }
+
+        /* Magnum doesn't wrap viewport arrays */
+        glViewportArrayv(0, GLsizei(count), viewports);
+        lineShader_.setViewProjectionMatrices({viewProjections, count});
+        triangleShader_.setViewProjectionMatrices({viewProjections, count});
+
+        const auto passStats = frame.forEachVisible(frusta,
+                                                    [&](SceneDrawable& drawable)
+                                                    {
+                                                        if (!drawable.drawMultiView(drawable.worldTransformation(),
+                                                                                    shaders))
+                                                            ++unsupportedCount_;
+                                                    });
+        stats.drawn += passStats.drawn;
+        stats.culled += passStats.culled;
+        ++passCount_;
+    }
+
+    /* ... and tracks the viewport of the bound framebuffer itself, so put back what it expects */
+    const Range2Di viewport = framebuffer.viewport();
+    glViewportIndexedf(0, Float(viewport.left()), Float(viewport.bottom()), Float(viewport.sizeX()),
+                       Float(viewport.sizeY()));
+
+    return stats;
+}
@@ -0,0 +1,50 @@
+#ifndef RENDER_MULTIVIEWRENDERER_H
+#define RENDER_MULTIVIEWRENDERER_H
+
+#include "../shaders/MultiViewFlatShader.h"
+#include "TransformCache.h"
+
+#include <Magnum/GL/AbstractFramebuffer.h>
+#include <Magnum/Math/Range.h>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Renders the scene into several viewports of one framebuffer, submitting every drawable once per MaxViews views.
+ *
+ * Drawables take part by implementing SceneDrawable::drawMultiView(), the ones that don't are skipped and counted in
+ * unsupportedCount().
+ */
+class MultiViewRenderer
+{
+public:
+    struct View
+    {
+        Range2Di viewport; ///< In framebuffer pixels.
+        Matrix4  projectionMatrix;
+        Matrix4  cameraMatrix;
+    };
+
+    static bool isSupported() { return MultiViewFlatShader::isSupported(); }
+
+    /// The shaders are loaded from @p cache if it isn't null, see ProgramBinaryCache.
+    explicit MultiViewRenderer(ProgramBinaryCache* cache = nullptr);
+
+    /// Draws @p frame into @p views of @p framebuffer, which has to be bound. Culls against all the view frustums.
+    TransformCache::CullingStats draw(GL::AbstractFramebuffer& framebuffer, const TransformCache& frame,
+                                      const std::vector<View>& views);
+
+    /// Number of passes over the drawables issued by the last draw().
+    std::size_t passCount() const { return passCount_; }
+    /// Number of drawables the last draw() skipped because they can't be drawn into several views.
+    std::size_t unsupportedCount() const { return unsupportedCount_; }
+
+private:
+    MultiViewFlatShader lineShader_;
+    MultiViewFlatShader triangleShader_;
+    std::size_t         passCount_{0};
+    std::size_t         unsupportedCount_{0};
+};
+
+#endif // RENDER_MULTIVIEWRENDERER_H
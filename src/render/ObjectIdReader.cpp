@@ -0,0 +1,77 @@
+#include "ObjectIdReader.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <limits>
+#include <utility>
+
+ObjectIdReader::ObjectIdReader()
+: image_(GL::PixelFormat::RedInteger, GL::PixelType::UnsignedInt)
+{
+}
+
+void ObjectIdReader::pick(GL::Framebuffer& framebuffer, const Vector2i& position)
+{
+    result_ = std::nullopt;
+
+    const Range2Di block = Math::intersect(Range2Di::fromSize(position, Vector2i{1}).padded(Vector2i{WindowRadius}),
+                                           framebuffer.viewport());
+    if (block.sizeX() <= 0 || block.sizeY() <= 0)
+    {
+        result_ = 0;
+        return;
+    }
+
+    /* RenderTarget attaches the object IDs where Magnum's shaders write them, see RenderTarget */
+    framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{Shaders::FlatGL3D::ObjectIdOutput});
+    framebuffer.read(block, image_, GL::BufferUsage::StreamRead);
+    framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{Shaders::FlatGL3D::ColorOutput});
+    fence_.insert();
+
+    pending_         = true;
+    pendingPosition_ = position;
+    pendingRange_    = block;
+    ++readbackCount_;
+}
+
+void ObjectIdReader::update()
+{
+    if (!pending_ || !fence_.isSignaled())
+        return;
+
+    fence_.reset();
+    pending_ = false;
+
+    /* 4 bytes per pixel, so the rows are tightly packed with the default alignment */
+    const Containers::Array<char>                  data = image_.buffer().data();
+    const Containers::ArrayView<const UnsignedInt> ids =
+        Containers::arrayCast<const UnsignedInt>(Containers::arrayView(data));
+
+    UnsignedInt id       = 0;
+    Int         distance = std::numeric_limits<Int>::max();
+    const Int   stride   = pendingRange_.sizeX();
+    for (Int y = pendingRange_.bottom(); y != pendingRange_.top(); ++y)
+        for (Int x = pendingRange_.left(); x != pendingRange_.right(); ++x)
+        {
+            const UnsignedInt candidate =
+                ids[std::size_t((y - pendingRange_.bottom()) * stride + x - pendingRange_.left())];
+            const Int d = (Vector2i{x, y} - pendingPosition_).dot();
+            if (candidate && d < distance)
+            {
+                id       = candidate;
+                distance = d;
+            }
+        }
+
+    result_ = id;
+}
+
+std::optional<UnsignedInt> ObjectIdReader::takeResult()
+{
+    return std::exchange(result_, std::nullopt);
+}
@@ -0,0 +1,58 @@
+#ifndef RENDER_OBJECTIDREADER_H
+#define RENDER_OBJECTIDREADER_H
+
+#include "Fence.h"
+
+#include <Magnum/GL/BufferImage.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/Math/Range.h>
+#include <optional>
+
+using namespace Magnum;
+
+/**
+ * Asynchronous picking from the object ID buffer of a RenderTarget through a pixel buffer object.
+ *
+ * Works like DepthReader: pick() copies a small window of object IDs around the position into a PBO guarded by a
+ * fence, and update() collects it once the GPU is done, usually a frame later. The IDs are resolved to drawables with
+ * a PickingRegistry. Unlike depth queries, picks are rare discrete events, so nothing is cached.
+ */
+class ObjectIdReader
+{
+public:
+    explicit ObjectIdReader();
+
+    /**
+     * Schedules a readback of the object IDs around @p position (in framebuffer pixels, bottom-left origin) from the
+     * object ID attachment of @p framebuffer, which has to be a resolved RenderTarget framebuffer. Replaces a pick
+     * that is still pending.
+     */
+    void pick(GL::Framebuffer& framebuffer, const Vector2i& position);
+
+    /// Collects a finished readback. Call once per frame; never blocks.
+    void update();
+
+    /**
+     * Object ID picked by the last pick(), once it is available. Zero if nothing was hit. Returns it only once.
+     *
+     * Lines and points are hard to hit exactly, so the nearest non-zero ID in a 5x5 window wins.
+     */
+    std::optional<UnsignedInt> takeResult();
+
+    bool isPending() const { return pending_; }
+
+    std::size_t readbackCount() const { return readbackCount_; }
+
+private:
+    static constexpr Int WindowRadius = 2;
+
+    GL::BufferImage2D          image_;
+    Fence                      fence_;
+    bool                       pending_{false};
+    Vector2i                   pendingPosition_;
+    Range2Di                   pendingRange_;
+    std::optional<UnsignedInt> result_;
+    std::size_t                readbackCount_{0};
+};
+
+#endif // RENDER_OBJECTIDREADER_H
@@ -0,0 +1,53 @@
+#include "OverlayInstances.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+
+OverlayInstances::OverlayInstances(const Vector2i& windowSize)
+: windowSize_(windowSize)
+{
+    CORRADE_INTERNAL_ASSERT((windowSize_ > Vector2i{0}).all());
+}
+
+void OverlayInstances::clear()
+{
+    instances_.clear();
+}
+
+void OverlayInstances::clear(const Vector2i& windowSize)
+{
+    CORRADE_INTERNAL_ASSERT((windowSize > Vector2i{0}).all());
+
+    windowSize_ = windowSize;
+    instances_.clear();
+}
+
+OverlayInstances& OverlayInstances::addRectangle(const Range2D& rectangle, const Color4& color)
+{
+    /* The unit square spans [-1, 1], so its half size maps to the size of the rectangle in clip space. Window Y points
+       down, clip space Y up. */
+    const Vector2 scale  = 2.0f / Vector2{windowSize_};
+    const Vector2 center = rectangle.center() * scale - Vector2{1.0f};
+    const Vector2 size   = rectangle.size() * scale / 2.0f;
+
+    instances_.push_back({Matrix3::translation({center.x(), -center.y()}) * Matrix3::scaling(size), color});
+    return *this;
+}
+
+OverlayInstances& OverlayInstances::addBorder(const Range2D& rectangle, const Color4& color, const Float thickness)
+{
+    const Float t = Math::min(thickness, rectangle.size().min() / 2.0f);
+
+    addRectangle({rectangle.min(), {rectangle.max().x(), rectangle.min().y() + t}}, color);
+    addRectangle({{rectangle.min().x(), rectangle.max().y() - t}, rectangle.max()}, color);
+    addRectangle({{rectangle.min().x(), rectangle.min().y() + t}, {rectangle.min().x() + t, rectangle.max().y() - t}},
+                 color);
+    addRectangle({{rectangle.max().x() - t, rectangle.min().y() + t}, {rectangle.max().x(), rectangle.max().y() - t}},
+                 color);
+    return *this;
+}
+
+OverlayInstances& OverlayInstances::addEdge(const Range2D& edge, const Color4& color, const Float thickness)
+{
+    return addRectangle(edge.padded(Vector2{thickness / 2.0f}), color);
+}
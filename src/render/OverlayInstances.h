@@ -0,0 +1,54 @@
+#ifndef RENDER_OVERLAYINSTANCES_H
+#define RENDER_OVERLAYINSTANCES_H
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Range.h>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Per-instance data of the layout overlay: every rectangle (a side of a pane border, an edge highlight, ...) is one
+ * instance of a unit square, transformed into clip space.
+ *
+ * Rectangles are given in window coordinates (origin at the top left), like the pane viewports. Building the
+ * instances doesn't touch the GPU, LayoutOverlay uploads and draws them in one call.
+ */
+class OverlayInstances
+{
+public:
+    struct Instance
+    {
+        Matrix3 transformationMatrix;
+        Color4  color;
+
+        bool operator==(const Instance&) const = default;
+    };
+
+    explicit OverlayInstances(const Vector2i& windowSize = {1, 1});
+
+    /// Removes all the instances. The window size is only changed if given.
+    void clear();
+    void clear(const Vector2i& windowSize);
+
+    /// Filled rectangle.
+    OverlayInstances& addRectangle(const Range2D& rectangle, const Color4& color);
+
+    /// Outline along the inside of @p rectangle, as four rectangles.
+    OverlayInstances& addBorder(const Range2D& rectangle, const Color4& color, Float thickness = 1.0f);
+
+    /// Line segment (a degenerate range) widened to @p thickness.
+    OverlayInstances& addEdge(const Range2D& edge, const Color4& color, Float thickness);
+
+    const std::vector<Instance>& instances() const { return instances_; }
+    std::size_t                  size() const { return instances_.size(); }
+    Vector2i                     windowSize() const { return windowSize_; }
+
+private:
+    Vector2i              windowSize_;
+    std::vector<Instance> instances_;
+};
+
+#endif // RENDER_OVERLAYINSTANCES_H
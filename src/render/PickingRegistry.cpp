@@ -0,0 +1,35 @@
+#include "PickingRegistry.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <limits>
+
+UnsignedInt PickingRegistry::add(SceneDrawable& drawable, const UnsignedInt count)
+{
+    CORRADE_INTERNAL_ASSERT(count > 0 && count <= std::numeric_limits<UnsignedInt>::max() - next_);
+
+    const UnsignedInt base = next_;
+    ranges_.emplace(base, Range{&drawable, count});
+    next_ += count;
+    return base;
+}
+
+void PickingRegistry::remove(const UnsignedInt base)
+{
+    const auto removed = ranges_.erase(base);
+    CORRADE_INTERNAL_ASSERT(removed == 1);
+}
+
+std::optional<PickingRegistry::Hit> PickingRegistry::find(const UnsignedInt id) const
+{
+    /* The range containing the ID is the last one starting at or before it */
+    auto found = ranges_.upper_bound(id);
+    if (found == ranges_.begin())
+        return std::nullopt;
+    --found;
+
+    const UnsignedInt index = id - found->first;
+    if (index >= found->second.count)
+        return std::nullopt;
+
+    return Hit{found->second.drawable, index};
+}
@@ -0,0 +1,50 @@
+#ifndef RENDER_PICKINGREGISTRY_H
+#define RENDER_PICKINGREGISTRY_H
+
+#include <Magnum/Magnum.h>
+#include <map>
+#include <optional>
+
+using namespace Magnum;
+
+class SceneDrawable;
+
+/**
+ * Hands out the object IDs drawables write into the object ID buffer of a RenderTarget and maps picked IDs back.
+ *
+ * Every drawable gets a contiguous range of IDs, one per pickable element (primitive, point, instance, ...), and adds
+ * the element index to the base ID of its range when drawing. A picked ID then resolves to the drawable and the element
+ * index. ID 0 is what the object ID buffer is cleared to and is never handed out.
+ */
+class PickingRegistry
+{
+public:
+    struct Hit
+    {
+        SceneDrawable* drawable;
+        UnsignedInt    index; ///< Element of the drawable, i.e. picked ID minus the base ID.
+    };
+
+    /// Reserves @p count consecutive IDs for @p drawable and returns the first one.
+    UnsignedInt add(SceneDrawable& drawable, UnsignedInt count = 1);
+
+    /// Releases the range starting at @p base. The IDs are not reused, so stale picks don't resolve to a new drawable.
+    void remove(UnsignedInt base);
+
+    std::optional<Hit> find(UnsignedInt id) const;
+
+    /// Registered ranges.
+    std::size_t size() const { return ranges_.size(); }
+
+private:
+    struct Range
+    {
+        SceneDrawable* drawable;
+        UnsignedInt    count;
+    };
+
+    std::map<UnsignedInt, Range> ranges_; ///< Keyed by the base ID.
+    UnsignedInt                  next_{1};
+};
+
+#endif // RENDER_PICKINGREGISTRY_H
@@ -0,0 +1,108 @@
+#include "Playhead.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <algorithm>
+#include <cmath>
+
+Playhead::Playhead(const std::size_t frameCount, const Float framesPerSecond)
+: frameCount_(frameCount)
+{
+    CORRADE_INTERNAL_ASSERT(frameCount_ != 0);
+    setFramesPerSecond(framesPerSecond);
+}
+
+void Playhead::play()
+{
+    // Played to the end, playing again starts over
+    if (!looping_ && !frameAt(direction_ == Direction::FORWARD ? 1 : -1))
+        frame_ = direction_ == Direction::FORWARD ? 0 : frameCount_ - 1;
+
+    playing_ = true;
+    due_     = {};
+}
+
+void Playhead::setFramesPerSecond(const Float framesPerSecond)
+{
+    CORRADE_INTERNAL_ASSERT(framesPerSecond > 0.0f);
+    framesPerSecond_ = framesPerSecond;
+}
+
+void Playhead::seek(const std::size_t frame)
+{
+    frame_ = std::min(frame, frameCount_ - 1);
+    due_   = {};
+}
+
+std::optional<std::size_t> Playhead::frameAt(const Int offset) const
+{
+    const long long count  = static_cast<long long>(frameCount_);
+    const long long target = static_cast<long long>(frame_) + offset;
+    if (looping_)
+        return std::size_t(((target % count) + count) % count);
+    if (target < 0 || target >= count)
+        return std::nullopt;
+    return std::size_t(target);
+}
+
+std::chrono::nanoseconds Playhead::frameDuration() const
+{
+    return std::chrono::nanoseconds{std::llround(1.0e9 / double(framesPerSecond_))};
+}
+
+std::size_t Playhead::advance(const std::chrono::nanoseconds elapsed, const std::function<bool(std::size_t)>& isReady)
+{
+    if (!playing_)
+        return 0;
+
+    const std::chrono::nanoseconds duration = frameDuration();
+    const Int                      step     = direction_ == Direction::FORWARD ? 1 : -1;
+
+    due_ += elapsed;
+    std::size_t moved = 0;
+    while (due_ >= duration)
+    {
+        const std::optional<std::size_t> next = frameAt(step);
+        if (!next)
+        {
+            playing_ = false;
+            due_     = {};
+            break;
+        }
+
+        // Waiting doesn't build up a debt, once the frame is there playback goes on at the normal rate
+        if (!isReady(*next))
+        {
+            ++stallCount_;
+            due_ = duration;
+            break;
+        }
+
+        frame_ = *next;
+        due_ -= duration;
+        ++moved;
+    }
+
+    return moved;
+}
+
+void Playhead::prefetchOrder(const std::size_t ahead, const std::size_t behind, std::vector<std::size_t>& frames) const
+{
+    frames.clear();
+    frames.push_back(frame_);
+
+    // In a sequence shorter than the window, looping would come back to the frames listed already
+    const auto addFrames = [&](const std::size_t count, const Int step)
+    {
+        for (std::size_t i = 1; i <= count; ++i)
+        {
+            const std::optional<std::size_t> frame = frameAt(Int(i) * step);
+            if (!frame || std::find(frames.begin(), frames.end(), *frame) != frames.end())
+                return;
+            frames.push_back(*frame);
+        }
+    };
+
+    const Int step = direction_ == Direction::FORWARD ? 1 : -1;
+    addFrames(ahead, step);
+    addFrames(behind, -step);
+}
@@ -0,0 +1,83 @@
+#ifndef RENDER_PLAYHEAD_H
+#define RENDER_PLAYHEAD_H
+
+#include <Magnum/Magnum.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Position in a sequence of frames played back at a fixed rate, forward or backward.
+ *
+ * The playhead only moves on to a frame that is ready to be shown. If it isn't, playback holds the current frame
+ * instead of skipping it and counts a stall, so a recording is reviewed frame by frame even when decoding falls behind.
+ */
+class Playhead
+{
+public:
+    enum class Direction : uint8_t
+    {
+        FORWARD,
+        BACKWARD
+    };
+
+    explicit Playhead(std::size_t frameCount, Float framesPerSecond = 30.0f);
+
+    void play();
+    void pause() { playing_ = false; }
+    bool isPlaying() const { return playing_; }
+
+    void      setDirection(Direction direction) { direction_ = direction; }
+    Direction direction() const { return direction_; }
+
+    /// Whether playback wraps around at the ends of the sequence instead of stopping there.
+    void setLooping(bool looping) { looping_ = looping; }
+    bool isLooping() const { return looping_; }
+
+    void  setFramesPerSecond(Float framesPerSecond);
+    Float framesPerSecond() const { return framesPerSecond_; }
+
+    /// Jumps to @p frame, clamped to the sequence, without waiting for it to be ready.
+    void seek(std::size_t frame);
+
+    /**
+     * Frame @p offset frames away from the current one, wrapping around if looping. Empty past the ends of the sequence
+     * otherwise.
+     */
+    std::optional<std::size_t> frameAt(Int offset) const;
+
+    /**
+     * Moves on by the frames due after @p elapsed, one at a time and only while @p isReady says the next one can be
+     * shown. Stops playing at the end of the sequence unless looping. Returns how many frames it moved.
+     */
+    std::size_t advance(std::chrono::nanoseconds elapsed, const std::function<bool(std::size_t)>& isReady);
+
+    /**
+     * Frames worth having at hand, most urgent first: the current one, then up to @p ahead in the playback direction
+     * and up to @p behind in the other one, each nearest first. No frame is listed twice.
+     */
+    void prefetchOrder(std::size_t ahead, std::size_t behind, std::vector<std::size_t>& frames) const;
+
+    std::size_t frame() const { return frame_; }
+    std::size_t frameCount() const { return frameCount_; }
+    /// Times advance() held a frame because the next one wasn't ready.
+    std::size_t stallCount() const { return stallCount_; }
+
+private:
+    std::chrono::nanoseconds frameDuration() const;
+
+    std::size_t              frameCount_;
+    std::size_t              frame_{0};
+    Float                    framesPerSecond_;
+    Direction                direction_{Direction::FORWARD};
+    bool                     playing_{false};
+    bool                     looping_{true};
+    std::chrono::nanoseconds due_{0}; ///< Playback time not spent on frames yet.
+    std::size_t              stallCount_{0};
+};
+
+#endif // RENDER_PLAYHEAD_H
@@ -0,0 +1,169 @@
+#include "PointOctree.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Frustum.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Intersection.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+PointOctree::PointOctree(const Containers::StridedArrayView1D<const Vector3> positions, const std::size_t nodeCapacity)
+: nodeCapacity_(nodeCapacity)
+, indices_(positions.size())
+{
+    CORRADE_INTERNAL_ASSERT(nodeCapacity_ != 0 && positions.size() <= std::size_t{~UnsignedInt{}});
+
+    Vector3 min{Constants::inf()};
+    Vector3 max{-Constants::inf()};
+    for (const Vector3& position : positions)
+    {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+
+    // Cubic nodes keep the subsampling grid uniform. Padded so that the points on the max faces are inside.
+    Range3D bounds;
+    if (!positions.isEmpty())
+    {
+        const Float size = Math::max((max - min).max(), 1.0e-6f) * 1.001f;
+        bounds           = Range3D::fromCenter((min + max) * 0.5f, Vector3{size * 0.5f});
+    }
+
+    std::iota(indices_.begin(), indices_.end(), 0u);
+    nodes_.push_back(Node{bounds, 0, 0, 0, {}});
+    nodes_.back().children.fill(-1);
+    build(0, indices_.size(), positions);
+}
+
+Containers::ArrayView<const UnsignedInt> PointOctree::indices(const std::size_t node) const
+{
+    CORRADE_INTERNAL_ASSERT(node < nodes_.size());
+    return {indices_.data() + nodes_[node].first, nodes_[node].count};
+}
+
+void PointOctree::build(const UnsignedInt node, const std::size_t count,
+                        const Containers::StridedArrayView1D<const Vector3>& positions)
+{
+    /* The nodes vector grows during the recursion, so nodes are only referenced by index. The indices don't move. */
+    const Range3D      bounds = nodes_[node].bounds;
+    const UnsignedInt  depth  = nodes_[node].depth;
+    UnsignedInt* const first  = indices_.data() + nodes_[node].first;
+    UnsignedInt* const last   = first + count;
+
+    // Nodes that got as small as the float precision allows can't be split either
+    if (count <= nodeCapacity_ || depth == MaxDepth || !(bounds.size() > Vector3{0.0f}).all())
+    {
+        nodes_[node].count = count;
+        return;
+    }
+
+    /* The first point in every cell of a grid over the node stays in it and is swapped to the front, the others go
+       down to the children */
+    const Int         grid = Math::max(Int(std::cbrt(Float(nodeCapacity_))), 1);
+    const Vector3     cellsPerUnit{Float(grid) / bounds.size()};
+    std::vector<bool> occupied(std::size_t(grid) * grid * grid);
+    UnsignedInt*      kept = first;
+    for (UnsignedInt* i = first; i != last; ++i)
+    {
+        const Vector3i    cell  = Math::clamp(Vector3i{(positions[*i] - bounds.min()) * cellsPerUnit}, 0, grid - 1);
+        const std::size_t index = (std::size_t(cell.z()) * grid + cell.y()) * grid + cell.x();
+        if (occupied[index])
+            continue;
+
+        occupied[index] = true;
+        std::swap(*i, *kept++);
+    }
+    nodes_[node].count = std::size_t(kept - first);
+
+    /* The rest is partitioned in place by octant, halving the ranges by Z, then Y, then X */
+    const Vector3 center   = bounds.center();
+    const auto    octantOf = [&](const UnsignedInt index)
+    {
+        const Vector3& position = positions[index];
+        return UnsignedInt((position.x() >= center.x() ? 1 : 0) | (position.y() >= center.y() ? 2 : 0) |
+                           (position.z() >= center.z() ? 4 : 0));
+    };
+    std::array<UnsignedInt*, 9> octants;
+    octants[0] = kept;
+    octants[8] = last;
+    for (UnsignedInt step = 4; step != 0; step /= 2)
+        for (UnsignedInt octant = 0; octant != 8; octant += 2 * step)
+            octants[octant + step] = std::partition(octants[octant], octants[octant + 2 * step],
+                                                    [&](const UnsignedInt index)
+                                                    { return octantOf(index) < octant + step; });
+
+    for (UnsignedInt octant = 0; octant != 8; ++octant)
+    {
+        if (octants[octant] == octants[octant + 1])
+            continue;
+
+        // Split exactly at the center, so that the points are inside the octant they were sorted into
+        const Vector3 min{octant & 1 ? center.x() : bounds.min().x(), octant & 2 ? center.y() : bounds.min().y(),
+                          octant & 4 ? center.z() : bounds.min().z()};
+        const Vector3 max{octant & 1 ? bounds.max().x() : center.x(), octant & 2 ? bounds.max().y() : center.y(),
+                          octant & 4 ? bounds.max().z() : center.z()};
+        const auto    child = UnsignedInt(nodes_.size());
+        nodes_.push_back(Node{{min, max}, std::size_t(octants[octant] - indices_.data()), 0, depth + 1, {}});
+        nodes_.back().children.fill(-1);
+        nodes_[node].children[octant] = Int(child);
+
+        build(child, std::size_t(octants[octant + 1] - octants[octant]), positions);
+    }
+}
+
+Float PointOctree::projectedSize(const Node& node, const Matrix4& transformation, const Matrix4& projection,
+                                 const Float viewportHeight) const
+{
+    const Float radius   = node.bounds.size().length() * 0.5f * transformation.scaling().max();
+    const Float distance = transformation.transformPoint(node.bounds.center()).length();
+
+    // The camera is inside the bounding sphere of the node, which is thus as large as it gets
+    if (distance <= radius)
+        return Constants::inf();
+
+    return radius / distance * projection[1][1] * viewportHeight * 0.5f;
+}
+
+std::size_t PointOctree::select(const Matrix4& transformation, const Matrix4& projection, const Float viewportHeight,
+                                const std::size_t pointBudget, std::vector<UnsignedInt>& nodes,
+                                const Float minProjectedSize) const
+{
+    nodes.clear();
+
+    const Frustum frustum = Frustum::fromMatrix(projection * transformation);
+
+    /* Largest node on screen first */
+    std::priority_queue<std::pair<Float, UnsignedInt>> candidates;
+    const auto push = [&](const UnsignedInt index, const Float minSize)
+    {
+        const Node& node = nodes_[index];
+        if (!Math::Intersection::rangeFrustum(node.bounds, frustum))
+            return;
+
+        const Float size = projectedSize(node, transformation, projection, viewportHeight);
+        if (size >= minSize)
+            candidates.emplace(size, index);
+    };
+    push(0, -Constants::inf());
+
+    std::size_t count = 0;
+    while (!candidates.empty())
+    {
+        const Node& node = nodes_[candidates.top().second];
+        if (count + node.count > pointBudget)
+            break;
+
+        nodes.push_back(candidates.top().second);
+        count += node.count;
+        candidates.pop();
+
+        for (const Int child : node.children)
+            if (child != -1)
+                push(UnsignedInt(child), minProjectedSize);
+    }
+
+    return count;
+}
@@ -0,0 +1,76 @@
+#ifndef RENDER_POINTOCTREE_H
+#define RENDER_POINTOCTREE_H
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+#include <array>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Level-of-detail octree over a point cloud, for drawing clouds much larger than what fits a frame.
+ *
+ * Every node holds a spatially uniform subsample of at most nodeCapacity() of the points inside its cube, and its
+ * children hold the remaining ones, so drawing a node and any subset of its descendants never draws a point twice and
+ * each level adds detail to the one above. The points themselves aren't copied, e.g. out of a memory-mapped file; the
+ * octree holds their indices, ordered so that the ones of every node are contiguous. select() picks the nodes to draw
+ * for a camera, largest on screen first, until a point budget is used up. Doesn't touch the GPU, see PointCloud for
+ * drawing.
+ */
+class PointOctree
+{
+public:
+    struct Node
+    {
+        Range3D            bounds; ///< Cube the node covers.
+        std::size_t        first;  ///< Index of the first point of the node in indices().
+        std::size_t        count;
+        UnsignedInt        depth;
+        std::array<Int, 8> children; ///< Indices into nodes(), -1 for octants without points.
+    };
+
+    /// Points of a node are subsampled on a grid with about this many cells.
+    static constexpr std::size_t DefaultNodeCapacity = 8192;
+    /// Nodes at this depth keep all their points, e.g. if there are many duplicates.
+    static constexpr UnsignedInt MaxDepth = 20;
+
+    /// Only reads @p positions while it's built, they aren't referenced afterwards.
+    explicit PointOctree(Containers::StridedArrayView1D<const Vector3> positions,
+                         std::size_t                                   nodeCapacity = DefaultNodeCapacity);
+
+    /// The root is the first one, children come after their parent.
+    const std::vector<Node>& nodes() const { return nodes_; }
+    /// Indices of all the points into the positions the octree was built from, node by node.
+    const std::vector<UnsignedInt>&          indices() const { return indices_; }
+    Containers::ArrayView<const UnsignedInt> indices(std::size_t node) const;
+    std::size_t                              nodeCapacity() const { return nodeCapacity_; }
+
+    /**
+     * Picks the nodes to draw through a camera, in order of decreasing projected size, until adding the next one
+     * would exceed @p pointBudget points. @p transformation goes from the octree to the camera and @p projection is
+     * the camera projection for a viewport of @p viewportHeight pixels. Nodes outside of the frustum are skipped with
+     * their subtrees, and so are nodes smaller than @p minProjectedSize pixels except for the root. A node is only
+     * picked after its parent, so every level of detail is complete with the levels above it. Returns the number of
+     * points of the picked nodes.
+     */
+    std::size_t select(const Matrix4& transformation, const Matrix4& projection, Float viewportHeight,
+                       std::size_t pointBudget, std::vector<UnsignedInt>& nodes, Float minProjectedSize = 32.0f) const;
+
+    /// Size of the node in pixels, as select() estimates it.
+    Float projectedSize(const Node& node, const Matrix4& transformation, const Matrix4& projection,
+                        Float viewportHeight) const;
+
+private:
+    std::size_t              nodeCapacity_;
+    std::vector<Node>        nodes_;
+    std::vector<UnsignedInt> indices_;
+
+    /// Builds @p node out of the points whose indices are in indices_ from its first onwards, @p count of them.
+    void build(UnsignedInt node, std::size_t count, const Containers::StridedArrayView1D<const Vector3>& positions);
+};
+
+#endif // RENDER_POINTOCTREE_H
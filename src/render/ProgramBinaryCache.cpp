@@ -0,0 +1,134 @@
+#include "ProgramBinaryCache.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/OpenGL.h>
+#include <cstring>
+
+namespace
+{
+
+constexpr Containers::StringView Magic = "cvdev program binary 1\n";
+
+/* FNV-1a, stable across runs and platforms unlike std::hash */
+UnsignedLong hash(const Containers::StringView data, UnsignedLong value = 14695981039346656037ull)
+{
+    for (const char c : data)
+    {
+        value ^= UnsignedByte(c);
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+} // namespace
+
+bool ProgramBinaryCache::isSupported()
+{
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::get_program_binary>();
+}
+
+ProgramBinaryCache::ProgramBinaryCache(const Containers::StringView directory, const Containers::StringView driver)
+: directory_(directory)
+{
+    if (driver.isEmpty())
+    {
+        GL::Context& context = GL::Context::current();
+        driver_ = Utility::format("{} | {} | {}", context.vendorString(), context.rendererString(),
+                                  context.versionString());
+    }
+    else
+        driver_ = driver;
+
+    if (!Utility::Path::make(directory_))
+        Warning{} << "ProgramBinaryCache: can't create" << directory_;
+}
+
+Containers::String ProgramBinaryCache::key(const Containers::StringView name,
+                                           const std::initializer_list<Containers::StringView> sources)
+{
+    UnsignedLong value = hash(name);
+    for (const Containers::StringView source : sources)
+        value = hash(source, value);
+    return Utility::format("{}:{:.16x}", name, value);
+}
+
+Containers::String ProgramBinaryCache::filename(const Containers::StringView key) const
+{
+    return Utility::Path::join(directory_, Utility::format("{:.16x}.bin", hash(key)));
+}
+
+Containers::String ProgramBinaryCache::header(const Containers::StringView key) const
+{
+    return Utility::format("{}{}\n{}\n", Magic, driver_, key);
+}
+
+bool ProgramBinaryCache::load(GL::AbstractShaderProgram& program, const Containers::StringView key)
+{
+    const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename(key));
+    if (!data)
+        return false;
+
+    /* The header is followed by the binary format and the binary */
+    const Containers::String expected = header(key);
+    if (data->size() <= expected.size() + sizeof(GLenum) ||
+        Containers::StringView{data->data(), expected.size()} != expected)
+    {
+        ++rejectedCount_;
+        return false;
+    }
+
+    GLenum format;
+    std::memcpy(&format, data->data() + expected.size(), sizeof(GLenum));
+    const Containers::ArrayView<const char> binary = data->exceptPrefix(expected.size() + sizeof(GLenum));
+
+    /* Magnum doesn't wrap program binaries. The driver may still refuse the binary, e.g. after an update that didn't
+       change the version string, in which case the program is compiled from source. */
+    glProgramBinary(program.id(), format, binary.data(), GLsizei(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program.id(), GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        ++rejectedCount_;
+        return false;
+    }
+
+    ++loadedCount_;
+    return true;
+}
+
+void ProgramBinaryCache::save(GL::AbstractShaderProgram& program, const Containers::StringView key)
+{
+    GLint size = 0;
+    glGetProgramiv(program.id(), GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0)
+        return;
+
+    const Containers::String          prefix = header(key);
+    Containers::Array<char>           data{Containers::NoInit, prefix.size() + sizeof(GLenum) + std::size_t(size)};
+    const Containers::ArrayView<char> binary = data.exceptPrefix(prefix.size() + sizeof(GLenum));
+
+    GLenum  format  = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program.id(), size, &written, &format, binary.data());
+    if (written != size)
+        return;
+
+    Utility::copy(Containers::arrayView(prefix.data(), prefix.size()), data.prefix(prefix.size()));
+    std::memcpy(data.data() + prefix.size(), &format, sizeof(GLenum));
+
+    if (!Utility::Path::write(filename(key), data))
+    {
+        Warning{} << "ProgramBinaryCache: can't write the binary for" << key;
+        return;
+    }
+
+    ++savedCount_;
+}
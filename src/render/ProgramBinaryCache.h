@@ -0,0 +1,64 @@
+#ifndef RENDER_PROGRAMBINARYCACHE_H
+#define RENDER_PROGRAMBINARYCACHE_H
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Magnum/GL/AbstractShaderProgram.h>
+#include <initializer_list>
+
+using namespace Magnum;
+
+/**
+ * Disk cache of linked shader program binaries (GL_ARB_get_program_binary, core in GL 4.1), so that shaders are only
+ * compiled from source the first time the application runs on a driver.
+ *
+ * A binary is stored per key, which names the shader configuration and hashes its sources, together with the vendor,
+ * renderer and version string of the driver that produced it. Binaries from another driver, unreadable files and
+ * binaries the driver refuses are rejected, and the program is compiled from source instead and stored again.
+ *
+ * Only programs the repo compiles itself can use it; Magnum's stock shaders compile in their constructors.
+ */
+class ProgramBinaryCache
+{
+public:
+    static bool isSupported();
+
+    /**
+     * Cache in @p directory, created if it doesn't exist. @p driver identifies the driver the binaries are valid for,
+     * by default the vendor, renderer and version string of the current context.
+     */
+    explicit ProgramBinaryCache(Containers::StringView directory, Containers::StringView driver = {});
+
+    /// Key of the program called @p name compiled from @p sources. Changes whenever one of the sources does.
+    static Containers::String key(Containers::StringView name, std::initializer_list<Containers::StringView> sources);
+
+    /**
+     * Loads the binary stored for @p key into @p program and returns whether it is linked now. Otherwise the program
+     * has to be compiled and linked from source, with a retrievable binary, and passed to save().
+     */
+    bool load(GL::AbstractShaderProgram& program, Containers::StringView key);
+
+    /// Stores the binary of the linked @p program for @p key. Failing to write the file only prints a warning.
+    void save(GL::AbstractShaderProgram& program, Containers::StringView key);
+
+    /// File the binary for @p key is stored in.
+    Containers::String filename(Containers::StringView key) const;
+
+    /// Programs loaded from the cache, i.e. cache hits.
+    std::size_t loadedCount() const { return loadedCount_; }
+    /// Programs stored after being compiled from source.
+    std::size_t savedCount() const { return savedCount_; }
+    /// Stored binaries that couldn't be used, e.g. because the driver was updated.
+    std::size_t rejectedCount() const { return rejectedCount_; }
+
+private:
+    Containers::String directory_;
+    Containers::String driver_;
+    std::size_t        loadedCount_{0};
+    std::size_t        savedCount_{0};
+    std::size_t        rejectedCount_{0};
+
+    Containers::String header(Containers::StringView key) const;
+};
+
+#endif // RENDER_PROGRAMBINARYCACHE_H
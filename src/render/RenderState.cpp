@@ -0,0 +1,65 @@
+#include "RenderState.h"
+
+#include <Magnum/GL/Renderer.h>
+
+namespace
+{
+
+GL::Renderer::Feature glFeature(const RenderFeature feature)
+{
+    switch (feature)
+    {
+        case RenderFeature::DEPTH_TEST:   return GL::Renderer::Feature::DepthTest;
+        case RenderFeature::FACE_CULLING: return GL::Renderer::Feature::FaceCulling;
+        case RenderFeature::BLENDING:     return GL::Renderer::Feature::Blending;
+        default:                          return GL::Renderer::Feature::ScissorTest;
+    }
+}
+
+} // namespace
+
+StateTracker::StateTracker(Apply apply, ApplyPointSize applyPointSize)
+: apply_(std::move(apply))
+, applyPointSize_(std::move(applyPointSize))
+{
+    if (!apply_)
+        apply_ = [](const RenderFeature feature, const bool enabled)
+        { GL::Renderer::setFeature(glFeature(feature), enabled); };
+    if (!applyPointSize_)
+        applyPointSize_ = [](const Float size) { GL::Renderer::setPointSize(size); };
+}
+
+void StateTracker::set(const RenderFeatures features)
+{
+    for (UnsignedInt i = 0; i != FeatureCount; ++i)
+    {
+        const auto feature = RenderFeature(1 << i);
+        const bool enabled = bool(features & feature);
+        if (known_ && bool(features_ & feature) == enabled)
+        {
+            ++skippedCount_;
+            continue;
+        }
+
+        apply_(feature, enabled);
+        ++changeCount_;
+    }
+
+    features_ = features;
+    known_    = true;
+}
+
+void StateTracker::setPointSize(const Float size)
+{
+    if (pointSizeKnown_ && pointSize_ == size)
+    {
+        ++skippedCount_;
+        return;
+    }
+
+    applyPointSize_(size);
+    ++changeCount_;
+
+    pointSize_      = size;
+    pointSizeKnown_ = true;
+}
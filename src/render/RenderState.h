@@ -0,0 +1,89 @@
+#ifndef RENDER_RENDERSTATE_H
+#define RENDER_RENDERSTATE_H
+
+#include <Corrade/Containers/EnumSet.h>
+#include <Magnum/Magnum.h>
+#include <cstdint>
+#include <functional>
+
+using namespace Magnum;
+
+/**
+ * Fixed-function features a draw can depend on. Everything not listed is expected to be disabled.
+ */
+enum class RenderFeature : uint8_t
+{
+    DEPTH_TEST   = 1 << 0,
+    FACE_CULLING = 1 << 1,
+    BLENDING     = 1 << 2,
+    SCISSOR_TEST = 1 << 3
+};
+
+using RenderFeatures = Containers::EnumSet<RenderFeature>;
+CORRADE_ENUMSET_OPERATORS(RenderFeatures)
+
+/**
+ * Fixed-function state a draw depends on, see StateTracker.
+ */
+struct RenderState
+{
+    RenderFeatures features;
+    Float          pointSize{1.0f};
+};
+
+/**
+ * Shadow copy of the enabled features and the point size, so that only actual changes reach the driver.
+ *
+ * The state is unknown at first and after invalidate(), in which case the next set() applies every feature and the
+ * next setPointSize() the point size.
+ */
+class StateTracker
+{
+public:
+    static constexpr UnsignedInt FeatureCount = 4;
+
+    /// Called for every feature that has to change. Enables or disables it through GL::Renderer by default.
+    using Apply = std::function<void(RenderFeature feature, bool enabled)>;
+    /// Called when the point size has to change. Sets it through GL::Renderer by default.
+    using ApplyPointSize = std::function<void(Float size)>;
+
+    explicit StateTracker(Apply apply = nullptr, ApplyPointSize applyPointSize = nullptr);
+
+    /// Enables exactly @p features.
+    void set(RenderFeatures features);
+    /// Enables exactly the features of @p state and sets its point size.
+    void set(const RenderState& state)
+    {
+        set(state.features);
+        setPointSize(state.pointSize);
+    }
+
+    void setPointSize(Float size);
+
+    /// Forgets the state, e.g. after code that doesn't go through the tracker changed it.
+    void invalidate()
+    {
+        known_          = false;
+        pointSizeKnown_ = false;
+    }
+
+    RenderFeatures features() const { return features_; }
+    Float          pointSize() const { return pointSize_; }
+
+    /// Features enabled or disabled and point sizes set so far.
+    std::size_t changeCount() const { return changeCount_; }
+    /// Features and point sizes that were already in the requested state and therefore left alone.
+    std::size_t skippedCount() const { return skippedCount_; }
+
+private:
+    Apply          apply_;
+    ApplyPointSize applyPointSize_;
+    RenderFeatures features_;
+    Float          pointSize_{1.0f};
+    bool           known_{false};
+    bool           pointSizeKnown_{false};
+    std::size_t    changeCount_{0};
+    std::size_t    skippedCount_{0};
+};
+
+#endif // RENDER_RENDERSTATE_H
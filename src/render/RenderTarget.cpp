@@ -0,0 +1,145 @@
+#include "RenderTarget.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Sampler.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Shaders/FlatGL.h>
+
+namespace
+{
+
+constexpr GL::Framebuffer::ColorAttachment ColorAttachment{0};
+constexpr GL::Framebuffer::ColorAttachment ObjectIdAttachment{1};
+
+/* Magnum's shaders write colour to location 0 and object IDs to location 1 */
+void mapOutputs(GL::Framebuffer& framebuffer)
+{
+    framebuffer.mapForDraw({{Shaders::FlatGL3D::ColorOutput, ColorAttachment},
+                            {Shaders::FlatGL3D::ObjectIdOutput, ObjectIdAttachment}});
+}
+
+} // namespace
+
+RenderTarget::RenderTarget(const Vector2i& capacity, const Int samples, GpuMemoryRegistry* const memory)
+: capacity_(capacity)
+, size_(capacity)
+, samples_(samples)
+, framebuffer_({{}, capacity})
+, memory_(memory)
+{
+    color_.setStorage(1, GL::TextureFormat::RGBA8, capacity_)
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge);
+    depth_.setStorage(GL::RenderbufferFormat::DepthComponent24, capacity_);
+    objectId_.setStorage(GL::RenderbufferFormat::R32UI, capacity_);
+
+    framebuffer_.attachTexture(ColorAttachment, color_, 0)
+        .attachRenderbuffer(ObjectIdAttachment, objectId_)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth_);
+    mapOutputs(framebuffer_);
+
+    CORRADE_INTERNAL_ASSERT(framebuffer_.checkStatus(GL::FramebufferTarget::Draw) ==
+                            GL::Framebuffer::Status::Complete);
+
+    allocateMultisample();
+
+    if (memory_)
+        memoryId_ = memory_->add(GpuMemoryRegistry::Kind::FRAMEBUFFER, memoryUsage());
+}
+
+RenderTarget::~RenderTarget()
+{
+    if (memory_)
+        memory_->remove(memoryId_);
+}
+
+void RenderTarget::allocateMultisample()
+{
+    multisampleFramebuffer_.reset();
+    multisampleColor_    = GL::Renderbuffer{NoCreate};
+    multisampleDepth_    = GL::Renderbuffer{NoCreate};
+    multisampleObjectId_ = GL::Renderbuffer{NoCreate};
+    if (samples_ == 0)
+        return;
+
+    multisampleColor_    = GL::Renderbuffer{};
+    multisampleDepth_    = GL::Renderbuffer{};
+    multisampleObjectId_ = GL::Renderbuffer{};
+    multisampleColor_.setStorageMultisample(samples_, GL::RenderbufferFormat::RGBA8, capacity_);
+    multisampleDepth_.setStorageMultisample(samples_, GL::RenderbufferFormat::DepthComponent24, capacity_);
+    multisampleObjectId_.setStorageMultisample(samples_, GL::RenderbufferFormat::R32UI, capacity_);
+
+    multisampleFramebuffer_.emplace(Range2Di{{}, size_});
+    multisampleFramebuffer_->attachRenderbuffer(ColorAttachment, multisampleColor_)
+        .attachRenderbuffer(ObjectIdAttachment, multisampleObjectId_)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, multisampleDepth_);
+    mapOutputs(*multisampleFramebuffer_);
+
+    CORRADE_INTERNAL_ASSERT(multisampleFramebuffer_->checkStatus(GL::FramebufferTarget::Draw) ==
+                            GL::Framebuffer::Status::Complete);
+}
+
+RenderTarget& RenderTarget::setSamples(const Int samples)
+{
+    CORRADE_INTERNAL_ASSERT(samples >= 0);
+    if (samples == samples_)
+        return *this;
+
+    samples_ = samples;
+    allocateMultisample();
+    if (memory_)
+        memory_->setSize(memoryId_, memoryUsage());
+    return *this;
+}
+
+RenderTarget& RenderTarget::setSize(const Vector2i& size)
+{
+    CORRADE_INTERNAL_ASSERT((size <= capacity_).all());
+
+    size_ = size;
+    framebuffer_.setViewport({{}, size_});
+    if (multisampleFramebuffer_)
+        multisampleFramebuffer_->setViewport({{}, size_});
+
+    return *this;
+}
+
+RenderTarget& RenderTarget::clear()
+{
+    GL::Framebuffer& target = framebuffer();
+    target.clear(GL::FramebufferClear::Depth)
+        .clearColor(Shaders::FlatGL3D::ColorOutput, Color4{})
+        .clearColor(Shaders::FlatGL3D::ObjectIdOutput, Vector4ui{});
+    return *this;
+}
+
+void RenderTarget::resolve()
+{
+    if (!multisampleFramebuffer_)
+        return;
+
+    /* A blit copies the read buffer into all the draw buffers, so colour and object IDs are resolved one by one.
+       Depth and the integer IDs can only be resolved with nearest filtering, which is fine as the sizes match. */
+    framebuffer_.mapForDraw(ColorAttachment);
+    GL::AbstractFramebuffer::blit(*multisampleFramebuffer_, framebuffer_, viewport(), viewport(),
+                                  GL::FramebufferBlit::Color | GL::FramebufferBlit::Depth,
+                                  GL::FramebufferBlitFilter::Nearest);
+
+    multisampleFramebuffer_->mapForRead(ObjectIdAttachment);
+    framebuffer_.mapForDraw(ObjectIdAttachment);
+    GL::AbstractFramebuffer::blit(*multisampleFramebuffer_, framebuffer_, viewport(), viewport(),
+                                  GL::FramebufferBlit::Color, GL::FramebufferBlitFilter::Nearest);
+
+    multisampleFramebuffer_->mapForRead(ColorAttachment);
+    mapOutputs(framebuffer_);
+}
+
+std::size_t RenderTarget::memoryUsage() const
+{
+    /* RGBA8 colour, 24-bit depth padded to 32 bits and R32UI object IDs, once single-sampled and once per sample */
+    constexpr std::size_t BytesPerSample = 4 + 4 + 4;
+    return std::size_t(capacity_.product()) * BytesPerSample * std::size_t(1 + samples_);
+}
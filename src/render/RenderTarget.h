@@ -0,0 +1,88 @@
+#ifndef RENDER_RENDERTARGET_H
+#define RENDER_RENDERTARGET_H
+
+#include "GpuMemoryRegistry.h"
+
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Math/Range.h>
+#include <optional>
+
+using namespace Magnum;
+
+/**
+ * Offscreen colour + depth + object ID target of a pane.
+ *
+ * The GPU storage is allocated once with the given capacity and only the area of size() is rendered to, so the
+ * target can be shrunk (or grown up to its capacity) without reallocating. Meant to be handed out by a BucketedPool.
+ *
+ * With a non-zero sample count the pane is rendered into multisampled renderbuffers and resolve() copies the result
+ * into the single-sampled colour texture, depth and object ID buffers, which is what gets composited and read back. The
+ * sample count can change at any time, which only reallocates the multisampled renderbuffers.
+ *
+ * The object ID attachment is filled by shaders writing to Shaders::FlatGL3D::ObjectIdOutput in the same pass as the
+ * colour and read back for picking, see ObjectIdReader. Zero means no object.
+ *
+ * If a GpuMemoryRegistry is passed, the target registers its storage there as long as it lives. Whoever owns the
+ * target decides whether the registry may evict it, see GpuMemoryRegistry::setEvict().
+ */
+class RenderTarget
+{
+public:
+    explicit RenderTarget(const Vector2i& capacity, Int samples = 0, GpuMemoryRegistry* memory = nullptr);
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&)            = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    RenderTarget& setSize(const Vector2i& size);
+    Vector2i      size() const { return size_; }
+    Vector2i      capacity() const { return capacity_; }
+    Int           samples() const { return samples_; }
+
+    /// Zero renders directly into the single-sampled attachments. Invalidates the contents if it changes.
+    RenderTarget& setSamples(Int samples);
+
+    /// Area of the target that is in use, in pixels.
+    Range2Di viewport() const { return {{}, size_}; }
+
+    /// Clears colour, depth and object IDs of framebuffer().
+    RenderTarget& clear();
+
+    /// Framebuffer to render the pane into.
+    GL::Framebuffer& framebuffer() { return multisampleFramebuffer_ ? *multisampleFramebuffer_ : framebuffer_; }
+
+    /// Single-sampled framebuffer with the final colour, depth and object IDs, valid after resolve(). Reads colour.
+    GL::Framebuffer& resolvedFramebuffer() { return framebuffer_; }
+    GL::Texture2D&   color() { return color_; }
+
+    /// Resolves the multisampled contents. No-op for single-sampled targets.
+    void resolve();
+
+    /// Bytes of GPU storage of all the attachments, multisampled ones included.
+    std::size_t memoryUsage() const;
+    /// ID in the GpuMemoryRegistry passed to the constructor, zero if there is none.
+    GpuMemoryRegistry::Id memoryId() const { return memoryId_; }
+
+private:
+    Vector2i         capacity_;
+    Vector2i         size_;
+    Int              samples_;
+    GL::Texture2D    color_;
+    GL::Renderbuffer depth_;
+    GL::Renderbuffer objectId_;
+    GL::Framebuffer  framebuffer_;
+
+    GL::Renderbuffer               multisampleColor_{NoCreate};
+    GL::Renderbuffer               multisampleDepth_{NoCreate};
+    GL::Renderbuffer               multisampleObjectId_{NoCreate};
+    std::optional<GL::Framebuffer> multisampleFramebuffer_;
+
+    GpuMemoryRegistry*    memory_;
+    GpuMemoryRegistry::Id memoryId_{0};
+
+    void allocateMultisample();
+};
+
+#endif // RENDER_RENDERTARGET_H
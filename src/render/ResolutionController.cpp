@@ -0,0 +1,71 @@
+#include "ResolutionController.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+
+namespace
+{
+
+/* Largest step not above @p scale */
+Float quantize(const Float scale)
+{
+    return Math::floor(scale / ResolutionController::ScaleStep) * ResolutionController::ScaleStep;
+}
+
+} // namespace
+
+ResolutionController::ResolutionController(const Duration budget)
+: budget_(budget)
+{
+}
+
+ResolutionController& ResolutionController::setEnabled(const bool enabled)
+{
+    enabled_ = enabled;
+    return *this;
+}
+
+ResolutionController& ResolutionController::setBudget(const Duration budget)
+{
+    CORRADE_INTERNAL_ASSERT(budget.count() > 0);
+    budget_ = budget;
+    return *this;
+}
+
+ResolutionController& ResolutionController::setInteractionScale(const Float scale)
+{
+    interactionScale_ = Math::clamp(scale, MinScale, 1.0f);
+    return *this;
+}
+
+void ResolutionController::addSample(const Duration gpuTime, const Float scale)
+{
+    CORRADE_INTERNAL_ASSERT(scale > 0.0f);
+
+    const Float sample = Float(gpuTime.count()) / (scale * scale);
+    fullResolutionTime_ =
+        fullResolutionTime_ == 0.0f ? sample : Math::lerp(fullResolutionTime_, sample, Smoothing);
+    if (fullResolutionTime_ <= 0.0f)
+        return;
+
+    const Float budget = Float(budget_.count());
+    const Float fits   = Math::sqrt(budget / fullResolutionTime_);
+    if (fits < budgetScale_)
+        budgetScale_ = Math::max(quantize(fits), MinScale);
+    else
+        budgetScale_ = Math::clamp(quantize(Math::sqrt(Headroom * budget / fullResolutionTime_)), budgetScale_, 1.0f);
+}
+
+void ResolutionController::nextFrame()
+{
+    if (interactionFramesLeft_ != 0)
+        --interactionFramesLeft_;
+}
+
+Float ResolutionController::scale() const
+{
+    if (!enabled_)
+        return 1.0f;
+
+    return isInteracting() ? Math::min(budgetScale(), interactionScale_) : budgetScale();
+}
@@ -0,0 +1,71 @@
+#ifndef RENDER_RESOLUTIONCONTROLLER_H
+#define RENDER_RESOLUTIONCONTROLLER_H
+
+#include <Magnum/Magnum.h>
+#include <chrono>
+
+using namespace Magnum;
+
+/**
+ * Picks the resolution a pane renders at, as a fraction of its size, to keep its GPU time within a budget.
+ *
+ * The GPU time is assumed to grow with the number of pixels, i.e. with the square of the scale. Measurements are
+ * smoothed and the scale moves in steps of ScaleStep, dropping as soon as the budget is exceeded but growing only when
+ * the larger scale fits with some headroom, so that it doesn't oscillate around the budget. While the pane is being
+ * interacted with it renders at most at the interaction scale, and goes back up InteractionFrames after the last
+ * interaction.
+ */
+class ResolutionController
+{
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    static constexpr Float MinScale  = 0.25f;
+    static constexpr Float ScaleStep = 1.0f / 16.0f;
+    /// Fraction of the budget a larger scale has to fit into before the scale grows.
+    static constexpr Float Headroom = 0.8f;
+    /// Weight of a new measurement in the smoothed GPU time.
+    static constexpr Float Smoothing = 0.25f;
+    /// Frames after the last interaction until the interaction scale is left.
+    static constexpr Int InteractionFrames = 8;
+
+    explicit ResolutionController(Duration budget = std::chrono::milliseconds{8});
+
+    /// When disabled the pane always renders at full resolution.
+    ResolutionController& setEnabled(bool enabled);
+    bool                  isEnabled() const { return enabled_; }
+
+    ResolutionController& setBudget(Duration budget);
+    Duration              budget() const { return budget_; }
+
+    /// At most MinScale to 1. 1 disables dropping the resolution while interacting.
+    ResolutionController& setInteractionScale(Float scale);
+    Float                 interactionScale() const { return interactionScale_; }
+
+    /// GPU time of a render at the scale() it was rendered with.
+    void addSample(Duration gpuTime, Float scale);
+
+    /// The camera of the pane moved.
+    void interact() { interactionFramesLeft_ = InteractionFrames; }
+    bool isInteracting() const { return interactionFramesLeft_ != 0; }
+
+    /// Advances to the next frame.
+    void nextFrame();
+
+    /// Scale to render at in this frame, in (0, 1].
+    Float scale() const;
+    /// Scale the budget allows for, regardless of interaction.
+    Float budgetScale() const { return enabled_ ? budgetScale_ : 1.0f; }
+    /// Smoothed GPU time at full resolution, zero if nothing was measured yet.
+    Duration estimatedFullResolutionTime() const { return Duration{Long(fullResolutionTime_)}; }
+
+private:
+    Duration budget_;
+    Float    interactionScale_{0.5f};
+    Float    budgetScale_{1.0f};
+    Float    fullResolutionTime_{0.0f}; ///< In nanoseconds.
+    Int      interactionFramesLeft_{0};
+    bool     enabled_{true};
+};
+
+#endif // RENDER_RESOLUTIONCONTROLLER_H
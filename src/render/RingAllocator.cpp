@@ -0,0 +1,61 @@
+#include "RingAllocator.h"
+
+#include <Corrade/Utility/Assert.h>
+
+RingAllocator::RingAllocator(const std::size_t capacity)
+: capacity_(capacity)
+{
+    CORRADE_INTERNAL_ASSERT(capacity_ > 0);
+}
+
+std::optional<std::size_t> RingAllocator::allocate(const std::size_t size, const std::size_t alignment)
+{
+    CORRADE_INTERNAL_ASSERT(alignment && !(alignment & (alignment - 1)));
+    if (size > capacity_)
+        return std::nullopt;
+
+    /* Nothing is in use, start over at the beginning to wrap around less often */
+    if (used_ == 0 && frames_.empty())
+        head_ = tail_ = 0;
+
+    /* The bytes in use go from the tail to the head. If they don't wrap around, the free bytes are after the head and
+       before the tail, otherwise between the head and the tail. */
+    const bool  wrapped = head_ < tail_ || (head_ == tail_ && used_ != 0);
+    std::size_t offset  = (head_ + alignment - 1) & ~(alignment - 1);
+    std::size_t padding = offset - head_;
+    if (wrapped)
+    {
+        if (offset + size > tail_)
+            return std::nullopt;
+    }
+    else if (offset + size > capacity_)
+    {
+        if (size > tail_)
+            return std::nullopt;
+
+        // Skip the rest of the buffer, it is released together with the frame
+        offset  = 0;
+        padding = capacity_ - head_;
+    }
+
+    head_ = offset + size;
+    used_ += padding + size;
+    currentBytes_ += padding + size;
+    return offset;
+}
+
+void RingAllocator::finishFrame()
+{
+    frames_.push_back({head_, currentBytes_});
+    currentBytes_ = 0;
+}
+
+void RingAllocator::releaseFrame()
+{
+    CORRADE_INTERNAL_ASSERT(!frames_.empty());
+
+    const Frame& frame = frames_.front();
+    tail_              = frame.end;
+    used_ -= frame.bytes;
+    frames_.pop_front();
+}
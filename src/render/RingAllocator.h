@@ -0,0 +1,53 @@
+#ifndef RENDER_RINGALLOCATOR_H
+#define RENDER_RINGALLOCATOR_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+/**
+ * Hands out byte ranges of a fixed-size buffer in a ring, grouped into frames that are released oldest first.
+ *
+ * Allocations of one frame are contiguous except for a wrap-around to the beginning, where the rest of the buffer is
+ * skipped. Nothing of a frame can be reused until releaseFrame() releases it, which for a GPU buffer is when the GPU
+ * is done with the frame, see StreamBuffer. No GL, so it can be tested on its own.
+ */
+class RingAllocator
+{
+public:
+    explicit RingAllocator(std::size_t capacity);
+
+    /**
+     * Offset of @p size bytes aligned to @p alignment, which has to be a power of two. Empty if they don't fit next to
+     * the frames still in use.
+     */
+    std::optional<std::size_t> allocate(std::size_t size, std::size_t alignment = 1);
+
+    /// Closes the current frame, the following allocations belong to the next one.
+    void finishFrame();
+
+    /// Makes the bytes of the oldest finished frame available again.
+    void releaseFrame();
+
+    std::size_t capacity() const { return capacity_; }
+    /// Bytes in use, including alignment padding and the bytes skipped when wrapping around.
+    std::size_t used() const { return used_; }
+    /// Finished frames that weren't released yet.
+    std::size_t pendingFrameCount() const { return frames_.size(); }
+
+private:
+    struct Frame
+    {
+        std::size_t end;   ///< Where the next frame starts.
+        std::size_t bytes; ///< Including padding.
+    };
+
+    std::size_t       capacity_;
+    std::size_t       head_{0}; ///< Where the next allocation goes.
+    std::size_t       tail_{0}; ///< Start of the oldest frame in use.
+    std::size_t       used_{0};
+    std::size_t       currentBytes_{0};
+    std::deque<Frame> frames_;
+};
+
+#endif // RENDER_RINGALLOCATOR_H
@@ -0,0 +1,78 @@
+#include "StreamBuffer.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <cstring>
+
+bool StreamBuffer::isSupported()
+{
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>();
+}
+
+StreamBuffer::StreamBuffer(const std::size_t capacity, GpuMemoryRegistry* const memory)
+: ring_(capacity)
+, memory_(memory)
+{
+    CORRADE_INTERNAL_ASSERT(isSupported());
+
+    /* Coherent, so that writes are visible to draws issued after them without flushing the ranges */
+    buffer_.setStorage(capacity, GL::Buffer::StorageFlag::MapWrite | GL::Buffer::StorageFlag::MapPersistent |
+                                     GL::Buffer::StorageFlag::MapCoherent);
+    mapped_ = buffer_.map(0, GLsizeiptr(capacity),
+                          GL::Buffer::MapFlag::Write | GL::Buffer::MapFlag::Persistent | GL::Buffer::MapFlag::Coherent);
+    CORRADE_INTERNAL_ASSERT(mapped_.data());
+
+    if (memory_)
+        memoryId_ = memory_->add(GpuMemoryRegistry::Kind::BUFFER, capacity);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    if (memory_)
+        memory_->remove(memoryId_);
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(const std::size_t size, const std::size_t alignment)
+{
+    CORRADE_INTERNAL_ASSERT(size <= ring_.capacity());
+
+    update();
+    std::optional<std::size_t> offset;
+    while (!(offset = ring_.allocate(size, alignment)))
+    {
+        // The current frame alone doesn't fit, the capacity is too small
+        CORRADE_INTERNAL_ASSERT(!fences_.empty());
+
+        fences_.front().wait();
+        fences_.pop_front();
+        ring_.releaseFrame();
+        ++waitCount_;
+    }
+
+    return {*offset, mapped_.sliceSize(*offset, size)};
+}
+
+std::size_t StreamBuffer::upload(const Containers::ArrayView<const void> data, const std::size_t stride)
+{
+    // The stride isn't necessarily a power of two, so the allocation leaves room to round up to it
+    const Allocation  allocation = allocate(data.size() + stride - 1);
+    const std::size_t index      = (allocation.offset + stride - 1) / stride;
+    std::memcpy(allocation.data.data() + (index * stride - allocation.offset), data.data(), data.size());
+    return index;
+}
+
+void StreamBuffer::finishFrame()
+{
+    ring_.finishFrame();
+    fences_.emplace_back().insert();
+}
+
+void StreamBuffer::update()
+{
+    while (!fences_.empty() && fences_.front().isSignaled())
+    {
+        fences_.pop_front();
+        ring_.releaseFrame();
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef RENDER_STREAMBUFFER_H
+#define RENDER_STREAMBUFFER_H
+
+#include "Fence.h"
+#include "GpuMemoryRegistry.h"
+#include "RingAllocator.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/Buffer.h>
+#include <deque>
+
+using namespace Magnum;
+
+/**
+ * Persistently mapped GPU buffer for data that changes every frame, e.g. vertices of live point clouds or per-draw
+ * uniforms.
+ *
+ * The buffer is allocated and mapped once (GL_ARB_buffer_storage, core in GL 4.4) and used as a ring, see
+ * RingAllocator. Producers write straight into the mapped memory returned by allocate() and draws reference the
+ * returned offset, so there is neither a per-frame buffer allocation nor a copy in the driver. Every frame is guarded
+ * by a fence and its range is only reused once the GPU is done with it; allocate() only blocks if the whole ring is
+ * still in use, which waitCount() reports.
+ */
+class StreamBuffer
+{
+public:
+    struct Allocation
+    {
+        std::size_t                 offset; ///< In buffer().
+        Containers::ArrayView<char> data;   ///< Mapped memory to write to, visible to the GPU without a flush.
+    };
+
+    static bool isSupported();
+
+    /// The buffer is accounted in @p memory if it's not null. It is in use all the time, so it's never evicted.
+    explicit StreamBuffer(std::size_t capacity, GpuMemoryRegistry* memory = nullptr);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&)            = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /// @p size bytes aligned to @p alignment (a power of two) in the current frame. @p size has to fit the capacity.
+    Allocation allocate(std::size_t size, std::size_t alignment = 1);
+
+    /**
+     * Copies @p data into the current frame at an offset that is a multiple of @p stride and returns that offset in
+     * strides, e.g. the base instance of instanced attributes that start at the beginning of buffer().
+     */
+    std::size_t upload(Containers::ArrayView<const void> data, std::size_t stride);
+    /// Copies @p items, returning the index of the first one in buffer().
+    template <class T> std::size_t upload(Containers::ArrayView<T> items)
+    {
+        return upload(Containers::ArrayView<const void>{items}, sizeof(T));
+    }
+
+    /// Fences the allocations since the last call. Call after the draws reading them were submitted.
+    void finishFrame();
+
+    /// Releases the frames the GPU is done with. Never blocks; allocate() calls it too.
+    void update();
+
+    GL::Buffer& buffer() { return buffer_; }
+
+    std::size_t capacity() const { return ring_.capacity(); }
+    std::size_t used() const { return ring_.used(); }
+    /// How many times allocate() had to wait for the GPU because the ring was full.
+    std::size_t waitCount() const { return waitCount_; }
+
+private:
+    RingAllocator               ring_;
+    GL::Buffer                  buffer_;
+    Containers::ArrayView<char> mapped_;
+    std::deque<Fence>           fences_; ///< One per finished frame of ring_, oldest first.
+    std::size_t                 waitCount_{0};
+    GpuMemoryRegistry*          memory_;
+    GpuMemoryRegistry::Id       memoryId_{0};
+};
+
+#endif // RENDER_STREAMBUFFER_H
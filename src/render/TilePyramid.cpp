@@ -0,0 +1,81 @@
+#include "TilePyramid.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+#include <cmath>
+
+TilePyramid::TilePyramid(const Vector2i& imageSize, const Int tileSize)
+: imageSize_(Math::max(imageSize, Vector2i{1}))
+, tileSize_(tileSize)
+{
+    CORRADE_INTERNAL_ASSERT(tileSize_ > 0);
+
+    for (Vector2i size = imageSize_; (size > Vector2i{tileSize_}).any(); size = (size + Vector2i{1}) / 2)
+        ++levelCount_;
+}
+
+Vector2i TilePyramid::levelSize(const UnsignedInt level) const
+{
+    CORRADE_INTERNAL_ASSERT(level < levelCount_);
+    return (imageSize_ + Vector2i{(1 << level) - 1}) >> Int(level);
+}
+
+Vector2i TilePyramid::tileCount(const UnsignedInt level) const
+{
+    return (levelSize(level) + Vector2i{tileSize_ - 1}) / tileSize_;
+}
+
+Range2Di TilePyramid::tilePixels(const Tile& tile) const
+{
+    CORRADE_INTERNAL_ASSERT((tile.index >= Vector2i{0}).all() && (tile.index < tileCount(tile.level)).all());
+
+    const Vector2i min = tile.index * tileSize_;
+    return {min, Math::min(min + Vector2i{tileSize_}, levelSize(tile.level))};
+}
+
+Range2D TilePyramid::tileArea(const Tile& tile) const
+{
+    // The last pixel of a level can cover less than 2^level pixels of the image
+    const Range2Di pixels = tilePixels(tile);
+    const Float    scale  = Float(1 << tile.level);
+    return {Vector2{pixels.min()} * scale, Math::min(Vector2{pixels.max()} * scale, Vector2{imageSize_})};
+}
+
+TilePyramid::Tile TilePyramid::parent(const Tile& tile) const
+{
+    CORRADE_INTERNAL_ASSERT(tile.level + 1 < levelCount_);
+    return {tile.level + 1, tile.index / 2};
+}
+
+UnsignedLong TilePyramid::key(const Tile& tile)
+{
+    // Levels fit 6 bits and tile indices 29 bits each, far more than any image has
+    return UnsignedLong(tile.level) << 58 | UnsignedLong(UnsignedInt(tile.index.y())) << 29 |
+           UnsignedLong(UnsignedInt(tile.index.x()));
+}
+
+UnsignedInt TilePyramid::level(const Float screenPixelsPerImagePixel) const
+{
+    if (!(screenPixelsPerImagePixel < 1.0f))
+        return 0;
+
+    const Float level = std::floor(std::log2(1.0f / Math::max(screenPixelsPerImagePixel, 1.0e-30f)));
+    return UnsignedInt(Math::min(level, Float(levelCount_ - 1)));
+}
+
+void TilePyramid::visibleTiles(const Range2D& area, const UnsignedInt level, std::vector<Tile>& tiles) const
+{
+    tiles.clear();
+
+    const Range2D visible = Math::intersect(area, Range2D{{}, Vector2{imageSize_}});
+    if ((visible.size() <= Vector2{0.0f}).any())
+        return;
+
+    const Float    tileArea = Float(tileSize_ << level);
+    const Vector2i count    = tileCount(level);
+    const Vector2i min      = Math::clamp(Vector2i{Math::floor(visible.min() / tileArea)}, Vector2i{0}, count - 1);
+    const Vector2i max      = Math::clamp(Vector2i{Math::ceil(visible.max() / tileArea)}, Vector2i{1}, count);
+    for (Int y = min.y(); y != max.y(); ++y)
+        for (Int x = min.x(); x != max.x(); ++x)
+            tiles.push_back({level, {x, y}});
+}
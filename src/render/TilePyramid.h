@@ -0,0 +1,63 @@
+#ifndef RENDER_TILEPYRAMID_H
+#define RENDER_TILEPYRAMID_H
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Range.h>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Layout of an image split into square tiles at every level of a resolution pyramid.
+ *
+ * Level 0 is the full resolution, every next level halves the size (rounding up) until the whole image fits a single
+ * tile. Tiles are indexed by column and row from the top left corner of the image; the ones at the right and bottom
+ * edges of a level are smaller than the tile size. Image areas are given in pixels of the full resolution image with
+ * Y down, at any level. Doesn't hold any pixels, see TiledImage.
+ */
+class TilePyramid
+{
+public:
+    struct Tile
+    {
+        UnsignedInt level;
+        Vector2i    index;
+
+        bool operator==(const Tile&) const = default;
+    };
+
+    static constexpr Int DefaultTileSize = 256;
+
+    explicit TilePyramid(const Vector2i& imageSize, Int tileSize = DefaultTileSize);
+
+    Vector2i    imageSize() const { return imageSize_; }
+    Int         tileSize() const { return tileSize_; }
+    UnsignedInt levelCount() const { return levelCount_; }
+    Vector2i    levelSize(UnsignedInt level) const;
+    Vector2i    tileCount(UnsignedInt level) const;
+
+    /// Pixels of @p tile in its level.
+    Range2Di tilePixels(const Tile& tile) const;
+    /// Area of the image @p tile covers.
+    Range2D tileArea(const Tile& tile) const;
+    /// Tile of the next coarser level that covers @p tile. @p tile must not be on the last level.
+    Tile parent(const Tile& tile) const;
+    /// Unique among all the tiles of the pyramid.
+    static UnsignedLong key(const Tile& tile);
+
+    /**
+     * Coarsest level that still has at least one pixel per screen pixel when the full resolution image is shown with
+     * @p screenPixelsPerImagePixel. Zero when zoomed in beyond the full resolution.
+     */
+    UnsignedInt level(Float screenPixelsPerImagePixel) const;
+
+    /// Replaces the contents of @p tiles with the tiles of @p level that overlap @p area, row by row.
+    void visibleTiles(const Range2D& area, UnsignedInt level, std::vector<Tile>& tiles) const;
+
+private:
+    Vector2i    imageSize_;
+    Int         tileSize_;
+    UnsignedInt levelCount_{1};
+};
+
+#endif // RENDER_TILEPYRAMID_H
@@ -0,0 +1,196 @@
+#include "TiledImage.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/Sampler.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/PixelFormat.h>
+#include <algorithm>
+
+TiledImage::Loader TiledImage::imageLoader(std::shared_ptr<const Image2D> image, const Int tileSize)
+{
+    CORRADE_INTERNAL_ASSERT(image && image->format() == PixelFormat::RGBA8Unorm);
+
+    const TilePyramid pyramid{image->size(), tileSize};
+    return [image = std::move(image), pyramid](const TilePyramid::Tile& tile) -> std::optional<Image2D>
+    {
+        const Range2Di pixels = pyramid.tilePixels(tile);
+        const Int      scale  = 1 << tile.level;
+        const Vector2i last   = image->size() - Vector2i{1};
+
+        Image2D tilePixels{PixelFormat::RGBA8Unorm, pixels.size(),
+                           Containers::Array<char>{NoInit, std::size_t(pixels.size().product()) * 4}};
+        const Containers::StridedArrayView2D<const Color4ub> source      = image->pixels<Color4ub>();
+        const Containers::StridedArrayView2D<Color4ub>       destination = tilePixels.pixels<Color4ub>();
+        for (Int y = 0; y != pixels.sizeY(); ++y)
+        {
+            // Both images have rows bottom-up, the pyramid has Y down
+            const Int imageY = Math::min((pixels.max().y() - 1 - y) * scale + scale / 2, last.y());
+            const Containers::StridedArrayView1D<const Color4ub> row = source[std::size_t(last.y() - imageY)];
+            for (Int x = 0; x != pixels.sizeX(); ++x)
+                destination[std::size_t(y)][std::size_t(x)] =
+                    row[std::size_t(Math::min((pixels.min().x() + x) * scale + scale / 2, last.x()))];
+        }
+        return tilePixels;
+    };
+}
+
+TiledImage::TiledImage(GpuResources& resources, const Vector2i& imageSize, Loader loader, const Int tileSize,
+                       const Int cacheCapacity)
+: resources_{resources}
+, shader_{resources.tile()}
+, pyramid_{imageSize, tileSize}
+, loader_{std::move(loader)}
+, slots_{std::size_t(Math::clamp(cacheCapacity, 1, GL::Texture2DArray::maxSize().z()))}
+, stream_{resources.instanceStream()}
+, mesh_{TileShader::quad()}
+{
+    CORRADE_INTERNAL_ASSERT(loader_);
+
+    // Zoomed in beyond the full resolution, image pixels are shown as squares
+    const Vector3i size{tileSize, tileSize, Int(slots_.capacity())};
+    texture_.setStorage(1, GL::TextureFormat::RGBA8, size)
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge);
+
+    // The cache is as large as it is regardless of the image, so there's nothing to evict
+    memoryId_ = resources_.memory().add(GpuMemoryRegistry::Kind::TEXTURE, std::size_t(size.product()) * 4);
+
+    // Streamed instances are read from the start of the stream buffer, every draw picks its own by the base instance
+    mesh_.addVertexBufferInstanced(stream_ ? stream_->buffer() : instanceBuffer_, 1, 0, TileShader::Rectangle{},
+                                   TileShader::TextureCoordinates{}, TileShader::Layer{});
+}
+
+TiledImage::~TiledImage()
+{
+    resources_.memory().remove(memoryId_);
+}
+
+std::optional<std::size_t> TiledImage::upload(const TilePyramid::Tile& tile)
+{
+    std::optional<Image2D> image = loader_(tile);
+    if (!image)
+        return std::nullopt;
+
+    CORRADE_INTERNAL_ASSERT(image->format() == PixelFormat::RGBA8Unorm &&
+                            image->size() == pyramid_.tilePixels(tile).size());
+
+    const std::optional<std::size_t> layer = slots_.insert(TilePyramid::key(tile));
+    CORRADE_INTERNAL_ASSERT(layer);
+
+    texture_.setSubImage(0, {0, 0, Int(*layer)},
+                         ImageView3D{image->storage(), image->format(), {image->size(), 1}, image->data()});
+    ++uploadCount_;
+    return layer;
+}
+
+void TiledImage::addInstance(const Range2D& area, const TilePyramid::Tile& source, const std::size_t layer)
+{
+    // Rows are bottom-up in the layer, and only the bottom left corner of it is used by tiles at the edges
+    const Range2Di pixels   = pyramid_.tilePixels(source);
+    const Float    scale    = Float(1 << source.level);
+    const Float    tileSize = Float(pyramid_.tileSize());
+
+    const auto textureCoordinates = [&](const Vector2& position)
+    {
+        const Vector2 local = position / scale - Vector2{pixels.min()};
+        return Vector2{local.x(), Float(pixels.sizeY()) - local.y()} / tileSize;
+    };
+
+    const Vector2 min = textureCoordinates(area.min());
+    const Vector2 max = textureCoordinates(area.max());
+    instances_.push_back({{area.min().x(), area.min().y(), area.max().x(), area.max().y()},
+                          {min.x(), min.y(), max.x(), max.y()},
+                          Float(layer)});
+}
+
+void TiledImage::update()
+{
+    slots_.nextFrame();
+    resources_.memory().touch(memoryId_);
+    stats_ = {};
+}
+
+void TiledImage::draw(const Range2D& area, const Vector2i& viewportSize)
+{
+    instances_.clear();
+
+    if ((area.size() <= Vector2{0.0f}).any() || (viewportSize <= Vector2i{0}).any())
+        return;
+
+    const UnsignedInt level = pyramid_.level(Float(viewportSize.x()) / area.sizeX());
+    pyramid_.visibleTiles(area, level, visible_);
+
+    /* Everything falls back to the coarsest tile, so it's loaded first and, being used by every draw, never evicted.
+       The visible tiles that are resident are marked as used before anything is uploaded, so that uploads don't evict
+       them. */
+    std::size_t             uploads = 0;
+    const TilePyramid::Tile root{pyramid_.levelCount() - 1, {}};
+    if (!slots_.find(TilePyramid::key(root)) && upload(root))
+        ++uploads;
+
+    requests_.clear();
+    for (const TilePyramid::Tile& tile : visible_)
+        if (!slots_.find(TilePyramid::key(tile)))
+            requests_.push_back({tile, (pyramid_.tileArea(tile).center() - area.center()).dot()});
+    std::sort(requests_.begin(), requests_.end(),
+              [](const Request& a, const Request& b) { return a.distance < b.distance; });
+
+    for (const Request& request : requests_)
+    {
+        // The cache is full of tiles of this draw, the rest stays on coarser tiles until the area or the zoom changes
+        if (!slots_.canInsert())
+            break;
+
+        if (uploads != uploadBudget_ && upload(request.tile))
+            ++uploads;
+        else
+            ++stats_.pendingTiles;
+    }
+
+    for (const TilePyramid::Tile& tile : visible_)
+    {
+        TilePyramid::Tile          source = tile;
+        std::optional<std::size_t> layer  = slots_.find(TilePyramid::key(source));
+        if (layer)
+            ++stats_.drawnTiles;
+        else
+        {
+            while (!layer && source.level + 1 < pyramid_.levelCount())
+            {
+                source = pyramid_.parent(source);
+                layer  = slots_.find(TilePyramid::key(source));
+            }
+            if (!layer)
+                continue;
+            ++stats_.fallbackTiles;
+        }
+
+        addInstance(pyramid_.tileArea(tile), source, *layer);
+    }
+
+    if (instances_.empty())
+        return;
+
+    const auto instances = Containers::arrayView(instances_.data(), instances_.size());
+    if (stream_)
+        mesh_.setBaseInstance(UnsignedInt(stream_->upload(instances)));
+    else
+        instanceBuffer_.setData(instances, GL::BufferUsage::StreamDraw);
+    mesh_.setInstanceCount(Int(instances_.size()));
+
+    // Image pixels with Y down to clip space
+    const Matrix3 transformationProjection = Matrix3::translation({-1.0f, 1.0f}) *
+                                             Matrix3::scaling(Vector2{2.0f, -2.0f} / area.size()) *
+                                             Matrix3::translation(-area.min());
+
+    shader_->setTransformationProjectionMatrix(transformationProjection).bindTileTexture(texture_).draw(mesh_);
+
+    if (stream_)
+        stream_->finishFrame();
+}
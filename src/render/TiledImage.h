@@ -0,0 +1,124 @@
+#ifndef RENDER_TILEDIMAGE_H
+#define RENDER_TILEDIMAGE_H
+
+#include "../containers/LruSlots.h"
+#include "GpuResources.h"
+#include "TilePyramid.h"
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/TextureArray.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Range.h>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * Image of any size shown from a tile pyramid, with only the tiles in view on the GPU.
+ *
+ * Tiles live in the layers of one texture array of a fixed number of layers, so the GPU memory doesn't depend on the
+ * image size. The tiles a draw needs are loaded and uploaded on demand, a few per draw, and the least recently drawn
+ * ones make room for them. Until a tile is there, the area is drawn from the nearest coarser tile that is, which is at
+ * worst the single tile of the coarsest level, loaded first. One image can be shown by several panes, tiles drawn by
+ * any of them in a frame stay on the GPU until update() starts the next one.
+ */
+class TiledImage
+{
+public:
+    /**
+     * Pixels of a tile as RGBA8 with rows bottom-up, of the size of TilePyramid::tilePixels(). Empty if they aren't
+     * available yet, e.g. because they're still being decoded; the tile is then requested again in a later draw.
+     */
+    using Loader = std::function<std::optional<Image2D>(const TilePyramid::Tile&)>;
+
+    static constexpr Int         DefaultCacheCapacity = 256;
+    static constexpr std::size_t DefaultUploadBudget  = 8;
+
+    struct Stats
+    {
+        std::size_t drawnTiles{0};    ///< Drawn at the level the zoom asks for.
+        std::size_t fallbackTiles{0}; ///< Drawn from a coarser tile.
+        std::size_t pendingTiles{0};  ///< Waiting for an upload or for the loader.
+    };
+
+    /**
+     * Loader cutting the tiles out of @p image, which has to be RGBA8. Coarser levels take the image pixel in the
+     * middle of the ones a pixel covers instead of averaging them, so every tile is as cheap as one of the full
+     * resolution.
+     */
+    static Loader imageLoader(std::shared_ptr<const Image2D> image, Int tileSize = TilePyramid::DefaultTileSize);
+
+    /// Up to @p cacheCapacity tiles are on the GPU at once, clamped to the layers the driver supports.
+    explicit TiledImage(GpuResources& resources, const Vector2i& imageSize, Loader loader,
+                        Int tileSize = TilePyramid::DefaultTileSize, Int cacheCapacity = DefaultCacheCapacity);
+    ~TiledImage();
+
+    TiledImage(const TiledImage&)            = delete;
+    TiledImage& operator=(const TiledImage&) = delete;
+
+    /// Starts a new frame. Call once per drawn frame, before the draws of all the panes.
+    void update();
+
+    /**
+     * Draws @p area of the image, in pixels of the full resolution image with Y down, so that it fills the current
+     * viewport of @p viewportSize pixels. Expects depth test and face culling to be disabled, flipping Y turns the
+     * quads around.
+     */
+    void draw(const Range2D& area, const Vector2i& viewportSize);
+
+    /// Tiles uploaded per draw at most, at least one.
+    void        setUploadBudget(std::size_t tiles) { uploadBudget_ = Math::max(tiles, std::size_t{1}); }
+    std::size_t uploadBudget() const { return uploadBudget_; }
+
+    /// Whether a draw() of the current frame left tiles out that another frame would show.
+    bool isStreaming() const { return stats_.pendingTiles != 0; }
+
+    const TilePyramid& pyramid() const { return pyramid_; }
+    Vector2i           imageSize() const { return pyramid_.imageSize(); }
+    /// Of all the draw() calls since the last update().
+    const Stats&       stats() const { return stats_; }
+    std::size_t        residentTileCount() const { return slots_.size(); }
+    std::size_t        cacheCapacity() const { return slots_.capacity(); }
+    /// Number of tiles uploaded so far.
+    std::size_t        uploadCount() const { return uploadCount_; }
+
+private:
+    struct Instance
+    {
+        Vector4 rectangle;
+        Vector4 textureCoordinates;
+        Float   layer;
+    };
+
+    struct Request
+    {
+        TilePyramid::Tile tile;
+        Float             distance; ///< From the center of the drawn area, nearest are uploaded first.
+    };
+
+    std::optional<std::size_t> upload(const TilePyramid::Tile& tile);
+    void                       addInstance(const Range2D& area, const TilePyramid::Tile& source, std::size_t layer);
+
+    GpuResources&                  resources_;
+    Resource<TileShader>           shader_;
+    TilePyramid                    pyramid_;
+    Loader                         loader_;
+    LruSlots                       slots_;
+    GL::Texture2DArray             texture_;
+    GpuMemoryRegistry::Id          memoryId_;
+    StreamBuffer*                  stream_; ///< Null if the instances go to instanceBuffer_.
+    GL::Buffer                     instanceBuffer_;
+    GL::Mesh                       mesh_;
+    std::vector<TilePyramid::Tile> visible_;
+    std::vector<Request>           requests_;
+    std::vector<Instance>          instances_;
+    Stats                          stats_;
+    std::size_t                    uploadBudget_{DefaultUploadBudget};
+    std::size_t                    uploadCount_{0};
+};
+
+#endif // RENDER_TILEDIMAGE_H
@@ -0,0 +1,57 @@
+#include "TransformCache.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/SceneGraph/AbstractObject.h>
+
+void TransformCache::update(SceneGraph::DrawableGroup3D& drawables)
+{
+    std::swap(bounded_, previousBounded_);
+    unbounded_.clear();
+    bounded_.clear();
+    dirtyObjects_.clear();
+
+    for (std::size_t i = 0; i != drawables.size(); ++i)
+    {
+        auto* drawable = dynamic_cast<SceneDrawable*>(&drawables[i]);
+        CORRADE_INTERNAL_ASSERT(drawable != nullptr);
+        (drawable->hasBoundingBox() ? bounded_ : unbounded_).push_back(drawable);
+
+        if (drawable->object().isDirty())
+            dirtyObjects_.emplace_back(drawable->object());
+    }
+
+    // Computes the absolute transformations of all the dirty objects in one pass and hands them to
+    // SceneDrawable::clean()
+    SceneGraph::AbstractObject3D::setClean(dirtyObjects_);
+
+    const bool membershipChanged = bounded_ != previousBounded_;
+    if (!membershipChanged && dirtyObjects_.empty())
+        return;
+
+    worldBounds_.resize(bounded_.size());
+    for (std::size_t i = 0; i != bounded_.size(); ++i)
+        worldBounds_[i] = bounded_[i]->worldBoundingBox();
+
+    if (membershipChanged || ++refitCount_ >= RefitsBeforeRebuild)
+    {
+        bvh_.build(worldBounds_);
+        refitCount_ = 0;
+        ++bvhBuildCount_;
+    }
+    else
+        bvh_.refit(worldBounds_);
+}
+
+TransformCache::CullingStats TransformCache::draw(SceneGraph::Camera3D& camera, StateTracker* const state) const
+{
+    const Matrix4 cameraMatrix = camera.cameraMatrix();
+    const Frustum frustum      = Frustum::fromMatrix(camera.projectionMatrix() * cameraMatrix);
+
+    return forEachVisible({&frustum, 1},
+                          [&](SceneDrawable& drawable)
+                          {
+                              if (state)
+                                  state->set(drawable.renderState());
+                              drawable.draw(cameraMatrix * drawable.worldTransformation(), camera);
+                          });
+}
@@ -0,0 +1,112 @@
+#ifndef RENDER_TRANSFORMCACHE_H
+#define RENDER_TRANSFORMCACHE_H
+
+#include "../containers/BVH.h"
+#include "../objects/SceneDrawable.h"
+#include "RenderState.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Math/Frustum.h>
+#include <Magnum/Math/Intersection.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/SceneGraph/Drawable.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace Magnum;
+
+/**
+ * World transformations of the drawables of a frame, shared by all the pane cameras.
+ *
+ * update() runs once per frame and only recomputes the transformations of the objects that were moved since the
+ * previous frame. draw() then only multiplies them with the camera matrix, so drawing N panes costs one pass over the
+ * hierarchy plus N passes over the drawables instead of N passes over the hierarchy.
+ *
+ * Drawables with a bounding box are kept in a BVH, which is refitted when they move and rebuilt when the set of
+ * drawables changes, and draw() only draws the ones in the frustum of the camera.
+ */
+class TransformCache
+{
+public:
+    struct CullingStats
+    {
+        std::size_t drawn{0};
+        std::size_t culled{0};
+    };
+
+    /// Refits in a row after which the BVH is rebuilt to keep it tight.
+    static constexpr std::size_t RefitsBeforeRebuild = 120;
+
+    /// Every drawable in @p drawables has to be a SceneDrawable.
+    void update(SceneGraph::DrawableGroup3D& drawables);
+
+    /**
+     * Draws the drawables collected by the last update() that are visible from @p camera. If @p state isn't null, the
+     * state each of them expects (see SceneDrawable::renderState()) is set through it first.
+     */
+    CullingStats draw(SceneGraph::Camera3D& camera, StateTracker* state = nullptr) const;
+
+    /// Calls @p visit with every drawable collected by the last update() that is in at least one of @p frusta.
+    template <class Visit>
+    CullingStats forEachVisible(Containers::ArrayView<const Frustum> frusta, Visit&& visit) const
+    {
+        CullingStats stats;
+        for (SceneDrawable* drawable : unbounded_)
+            visit(*drawable);
+        stats.drawn = unbounded_.size();
+
+        if (!cullingEnabled_)
+        {
+            for (SceneDrawable* drawable : bounded_)
+                visit(*drawable);
+            stats.drawn += bounded_.size();
+            return stats;
+        }
+
+        const auto visible = [&](const Range3D& box)
+        {
+            return std::any_of(frusta.begin(), frusta.end(), [&](const Frustum& frustum)
+                               { return Math::Intersection::rangeFrustum(box, frustum); });
+        };
+
+        std::size_t drawn = 0;
+        bvh_.query(visible,
+                   [&](const std::size_t index)
+                   {
+                       // A leaf holds several boxes, test them one by one too
+                       if (!visible(worldBounds_[index]))
+                           return;
+
+                       visit(*bounded_[index]);
+                       ++drawn;
+                   });
+
+        stats.drawn += drawn;
+        stats.culled = bounded_.size() - drawn;
+        return stats;
+    }
+
+    void setCullingEnabled(bool enabled) { cullingEnabled_ = enabled; }
+    bool isCullingEnabled() const { return cullingEnabled_; }
+
+    /// Number of drawables collected by the last update().
+    std::size_t size() const { return unbounded_.size() + bounded_.size(); }
+    /// Number of objects whose transformation was recomputed by the last update().
+    std::size_t updatedCount() const { return dirtyObjects_.size(); }
+    /// Number of times the BVH was built from scratch.
+    std::size_t bvhBuildCount() const { return bvhBuildCount_; }
+
+private:
+    std::vector<SceneDrawable*>                                        unbounded_;
+    std::vector<SceneDrawable*>                                        bounded_;
+    std::vector<SceneDrawable*>                                        previousBounded_;
+    std::vector<Range3D>                                               worldBounds_;
+    std::vector<std::reference_wrapper<SceneGraph::AbstractObject3D>> dirtyObjects_;
+    BVH                                                                bvh_;
+    std::size_t                                                        refitCount_{0};
+    std::size_t                                                        bvhBuildCount_{0};
+    bool                                                               cullingEnabled_{true};
+};
+
+#endif // RENDER_TRANSFORMCACHE_H
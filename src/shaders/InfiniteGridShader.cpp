@@ -0,0 +1,173 @@
+#include "InfiniteGridShader.h"
+
+#include "../render/ProgramBinaryCache.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Shader.h>
+#include <Magnum/GL/Version.h>
+
+namespace
+{
+
+constexpr Containers::StringView VertexSource = R"GLSL(
+out highp vec2 position;
+
+void main()
+{
+    /* (-1, -1), (3, -1), (-1, 3) */
+    position    = vec2(float((gl_VertexID & 1) << 2) - 1.0, float((gl_VertexID & 2) << 1) - 1.0);
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+)GLSL";
+
+constexpr Containers::StringView FragmentSource = R"GLSL(
+uniform highp mat4 transformationProjectionMatrix;
+uniform highp mat4 inverseTransformationProjectionMatrix;
+uniform highp float cellSize;
+uniform lowp vec4 color;
+uniform lowp vec4 majorColor;
+uniform highp uint objectId;
+
+in highp vec2 position;
+
+layout(location = 0) out lowp vec4 fragmentColor;
+layout(location = 1) out highp uint fragmentObjectId;
+
+highp vec3 unproject(highp float depth)
+{
+    highp vec4 point = inverseTransformationProjectionMatrix * vec4(position, depth, 1.0);
+    return point.xyz / point.w;
+}
+
+/* How much of the pixel is covered by a line of a level whose lines are at integer coordinates */
+lowp float coverage(highp vec2 coordinates, highp vec2 derivative)
+{
+    highp vec2 distance = abs(fract(coordinates - 0.5) - 0.5) / derivative;
+    return 1.0 - min(min(distance.x, distance.y), 1.0);
+}
+
+void main()
+{
+    /* Intersect the view ray with the plane, between the near and far plane */
+    highp vec3 near = unproject(-1.0);
+    highp vec3 far  = unproject(1.0);
+    highp float t   = near.z / (near.z - far.z);
+    if (!(t >= 0.0 && t <= 1.0)) /* also catches rays parallel to the plane */
+        discard;
+    highp vec3 point = mix(near, far, t);
+
+    highp vec4 clip = transformationProjectionMatrix * vec4(point, 1.0);
+    gl_FragDepth    = clip.z / clip.w * 0.5 + 0.5;
+
+    /* The finest level that keeps its lines at least MIN_LINE_SPACING pixels
+       apart, faded by how close it is to the next one */
+    highp vec2 coordinates = point.xy / cellSize;
+    highp vec2 derivative  = max(fwidth(coordinates), vec2(1.0e-6));
+    highp float lod        = max(0.0, log(length(derivative) * MIN_LINE_SPACING) / log(SUBDIVISIONS));
+    highp float spacing    = pow(SUBDIVISIONS, floor(lod));
+    lowp float fade        = fract(lod);
+
+    lowp float fine   = coverage(coordinates / spacing, derivative / spacing) * (1.0 - fade);
+    spacing          *= SUBDIVISIONS;
+    lowp float coarse = coverage(coordinates / spacing, derivative / spacing);
+    spacing          *= SUBDIVISIONS;
+    lowp float major  = coverage(coordinates / spacing, derivative / spacing);
+
+    lowp vec4 minor = vec4(color.rgb, color.a * max(fine, coarse));
+    fragmentColor   = mix(minor, majorColor, major);
+    if (fragmentColor.a < 1.0 / 255.0)
+        discard;
+
+    fragmentObjectId = objectId;
+}
+)GLSL";
+
+} // namespace
+
+bool InfiniteGridShader::isSupported()
+{
+    return GL::Context::current().isVersionSupported(GL::Version::GL330);
+}
+
+GL::Mesh InfiniteGridShader::fullScreenTriangle()
+{
+    GL::Mesh mesh;
+    mesh.setCount(3);
+    return mesh;
+}
+
+InfiniteGridShader::InfiniteGridShader(ProgramBinaryCache* const cache)
+{
+    CORRADE_INTERNAL_ASSERT(isSupported());
+
+    const Containers::String defines = Utility::format("#define MIN_LINE_SPACING {:.1f}\n"
+                                                       "#define SUBDIVISIONS {:.1f}\n",
+                                                       MinLineSpacing, Subdivisions);
+    const Containers::String key =
+        cache ? ProgramBinaryCache::key("InfiniteGridShader", {VertexSource, defines, FragmentSource}) : "";
+    if (!cache || !cache->load(*this, key))
+    {
+        GL::Shader vert{GL::Version::GL330, GL::Shader::Type::Vertex};
+        GL::Shader frag{GL::Version::GL330, GL::Shader::Type::Fragment};
+
+        vert.addSource(VertexSource);
+        frag.addSource(defines).addSource(FragmentSource);
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+        attachShaders({vert, frag});
+        if (cache)
+            setRetrievableBinary(true);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        if (cache)
+            cache->save(*this, key);
+    }
+
+    transformationProjectionMatrixUniform_        = uniformLocation("transformationProjectionMatrix");
+    inverseTransformationProjectionMatrixUniform_ = uniformLocation("inverseTransformationProjectionMatrix");
+    cellSizeUniform_                              = uniformLocation("cellSize");
+    colorUniform_                                 = uniformLocation("color");
+    majorColorUniform_                            = uniformLocation("majorColor");
+    objectIdUniform_                              = uniformLocation("objectId");
+
+    setCellSize(1.0f);
+    setColor(Color4{1.0f});
+    setMajorColor(Color4{1.0f});
+}
+
+InfiniteGridShader& InfiniteGridShader::setTransformationProjectionMatrix(const Matrix4& matrix)
+{
+    setUniform(transformationProjectionMatrixUniform_, matrix);
+    setUniform(inverseTransformationProjectionMatrixUniform_, matrix.inverted());
+    return *this;
+}
+
+InfiniteGridShader& InfiniteGridShader::setCellSize(const Float size)
+{
+    CORRADE_INTERNAL_ASSERT(size > 0.0f);
+    setUniform(cellSizeUniform_, size);
+    return *this;
+}
+
+InfiniteGridShader& InfiniteGridShader::setColor(const Color4& color)
+{
+    setUniform(colorUniform_, color);
+    return *this;
+}
+
+InfiniteGridShader& InfiniteGridShader::setMajorColor(const Color4& color)
+{
+    setUniform(majorColorUniform_, color);
+    return *this;
+}
+
+InfiniteGridShader& InfiniteGridShader::setObjectId(const UnsignedInt id)
+{
+    setUniform(objectIdUniform_, id);
+    return *this;
+}
@@ -0,0 +1,60 @@
+#ifndef SHADERS_INFINITEGRIDSHADER_H
+#define SHADERS_INFINITEGRIDSHADER_H
+
+#include <Magnum/GL/AbstractShaderProgram.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+
+using namespace Magnum;
+
+class ProgramBinaryCache;
+
+/**
+ * Grid on the XY plane of its transformation that extends to the horizon, drawn as a single full-screen triangle.
+ *
+ * Every fragment intersects its view ray with the plane and draws anti-aliased lines from the screen-space derivatives
+ * of the plane coordinates, so the cost doesn't depend on the extent or the zoom. The line spacing is picked per pixel
+ * from those derivatives: lines are at least MinLineSpacing pixels apart, every Subdivisions-th line is a major line,
+ * and the finest level fades out while the next one takes over. Writes depth and, like Shaders::FlatGL3D with
+ * Flag::ObjectId, the object ID to output 1 for the lines only, so objects below the plane stay visible between them.
+ *
+ * Draw it with blending enabled. The mesh is fullScreenTriangle(), with no attributes.
+ */
+class InfiniteGridShader : public GL::AbstractShaderProgram
+{
+public:
+    /// Smallest distance between two lines, in pixels.
+    static constexpr Float MinLineSpacing = 8.0f;
+    /// Lines of one level per line of the next coarser one.
+    static constexpr Float Subdivisions = 10.0f;
+
+    static bool isSupported();
+
+    /// Three vertices without attributes covering the whole viewport.
+    static GL::Mesh fullScreenTriangle();
+
+    /// Loads the linked program from @p cache if possible, otherwise compiles it and stores it there.
+    explicit InfiniteGridShader(ProgramBinaryCache* cache = nullptr);
+    explicit InfiniteGridShader(NoCreateT) noexcept
+    : GL::AbstractShaderProgram{NoCreate}
+    {
+    }
+
+    /// Projection times the transformation of the grid plane relative to the camera.
+    InfiniteGridShader& setTransformationProjectionMatrix(const Matrix4& matrix);
+    /// Distance between the finest lines, in plane units.
+    InfiniteGridShader& setCellSize(Float size);
+    InfiniteGridShader& setColor(const Color4& color);
+    InfiniteGridShader& setMajorColor(const Color4& color);
+    InfiniteGridShader& setObjectId(UnsignedInt id);
+
+private:
+    Int transformationProjectionMatrixUniform_{0};
+    Int inverseTransformationProjectionMatrixUniform_{1};
+    Int cellSizeUniform_{2};
+    Int colorUniform_{3};
+    Int majorColorUniform_{4};
+    Int objectIdUniform_{5};
+};
+
+#endif // SHADERS_INFINITEGRIDSHADER_H
@@ -0,0 +1,120 @@
+#include "LabelShader.h"
+
+#include "../render/ProgramBinaryCache.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Shader.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/Version.h>
+
+namespace
+{
+
+constexpr Int GlyphTextureUnit = 0;
+
+constexpr Containers::StringView VertexSource = R"GLSL(
+uniform highp vec2 viewportSize;
+
+layout(location = 0) in highp vec4 rectangle;
+layout(location = 1) in highp vec4 textureCoordinates;
+layout(location = 2) in lowp vec4 color;
+layout(location = 3) in highp uint objectId;
+
+out highp vec2 interpolatedTextureCoordinates;
+flat out lowp vec4 interpolatedColor;
+flat out highp uint interpolatedObjectId;
+
+void main()
+{
+    /* (0, 0), (1, 0), (0, 1), (1, 1) as a triangle strip */
+    highp vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    highp vec2 position = mix(rectangle.xy, rectangle.zw, corner);
+    gl_Position = vec4(position / viewportSize * 2.0 - 1.0, 0.0, 1.0);
+
+    interpolatedTextureCoordinates = mix(textureCoordinates.xy, textureCoordinates.zw, corner);
+    interpolatedColor              = color;
+    interpolatedObjectId           = objectId;
+}
+)GLSL";
+
+constexpr Containers::StringView FragmentSource = R"GLSL(
+uniform lowp sampler2D glyphTexture;
+
+in highp vec2 interpolatedTextureCoordinates;
+flat in lowp vec4 interpolatedColor;
+flat in highp uint interpolatedObjectId;
+
+layout(location = 0) out lowp vec4 fragmentColor;
+layout(location = 1) out highp uint fragmentObjectId;
+
+void main()
+{
+    fragmentColor = vec4(interpolatedColor.rgb,
+                         interpolatedColor.a * texture(glyphTexture, interpolatedTextureCoordinates).a);
+    /* Keep the object IDs of the scene between the glyph strokes */
+    if (fragmentColor.a < 1.0 / 255.0)
+        discard;
+
+    fragmentObjectId = interpolatedObjectId;
+}
+)GLSL";
+
+} // namespace
+
+bool LabelShader::isSupported()
+{
+    return GL::Context::current().isVersionSupported(GL::Version::GL330);
+}
+
+GL::Mesh LabelShader::quad()
+{
+    GL::Mesh mesh{GL::MeshPrimitive::TriangleStrip};
+    mesh.setCount(4);
+    return mesh;
+}
+
+LabelShader::LabelShader(ProgramBinaryCache* const cache)
+{
+    CORRADE_INTERNAL_ASSERT(isSupported());
+
+    const Containers::String key =
+        cache ? ProgramBinaryCache::key("LabelShader", {VertexSource, FragmentSource}) : "";
+    if (!cache || !cache->load(*this, key))
+    {
+        GL::Shader vert{GL::Version::GL330, GL::Shader::Type::Vertex};
+        GL::Shader frag{GL::Version::GL330, GL::Shader::Type::Fragment};
+
+        vert.addSource(VertexSource);
+        frag.addSource(FragmentSource);
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+        attachShaders({vert, frag});
+        if (cache)
+            setRetrievableBinary(true);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        if (cache)
+            cache->save(*this, key);
+    }
+
+    viewportSizeUniform_ = uniformLocation("viewportSize");
+    setUniform(uniformLocation("glyphTexture"), GlyphTextureUnit);
+
+    setViewportSize(Vector2{1.0f});
+}
+
+LabelShader& LabelShader::setViewportSize(const Vector2& size)
+{
+    setUniform(viewportSizeUniform_, size);
+    return *this;
+}
+
+LabelShader& LabelShader::bindGlyphTexture(GL::Texture2D& texture)
+{
+    texture.bind(GlyphTextureUnit);
+    return *this;
+}
@@ -0,0 +1,52 @@
+#ifndef SHADERS_LABELSHADER_H
+#define SHADERS_LABELSHADER_H
+
+#include <Magnum/GL/AbstractShaderProgram.h>
+#include <Magnum/GL/Attribute.h>
+#include <Magnum/Math/Vector2.h>
+
+using namespace Magnum;
+
+class ProgramBinaryCache;
+
+/**
+ * Instanced glyph quads in pixel coordinates, see LabelInstances.
+ *
+ * Every instance is a quad generated from gl_VertexID, so the mesh is quad() and all the data is in the per-instance
+ * attributes. The glyph texture is sampled for coverage only (its alpha channel), multiplied with the instance colour.
+ * Like Shaders::FlatGL3D with Flag::ObjectId, the object ID of the instance goes to output 1 where the glyph covers the
+ * pixel.
+ *
+ * Draw it with blending enabled and depth test disabled, labels are always on top of the scene.
+ */
+class LabelShader : public GL::AbstractShaderProgram
+{
+public:
+    /// Min and max corner of the quad in pixels, origin at the bottom left.
+    using Rectangle = GL::Attribute<0, Vector4>;
+    /// Texture coordinates at the min and max corner.
+    using TextureCoordinates = GL::Attribute<1, Vector4>;
+    using Color              = GL::Attribute<2, Vector4>;
+    using ObjectId           = GL::Attribute<3, UnsignedInt>;
+
+    static bool isSupported();
+
+    /// Four vertices without attributes, drawn as a triangle strip.
+    static GL::Mesh quad();
+
+    /// Loads the linked program from @p cache if possible, otherwise compiles it and stores it there.
+    explicit LabelShader(ProgramBinaryCache* cache = nullptr);
+    explicit LabelShader(NoCreateT) noexcept
+    : GL::AbstractShaderProgram{NoCreate}
+    {
+    }
+
+    /// Size of the viewport the rectangles are in, in pixels.
+    LabelShader& setViewportSize(const Vector2& size);
+    LabelShader& bindGlyphTexture(GL::Texture2D& texture);
+
+private:
+    Int viewportSizeUniform_{0};
+};
+
+#endif // SHADERS_LABELSHADER_H
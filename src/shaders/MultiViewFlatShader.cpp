@@ -0,0 +1,145 @@
+#include "MultiViewFlatShader.h"
+
+#include "../render/ProgramBinaryCache.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Shader.h>
+#include <Magnum/GL/Version.h>
+
+namespace
+{
+
+constexpr Containers::StringView VertexSource = R"GLSL(
+layout(location = 0) in highp vec4 position;
+
+uniform highp mat4 transformationMatrix;
+
+void main()
+{
+    gl_Position = transformationMatrix * position;
+}
+)GLSL";
+
+constexpr Containers::StringView GeometrySource = R"GLSL(
+layout(INPUT_PRIMITIVE) in;
+layout(OUTPUT_PRIMITIVE, max_vertices = MAX_VERTICES) out;
+
+uniform highp mat4 viewProjectionMatrices[MAX_VIEWS];
+uniform int viewCount;
+
+void main()
+{
+    for (int view = 0; view < viewCount; ++view)
+    {
+        for (int i = 0; i < VERTEX_COUNT; ++i)
+        {
+            gl_ViewportIndex = view;
+            gl_Position      = viewProjectionMatrices[view] * gl_in[i].gl_Position;
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
+)GLSL";
+
+constexpr Containers::StringView FragmentSource = R"GLSL(
+uniform lowp vec4 color;
+uniform highp uint objectId;
+
+layout(location = 0) out lowp vec4 fragmentColor;
+layout(location = 1) out highp uint fragmentObjectId;
+
+void main()
+{
+    fragmentColor    = color;
+    fragmentObjectId = objectId;
+}
+)GLSL";
+
+} // namespace
+
+bool MultiViewFlatShader::isSupported()
+{
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::viewport_array>() &&
+           GL::Context::current().isVersionSupported(GL::Version::GL320);
+}
+
+MultiViewFlatShader::MultiViewFlatShader(const Primitive primitive, ProgramBinaryCache* const cache)
+: primitive_(primitive)
+{
+    CORRADE_INTERNAL_ASSERT(isSupported());
+
+    const bool                   lines       = primitive_ == Primitive::LINES;
+    const Int                    vertexCount = lines ? 2 : 3;
+    const Containers::StringView extension   = "#extension GL_ARB_viewport_array : require\n";
+    const Containers::String     defines =
+        Utility::format("#define INPUT_PRIMITIVE {}\n"
+                        "#define OUTPUT_PRIMITIVE {}\n"
+                        "#define VERTEX_COUNT {}\n"
+                        "#define MAX_VIEWS {}\n"
+                        "#define MAX_VERTICES {}\n",
+                        lines ? "lines" : "triangles", lines ? "line_strip" : "triangle_strip", vertexCount, MaxViews,
+                        MaxViews * vertexCount);
+
+    const Containers::String key =
+        cache ? ProgramBinaryCache::key("MultiViewFlatShader",
+                                        {VertexSource, extension, defines, GeometrySource, FragmentSource})
+              : "";
+    if (!cache || !cache->load(*this, key))
+    {
+        GL::Shader vert{GL::Version::GL330, GL::Shader::Type::Vertex};
+        GL::Shader geom{GL::Version::GL330, GL::Shader::Type::Geometry};
+        GL::Shader frag{GL::Version::GL330, GL::Shader::Type::Fragment};
+
+        vert.addSource(VertexSource);
+        geom.addSource(extension).addSource(defines).addSource(GeometrySource);
+        frag.addSource(FragmentSource);
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && geom.compile() && frag.compile());
+
+        attachShaders({vert, geom, frag});
+        if (cache)
+            setRetrievableBinary(true);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        if (cache)
+            cache->save(*this, key);
+    }
+
+    transformationMatrixUniform_   = uniformLocation("transformationMatrix");
+    viewProjectionMatricesUniform_ = uniformLocation("viewProjectionMatrices");
+    viewCountUniform_              = uniformLocation("viewCount");
+    colorUniform_                  = uniformLocation("color");
+    objectIdUniform_               = uniformLocation("objectId");
+}
+
+MultiViewFlatShader& MultiViewFlatShader::setTransformationMatrix(const Matrix4& matrix)
+{
+    setUniform(transformationMatrixUniform_, matrix);
+    return *this;
+}
+
+MultiViewFlatShader& MultiViewFlatShader::setViewProjectionMatrices(const Containers::ArrayView<const Matrix4> matrices)
+{
+    CORRADE_INTERNAL_ASSERT(matrices.size() <= MaxViews);
+
+    setUniform(viewProjectionMatricesUniform_, matrices);
+    setUniform(viewCountUniform_, Int(matrices.size()));
+    return *this;
+}
+
+MultiViewFlatShader& MultiViewFlatShader::setColor(const Color4& color)
+{
+    setUniform(colorUniform_, color);
+    return *this;
+}
+
+MultiViewFlatShader& MultiViewFlatShader::setObjectId(const UnsignedInt id)
+{
+    setUniform(objectIdUniform_, id);
+    return *this;
+}
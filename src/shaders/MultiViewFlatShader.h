@@ -0,0 +1,71 @@
+#ifndef SHADERS_MULTIVIEWFLATSHADER_H
+#define SHADERS_MULTIVIEWFLATSHADER_H
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/AbstractShaderProgram.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+
+using namespace Magnum;
+
+class ProgramBinaryCache;
+
+/**
+ * Flat-colored shader drawing every primitive into several viewports at once.
+ *
+ * The vertex shader only transforms to world space, a geometry shader then emits each primitive once per view with
+ * that view's view-projection matrix and gl_ViewportIndex, so the geometry is submitted once for up to MaxViews panes.
+ * Needs GL_ARB_viewport_array (core in GL 4.1) and geometry shaders, see isSupported().
+ *
+ * Like Shaders::FlatGL3D with Flag::ObjectId, the object ID goes to output 1, see RenderTarget.
+ */
+class MultiViewFlatShader : public GL::AbstractShaderProgram
+{
+public:
+    using Position = GL::Attribute<0, Vector3>;
+
+    /// Guaranteed minimum of GL_MAX_VIEWPORTS.
+    static constexpr UnsignedInt MaxViews = 16;
+
+    enum class Primitive : UnsignedByte
+    {
+        LINES = 0,
+        TRIANGLES
+    };
+
+    static bool isSupported();
+
+    /// Loads the linked program from @p cache if possible, otherwise compiles it and stores it there.
+    explicit MultiViewFlatShader(Primitive primitive, ProgramBinaryCache* cache = nullptr);
+    explicit MultiViewFlatShader(NoCreateT) noexcept
+    : GL::AbstractShaderProgram{NoCreate}
+    {
+    }
+
+    Primitive primitive() const { return primitive_; }
+
+    MultiViewFlatShader& setTransformationMatrix(const Matrix4& matrix);
+    /// One matrix per view, at most MaxViews. View i is drawn into viewport i.
+    MultiViewFlatShader& setViewProjectionMatrices(Containers::ArrayView<const Matrix4> matrices);
+    MultiViewFlatShader& setColor(const Color4& color);
+    MultiViewFlatShader& setObjectId(UnsignedInt id);
+
+private:
+    Primitive primitive_{};
+    Int       transformationMatrixUniform_{0};
+    Int       viewProjectionMatricesUniform_{1};
+    Int       viewCountUniform_{2};
+    Int       colorUniform_{3};
+    Int       objectIdUniform_{4};
+};
+
+/**
+ * The multi-view shader for each primitive type a drawable can have.
+ */
+struct MultiViewShaders
+{
+    MultiViewFlatShader& lines;
+    MultiViewFlatShader& triangles;
+};
+
+#endif // SHADERS_MULTIVIEWFLATSHADER_H
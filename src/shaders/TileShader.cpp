@@ -0,0 +1,105 @@
+#include "TileShader.h"
+
+#include "../render/ProgramBinaryCache.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Shader.h>
+#include <Magnum/GL/TextureArray.h>
+#include <Magnum/GL/Version.h>
+
+namespace
+{
+
+constexpr Int TileTextureUnit = 0;
+
+constexpr Containers::StringView VertexSource = R"GLSL(
+uniform highp mat3 transformationProjectionMatrix;
+
+layout(location = 0) in highp vec4 rectangle;
+layout(location = 1) in highp vec4 textureCoordinates;
+layout(location = 2) in highp float layer;
+
+out highp vec3 interpolatedTextureCoordinates;
+
+void main()
+{
+    /* (0, 0), (1, 0), (0, 1), (1, 1) as a triangle strip */
+    highp vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    highp vec2 position = mix(rectangle.xy, rectangle.zw, corner);
+    gl_Position = vec4((transformationProjectionMatrix * vec3(position, 1.0)).xy, 0.0, 1.0);
+
+    interpolatedTextureCoordinates = vec3(mix(textureCoordinates.xy, textureCoordinates.zw, corner), layer);
+}
+)GLSL";
+
+constexpr Containers::StringView FragmentSource = R"GLSL(
+uniform lowp sampler2DArray tileTexture;
+
+in highp vec3 interpolatedTextureCoordinates;
+
+layout(location = 0) out lowp vec4 fragmentColor;
+
+void main()
+{
+    fragmentColor = texture(tileTexture, interpolatedTextureCoordinates);
+}
+)GLSL";
+
+} // namespace
+
+bool TileShader::isSupported()
+{
+    return GL::Context::current().isVersionSupported(GL::Version::GL330);
+}
+
+GL::Mesh TileShader::quad()
+{
+    GL::Mesh mesh{GL::MeshPrimitive::TriangleStrip};
+    mesh.setCount(4);
+    return mesh;
+}
+
+TileShader::TileShader(ProgramBinaryCache* const cache)
+{
+    CORRADE_INTERNAL_ASSERT(isSupported());
+
+    const Containers::String key = cache ? ProgramBinaryCache::key("TileShader", {VertexSource, FragmentSource}) : "";
+    if (!cache || !cache->load(*this, key))
+    {
+        GL::Shader vert{GL::Version::GL330, GL::Shader::Type::Vertex};
+        GL::Shader frag{GL::Version::GL330, GL::Shader::Type::Fragment};
+
+        vert.addSource(VertexSource);
+        frag.addSource(FragmentSource);
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+        attachShaders({vert, frag});
+        if (cache)
+            setRetrievableBinary(true);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        if (cache)
+            cache->save(*this, key);
+    }
+
+    transformationProjectionMatrixUniform_ = uniformLocation("transformationProjectionMatrix");
+    setUniform(uniformLocation("tileTexture"), TileTextureUnit);
+
+    setTransformationProjectionMatrix(Matrix3{});
+}
+
+TileShader& TileShader::setTransformationProjectionMatrix(const Matrix3& matrix)
+{
+    setUniform(transformationProjectionMatrixUniform_, matrix);
+    return *this;
+}
+
+TileShader& TileShader::bindTileTexture(GL::Texture2DArray& texture)
+{
+    texture.bind(TileTextureUnit);
+    return *this;
+}
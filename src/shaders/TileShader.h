@@ -0,0 +1,47 @@
+#ifndef SHADERS_TILESHADER_H
+#define SHADERS_TILESHADER_H
+
+#include <Magnum/GL/AbstractShaderProgram.h>
+#include <Magnum/GL/Attribute.h>
+#include <Magnum/Math/Matrix3.h>
+
+using namespace Magnum;
+
+class ProgramBinaryCache;
+
+/**
+ * Instanced image tiles sampled from the layers of a texture array, see TiledImage.
+ *
+ * Like LabelShader, every instance is a quad generated from gl_VertexID, so the mesh is quad() and all the data is in
+ * the per-instance attributes.
+ */
+class TileShader : public GL::AbstractShaderProgram
+{
+public:
+    /// Min and max corner of the quad, in the coordinates the transformation projection matrix maps to clip space.
+    using Rectangle = GL::Attribute<0, Vector4>;
+    /// Texture coordinates at the min and max corner.
+    using TextureCoordinates = GL::Attribute<1, Vector4>;
+    /// Layer of the texture array the tile is in.
+    using Layer = GL::Attribute<2, Float>;
+
+    static bool isSupported();
+
+    /// Four vertices without attributes, drawn as a triangle strip.
+    static GL::Mesh quad();
+
+    /// Loads the linked program from @p cache if possible, otherwise compiles it and stores it there.
+    explicit TileShader(ProgramBinaryCache* cache = nullptr);
+    explicit TileShader(NoCreateT) noexcept
+    : GL::AbstractShaderProgram{NoCreate}
+    {
+    }
+
+    TileShader& setTransformationProjectionMatrix(const Matrix3& matrix);
+    TileShader& bindTileTexture(GL::Texture2DArray& texture);
+
+private:
+    Int transformationProjectionMatrixUniform_{0};
+};
+
+#endif // SHADERS_TILESHADER_H
@@ -0,0 +1,171 @@
+#include "../containers/BVH.h"
+
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+// Enough objects for culling to matter
+constexpr std::size_t ObjectCount = 20000;
+
+struct BVHTest : Corrade::TestSuite::Tester
+{
+    explicit BVHTest();
+
+    void Empty();
+    void QueryMatchesBruteForce();
+    void Refit();
+    void IdenticalCenters();
+
+    void QueryBenchmark();
+    void BruteForceBenchmark();
+};
+
+BVHTest::BVHTest()
+{
+    addTests({&BVHTest::Empty});
+    addTests({&BVHTest::QueryMatchesBruteForce});
+    addTests({&BVHTest::Refit});
+    addTests({&BVHTest::IdenticalCenters});
+
+    addBenchmarks({&BVHTest::QueryBenchmark}, 10);
+    addBenchmarks({&BVHTest::BruteForceBenchmark}, 10);
+}
+
+std::vector<Range3D> randomBoxes(const std::size_t count, const UnsignedInt seed)
+{
+    std::mt19937                          generator{seed};
+    std::uniform_real_distribution<Float> position{-100.0f, 100.0f};
+    std::uniform_real_distribution<Float> size{0.1f, 2.0f};
+
+    std::vector<Range3D> boxes;
+    boxes.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        boxes.push_back(Range3D::fromSize({position(generator), position(generator), position(generator)},
+                                          {size(generator), size(generator), size(generator)}));
+    return boxes;
+}
+
+std::vector<std::size_t> query(const BVH& bvh, const Range3D& range)
+{
+    std::vector<std::size_t> found;
+    bvh.query([&](const Range3D& box) { return Math::intersects(box, range); },
+              [&](const std::size_t index) { found.push_back(index); });
+    return found;
+}
+
+std::vector<std::size_t> bruteForce(const std::vector<Range3D>& boxes, const Range3D& range)
+{
+    std::vector<std::size_t> found;
+    for (std::size_t i = 0; i != boxes.size(); ++i)
+        if (Math::intersects(boxes[i], range))
+            found.push_back(i);
+    return found;
+}
+
+// The tree only guarantees that nodes overlapping the range are visited, so filter the candidates like a caller would
+std::vector<std::size_t> filtered(std::vector<std::size_t> found, const std::vector<Range3D>& boxes,
+                                  const Range3D& range)
+{
+    std::erase_if(found, [&](const std::size_t i) { return !Math::intersects(boxes[i], range); });
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+void BVHTest::Empty()
+{
+    BVH bvh;
+    bvh.build({});
+    CORRADE_COMPARE(bvh.size(), 0);
+    CORRADE_COMPARE(bvh.nodeCount(), 0);
+    CORRADE_VERIFY(query(bvh, Range3D{{-1.0f}, {1.0f}}).empty());
+}
+
+void BVHTest::QueryMatchesBruteForce()
+{
+    const auto boxes = randomBoxes(1000, 0);
+    BVH        bvh;
+    bvh.build(boxes);
+    CORRADE_COMPARE(bvh.size(), boxes.size());
+
+    for (const Range3D range : {Range3D{{-10.0f}, {10.0f}}, Range3D{{50.0f, -100.0f, -5.0f}, {100.0f, 0.0f, 5.0f}},
+                                Range3D{{200.0f}, {300.0f}}})
+    {
+        CORRADE_ITERATION(range);
+        CORRADE_COMPARE_AS(filtered(query(bvh, range), boxes, range), bruteForce(boxes, range),
+                           TestSuite::Compare::Container);
+    }
+}
+
+void BVHTest::Refit()
+{
+    auto boxes = randomBoxes(1000, 1);
+    BVH  bvh;
+    bvh.build(boxes);
+
+    // Move every tenth box far away, the tree has to follow
+    for (std::size_t i = 0; i < boxes.size(); i += 10)
+        boxes[i] = boxes[i].translated(Vector3{500.0f});
+    bvh.refit(boxes);
+
+    const Range3D range{{400.0f}, {700.0f}};
+    CORRADE_COMPARE_AS(filtered(query(bvh, range), boxes, range), bruteForce(boxes, range),
+                       TestSuite::Compare::Container);
+    CORRADE_COMPARE(bruteForce(boxes, range).size(), 100);
+    CORRADE_VERIFY(bvh.bounds().contains(boxes[0].center()));
+}
+
+void BVHTest::IdenticalCenters()
+{
+    const std::vector<Range3D> boxes(100, Range3D{{-1.0f}, {1.0f}});
+    BVH                        bvh;
+    bvh.build(boxes);
+
+    // Can't be split, but still has to find everything
+    CORRADE_COMPARE(bvh.nodeCount(), 1);
+    CORRADE_COMPARE(query(bvh, Range3D{{0.0f}, {0.5f}}).size(), boxes.size());
+}
+
+void BVHTest::QueryBenchmark()
+{
+    const auto    boxes = randomBoxes(ObjectCount, 2);
+    const Range3D range{{-20.0f}, {20.0f}};
+    BVH           bvh;
+    bvh.build(boxes);
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(10)
+    {
+        found = filtered(query(bvh, range), boxes, range).size();
+    }
+
+    CORRADE_COMPARE(found, bruteForce(boxes, range).size());
+}
+
+void BVHTest::BruteForceBenchmark()
+{
+    const auto    boxes = randomBoxes(ObjectCount, 2);
+    const Range3D range{{-20.0f}, {20.0f}};
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(10)
+    {
+        found = bruteForce(boxes, range).size();
+    }
+
+    CORRADE_VERIFY(found > 0);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::BVHTest)
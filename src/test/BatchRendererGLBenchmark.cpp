@@ -0,0 +1,239 @@
+#include "../render/BatchRenderer.h"
+
+#include <Corrade/Containers/StringView.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Primitives/Icosphere.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+#include <memory>
+#include <vector>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i FramebufferSize{1024, 1024};
+constexpr Int      CubesPerSide = 64; // 4096 drawables
+
+Trade::MeshData generateCube()
+{
+    return Primitives::cubeSolid();
+}
+
+class Cube : public Object3D, public SceneDrawable
+{
+public:
+    explicit Cube(Object3D* parent, SceneGraph::DrawableGroup3D& drawables, GL::Mesh& mesh, Shaders::FlatGL3D& shader,
+                  const Color3& color)
+    : Object3D(parent)
+    , SceneDrawable(static_cast<Object3D&>(*this), &drawables)
+    , mesh_(mesh)
+    , shader_(shader)
+    , color_(color)
+    {
+        setBoundingBox({{-1.0f}, {1.0f}});
+    }
+
+    void draw(const Matrix4& transformation, SceneGraph::Camera3D& camera) override
+    {
+        shader_.setColor(color_)
+            .setTransformationProjectionMatrix(camera.projectionMatrix() * transformation)
+            .draw(mesh_);
+    }
+
+    bool drawBatched(const Matrix4& transformation, BatchRenderer& batch) override
+    {
+        batch.add(batch.mesh("cube", generateCube), transformation, batch.material(color_));
+        return true;
+    }
+
+private:
+    GL::Mesh&          mesh_;
+    Shaders::FlatGL3D& shader_;
+    Color3             color_;
+};
+
+struct BatchRendererGLBenchmark : GL::OpenGLTester
+{
+    explicit BatchRendererGLBenchmark();
+
+    void MeshesAndMaterials();
+    void SameImage();
+
+    void IndividualDraws();
+    void BatchedDraws();
+
+private:
+    void clear();
+
+    GL::Renderbuffer color_;
+    GL::Renderbuffer depth_;
+    GL::Framebuffer  framebuffer_{{{}, FramebufferSize}};
+
+    GL::Mesh                           mesh_;
+    Shaders::FlatGL3D                  shader_;
+    Scene3D                            scene_;
+    SceneGraph::DrawableGroup3D        drawables_;
+    std::vector<std::unique_ptr<Cube>> cubes_;
+    Object3D                           cameraObject_{&scene_};
+    SceneGraph::Camera3D               camera_{cameraObject_};
+    TransformCache                     cache_;
+};
+
+BatchRendererGLBenchmark::BatchRendererGLBenchmark()
+{
+    addTests({&BatchRendererGLBenchmark::MeshesAndMaterials});
+    addTests({&BatchRendererGLBenchmark::SameImage});
+
+    // Each iteration draws the whole scene once, so this is the CPU and driver cost of a pane with many small objects
+    addBenchmarks({&BatchRendererGLBenchmark::IndividualDraws}, 10);
+    addBenchmarks({&BatchRendererGLBenchmark::BatchedDraws}, 10);
+
+    using namespace Math::Literals;
+
+    color_.setStorage(GL::RenderbufferFormat::RGBA8, FramebufferSize);
+    depth_.setStorage(GL::RenderbufferFormat::DepthComponent24, FramebufferSize);
+    framebuffer_.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color_)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth_);
+
+    mesh_ = MeshTools::compile(generateCube());
+    for (Int y = 0; y != CubesPerSide; ++y)
+    {
+        for (Int x = 0; x != CubesPerSide; ++x)
+        {
+            const Color3 color = Color3::fromHsv({Deg(Float((x + y) % 8) * 45.0f), 0.8f, 0.9f});
+            cubes_.push_back(std::make_unique<Cube>(&scene_, drawables_, mesh_, shader_, color));
+            cubes_.back()->scale(Vector3{0.4f}).translate(
+                {Float(x - CubesPerSide / 2), Float(y - CubesPerSide / 2), 0.0f});
+        }
+    }
+
+    cameraObject_.translate({0.0f, 0.0f, 60.0f});
+    camera_.setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 100.0f));
+    cache_.update(drawables_);
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void BatchRendererGLBenchmark::clear()
+{
+    framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth).bind();
+}
+
+void BatchRendererGLBenchmark::MeshesAndMaterials()
+{
+    if (!BatchRenderer::isSupported())
+        CORRADE_SKIP("Uniform buffers are not supported.");
+
+    using namespace Math::Literals;
+
+    BatchRenderer batch;
+
+    // Meshes are generated once per name, materials stored once per color
+    const UnsignedInt cube = batch.mesh("cube", generateCube);
+    CORRADE_COMPARE(batch.mesh("cube", [] { return Primitives::icosphereSolid(1); }), cube);
+    const UnsignedInt sphere = batch.mesh("sphere", [] { return Primitives::icosphereSolid(1); });
+    CORRADE_VERIFY(sphere != cube);
+
+    const UnsignedInt red = batch.material(0xff0000_rgbf);
+    CORRADE_COMPARE(batch.material(0x00ff00_rgbf), red + 1);
+    CORRADE_COMPARE(batch.material(0xff0000_rgbf), red);
+
+    // More draws than fit into a single call, of two meshes sharing one GPU mesh
+    for (UnsignedInt i = 0; i != BatchRenderer::DrawCount + 1; ++i)
+        batch.add(i % 2 ? cube : sphere, Matrix4::translation(Vector3::zAxis(-5.0f)), red);
+
+    clear();
+    batch.draw(camera_.projectionMatrix());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(batch.batchedCount(), BatchRenderer::DrawCount + 1);
+    if (BatchRenderer::isMultiDrawSupported())
+        CORRADE_COMPARE(batch.drawCallCount(), 2);
+    else
+        CORRADE_COMPARE(batch.drawCallCount(), BatchRenderer::DrawCount + 1);
+
+    // The queue is empty afterwards
+    batch.draw(camera_.projectionMatrix());
+    CORRADE_COMPARE(batch.batchedCount(), 0);
+    CORRADE_COMPARE(batch.drawCallCount(), 0);
+}
+
+void BatchRendererGLBenchmark::SameImage()
+{
+    if (!BatchRenderer::isSupported())
+        CORRADE_SKIP("Uniform buffers are not supported.");
+
+    clear();
+    const auto stats = cache_.draw(camera_);
+    const Image2D individual = framebuffer_.read({{}, FramebufferSize}, {PixelFormat::RGBA8Unorm});
+
+    BatchRenderer batch;
+    clear();
+    const auto batchedStats = batch.draw(cache_, camera_);
+    const Image2D batched   = framebuffer_.read({{}, FramebufferSize}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(batchedStats.drawn, stats.drawn);
+    CORRADE_COMPARE(batch.batchedCount(), stats.drawn);
+
+    for (Int y = 0; y < FramebufferSize.y(); y += 64)
+    {
+        for (Int x = 0; x < FramebufferSize.x(); x += 64)
+        {
+            CORRADE_ITERATION(Vector2i(x, y));
+            CORRADE_COMPARE(batched.pixels<Color4ub>()[y][x], individual.pixels<Color4ub>()[y][x]);
+        }
+    }
+}
+
+void BatchRendererGLBenchmark::IndividualDraws()
+{
+    CORRADE_BENCHMARK(10)
+    {
+        clear();
+        cache_.draw(camera_);
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void BatchRendererGLBenchmark::BatchedDraws()
+{
+    if (!BatchRenderer::isSupported())
+        CORRADE_SKIP("Uniform buffers are not supported.");
+
+    BatchRenderer batch;
+    // The first draw generates and uploads the mesh
+    batch.draw(cache_, camera_);
+
+    CORRADE_BENCHMARK(10)
+    {
+        clear();
+        batch.draw(cache_, camera_);
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(batch.batchedCount(), cubes_.size());
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::BatchRendererGLBenchmark)
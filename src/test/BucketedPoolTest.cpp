@@ -0,0 +1,174 @@
+#include "../containers/BucketedPool.h"
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct BucketedPoolTest : Corrade::TestSuite::Tester
+{
+    explicit BucketedPoolTest();
+
+    void Buckets();
+    void ReuseInPlace();
+    void ReleaseAndTrim();
+    void Erase();
+    void ResizeStorm();
+};
+
+BucketedPoolTest::BucketedPoolTest()
+{
+    addTests({&BucketedPoolTest::Buckets});
+    addTests({&BucketedPoolTest::ReuseInPlace});
+    addTests({&BucketedPoolTest::ReleaseAndTrim});
+    addTests({&BucketedPoolTest::Erase});
+    addTests({&BucketedPoolTest::ResizeStorm});
+}
+
+// Stands in for a GPU render target, counting how many times storage would be allocated
+class CountingTarget
+{
+public:
+    static inline std::size_t allocations = 0;
+
+    explicit CountingTarget(const Vector2i& capacity)
+    : capacity_(capacity)
+    {
+        ++allocations;
+    }
+
+    void     setSize(const Vector2i& size) { size_ = size; }
+    Vector2i size() const { return size_; }
+    Vector2i capacity() const { return capacity_; }
+
+private:
+    Vector2i capacity_;
+    Vector2i size_;
+};
+
+void BucketedPoolTest::Buckets()
+{
+    BucketedPool<CountingTarget> pool(Vector2i{256});
+    CORRADE_COMPARE(pool.bucket({1, 1}), Vector2i(256, 256));
+    CORRADE_COMPARE(pool.bucket({256, 256}), Vector2i(256, 256));
+    CORRADE_COMPARE(pool.bucket({257, 100}), Vector2i(512, 256));
+    CORRADE_COMPARE(pool.bucket({0, 0}), Vector2i(256, 256));
+}
+
+void BucketedPoolTest::ReuseInPlace()
+{
+    BucketedPool<CountingTarget> pool(Vector2i{256});
+
+    CountingTarget& target = pool.acquire({600, 400});
+    CORRADE_COMPARE(target.capacity(), Vector2i(768, 512));
+    CORRADE_COMPARE(pool.allocationCount(), 1);
+
+    // Growing within the bucket and shrinking by less than a bucket step keeps the same storage
+    CORRADE_COMPARE(&pool.resize(target, {700, 500}), &target);
+    CORRADE_COMPARE(&pool.resize(target, {300, 300}), &target);
+    CORRADE_COMPARE(target.size(), Vector2i(300, 300));
+    CORRADE_COMPARE(pool.allocationCount(), 1);
+
+    // Shrinking by more than a bucket step hands out a smaller target and keeps the old one around
+    CountingTarget& smaller = pool.resize(target, {100, 100});
+    CORRADE_VERIFY(&smaller != &target);
+    CORRADE_COMPARE(smaller.capacity(), Vector2i(256, 256));
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.inUse(), 1);
+
+    // ... which is picked up again when growing back
+    CORRADE_COMPARE(&pool.resize(smaller, {600, 400}), &target);
+    CORRADE_COMPARE(pool.allocationCount(), 2);
+}
+
+void BucketedPoolTest::ReleaseAndTrim()
+{
+    BucketedPool<CountingTarget> pool;
+
+    CountingTarget& a = pool.acquire({100, 100});
+    pool.acquire({1000, 1000});
+    CORRADE_COMPARE(pool.size(), 2);
+
+    pool.release(a);
+    CORRADE_COMPARE(pool.inUse(), 1);
+    CORRADE_COMPARE(pool.trim(), 1);
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(pool.trim(), 0);
+}
+
+void BucketedPoolTest::Erase()
+{
+    BucketedPool<CountingTarget> pool;
+
+    CountingTarget& a = pool.acquire({100, 100});
+    CountingTarget& b = pool.acquire({1000, 1000});
+
+    // Resources in use stay
+    CORRADE_VERIFY(!pool.erase(a));
+    CORRADE_COMPARE(pool.size(), 2);
+
+    pool.release(a);
+    pool.release(b);
+    CORRADE_VERIFY(pool.erase(a));
+    CORRADE_COMPARE(pool.size(), 1);
+    CORRADE_COMPARE(&pool.acquire({1000, 1000}), &b);
+}
+
+void BucketedPoolTest::ResizeStorm()
+{
+    // Four panes in a 2x2 layout while the window is dragged from 1280x720 to 1920x1080 and back, with several resize
+    // events per frame. The application applies only the last event of every frame.
+    constexpr Int eventsPerFrame = 8;
+    constexpr Int frames         = 80;
+
+    CountingTarget::allocations = 0;
+    BucketedPool<CountingTarget> pool;
+    std::vector<CountingTarget*> panes(4, nullptr);
+
+    std::size_t resizeEvents = 0;
+    std::size_t appliedSizes = 0;
+    for (Int frame = 0; frame != frames; ++frame)
+    {
+        Vector2i windowSize;
+        for (Int event = 0; event != eventsPerFrame; ++event)
+        {
+            const Int   step = frame * eventsPerFrame + event;
+            const Float t    = Float(step < frames * eventsPerFrame / 2 ? step : frames * eventsPerFrame - step) /
+                            Float(frames * eventsPerFrame / 2);
+            windowSize = Math::lerp(Vector2i{1280, 720}, Vector2i{1920, 1080}, t);
+            ++resizeEvents;
+        }
+
+        for (auto& pane : panes)
+        {
+            const Vector2i size = windowSize / 2;
+            pane                = pane ? &pool.resize(*pane, size) : &pool.acquire(size);
+            CORRADE_COMPARE(pane->size(), size);
+        }
+        ++appliedSizes;
+    }
+
+    Utility::Debug{} << "Resize events:" << resizeEvents << "applied:" << appliedSizes
+                     << "allocations:" << CountingTarget::allocations;
+
+    CORRADE_COMPARE(pool.allocationCount(), CountingTarget::allocations);
+    CORRADE_COMPARE(pool.inUse(), panes.size());
+    // Without pooling every applied resize would reallocate every pane; with 256 px buckets each pane only needs one
+    // target per bucket it passes through (640x360 -> 960x540 spans two buckets per axis).
+    CORRADE_COMPARE_AS(CountingTarget::allocations, 3 * panes.size(), TestSuite::Compare::LessOrEqual);
+
+    pool.trim();
+    CORRADE_COMPARE(pool.size(), panes.size());
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::BucketedPoolTest)
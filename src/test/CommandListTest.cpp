@@ -0,0 +1,175 @@
+#include "../render/CommandList.h"
+
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <string>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct CommandListTest : Corrade::TestSuite::Tester
+{
+    explicit CommandListTest();
+
+    void KeyOrder();
+    void RedundantFeatures();
+    void PointSize();
+    void SortedExecution();
+    void UnknownState();
+};
+
+CommandListTest::CommandListTest()
+{
+    addTests({&CommandListTest::KeyOrder});
+    addTests({&CommandListTest::RedundantFeatures});
+    addTests({&CommandListTest::PointSize});
+    addTests({&CommandListTest::SortedExecution});
+    addTests({&CommandListTest::UnknownState});
+}
+
+// Records the feature changes instead of calling GL
+struct RecordingState
+{
+    explicit RecordingState()
+    : tracker{[this](const RenderFeature feature, const bool enabled) { changes.emplace_back(feature, enabled); },
+              [this](const Float size) { pointSizes.push_back(size); }}
+    {
+    }
+
+    std::vector<std::pair<RenderFeature, bool>> changes;
+    std::vector<Float>                          pointSizes;
+    StateTracker                                tracker;
+};
+
+void CommandListTest::KeyOrder()
+{
+    using Pass = CommandList::Pass;
+
+    // Pass dominates everything else
+    CORRADE_VERIFY(CommandList::key(Pass::SCENE, 255, 4095, 65535, 1.0f) < CommandList::key(Pass::OVERLAY));
+    CORRADE_VERIFY(CommandList::key(Pass::OVERLAY, 255) < CommandList::key(Pass::UI));
+
+    // ... then target, shader, mesh and depth
+    CORRADE_VERIFY(CommandList::key(Pass::SCENE, 0, 7) < CommandList::key(Pass::SCENE, 1, 0));
+    CORRADE_VERIFY(CommandList::key(Pass::SCENE, 0, 0, 9) < CommandList::key(Pass::SCENE, 0, 1, 0));
+    CORRADE_VERIFY(CommandList::key(Pass::SCENE, 0, 0, 0, 0.9f) < CommandList::key(Pass::SCENE, 0, 0, 1, 0.1f));
+    CORRADE_VERIFY(CommandList::key(Pass::SCENE, 0, 0, 0, 0.1f) < CommandList::key(Pass::SCENE, 0, 0, 0, 0.2f));
+
+    const CommandList::Key key = CommandList::key(Pass::SCENE, 3, 17, 1000, 0.5f);
+    CORRADE_COMPARE(CommandList::target(key), 3);
+    CORRADE_COMPARE(CommandList::shader(key), 17);
+    CORRADE_COMPARE(CommandList::mesh(key), 1000);
+}
+
+void CommandListTest::RedundantFeatures()
+{
+    RecordingState state;
+
+    // Nothing is known at first, so everything is set
+    state.tracker.set(RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING);
+    CORRADE_COMPARE(state.changes.size(), StateTracker::FeatureCount);
+    CORRADE_COMPARE(state.tracker.skippedCount(), 0);
+
+    // Only what differs is touched afterwards
+    state.changes.clear();
+    state.tracker.set(RenderFeature::DEPTH_TEST | RenderFeature::BLENDING);
+    CORRADE_COMPARE(state.changes.size(), 2);
+    CORRADE_VERIFY(state.changes[0] == std::make_pair(RenderFeature::FACE_CULLING, false));
+    CORRADE_VERIFY(state.changes[1] == std::make_pair(RenderFeature::BLENDING, true));
+
+    state.changes.clear();
+    state.tracker.set(RenderFeature::DEPTH_TEST | RenderFeature::BLENDING);
+    CORRADE_VERIFY(state.changes.empty());
+    CORRADE_COMPARE(state.tracker.changeCount(), StateTracker::FeatureCount + 2);
+    CORRADE_COMPARE(state.tracker.skippedCount(), 2 + StateTracker::FeatureCount);
+}
+
+void CommandListTest::PointSize()
+{
+    RecordingState state;
+
+    // Drawables set their whole state, so consecutive ones with the same point size only set it once
+    state.tracker.set(RenderState{RenderFeature::DEPTH_TEST, 2.0f});
+    state.tracker.set(RenderState{RenderFeature::DEPTH_TEST | RenderFeature::BLENDING, 2.0f});
+    state.tracker.set(RenderState{RenderFeature::DEPTH_TEST});
+    CORRADE_COMPARE_AS(state.pointSizes, (std::vector<Float>{2.0f, 1.0f}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(state.changes.size(), StateTracker::FeatureCount + 2);
+
+    // Setting only the features leaves the point size alone
+    state.tracker.set(RenderFeature::FACE_CULLING);
+    CORRADE_COMPARE(state.tracker.pointSize(), 1.0f);
+    CORRADE_COMPARE(state.pointSizes.size(), 2);
+
+    state.tracker.invalidate();
+    state.tracker.setPointSize(1.0f);
+    CORRADE_COMPARE(state.pointSizes.size(), 3);
+}
+
+void CommandListTest::SortedExecution()
+{
+    using Pass = CommandList::Pass;
+    constexpr RenderFeatures scene = RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING;
+    constexpr RenderFeatures ui    = RenderFeature::BLENDING | RenderFeature::SCISSOR_TEST;
+
+    RecordingState           state;
+    CommandList              commands;
+    std::vector<std::string> order;
+
+    // Submitted interleaved, like the UI being recorded before the panes are
+    commands.submit(CommandList::key(Pass::UI), ui, [&] { order.push_back("ui"); });
+    commands.submit(CommandList::key(Pass::SCENE, 1, 2), scene, [&] { order.push_back("pane 1 shader 2"); });
+    commands.submit(CommandList::key(Pass::OVERLAY), {}, [&] { order.push_back("overlay"); });
+    commands.submit(CommandList::key(Pass::SCENE, 0, 1), scene, [&] { order.push_back("pane 0 shader 1"); });
+    commands.submit(CommandList::key(Pass::SCENE, 1, 1), scene, [&] { order.push_back("pane 1 shader 1"); });
+    commands.submit(CommandList::key(Pass::SCENE, 0, 2), scene, [&] { order.push_back("pane 0 shader 2"); });
+    commands.submit(CommandList::key(Pass::SCENE, 0, 1), scene, [&] { order.push_back("pane 0 shader 1 again"); });
+    CORRADE_COMPARE(commands.size(), 7);
+
+    const CommandList::Stats stats = commands.execute(state.tracker);
+    CORRADE_COMPARE_AS(order,
+                       (std::vector<std::string>{"pane 0 shader 1", "pane 0 shader 1 again", "pane 0 shader 2",
+                                                 "pane 1 shader 1", "pane 1 shader 2", "overlay", "ui"}),
+                       TestSuite::Compare::Container);
+    CORRADE_COMPARE(commands.size(), 0);
+
+    // The scene features are set once, then disabled for the overlay and the UI ones enabled
+    CORRADE_COMPARE(state.changes.size(), StateTracker::FeatureCount + 2 + 2);
+
+    CORRADE_COMPARE(stats.commands, 7);
+    // Features, target switches (to pane 1, to the overlay) and shader switches (one per pane, both target switches)
+    CORRADE_COMPARE(stats.stateChanges, 8 + 2 + 4);
+    // In submission order, every command sets all the features and there are 4 target and 5 shader switches
+    CORRADE_COMPARE(stats.stateChangesSaved, 7 * StateTracker::FeatureCount + 4 + 5 - stats.stateChanges);
+    CORRADE_COMPARE(commands.stats().stateChanges, stats.stateChanges);
+}
+
+void CommandListTest::UnknownState()
+{
+    RecordingState state;
+    CommandList    commands;
+
+    commands.submit(CommandList::key(CommandList::Pass::SCENE), RenderFeature::DEPTH_TEST, [] {});
+    commands.execute(state.tracker);
+    CORRADE_COMPARE(state.changes.size(), StateTracker::FeatureCount);
+
+    // Someone changed the state behind the tracker's back, so all of it has to be set again
+    state.tracker.invalidate();
+    commands.submit(CommandList::key(CommandList::Pass::SCENE), RenderFeature::DEPTH_TEST, [] {});
+    commands.execute(state.tracker);
+    CORRADE_COMPARE(state.changes.size(), 2 * StateTracker::FeatureCount);
+
+    // An empty list doesn't touch anything
+    CORRADE_COMPARE(commands.execute(state.tracker).commands, 0);
+    CORRADE_COMPARE(state.changes.size(), 2 * StateTracker::FeatureCount);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::CommandListTest)
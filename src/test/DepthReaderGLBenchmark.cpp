@@ -0,0 +1,170 @@
+#include "../render/DepthReader.h"
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Primitives/Plane.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i FramebufferSize{1024, 1024};
+constexpr Vector2i CursorPosition{512, 512};
+// Enough overdraw to keep the GPU busy for a while after the CPU is done submitting, like a real frame would
+constexpr Int DrawsPerFrame = 256;
+
+struct DepthReaderGLBenchmark : GL::OpenGLTester
+{
+    explicit DepthReaderGLBenchmark();
+
+    void AsyncResult();
+    void CachedQueries();
+
+    void SynchronousReadFrame();
+    void AsynchronousReadFrame();
+
+private:
+    void renderFrame();
+
+    GL::Renderbuffer  color_;
+    GL::Renderbuffer  depth_;
+    GL::Framebuffer   framebuffer_{{{}, FramebufferSize}};
+    GL::Mesh          plane_;
+    Shaders::FlatGL3D shader_;
+};
+
+DepthReaderGLBenchmark::DepthReaderGLBenchmark()
+{
+    addTests({&DepthReaderGLBenchmark::AsyncResult});
+    addTests({&DepthReaderGLBenchmark::CachedQueries});
+
+    // Each iteration is one frame with a depth query, so this is the frame time including the hitch of the query
+    addBenchmarks({&DepthReaderGLBenchmark::SynchronousReadFrame}, 20);
+    addBenchmarks({&DepthReaderGLBenchmark::AsynchronousReadFrame}, 20);
+
+    color_.setStorage(GL::RenderbufferFormat::RGBA8, FramebufferSize);
+    depth_.setStorage(GL::RenderbufferFormat::DepthComponent24, FramebufferSize);
+    framebuffer_.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color_)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth_);
+
+    plane_ = MeshTools::compile(Primitives::planeSolid());
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void DepthReaderGLBenchmark::renderFrame()
+{
+    using namespace Math::Literals;
+
+    framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth).bind();
+
+    // A plane at z = 0 ends up at depth 0.5
+    shader_.setColor(0x2f83cc_rgbf).setTransformationProjectionMatrix(Matrix4{});
+    for (Int i = 0; i != DrawsPerFrame; ++i)
+        shader_.draw(plane_);
+}
+
+void DepthReaderGLBenchmark::AsyncResult()
+{
+    DepthReader reader;
+    renderFrame();
+
+    // Nothing is cached, so the query is scheduled instead of answered
+    CORRADE_VERIFY(!reader.depthAt(framebuffer_, CursorPosition));
+    CORRADE_VERIFY(reader.isPending());
+    CORRADE_COMPARE(reader.readbackCount(), 1);
+
+    GL::Renderer::finish();
+    reader.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!reader.isPending());
+    const auto depth = reader.takeResult();
+    CORRADE_VERIFY(depth);
+    CORRADE_COMPARE_WITH(*depth, 0.5f, TestSuite::Compare::around(0.001f));
+    CORRADE_VERIFY(!reader.takeResult());
+}
+
+void DepthReaderGLBenchmark::CachedQueries()
+{
+    DepthReader reader{16};
+    renderFrame();
+
+    CORRADE_VERIFY(!reader.depthAt(framebuffer_, CursorPosition));
+    GL::Renderer::finish();
+    reader.update();
+
+    // Queries around the last one are answered from the cache, without touching the GPU
+    const auto depth = reader.depthAt(framebuffer_, CursorPosition + Vector2i{5, -3});
+    CORRADE_VERIFY(depth);
+    CORRADE_COMPARE_WITH(*depth, 0.5f, TestSuite::Compare::around(0.001f));
+    CORRADE_COMPARE(reader.readbackCount(), 1);
+
+    // ... unless they're too far away
+    CORRADE_VERIFY(!reader.depthAt(framebuffer_, CursorPosition + Vector2i{100, 0}));
+    CORRADE_COMPARE(reader.readbackCount(), 2);
+    GL::Renderer::finish();
+    reader.update();
+
+    // ... or the contents changed
+    reader.invalidate();
+    CORRADE_VERIFY(!reader.depthAt(framebuffer_, CursorPosition + Vector2i{100, 0}));
+    CORRADE_COMPARE(reader.readbackCount(), 3);
+    GL::Renderer::finish();
+    reader.update();
+}
+
+void DepthReaderGLBenchmark::SynchronousReadFrame()
+{
+    Float depth{};
+    CORRADE_BENCHMARK(20)
+    {
+        renderFrame();
+        const Image2D image =
+            framebuffer_.read(Range2Di::fromSize(CursorPosition, Vector2i{1}).padded(Vector2i{2}),
+                              {GL::PixelFormat::DepthComponent, GL::PixelType::Float});
+        depth = image.pixels<Float>()[0][0];
+    }
+
+    CORRADE_COMPARE_WITH(depth, 0.5f, TestSuite::Compare::around(0.001f));
+}
+
+void DepthReaderGLBenchmark::AsynchronousReadFrame()
+{
+    DepthReader reader;
+    CORRADE_BENCHMARK(20)
+    {
+        renderFrame();
+        // Every frame changes the contents, so every query needs a readback
+        reader.invalidate();
+        reader.update();
+        static_cast<void>(reader.depthAt(framebuffer_, CursorPosition));
+    }
+
+    // Don't leak the queued GPU work into the next benchmark
+    GL::Renderer::finish();
+    reader.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::DepthReaderGLBenchmark)
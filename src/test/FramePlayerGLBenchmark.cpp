@@ -0,0 +1,255 @@
+#include "../render/FramePlayer.h"
+#include "../render/RenderTarget.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/PixelFormat.h>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+constexpr Vector2i    FrameSize{8, 8};
+constexpr std::size_t FrameCount = 12;
+// 4K UHD, 33 MB per frame, two seconds of it at 60 fps
+constexpr Vector2i    PlaybackFrameSize{3840, 2160};
+constexpr std::size_t PlaybackFrames = 120;
+constexpr std::size_t Iterations     = 3;
+
+struct FramePlayerGLBenchmark : GL::OpenGLTester
+{
+    explicit FramePlayerGLBenchmark();
+
+    void PlayAhead();
+    void SeekReusesFrames();
+    void WrongSize();
+
+    void Playback4K();
+
+private:
+    std::unique_ptr<ImageLoader> loader(const Vector2i& wrongSize = FrameSize);
+    void                         settle(FramePlayer& player);
+    Color4ub                     colorAt(RenderTarget& target, const Vector2i& position);
+
+    GpuResources                       resources_;
+    std::mutex                         mutex_;
+    std::map<std::string, std::size_t> decodeCounts_; ///< By path.
+    std::optional<Image2D>             playbackFrame_;
+};
+
+std::vector<std::string> frameFiles(const std::size_t count)
+{
+    std::vector<std::string> files;
+    for (std::size_t i = 0; i != count; ++i)
+        files.push_back(std::to_string(i));
+    return files;
+}
+
+FramePlayerGLBenchmark::FramePlayerGLBenchmark()
+{
+    addTests({&FramePlayerGLBenchmark::PlayAhead});
+    addTests({&FramePlayerGLBenchmark::SeekReusesFrames});
+    addTests({&FramePlayerGLBenchmark::WrongSize});
+
+    /* Each iteration is one 60 Hz display frame, so the time per iteration has to stay below 16.7 ms for playback to
+       keep up. The frames are copied out of memory instead of being decoded, what's measured is the upload. */
+    addBenchmarks({&FramePlayerGLBenchmark::Playback4K}, Iterations);
+}
+
+// Every frame is filled with a color telling it apart, "1" is of @p wrongSize if given
+std::unique_ptr<ImageLoader> FramePlayerGLBenchmark::loader(const Vector2i& wrongSize)
+{
+    const ImageLoader::DecoderFactory factory = [this, wrongSize]
+    {
+        return ImageLoader::Decoder{
+            [this, wrongSize](const std::string& path)
+            {
+                {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    ++decodeCounts_[path];
+                }
+
+                const Vector2i          size  = path == "1" ? wrongSize : FrameSize;
+                const Color4ub          color = {UnsignedByte((std::stoi(path) + 1) * 20), 0, 0, 255};
+                Containers::Array<char> data{NoInit, std::size_t(size.product()) * 4};
+                for (Color4ub& pixel : Containers::arrayCast<Color4ub>(data))
+                    pixel = color;
+                return std::optional<Image2D>{Image2D{PixelFormat::RGBA8Unorm, size, std::move(data)}};
+            }};
+    };
+    return std::make_unique<ImageLoader>(1, factory);
+}
+
+// Updates until the window around the playhead is decoded and the ring is full of it
+void FramePlayerGLBenchmark::settle(FramePlayer& player)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    do
+    {
+        std::this_thread::sleep_for(1ms);
+        player.update(std::chrono::steady_clock::now());
+    } while ((player.isStreaming() || !player.shownFrame()) && std::chrono::steady_clock::now() < deadline);
+}
+
+Color4ub FramePlayerGLBenchmark::colorAt(RenderTarget& target, const Vector2i& position)
+{
+    const Image2D image = target.resolvedFramebuffer().read(Range2Di::fromSize(position, Vector2i{1}),
+                                                            {PixelFormat::RGBA8Unorm});
+    return image.pixels<Color4ub>()[0][0];
+}
+
+void FramePlayerGLBenchmark::PlayAhead()
+{
+    decodeCounts_.clear();
+    RenderTarget target{FrameSize};
+    FramePlayer  player{resources_, frameFiles(FrameCount), loader(), 4, 8};
+
+    // Nothing to show until the first frame is decoded
+    target.clear().framebuffer().bind();
+    player.draw({{}, Vector2{FrameSize}}, FrameSize);
+    CORRADE_VERIFY(!player.shownFrame());
+
+    // Of the window of 8, 5 frames are ahead, of which the ring has room for 3 next to the current one
+    settle(player);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(player.shownFrame(), 0);
+    CORRADE_COMPARE(player.frameSize(), FrameSize);
+    CORRADE_COMPARE(player.stats().decodedAhead, 5);
+    CORRADE_COMPARE(player.stats().uploadedAhead, 3);
+    CORRADE_COMPARE(player.stats().decoding, 0);
+    CORRADE_COMPARE(resources_.memory().used(GpuMemoryRegistry::Kind::TEXTURE),
+                    std::size_t(FrameSize.product()) * 4 * 4);
+
+    target.clear().framebuffer().bind();
+    player.draw({{}, Vector2{FrameSize}}, FrameSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(colorAt(target, {4, 4}), (Color4ub{20, 0, 0, 255}));
+
+    // 100 ms at 30 fps are three frames, all of them on the GPU already
+    const auto start = std::chrono::steady_clock::now();
+    player.play();
+    player.update(start);
+    player.update(start + 100ms);
+    CORRADE_COMPARE(player.playhead().frame(), 3);
+    CORRADE_COMPARE(player.shownFrame(), 3);
+    CORRADE_COMPARE(player.playhead().stallCount(), 0);
+
+    target.clear().framebuffer().bind();
+    player.draw({{}, Vector2{FrameSize}}, FrameSize);
+    CORRADE_COMPARE(colorAt(target, {4, 4}), (Color4ub{80, 0, 0, 255}));
+}
+
+void FramePlayerGLBenchmark::SeekReusesFrames()
+{
+    decodeCounts_.clear();
+    FramePlayer player{resources_, frameFiles(FrameCount), loader(), 4, 8};
+    // Without wrapping around, the windows around frames 0 and 2 fit the cache together
+    player.playhead().setLooping(false);
+    settle(player);
+
+    // Forward and back within the frames decoded already, nothing is decoded twice
+    player.seek(2);
+    settle(player);
+    CORRADE_COMPARE(player.shownFrame(), 2);
+    player.seek(0);
+    settle(player);
+    CORRADE_COMPARE(player.shownFrame(), 0);
+
+    player.playhead().setDirection(Playhead::Direction::BACKWARD);
+    settle(player);
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (const auto& [path, count] : decodeCounts_)
+    {
+        CORRADE_ITERATION(path);
+        CORRADE_COMPARE(count, 1);
+    }
+    CORRADE_COMPARE(player.failedCount(), 0);
+}
+
+void FramePlayerGLBenchmark::WrongSize()
+{
+    decodeCounts_.clear();
+    FramePlayer player{resources_, frameFiles(FrameCount), loader({4, 4}), 4, 8};
+    settle(player);
+    CORRADE_COMPARE(player.failedCount(), 1);
+
+    // The failed frame is skipped instead of holding playback
+    const auto start = std::chrono::steady_clock::now();
+    player.play();
+    player.update(start);
+    player.update(start + 40ms);
+    CORRADE_COMPARE(player.playhead().frame(), 1);
+    CORRADE_COMPARE(player.shownFrame(), 0);
+    player.update(start + 70ms);
+    CORRADE_COMPARE(player.playhead().frame(), 2);
+    CORRADE_COMPARE(player.shownFrame(), 2);
+    CORRADE_COMPARE(player.playhead().stallCount(), 0);
+}
+
+void FramePlayerGLBenchmark::Playback4K()
+{
+    if (!playbackFrame_)
+    {
+        playbackFrame_.emplace(PixelFormat::RGBA8Unorm, PlaybackFrameSize,
+                               Containers::Array<char>{ValueInit, std::size_t(PlaybackFrameSize.product()) * 4});
+    }
+
+    // Copying a frame out of memory is a lot faster than decoding one, so two workers keep up
+    const ImageLoader::DecoderFactory factory = [this]
+    {
+        return ImageLoader::Decoder{
+            [this](const std::string&)
+            {
+                Containers::Array<char> data{NoInit, playbackFrame_->data().size()};
+                std::memcpy(data.data(), playbackFrame_->data().data(), data.size());
+                return std::optional<Image2D>{Image2D{PixelFormat::RGBA8Unorm, PlaybackFrameSize, std::move(data)}};
+            }};
+    };
+
+    RenderTarget target{{1920, 1080}};
+    FramePlayer  player{resources_, frameFiles(PlaybackFrames * 2), std::make_unique<ImageLoader>(2, factory), 6, 12};
+    player.playhead().setFramesPerSecond(60.0f);
+    settle(player);
+
+    auto       now   = std::chrono::steady_clock::now();
+    const auto start = now;
+    player.play();
+    player.update(now);
+    CORRADE_BENCHMARK(PlaybackFrames)
+    {
+        now += std::chrono::nanoseconds{16'666'667};
+        player.update(now);
+        target.framebuffer().bind();
+        player.draw({{}, Vector2{PlaybackFrameSize}}, target.size());
+        GL::Renderer::finish();
+    }
+    const double seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+    Utility::Debug{} << "4K playback:" << Float(double(player.playhead().frame()) / seconds) << "frames/s,"
+                     << player.playhead().stallCount() << "stalls";
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(player.playhead().frame() > 0);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::FramePlayerGLBenchmark)
@@ -0,0 +1,129 @@
+#include "../render/FrameScheduler.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+struct FrameSchedulerTest : Corrade::TestSuite::Tester
+{
+    explicit FrameSchedulerTest();
+
+    void EventDriven();
+    void MultipleFrames();
+    void Continuous();
+    void FrameRateLimit();
+    void RequestFromThreads();
+};
+
+FrameSchedulerTest::FrameSchedulerTest()
+{
+    addTests({&FrameSchedulerTest::EventDriven});
+    addTests({&FrameSchedulerTest::MultipleFrames});
+    addTests({&FrameSchedulerTest::Continuous});
+    addTests({&FrameSchedulerTest::FrameRateLimit});
+    addTests({&FrameSchedulerTest::RequestFromThreads});
+}
+
+void FrameSchedulerTest::EventDriven()
+{
+    std::size_t    wakeUps = 0;
+    FrameScheduler scheduler{[&] { ++wakeUps; }};
+
+    // The first frame is always drawn, after that the scheduler stays idle until something asks for a frame
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    scheduler.frameStarted();
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+    CORRADE_COMPARE(wakeUps, 0);
+
+    // Several requests before the frame is drawn are coalesced into one frame
+    scheduler.requestFrame();
+    scheduler.requestFrame();
+    CORRADE_COMPARE(wakeUps, 2);
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+}
+
+void FrameSchedulerTest::MultipleFrames()
+{
+    FrameScheduler scheduler;
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+
+    scheduler.requestFrame(3);
+    // A smaller request doesn't cut the larger one short
+    scheduler.requestFrame(1);
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+}
+
+void FrameSchedulerTest::Continuous()
+{
+    std::size_t    wakeUps = 0;
+    FrameScheduler scheduler{[&] { ++wakeUps; }, FrameScheduler::RedrawMode::CONTINUOUS};
+
+    // Every frame requests the next one
+    for (Int i = 0; i != 5; ++i)
+    {
+        CORRADE_VERIFY(scheduler.takeFrameRequest());
+        scheduler.frameStarted();
+    }
+    CORRADE_COMPARE(scheduler.frameCount(), 5);
+    CORRADE_COMPARE(wakeUps, 5);
+
+    // ... until switched back
+    scheduler.setMode(FrameScheduler::RedrawMode::EVENT_DRIVEN);
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    scheduler.frameStarted();
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+}
+
+void FrameSchedulerTest::FrameRateLimit()
+{
+    FrameScheduler scheduler{nullptr, FrameScheduler::RedrawMode::EVENT_DRIVEN, 50.0f};
+
+    const FrameScheduler::Clock::time_point start{1s};
+    scheduler.frameStarted(start);
+    CORRADE_VERIFY(scheduler.nextFrameTime() == start + 20ms);
+
+    scheduler.setMaxFramesPerSecond(0.0f);
+    CORRADE_VERIFY(scheduler.nextFrameTime() == start);
+}
+
+void FrameSchedulerTest::RequestFromThreads()
+{
+    std::atomic<Int> wakeUps{0};
+    FrameScheduler   scheduler{[&] { ++wakeUps; }};
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+
+    std::vector<std::thread> producers;
+    for (Int i = 0; i != 4; ++i)
+        producers.emplace_back(
+            [&]
+            {
+                for (Int j = 0; j != 1000; ++j)
+                    scheduler.requestFrame();
+            });
+    for (auto& producer : producers)
+        producer.join();
+
+    CORRADE_COMPARE(wakeUps.load(), 4000);
+    CORRADE_VERIFY(scheduler.takeFrameRequest());
+    CORRADE_VERIFY(!scheduler.takeFrameRequest());
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::FrameSchedulerTest)
@@ -0,0 +1,181 @@
+#include "../render/GpuMemoryRegistry.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+using Kind = GpuMemoryRegistry::Kind;
+
+struct GpuMemoryRegistryTest : Corrade::TestSuite::Tester
+{
+    explicit GpuMemoryRegistryTest();
+
+    void Accounting();
+    void EvictLeastRecentlyDrawn();
+    void KeepDrawnThisFrame();
+    void ReloadOnDemand();
+    void EvictRefused();
+    void EvictRemoves();
+    void Unlimited();
+};
+
+GpuMemoryRegistryTest::GpuMemoryRegistryTest()
+{
+    addTests({&GpuMemoryRegistryTest::Accounting});
+    addTests({&GpuMemoryRegistryTest::EvictLeastRecentlyDrawn});
+    addTests({&GpuMemoryRegistryTest::KeepDrawnThisFrame});
+    addTests({&GpuMemoryRegistryTest::ReloadOnDemand});
+    addTests({&GpuMemoryRegistryTest::EvictRefused});
+    addTests({&GpuMemoryRegistryTest::EvictRemoves});
+    addTests({&GpuMemoryRegistryTest::Unlimited});
+}
+
+void GpuMemoryRegistryTest::Accounting()
+{
+    GpuMemoryRegistry memory;
+    const auto texture = memory.add(Kind::TEXTURE, 100);
+    memory.add(Kind::BUFFER, 200);
+    const auto target = memory.add(Kind::FRAMEBUFFER, 300);
+    CORRADE_COMPARE(memory.count(), 3);
+    CORRADE_COMPARE(memory.used(), 600);
+    CORRADE_COMPARE(memory.used(Kind::BUFFER), 200);
+
+    // E.g. a render target switching to MSAA
+    memory.setSize(target, 1200);
+    CORRADE_COMPARE(memory.used(Kind::FRAMEBUFFER), 1200);
+    CORRADE_COMPARE(memory.used(), 1500);
+
+    memory.remove(texture);
+    CORRADE_COMPARE(memory.used(Kind::TEXTURE), 0);
+    CORRADE_COMPARE(memory.used(), 1400);
+    CORRADE_COMPARE(memory.count(), 2);
+}
+
+void GpuMemoryRegistryTest::EvictLeastRecentlyDrawn()
+{
+    GpuMemoryRegistry memory{250};
+
+    std::vector<int> evicted;
+    const auto       a = memory.add(Kind::TEXTURE, 100, [&] { evicted.push_back(0); return true; });
+    const auto       b = memory.add(Kind::TEXTURE, 100, [&] { evicted.push_back(1); return true; });
+    const auto       c = memory.add(Kind::TEXTURE, 100, [&] { evicted.push_back(2); return true; });
+    memory.add(Kind::BUFFER, 50);
+
+    // Everything was just created, i.e. is possibly used by this frame
+    CORRADE_COMPARE(memory.enforceBudget(), 0);
+    CORRADE_VERIFY(evicted.empty());
+
+    memory.touch(c);
+    memory.touch(a);
+    CORRADE_COMPARE(memory.enforceBudget(), 100);
+
+    // b wasn't drawn since the first frame, the unevictable buffer doesn't count
+    CORRADE_COMPARE(evicted, std::vector<int>{1});
+    CORRADE_VERIFY(!memory.isResident(b));
+    CORRADE_VERIFY(memory.isResident(c));
+    CORRADE_COMPARE(memory.used(), 250);
+    CORRADE_COMPARE(memory.evictionCount(), 1);
+
+    // Over budget again, c was drawn less recently than a
+    memory.touch(a);
+    memory.setBudget(150);
+    memory.enforceBudget();
+    CORRADE_COMPARE(evicted, (std::vector<int>{1, 2}));
+    CORRADE_COMPARE(memory.used(), 150);
+    CORRADE_COMPARE(memory.count(), 4);
+}
+
+void GpuMemoryRegistryTest::KeepDrawnThisFrame()
+{
+    GpuMemoryRegistry memory{100};
+    const auto        a = memory.add(Kind::TEXTURE, 100, [] { return true; });
+    const auto        b = memory.add(Kind::TEXTURE, 100, [] { return true; });
+    memory.enforceBudget();
+
+    // Both are still referenced by the commands of the frame, so the budget is exceeded rather than breaking it
+    memory.touch(a);
+    memory.touch(b);
+    CORRADE_COMPARE(memory.enforceBudget(), 0);
+    CORRADE_COMPARE(memory.used(), 200);
+    CORRADE_COMPARE(memory.evictionCount(), 0);
+}
+
+void GpuMemoryRegistryTest::ReloadOnDemand()
+{
+    GpuMemoryRegistry memory{100};
+    const auto        tile = memory.add(Kind::TEXTURE, 100, [] { return true; });
+    memory.add(Kind::TEXTURE, 100);
+    memory.enforceBudget();
+    memory.enforceBudget();
+    CORRADE_VERIFY(!memory.isResident(tile));
+
+    // The owner finds out when it draws the tile again, uploads it and reports its size
+    CORRADE_VERIFY(!memory.touch(tile));
+    memory.reload(tile, 80);
+    CORRADE_VERIFY(memory.touch(tile));
+    CORRADE_COMPARE(memory.used(), 180);
+    CORRADE_COMPARE(memory.reloadCount(), 1);
+
+    // ... and it's safe from eviction for the rest of the frame
+    CORRADE_COMPARE(memory.enforceBudget(), 0);
+    CORRADE_VERIFY(memory.isResident(tile));
+}
+
+void GpuMemoryRegistryTest::EvictRefused()
+{
+    GpuMemoryRegistry memory{100};
+    bool              inUse = true;
+    const auto        a     = memory.add(Kind::FRAMEBUFFER, 100, [&] { return !inUse; });
+    const auto        b     = memory.add(Kind::FRAMEBUFFER, 100, [] { return true; });
+    memory.enforceBudget();
+    memory.touch(b);
+
+    // a is the least recently drawn but can't go, b was drawn this frame
+    CORRADE_COMPARE(memory.enforceBudget(), 0);
+    CORRADE_VERIFY(memory.isResident(a));
+
+    inUse = false;
+    CORRADE_COMPARE(memory.enforceBudget(), 100);
+    CORRADE_VERIFY(!memory.isResident(a));
+    CORRADE_VERIFY(memory.isResident(b));
+}
+
+void GpuMemoryRegistryTest::EvictRemoves()
+{
+    // Like a pooled render target, which unregisters itself when the pool deletes it
+    GpuMemoryRegistry     memory{100};
+    GpuMemoryRegistry::Id a{};
+    GpuMemoryRegistry::Id b{};
+    a = memory.add(Kind::FRAMEBUFFER, 100, [&] { memory.remove(a); return true; });
+    b = memory.add(Kind::FRAMEBUFFER, 100, [&] { memory.remove(b); return true; });
+    memory.enforceBudget();
+    memory.touch(b);
+
+    CORRADE_COMPARE(memory.enforceBudget(), 100);
+    CORRADE_COMPARE(memory.count(), 1);
+    CORRADE_COMPARE(memory.used(), 100);
+    CORRADE_COMPARE(memory.used(Kind::FRAMEBUFFER), 100);
+    CORRADE_COMPARE(memory.evictionCount(), 1);
+}
+
+void GpuMemoryRegistryTest::Unlimited()
+{
+    GpuMemoryRegistry memory;
+    bool              evicted = false;
+    memory.add(Kind::TEXTURE, std::size_t{1} << 40, [&] { return evicted = true; });
+    memory.enforceBudget();
+    memory.enforceBudget();
+    CORRADE_VERIFY(!evicted);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::GpuMemoryRegistryTest)
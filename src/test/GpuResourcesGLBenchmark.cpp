@@ -0,0 +1,136 @@
+#include "../render/GpuResources.h"
+
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/Primitives/Grid.h>
+#include <Magnum/Primitives/Square.h>
+#include <vector>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+// Roughly what creating a pane with a grid and a border used to compile and upload
+constexpr Int Panes = 16;
+
+struct GpuResourcesGLBenchmark : GL::OpenGLTester
+{
+    explicit GpuResourcesGLBenchmark();
+
+    void Sharing();
+    void ReferenceCounting();
+
+    void PaneCreationUncached();
+    void PaneCreationCached();
+};
+
+GpuResourcesGLBenchmark::GpuResourcesGLBenchmark()
+{
+    addTests({&GpuResourcesGLBenchmark::Sharing});
+    addTests({&GpuResourcesGLBenchmark::ReferenceCounting});
+
+    addBenchmarks({&GpuResourcesGLBenchmark::PaneCreationUncached}, 5);
+    addBenchmarks({&GpuResourcesGLBenchmark::PaneCreationCached}, 5);
+}
+
+Trade::MeshData gridMesh()
+{
+    return Primitives::grid3DWireframe({15, 15});
+}
+
+void GpuResourcesGLBenchmark::Sharing()
+{
+    GpuResources resources;
+
+    Resource<Shaders::FlatGL3D> a = resources.flat3D();
+    Resource<Shaders::FlatGL3D> b = resources.flat3D();
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(&*a, &*b);
+
+    // A different configuration is a different program
+    Resource<Shaders::FlatGL3D> c = resources.flat3D(Shaders::FlatGL3D::Flag::VertexColor);
+    CORRADE_VERIFY(&*a != &*c);
+
+    Resource<GL::Mesh> gridA = resources.mesh("grid", gridMesh);
+    Resource<GL::Mesh> gridB = resources.mesh("grid", gridMesh);
+    CORRADE_COMPARE(&*gridA, &*gridB);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(resources.creationCount(), 3);
+    CORRADE_COMPARE(resources.count(), 3);
+}
+
+void GpuResourcesGLBenchmark::ReferenceCounting()
+{
+    GpuResources resources;
+
+    {
+        Resource<Shaders::FlatGL2D> shader = resources.flat2D();
+        CORRADE_COMPARE(resources.count(), 1);
+    }
+
+    // Nothing refers to the shader anymore, so it's gone and compiled again when needed
+    CORRADE_COMPARE(resources.count(), 0);
+    Resource<Shaders::FlatGL2D> shader = resources.flat2D();
+    CORRADE_VERIFY(shader);
+    CORRADE_COMPARE(resources.creationCount(), 2);
+}
+
+void GpuResourcesGLBenchmark::PaneCreationUncached()
+{
+    CORRADE_BENCHMARK(1)
+    {
+        std::vector<Shaders::FlatGL2D> borderShaders;
+        std::vector<Shaders::FlatGL3D> gridShaders;
+        std::vector<GL::Mesh>          meshes;
+        for (Int i = 0; i != Panes; ++i)
+        {
+            borderShaders.emplace_back();
+            gridShaders.emplace_back();
+            meshes.push_back(MeshTools::compile(Primitives::squareWireframe()));
+            meshes.push_back(MeshTools::compile(gridMesh()));
+        }
+        // Program linking may be deferred until first use, make sure it's included
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void GpuResourcesGLBenchmark::PaneCreationCached()
+{
+    CORRADE_BENCHMARK(1)
+    {
+        GpuResources                             resources;
+        std::vector<Resource<Shaders::FlatGL2D>> borderShaders;
+        std::vector<Resource<Shaders::FlatGL3D>> gridShaders;
+        std::vector<Resource<GL::Mesh>>          meshes;
+        for (Int i = 0; i != Panes; ++i)
+        {
+            borderShaders.push_back(resources.flat2D());
+            gridShaders.push_back(resources.flat3D());
+            meshes.push_back(resources.mesh("square", [] { return Primitives::squareWireframe(); }));
+            meshes.push_back(resources.mesh("grid", gridMesh));
+        }
+        GL::Renderer::finish();
+
+        CORRADE_COMPARE(resources.creationCount(), 4);
+
+        // The handles have to go away before the cache
+        borderShaders.clear();
+        gridShaders.clear();
+        meshes.clear();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::GpuResourcesGLBenchmark)
@@ -0,0 +1,137 @@
+#include "../io/ImageLoader.h"
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+// A directory of camera-sized frames, 3 MB each
+constexpr Vector2i    ImageSize{1024, 1024};
+constexpr std::size_t ImageCount = 32;
+constexpr std::size_t Iterations = 3;
+
+struct ImageLoaderBenchmark : Corrade::TestSuite::Tester
+{
+    explicit ImageLoaderBenchmark();
+    ~ImageLoaderBenchmark();
+
+    void OneThread();
+    void AllThreads();
+
+private:
+    bool canImport();
+    void decodeAll(std::size_t threadCount);
+
+    Containers::String       directory_;
+    std::vector<std::string> files_;
+};
+
+ImageLoaderBenchmark::ImageLoaderBenchmark()
+{
+    /* Each iteration requests the whole directory and waits for all of it. The files were just written, so they're
+       served from the page cache and what's measured is decoding and the handover to the render thread. */
+    addBenchmarks({&ImageLoaderBenchmark::OneThread}, Iterations);
+    addBenchmarks({&ImageLoaderBenchmark::AllThreads}, Iterations);
+
+    directory_ = Utility::Path::join(std::filesystem::temp_directory_path().string(), "ImageLoaderBenchmark");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(directory_));
+
+    /* Uncompressed 24-bit TGA: an 18-byte header, then BGR pixels with rows from the bottom, which every Magnum build
+       can import without external libraries. A gradient, so that the pixels aren't all alike. */
+    std::string data(18 + std::size_t(ImageSize.product()) * 3, '\0');
+    data[2]  = 2;
+    data[12] = char(ImageSize.x() & 0xff);
+    data[13] = char(ImageSize.x() >> 8);
+    data[14] = char(ImageSize.y() & 0xff);
+    data[15] = char(ImageSize.y() >> 8);
+    data[16] = 24;
+    for (Int y = 0; y != ImageSize.y(); ++y)
+        for (Int x = 0; x != ImageSize.x(); ++x)
+        {
+            char* const bgr = data.data() + 18 + (std::size_t(y) * ImageSize.x() + x) * 3;
+
+            bgr[0] = char(x);
+            bgr[1] = char(y);
+            bgr[2] = char(x + y);
+        }
+
+    for (std::size_t i = 0; i != ImageCount; ++i)
+    {
+        files_.push_back(Utility::Path::join(directory_, "frame" + std::to_string(i) + ".tga"));
+        CORRADE_INTERNAL_ASSERT_OUTPUT(
+            Utility::Path::write(files_.back(), Containers::ArrayView<const char>{data.data(), data.size()}));
+    }
+}
+
+ImageLoaderBenchmark::~ImageLoaderBenchmark()
+{
+    for (const std::string& file : files_)
+        Utility::Path::remove(file);
+    Utility::Path::remove(directory_);
+}
+
+bool ImageLoaderBenchmark::canImport()
+{
+    PluginManager::Manager<Trade::AbstractImporter> manager;
+    return (manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) &&
+           (manager.load("TgaImporter") & PluginManager::LoadState::Loaded);
+}
+
+void ImageLoaderBenchmark::decodeAll(const std::size_t threadCount)
+{
+    if (!canImport())
+        CORRADE_SKIP("AnyImageImporter or TgaImporter can't be loaded.");
+
+    ImageLoader loader{threadCount};
+    std::size_t decoded = 0;
+    const auto  start   = std::chrono::steady_clock::now();
+    CORRADE_BENCHMARK(Iterations)
+    {
+        for (const std::string& file : files_)
+            loader.request(file);
+
+        for (std::size_t taken = 0; taken != files_.size();)
+        {
+            if (const std::optional<ImageLoader::Result> result = loader.take())
+            {
+                decoded += result->image ? 1 : 0;
+                ++taken;
+            }
+            else
+                std::this_thread::yield();
+        }
+    }
+    const double seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+    Utility::Debug{} << threadCount << "threads:" << Float(double(ImageCount * Iterations) / seconds) << "images/s";
+
+    CORRADE_COMPARE(decoded, ImageCount * Iterations);
+}
+
+void ImageLoaderBenchmark::OneThread()
+{
+    decodeAll(1);
+}
+
+void ImageLoaderBenchmark::AllThreads()
+{
+    decodeAll(ImageLoader::defaultThreadCount());
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::ImageLoaderBenchmark)
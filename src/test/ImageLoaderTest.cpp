@@ -0,0 +1,392 @@
+#include "../io/ImageLoader.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct ImageLoaderTest : Corrade::TestSuite::Tester
+{
+    explicit ImageLoaderTest();
+
+    void Deliver();
+    void Priority();
+    void SetPriority();
+    void Cancel();
+    void CancelWhileFull();
+    void Failed();
+
+    void ConvertGray();
+    void ConvertGrayAlpha();
+    void Convert16Bit();
+    void ImporterDecoder();
+};
+
+ImageLoaderTest::ImageLoaderTest()
+{
+    addTests({&ImageLoaderTest::Deliver});
+    addTests({&ImageLoaderTest::Priority});
+    addTests({&ImageLoaderTest::SetPriority});
+    addTests({&ImageLoaderTest::Cancel});
+    addTests({&ImageLoaderTest::CancelWhileFull});
+    addTests({&ImageLoaderTest::Failed});
+
+    addTests({&ImageLoaderTest::ConvertGray});
+    addTests({&ImageLoaderTest::ConvertGrayAlpha});
+    addTests({&ImageLoaderTest::Convert16Bit});
+    addTests({&ImageLoaderTest::ImporterDecoder});
+}
+
+// Stands in for the importers: decodes every path into a pixel, except "broken", and holds the decoders back until
+// it's opened, to have requests pile up in the queue
+class FakeDecoder
+{
+public:
+    explicit FakeDecoder(bool open = true)
+    : open_(open)
+    {
+    }
+
+    ImageLoader::DecoderFactory factory()
+    {
+        return [this] { return ImageLoader::Decoder{[this](const std::string& path) { return decode(path); }}; };
+    }
+
+    void open()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            open_ = true;
+        }
+        condition_.notify_all();
+    }
+
+    /// Until @p count decodes started, so that these are in flight and the next requests wait in the queue.
+    void waitForStarted(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        condition_.wait(lock, [&] { return started_.size() >= count; });
+    }
+
+    std::vector<std::string> started()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return started_;
+    }
+
+private:
+    std::optional<Image2D> decode(const std::string& path)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            started_.push_back(path);
+            condition_.notify_all();
+            condition_.wait(lock, [&] { return open_; });
+        }
+
+        if (path == "broken")
+            return std::nullopt;
+        return Image2D{PixelFormat::RGBA8Unorm, {1, 1}, Containers::Array<char>{ValueInit, 4}};
+    }
+
+    std::mutex               mutex_;
+    std::condition_variable  condition_;
+    bool                     open_;
+    std::vector<std::string> started_;
+};
+
+// Takes results until @p count arrived, giving up after a while instead of hanging the test
+std::vector<ImageLoader::Result> takeResults(ImageLoader& loader, std::size_t count)
+{
+    std::vector<ImageLoader::Result> results;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (results.size() != count && std::chrono::steady_clock::now() < deadline)
+    {
+        if (std::optional<ImageLoader::Result> result = loader.take())
+            results.push_back(*std::move(result));
+        else
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return results;
+}
+
+// Waits until @p condition holds, giving up after a while instead of hanging the test
+template <class Condition>
+bool waitFor(Condition condition)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (!condition() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    return condition();
+}
+
+// The pixels of the file ImporterDecoder() writes
+Color4ub expectedPixel(const Int x, const Int y)
+{
+    return {UnsignedByte(x * 100), UnsignedByte(y * 100), 50, 255};
+}
+
+std::vector<std::string> paths(const std::vector<ImageLoader::Result>& results)
+{
+    std::vector<std::string> out;
+    for (const ImageLoader::Result& result : results)
+        out.push_back(result.path);
+    return out;
+}
+
+void ImageLoaderTest::Deliver()
+{
+    constexpr std::size_t    count = 50;
+    FakeDecoder              decoder;
+    std::atomic<std::size_t> wakeUps{0};
+    {
+        // Queues of a single result, so that workers also wait for the render thread
+        ImageLoader loader{3, decoder.factory(), [&] { ++wakeUps; }, 1};
+        CORRADE_COMPARE(loader.threadCount(), 3);
+
+        std::vector<ImageLoader::Id> ids;
+        for (std::size_t i = 0; i != count; ++i)
+            ids.push_back(loader.request(std::to_string(i)));
+        CORRADE_COMPARE(loader.pendingCount(), count);
+
+        const std::vector<ImageLoader::Result> results = takeResults(loader, count);
+        CORRADE_COMPARE(results.size(), count);
+        for (const ImageLoader::Result& result : results)
+        {
+            const auto found = std::find(ids.begin(), ids.end(), result.id);
+            CORRADE_VERIFY(found != ids.end());
+            CORRADE_COMPARE(result.path, std::to_string(found - ids.begin()));
+            CORRADE_VERIFY(result.image);
+            CORRADE_COMPARE(result.image->size(), Vector2i{1});
+            ids.erase(found);
+        }
+
+        CORRADE_COMPARE(loader.pendingCount(), 0);
+        CORRADE_COMPARE(loader.decodedCount(), count);
+        CORRADE_VERIFY(!loader.take());
+    }
+
+    // Once for every result
+    CORRADE_COMPARE(wakeUps.load(), count);
+}
+
+void ImageLoaderTest::Priority()
+{
+    FakeDecoder decoder{false};
+    ImageLoader loader{1, decoder.factory()};
+
+    // The first request keeps the only worker busy while the others are queued
+    loader.request("busy");
+    decoder.waitForStarted(1);
+    loader.request("a", 0.0f);
+    loader.request("b", 2.0f);
+    loader.request("c", 1.0f);
+    loader.request("d", 1.0f);
+    decoder.open();
+
+    // Highest priority first, requests of the same one in order
+    CORRADE_COMPARE(paths(takeResults(loader, 5)), (std::vector<std::string>{"busy", "b", "c", "d", "a"}));
+}
+
+void ImageLoaderTest::SetPriority()
+{
+    FakeDecoder decoder{false};
+    ImageLoader loader{1, decoder.factory()};
+
+    const ImageLoader::Id busy = loader.request("busy");
+    decoder.waitForStarted(1);
+    const ImageLoader::Id a = loader.request("a", 0.0f);
+    loader.request("b", 1.0f);
+
+    CORRADE_VERIFY(loader.setPriority(a, 2.0f));
+    // Too late for the one being decoded
+    CORRADE_VERIFY(!loader.setPriority(busy, 3.0f));
+    decoder.open();
+
+    CORRADE_COMPARE(paths(takeResults(loader, 3)), (std::vector<std::string>{"busy", "a", "b"}));
+    CORRADE_VERIFY(!loader.setPriority(a, 0.0f));
+}
+
+void ImageLoaderTest::Cancel()
+{
+    FakeDecoder decoder{false};
+    ImageLoader loader{1, decoder.factory()};
+
+    const ImageLoader::Id busy = loader.request("busy");
+    decoder.waitForStarted(1);
+    const ImageLoader::Id waiting = loader.request("waiting");
+    loader.request("wanted");
+
+    loader.cancel(busy);
+    loader.cancel(waiting);
+    // Cancelling twice doesn't count twice
+    loader.cancel(waiting);
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+    decoder.open();
+
+    // The waiting request is never decoded, the one in flight is decoded in vain and dropped
+    const std::vector<ImageLoader::Result> results = takeResults(loader, 1);
+    CORRADE_COMPARE(paths(results), (std::vector<std::string>{"wanted"}));
+    CORRADE_COMPARE(decoder.started(), (std::vector<std::string>{"busy", "wanted"}));
+    CORRADE_COMPARE(loader.cancelledCount(), 1);
+    CORRADE_COMPARE(loader.droppedCount(), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+
+    // Cancelling what was taken already does nothing
+    loader.cancel(results.front().id);
+    CORRADE_COMPARE(loader.cancelledCount(), 1);
+}
+
+void ImageLoaderTest::CancelWhileFull()
+{
+    FakeDecoder decoder;
+    // A queue of a single result, which the first one fills
+    ImageLoader loader{1, decoder.factory(), nullptr, 1};
+
+    loader.request("first");
+    const ImageLoader::Id second = loader.request("second");
+    decoder.waitForStarted(2);
+
+    // The worker waiting for room with the second result is woken up and drops it, without anything being taken
+    loader.cancel(second);
+    CORRADE_VERIFY(waitFor([&] { return loader.droppedCount() == 1; }));
+    CORRADE_COMPARE(paths(takeResults(loader, 1)), (std::vector<std::string>{"first"}));
+    CORRADE_VERIFY(!loader.take());
+}
+
+void ImageLoaderTest::Failed()
+{
+    FakeDecoder decoder;
+    ImageLoader loader{2, decoder.factory()};
+
+    loader.request("broken");
+    const std::vector<ImageLoader::Result> results = takeResults(loader, 1);
+    CORRADE_COMPARE(results.size(), 1);
+    CORRADE_COMPARE(results.front().path, "broken");
+    CORRADE_VERIFY(!results.front().image);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+}
+
+void ImageLoaderTest::ConvertGray()
+{
+    const char        data[]{'\x10', '\xf0'};
+    const ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 1}, data};
+
+    const std::optional<Image2D> rgba = ImageLoader::toRgba8(image);
+    CORRADE_VERIFY(rgba);
+    CORRADE_COMPARE(rgba->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(rgba->pixels<Color4ub>()[0][0], (Color4ub{0x10, 0x10, 0x10, 0xff}));
+    CORRADE_COMPARE(rgba->pixels<Color4ub>()[0][1], (Color4ub{0xf0, 0xf0, 0xf0, 0xff}));
+}
+
+void ImageLoaderTest::ConvertGrayAlpha()
+{
+    const char        data[]{'\x10', '\x80', '\xf0', '\x00'};
+    const ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::RG8Unorm, {1, 2}, data};
+
+    // Rows stay in the order they were in
+    const std::optional<Image2D> rgba = ImageLoader::toRgba8(image);
+    CORRADE_VERIFY(rgba);
+    CORRADE_COMPARE(rgba->pixels<Color4ub>()[0][0], (Color4ub{0x10, 0x10, 0x10, 0x80}));
+    CORRADE_COMPARE(rgba->pixels<Color4ub>()[1][0], (Color4ub{0xf0, 0xf0, 0xf0, 0x00}));
+}
+
+void ImageLoaderTest::Convert16Bit()
+{
+    // The most significant byte of every channel is kept, gray is spread like with 8 bits
+    const UnsignedShort          rgbaData[]{0x1234, 0xabcd, 0x00ff, 0xff00};
+    const std::optional<Image2D> rgba =
+        ImageLoader::toRgba8(ImageView2D{PixelFormat::RGBA16Unorm, {1, 1}, Containers::arrayView(rgbaData)});
+    CORRADE_VERIFY(rgba);
+    CORRADE_COMPARE(rgba->pixels<Color4ub>()[0][0], (Color4ub{0x12, 0xab, 0x00, 0xff}));
+
+    const UnsignedShort          grayData[]{0x8001, 0};
+    const std::optional<Image2D> gray =
+        ImageLoader::toRgba8(ImageView2D{PixelFormat::R16Unorm, {2, 1}, Containers::arrayView(grayData)});
+    CORRADE_VERIFY(gray);
+    CORRADE_COMPARE(gray->pixels<Color4ub>()[0][0], (Color4ub{0x80, 0x80, 0x80, 0xff}));
+
+    // Neither 8 nor 16 bits per channel
+    const Float        floatData[]{0.5f};
+    std::ostringstream out;
+    Error              redirectError{&out};
+    CORRADE_VERIFY(!ImageLoader::toRgba8(ImageView2D{PixelFormat::R32F, {1, 1}, Containers::arrayView(floatData)}));
+    CORRADE_COMPARE(out.str(), "ImageLoader: can't convert PixelFormat::R32F to RGBA8\n");
+}
+
+void ImageLoaderTest::ImporterDecoder()
+{
+    {
+        PluginManager::Manager<Trade::AbstractImporter> manager;
+        if (!(manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+            !(manager.load("TgaImporter") & PluginManager::LoadState::Loaded))
+            CORRADE_SKIP("AnyImageImporter or TgaImporter can't be loaded.");
+    }
+
+    /* Uncompressed 24-bit TGA of 3 x 2 pixels: an 18-byte header, then BGR pixels with rows from the bottom, which
+       every Magnum build can import without external libraries */
+    constexpr Vector2i size{3, 2};
+    std::string        data(18 + std::size_t(size.product()) * 3, '\0');
+    data[2]  = 2;
+    data[12] = char(size.x());
+    data[14] = char(size.y());
+    data[16] = 24;
+    for (Int y = 0; y != size.y(); ++y)
+        for (Int x = 0; x != size.x(); ++x)
+        {
+            const Color4ub pixel = expectedPixel(x, y);
+            char* const    bgr   = data.data() + 18 + std::size_t(y * size.x() + x) * 3;
+
+            bgr[0] = char(pixel.b());
+            bgr[1] = char(pixel.g());
+            bgr[2] = char(pixel.r());
+        }
+
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string file      = Utility::Path::join(directory, "ImageLoaderTest.tga");
+    CORRADE_VERIFY(Utility::Path::write(file, Containers::ArrayView<const char>{data.data(), data.size()}));
+
+    const ImageLoader::Decoder   decode = ImageLoader::importerDecoder()();
+    const std::optional<Image2D> image  = decode(file);
+    Utility::Path::remove(file);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(image->size(), size);
+
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image->pixels<Color4ub>();
+    for (Int y = 0; y != size.y(); ++y)
+        for (Int x = 0; x != size.x(); ++x)
+        {
+            CORRADE_ITERATION(Vector2i(x, y));
+            CORRADE_COMPARE(pixels[std::size_t(y)][std::size_t(x)], expectedPixel(x, y));
+        }
+
+    CORRADE_VERIFY(!decode(Utility::Path::join(directory, "ImageLoaderTestMissing.tga")));
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::ImageLoaderTest)
@@ -0,0 +1,116 @@
+#include "../render/RenderTarget.h"
+#include "../shaders/InfiniteGridShader.h"
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/PixelFormat.h>
+#include <algorithm>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i TargetSize{256, 256};
+
+struct InfiniteGridGLTest : GL::OpenGLTester
+{
+    explicit InfiniteGridGLTest();
+
+    void Lines();
+    void FarAway();
+    void LookingAway();
+
+private:
+    /// Renders the grid seen from @p height above it, looking down or up, and reads the colour back.
+    Image2D render(Float height, bool lookingUp = false);
+
+    RenderTarget       target_{TargetSize};
+    InfiniteGridShader shader_;
+    GL::Mesh           triangle_{InfiniteGridShader::fullScreenTriangle()};
+};
+
+InfiniteGridGLTest::InfiniteGridGLTest()
+{
+    addTests({&InfiniteGridGLTest::Lines});
+    addTests({&InfiniteGridGLTest::FarAway});
+    addTests({&InfiniteGridGLTest::LookingAway});
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::SourceAlpha,
+                                   GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+}
+
+Image2D InfiniteGridGLTest::render(const Float height, const bool lookingUp)
+{
+    using namespace Math::Literals;
+
+    // A 90 degree field of view sees 2 * height units across
+    const Matrix4 camera = Matrix4::translation(Vector3::zAxis(height)) *
+                           (lookingUp ? Matrix4::rotationX(180.0_degf) : Matrix4{});
+    const Matrix4 projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, height * 0.001f, height * 10.0f);
+
+    target_.clear().framebuffer().bind();
+    shader_.setColor(0xffffff_rgbf)
+        .setMajorColor(0xffffff_rgbf)
+        .setTransformationProjectionMatrix(projection * camera.inverted())
+        .draw(triangle_);
+    target_.resolve();
+
+    return target_.resolvedFramebuffer().read(target_.viewport(), {PixelFormat::RGBA8Unorm});
+}
+
+std::size_t litPixels(const Image2D& image)
+{
+    std::size_t count = 0;
+    for (const auto row : image.pixels<Color4ub>())
+        count += std::size_t(std::count_if(row.begin(), row.end(), [](const Color4ub& c) { return c.r() != 0; }));
+    return count;
+}
+
+void InfiniteGridGLTest::Lines()
+{
+    // 20 units over 256 pixels is 12.8 pixels per unit, so only the finest lines are one unit apart
+    const Image2D image  = render(10.0f);
+    const auto    pixels = image.pixels<Color4ub>();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    // The line at x = 0 runs between the two middle columns, a pixel row at y = -4.5 is between two lines
+    CORRADE_COMPARE_AS(pixels[70][127].r(), 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(pixels[70][128].r(), 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE(pixels[70][134].r(), 0);
+}
+
+void InfiniteGridGLTest::FarAway()
+{
+    // The grid doesn't end, and the line spacing follows the distance so the lines neither vanish nor turn into a
+    // solid area
+    const Image2D image = render(10000.0f);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const std::size_t lit = litPixels(image);
+    CORRADE_COMPARE_AS(lit, 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(lit, std::size_t(TargetSize.product()) / 2, TestSuite::Compare::Less);
+}
+
+void InfiniteGridGLTest::LookingAway()
+{
+    const Image2D image = render(10.0f, true);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(litPixels(image), 0);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::InfiniteGridGLTest)
@@ -0,0 +1,166 @@
+#include "../render/LabelInstances.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Angle.h>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct LabelInstancesTest : Corrade::TestSuite::Tester
+{
+    explicit LabelInstancesTest();
+
+    void Layout();
+    void Scale();
+    void SpacesAndMissingGlyphs();
+    void Culling();
+    void DeclutterByPriority();
+    void DeclutterByDepth();
+    void ManyLabels();
+};
+
+LabelInstancesTest::LabelInstancesTest()
+{
+    addTests({&LabelInstancesTest::Layout});
+    addTests({&LabelInstancesTest::Scale});
+    addTests({&LabelInstancesTest::SpacesAndMissingGlyphs});
+    addTests({&LabelInstancesTest::Culling});
+    addTests({&LabelInstancesTest::DeclutterByPriority});
+    addTests({&LabelInstancesTest::DeclutterByDepth});
+    addTests({&LabelInstancesTest::ManyLabels});
+}
+
+// Monospaced glyphs, 8 px wide and 12 px above the baseline, with the character code in the texture coordinates
+GlyphAtlas monospaceAtlas()
+{
+    GlyphAtlas atlas{16.0f, 4.0f};
+    atlas.add(' ', {{}, {}, 8.0f});
+    for (char c = '!'; c != 127; ++c)
+        atlas.add(c, {{{0.0f, 0.0f}, {8.0f, 12.0f}}, {{Float(c), 0.0f}, {Float(c), 1.0f}}, 8.0f});
+    return atlas;
+}
+
+Matrix4 perspective()
+{
+    using namespace Math::Literals;
+    return Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 10.0f);
+}
+
+void LabelInstancesTest::Layout()
+{
+    LabelInstances instances;
+    instances.update({{{}, "ab", Color4{1.0f, 0.0f, 0.0f}, 0.0f, 7}}, monospaceAtlas(), Matrix4{}, {200, 100});
+
+    // Centred above the anchor at the center of the viewport, the baseline above the descent
+    CORRADE_COMPARE(instances.size(), 2);
+    CORRADE_COMPARE(instances.placed()[0], (Range2D{{92.0f, 54.0f}, {108.0f, 70.0f}}));
+    CORRADE_COMPARE(instances.instances()[0].rectangle, (Vector4{92.0f, 58.0f, 100.0f, 70.0f}));
+    CORRADE_COMPARE(instances.instances()[1].rectangle, (Vector4{100.0f, 58.0f, 108.0f, 70.0f}));
+    CORRADE_COMPARE(instances.instances()[1].textureCoordinates, (Vector4{Float('b'), 0.0f, Float('b'), 1.0f}));
+    CORRADE_COMPARE(instances.instances()[0].color, (Color4{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(instances.instances()[0].objectId, 7);
+    CORRADE_COMPARE(instances.stats().drawn, 1);
+}
+
+void LabelInstancesTest::Scale()
+{
+    // A pane rendering at twice the resolution it's shown at needs twice as large glyphs
+    LabelInstances instances;
+    instances.update({{{}, "ab"}}, monospaceAtlas(), Matrix4{}, {200, 100}, 2.0f);
+
+    CORRADE_COMPARE(instances.placed()[0], (Range2D{{84.0f, 58.0f}, {116.0f, 90.0f}}));
+    CORRADE_COMPARE(instances.instances()[0].rectangle, (Vector4{84.0f, 66.0f, 100.0f, 90.0f}));
+}
+
+void LabelInstancesTest::SpacesAndMissingGlyphs()
+{
+    LabelInstances instances;
+    instances.update({{{}, "a b\x01"}}, monospaceAtlas(), Matrix4{}, {200, 100});
+
+    // The space moves the pen without an instance, the unknown character takes no space
+    CORRADE_COMPARE(instances.size(), 2);
+    CORRADE_COMPARE(instances.placed()[0].sizeX(), 24.0f);
+    CORRADE_COMPARE(instances.instances()[1].rectangle.x(), instances.instances()[0].rectangle.x() + 16.0f);
+}
+
+void LabelInstancesTest::Culling()
+{
+    LabelInstances           instances;
+    const std::vector<Label> labels{
+        {{0.0f, 0.0f, -1.0f}, "visible"},
+        {{0.0f, 0.0f, 1.0f}, "behind"},
+        {{0.0f, 0.0f, -20.0f}, "beyond the far plane"},
+        {{50.0f, 0.0f, -1.0f}, "right of the viewport"},
+        // The anchor is just below the viewport, but the text is above it
+        {{0.0f, -1.02f, -1.0f}, "partially visible"},
+    };
+    instances.update(labels, monospaceAtlas(), perspective(), {100, 100});
+
+    CORRADE_COMPARE(instances.stats().drawn, 2);
+    CORRADE_COMPARE(instances.stats().culled, 3);
+    CORRADE_COMPARE(instances.stats().decluttered, 0);
+}
+
+void LabelInstancesTest::DeclutterByPriority()
+{
+    LabelInstances           instances;
+    const std::vector<Label> labels{
+        {{}, "low", Color4{}, 0.0f, 1},
+        {{}, "high", Color4{}, 1.0f, 2},
+        // Far enough away to not overlap
+        {{0.5f, 0.5f, 0.0f}, "other", Color4{}, -1.0f, 3},
+    };
+    instances.update(labels, monospaceAtlas(), Matrix4{}, {400, 400});
+
+    CORRADE_COMPARE(instances.stats().drawn, 2);
+    CORRADE_COMPARE(instances.stats().decluttered, 1);
+    CORRADE_COMPARE(instances.instances()[0].objectId, 2);
+    CORRADE_COMPARE(instances.instances().back().objectId, 3);
+}
+
+void LabelInstancesTest::DeclutterByDepth()
+{
+    // Two labels on the same view ray, the nearer one wins
+    LabelInstances           instances;
+    const std::vector<Label> labels{
+        {{0.0f, 0.0f, -4.0f}, "far", Color4{}, 0.0f, 1},
+        {{0.0f, 0.0f, -2.0f}, "near", Color4{}, 0.0f, 2},
+    };
+    instances.update(labels, monospaceAtlas(), perspective(), {400, 400});
+
+    CORRADE_COMPARE(instances.stats().drawn, 1);
+    CORRADE_COMPARE(instances.stats().decluttered, 1);
+    CORRADE_COMPARE(instances.instances()[0].objectId, 2);
+}
+
+void LabelInstancesTest::ManyLabels()
+{
+    // A 100x100 grid of labels 10 px apart, each 24x16 px, so most of them overlap
+    std::vector<Label> labels;
+    for (Int y = 0; y != 100; ++y)
+        for (Int x = 0; x != 100; ++x)
+            labels.push_back({{Float(x) / 50.0f - 1.0f, Float(y) / 50.0f - 1.0f, 0.0f}, "123"});
+
+    LabelInstances instances;
+    instances.update(labels, monospaceAtlas(), Matrix4{}, {1000, 1000});
+
+    const LabelInstances::Stats& stats = instances.stats();
+    CORRADE_COMPARE(stats.drawn + stats.decluttered + stats.culled, labels.size());
+    CORRADE_COMPARE(instances.size(), stats.drawn * 3);
+    CORRADE_VERIFY(stats.drawn > 1000);
+    CORRADE_VERIFY(stats.decluttered > 5000);
+
+    const std::vector<Range2D>& placed = instances.placed();
+    for (std::size_t i = 0; i != placed.size(); ++i)
+        for (std::size_t j = i + 1; j != placed.size(); ++j)
+            CORRADE_VERIFY(!Math::intersects(placed[i], placed[j]));
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::LabelInstancesTest)
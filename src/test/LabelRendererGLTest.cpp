@@ -0,0 +1,116 @@
+#include "../render/LabelRenderer.h"
+#include "../render/RenderTarget.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i TargetSize{64, 64};
+
+struct LabelRendererGLTest : GL::OpenGLTester
+{
+    explicit LabelRendererGLTest();
+
+    void DrawGlyphs();
+    void NothingVisible();
+
+private:
+    Color4ub    colorAt(RenderTarget& target, const Vector2i& position);
+    UnsignedInt objectIdAt(RenderTarget& target, const Vector2i& position);
+
+    GpuResources  resources_;
+    GL::Texture2D glyphs_;
+    GlyphAtlas    atlas_{16.0f, 4.0f};
+};
+
+LabelRendererGLTest::LabelRendererGLTest()
+{
+    addTests({&LabelRendererGLTest::DrawGlyphs});
+    addTests({&LabelRendererGLTest::NothingVisible});
+
+    // Every glyph is a solid 8x12 block
+    Containers::Array<Color4ub> texels{DirectInit, 16, Color4ub{255}};
+    glyphs_.setStorage(1, GL::TextureFormat::RGBA8, {4, 4})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, Containers::arrayView(texels)});
+    for (char c = 'a'; c <= 'z'; ++c)
+        atlas_.add(c, {{{0.0f, 0.0f}, {8.0f, 12.0f}}, {{0.25f, 0.25f}, {0.75f, 0.75f}}, 8.0f});
+
+    // LabelRenderer::Features
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+}
+
+Color4ub LabelRendererGLTest::colorAt(RenderTarget& target, const Vector2i& position)
+{
+    const Image2D image = target.resolvedFramebuffer().read(Range2Di::fromSize(position, Vector2i{1}),
+                                                            {PixelFormat::RGBA8Unorm});
+    return image.pixels<Color4ub>()[0][0];
+}
+
+UnsignedInt LabelRendererGLTest::objectIdAt(RenderTarget& target, const Vector2i& position)
+{
+    GL::Framebuffer& framebuffer = target.resolvedFramebuffer();
+    framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{1});
+    const Image2D image = framebuffer.read(Range2Di::fromSize(position, Vector2i{1}),
+                                           {GL::PixelFormat::RedInteger, GL::PixelType::UnsignedInt});
+    framebuffer.mapForRead(GL::Framebuffer::ColorAttachment{0});
+    return image.pixels<UnsignedInt>()[0][0];
+}
+
+void LabelRendererGLTest::DrawGlyphs()
+{
+    RenderTarget  target{TargetSize};
+    LabelRenderer renderer{resources_, atlas_, glyphs_};
+
+    // Centred above the middle of the target: "ab" covers x in [24, 40) and y in [40, 52)
+    const std::vector<Label> labels{
+        {{}, "ab", Color4{1.0f, 0.0f, 0.0f}, 0.0f, 5},
+        {{}, "hidden", Color4{0.0f, 1.0f, 0.0f}, -1.0f, 6},
+    };
+    target.clear().framebuffer().bind();
+    renderer.draw(labels, Matrix4{}, TargetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(renderer.drawCallCount(), 1);
+    CORRADE_COMPARE(renderer.instances().size(), 2);
+    CORRADE_COMPARE(renderer.instances().stats().decluttered, 1);
+
+    CORRADE_COMPARE(colorAt(target, {26, 42}), (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(colorAt(target, {38, 50}), (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(objectIdAt(target, {26, 42}), 5);
+
+    // Below the text, between the anchor and the baseline
+    CORRADE_COMPARE(colorAt(target, {32, 34}), (Color4ub{0, 0, 0, 0}));
+    CORRADE_COMPARE(objectIdAt(target, {32, 34}), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void LabelRendererGLTest::NothingVisible()
+{
+    RenderTarget  target{TargetSize};
+    LabelRenderer renderer{resources_, atlas_, glyphs_};
+
+    target.clear().framebuffer().bind();
+    renderer.draw({{{5.0f, 0.0f, 0.0f}, "outside"}}, Matrix4{}, TargetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(renderer.drawCallCount(), 0);
+    CORRADE_COMPARE(renderer.instances().stats().culled, 1);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::LabelRendererGLTest)
@@ -0,0 +1,85 @@
+#include "../render/LayoutOverlay.h"
+
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i WindowSize{64, 64};
+
+struct LayoutOverlayGLTest : GL::OpenGLTester
+{
+    explicit LayoutOverlayGLTest();
+
+    void SingleDrawCall();
+    void UploadOnlyOnChange();
+
+private:
+    GpuResources     resources_;
+    GL::Renderbuffer color_;
+    GL::Framebuffer  framebuffer_{{{}, WindowSize}};
+};
+
+LayoutOverlayGLTest::LayoutOverlayGLTest()
+{
+    addTests({&LayoutOverlayGLTest::SingleDrawCall});
+    addTests({&LayoutOverlayGLTest::UploadOnlyOnChange});
+
+    color_.setStorage(GL::RenderbufferFormat::RGBA8, WindowSize);
+    framebuffer_.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color_);
+}
+
+void LayoutOverlayGLTest::SingleDrawCall()
+{
+    LayoutOverlay    overlay{resources_};
+    OverlayInstances instances{WindowSize};
+    for (Int y = 0; y != 4; ++y)
+        for (Int x = 0; x != 4; ++x)
+            instances.addBorder(Range2D::fromSize(Vector2{Vector2i{x, y} * 16}, Vector2{16.0f}), Color4{1.0f});
+    instances.addEdge({{16.0f, 0.0f}, {16.0f, 64.0f}}, Color4{1.0f}, 4.0f);
+
+    framebuffer_.clear(GL::FramebufferClear::Color).bind();
+    overlay.draw(instances);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(overlay.drawCallCount(), 1);
+
+    // The top left corner is on a border, the center of the first pane isn't
+    const Image2D image = framebuffer_.read({{}, WindowSize}, {PixelFormat::RGBA8Unorm});
+    const auto    pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[WindowSize.y() - 1][0], (Color4ub{255, 255, 255, 255}));
+    CORRADE_COMPARE(pixels[WindowSize.y() - 8][8], (Color4ub{0, 0, 0, 0}));
+}
+
+void LayoutOverlayGLTest::UploadOnlyOnChange()
+{
+    LayoutOverlay    overlay{resources_};
+    OverlayInstances instances{WindowSize};
+    instances.addBorder({{}, Vector2{WindowSize}}, Color4{1.0f});
+
+    framebuffer_.bind();
+    overlay.draw(instances);
+    overlay.draw(instances);
+    CORRADE_COMPARE(overlay.uploadCount(), 1);
+
+    instances.addEdge({{32.0f, 0.0f}, {32.0f, 64.0f}}, Color4{1.0f}, 4.0f);
+    overlay.draw(instances);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(overlay.uploadCount(), 2);
+    CORRADE_COMPARE(overlay.drawCallCount(), 3);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::LayoutOverlayGLTest)
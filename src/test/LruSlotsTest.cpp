@@ -0,0 +1,86 @@
+#include "../containers/LruSlots.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct LruSlotsTest : Corrade::TestSuite::Tester
+{
+    explicit LruSlotsTest();
+
+    void Fill();
+    void EvictLeastRecentlyUsed();
+    void KeepUsedThisFrame();
+};
+
+LruSlotsTest::LruSlotsTest()
+{
+    addTests({&LruSlotsTest::Fill});
+    addTests({&LruSlotsTest::EvictLeastRecentlyUsed});
+    addTests({&LruSlotsTest::KeepUsedThisFrame});
+}
+
+void LruSlotsTest::Fill()
+{
+    LruSlots slots{3};
+    CORRADE_COMPARE(slots.insert(10), 0);
+    CORRADE_COMPARE(slots.insert(20), 1);
+    CORRADE_COMPARE(slots.insert(30), 2);
+    CORRADE_COMPARE(slots.size(), 3);
+
+    CORRADE_COMPARE(slots.find(20), 1);
+    CORRADE_VERIFY(!slots.find(40));
+    CORRADE_COMPARE(slots.evictionCount(), 0);
+}
+
+void LruSlotsTest::EvictLeastRecentlyUsed()
+{
+    LruSlots slots{3};
+    slots.insert(10);
+    slots.insert(20);
+    slots.insert(30);
+
+    // 20 was used last, then 10, so 30 is the least recently used one
+    slots.nextFrame();
+    slots.find(10);
+    slots.find(20);
+
+    CORRADE_VERIFY(slots.canInsert());
+    CORRADE_COMPARE(slots.insert(40), 2);
+    CORRADE_VERIFY(!slots.find(30));
+    CORRADE_COMPARE(slots.find(40), 2);
+    CORRADE_COMPARE(slots.size(), 3);
+    CORRADE_COMPARE(slots.evictionCount(), 1);
+}
+
+void LruSlotsTest::KeepUsedThisFrame()
+{
+    LruSlots slots{2};
+    slots.insert(10);
+    slots.insert(20);
+
+    // Both are used in this frame, so there's no room until the next one
+    CORRADE_VERIFY(!slots.canInsert());
+    CORRADE_VERIFY(!slots.insert(30));
+    CORRADE_COMPARE(slots.find(10), 0);
+
+    slots.nextFrame();
+    slots.find(10);
+    CORRADE_VERIFY(slots.canInsert());
+    CORRADE_COMPARE(slots.insert(30), 1);
+    CORRADE_VERIFY(!slots.find(20));
+
+    // 10 and 30 are used in this frame now
+    CORRADE_VERIFY(!slots.canInsert());
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::LruSlotsTest)
@@ -0,0 +1,233 @@
+#include "../render/MultiViewRenderer.h"
+#include "../render/TransformCache.h"
+
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+#include <memory>
+#include <vector>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i FramebufferSize{1024, 1024};
+constexpr Int      CubesPerSide = 16; // 256 drawables
+
+const struct
+{
+    Int panesPerSide;
+} PaneData[]{{2}, {4}, {8}};
+
+class Cube : public Object3D, public SceneDrawable
+{
+public:
+    explicit Cube(Object3D* parent, SceneGraph::DrawableGroup3D& drawables, GL::Mesh& mesh, Shaders::FlatGL3D& shader)
+    : Object3D(parent)
+    , SceneDrawable(static_cast<Object3D&>(*this), &drawables)
+    , mesh_(mesh)
+    , shader_(shader)
+    {
+        setBoundingBox({{-1.0f}, {1.0f}});
+    }
+
+    void draw(const Matrix4& transformation, SceneGraph::Camera3D& camera) override
+    {
+        shader_.setTransformationProjectionMatrix(camera.projectionMatrix() * transformation).draw(mesh_);
+    }
+
+    bool drawMultiView(const Matrix4& worldTransformation, MultiViewShaders& shaders) override
+    {
+        shaders.triangles.setTransformationMatrix(worldTransformation).draw(mesh_);
+        return true;
+    }
+
+private:
+    GL::Mesh&          mesh_;
+    Shaders::FlatGL3D& shader_;
+};
+
+struct MultiViewGLBenchmark : GL::OpenGLTester
+{
+    explicit MultiViewGLBenchmark();
+
+    void SameImage();
+
+    void PerPaneLoop();
+    void MultiView();
+
+private:
+    void setupPanes(Int panesPerSide);
+    void drawPerPane();
+
+    GL::Renderbuffer color_;
+    GL::Renderbuffer depth_;
+    GL::Framebuffer  framebuffer_{{{}, FramebufferSize}};
+
+    GL::Mesh                           mesh_;
+    Shaders::FlatGL3D                  shader_;
+    Scene3D                            scene_;
+    SceneGraph::DrawableGroup3D        drawables_;
+    std::vector<std::unique_ptr<Cube>> cubes_;
+
+    std::vector<std::unique_ptr<Object3D>>             cameraObjects_;
+    std::vector<std::unique_ptr<SceneGraph::Camera3D>> cameras_;
+    std::vector<MultiViewRenderer::View>               views_;
+    TransformCache                                     cache_;
+};
+
+MultiViewGLBenchmark::MultiViewGLBenchmark()
+{
+    addTests({&MultiViewGLBenchmark::SameImage});
+
+    // Each iteration draws all the panes once, with the pane count as the instance
+    addInstancedBenchmarks({&MultiViewGLBenchmark::PerPaneLoop, &MultiViewGLBenchmark::MultiView}, 10,
+                           Containers::arraySize(PaneData));
+
+    color_.setStorage(GL::RenderbufferFormat::RGBA8, FramebufferSize);
+    depth_.setStorage(GL::RenderbufferFormat::DepthComponent24, FramebufferSize);
+    framebuffer_.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color_)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth_);
+
+    mesh_ = MeshTools::compile(Primitives::cubeSolid());
+    shader_.setColor(Color3{1.0f});
+    for (Int y = 0; y != CubesPerSide; ++y)
+    {
+        for (Int x = 0; x != CubesPerSide; ++x)
+        {
+            auto& cube = *cubes_.emplace_back(std::make_unique<Cube>(&scene_, drawables_, mesh_, shader_));
+            cube.scale(Vector3{0.4f}).translate({Float(x - CubesPerSide / 2), Float(y - CubesPerSide / 2), 0.0f});
+        }
+    }
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void MultiViewGLBenchmark::setupPanes(const Int panesPerSide)
+{
+    using namespace Math::Literals;
+
+    cameras_.clear();
+    cameraObjects_.clear();
+    views_.clear();
+
+    const Vector2i paneSize = FramebufferSize / panesPerSide;
+    for (Int y = 0; y != panesPerSide; ++y)
+    {
+        for (Int x = 0; x != panesPerSide; ++x)
+        {
+            // Every pane looks at the whole scene from a slightly different place
+            auto& object = *cameraObjects_.emplace_back(std::make_unique<Object3D>(&scene_));
+            object.translate({Float(x) * 0.1f, Float(y) * 0.1f, 20.0f});
+            auto& camera = *cameras_.emplace_back(std::make_unique<SceneGraph::Camera3D>(object));
+            camera.setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 100.0f));
+
+            views_.push_back({Range2Di::fromSize(Vector2i{x, y} * paneSize, paneSize), camera.projectionMatrix(),
+                              camera.cameraMatrix()});
+        }
+    }
+
+    cache_.update(drawables_);
+}
+
+void MultiViewGLBenchmark::drawPerPane()
+{
+    for (std::size_t i = 0; i != cameras_.size(); ++i)
+    {
+        framebuffer_.setViewport(views_[i].viewport);
+        cache_.draw(*cameras_[i]);
+    }
+    framebuffer_.setViewport({{}, FramebufferSize});
+}
+
+void MultiViewGLBenchmark::SameImage()
+{
+    if (!MultiViewRenderer::isSupported())
+        CORRADE_SKIP("GL_ARB_viewport_array or geometry shaders are not supported.");
+
+    setupPanes(2);
+    MultiViewRenderer renderer;
+
+    framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth).bind();
+    drawPerPane();
+    const Image2D perPane = framebuffer_.read({{}, FramebufferSize}, {PixelFormat::RGBA8Unorm});
+
+    framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth);
+    const auto stats = renderer.draw(framebuffer_, cache_, views_);
+    const Image2D multiView = framebuffer_.read({{}, FramebufferSize}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(renderer.passCount(), 1);
+    CORRADE_COMPARE(renderer.unsupportedCount(), 0);
+    CORRADE_COMPARE(stats.drawn, cubes_.size());
+
+    // Same pixels at the center of every pane
+    for (const MultiViewRenderer::View& view : views_)
+    {
+        CORRADE_ITERATION(view.viewport);
+        const Vector2i center = view.viewport.center();
+        CORRADE_COMPARE(multiView.pixels<Color4ub>()[center.y()][center.x()],
+                        perPane.pixels<Color4ub>()[center.y()][center.x()]);
+    }
+}
+
+void MultiViewGLBenchmark::PerPaneLoop()
+{
+    const Int panesPerSide = PaneData[testCaseInstanceId()].panesPerSide;
+    setTestCaseDescription(Utility::format("{} panes", panesPerSide * panesPerSide));
+    setupPanes(panesPerSide);
+
+    framebuffer_.bind();
+    CORRADE_BENCHMARK(10)
+    {
+        framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth);
+        drawPerPane();
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MultiViewGLBenchmark::MultiView()
+{
+    if (!MultiViewRenderer::isSupported())
+        CORRADE_SKIP("GL_ARB_viewport_array or geometry shaders are not supported.");
+
+    const Int panesPerSide = PaneData[testCaseInstanceId()].panesPerSide;
+    setTestCaseDescription(Utility::format("{} panes", panesPerSide * panesPerSide));
+    setupPanes(panesPerSide);
+    MultiViewRenderer renderer;
+
+    framebuffer_.bind();
+    CORRADE_BENCHMARK(10)
+    {
+        framebuffer_.clear(GL::FramebufferClear::Color | GL::FramebufferClear::Depth);
+        renderer.draw(framebuffer_, cache_, views_);
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.passCount(), (views_.size() + MultiViewFlatShader::MaxViews - 1) /
+                                              MultiViewFlatShader::MaxViews);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::MultiViewGLBenchmark)
@@ -0,0 +1,153 @@
+#include "../render/ObjectIdReader.h"
+#include "../render/RenderTarget.h"
+
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/Primitives/Plane.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+constexpr Vector2i TargetSize{256, 256};
+// What pick() returns if the readback didn't finish
+constexpr UnsignedInt NotReady = ~0u;
+
+const struct
+{
+    Int samples;
+} SampleData[]{{0}, {4}};
+
+struct ObjectIdPickingGLTest : GL::OpenGLTester
+{
+    explicit ObjectIdPickingGLTest();
+
+    void Pick();
+    void NearestInWindow();
+    void PickPoint();
+
+private:
+    UnsignedInt pick(RenderTarget& target, const Vector2i& position);
+
+    GL::Mesh          plane_;
+    Shaders::FlatGL3D shader_{Shaders::FlatGL3D::Configuration{}.setFlags(Shaders::FlatGL3D::Flag::ObjectId)};
+};
+
+ObjectIdPickingGLTest::ObjectIdPickingGLTest()
+{
+    addInstancedTests({&ObjectIdPickingGLTest::Pick}, Containers::arraySize(SampleData));
+    addTests({&ObjectIdPickingGLTest::NearestInWindow, &ObjectIdPickingGLTest::PickPoint});
+
+    plane_ = MeshTools::compile(Primitives::planeSolid());
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+UnsignedInt ObjectIdPickingGLTest::pick(RenderTarget& target, const Vector2i& position)
+{
+    ObjectIdReader reader;
+    reader.pick(target.resolvedFramebuffer(), position);
+
+    GL::Renderer::finish();
+    reader.update();
+    return reader.takeResult().value_or(NotReady);
+}
+
+void ObjectIdPickingGLTest::Pick()
+{
+    auto&& data = SampleData[testCaseInstanceId()];
+    setTestCaseDescription(Utility::format("{} samples", data.samples));
+
+    using namespace Math::Literals;
+
+    RenderTarget target{TargetSize, data.samples};
+    target.clear().framebuffer().bind();
+
+    // Object 7 covers the left half, object 9 the bottom right quarter in front of it
+    shader_.setColor(0x2f83cc_rgbf)
+        .setObjectId(7)
+        .setTransformationProjectionMatrix(Matrix4::translation({-0.5f, 0.0f, 0.0f}) *
+                                           Matrix4::scaling({0.5f, 1.0f, 1.0f}))
+        .draw(plane_);
+    shader_.setColor(0xdcdcdc_rgbf)
+        .setObjectId(9)
+        .setTransformationProjectionMatrix(Matrix4::translation({0.5f, -0.5f, -0.5f}) * Matrix4::scaling(Vector3{0.5f}))
+        .draw(plane_);
+    target.resolve();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(pick(target, {64, 128}), 7);
+    CORRADE_COMPARE(pick(target, {192, 64}), 9);
+    // Nothing was drawn there, the colour of the clear doesn't leak into the IDs
+    CORRADE_COMPARE(pick(target, {192, 192}), 0);
+    // Outside of the target
+    ObjectIdReader reader;
+    reader.pick(target.resolvedFramebuffer(), {1000, 1000});
+    CORRADE_VERIFY(!reader.isPending());
+    CORRADE_VERIFY(reader.takeResult() == 0u);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ObjectIdPickingGLTest::NearestInWindow()
+{
+    RenderTarget target{TargetSize};
+    target.clear().framebuffer().bind();
+
+    // Object 3 ends at pixel column 128, so a click slightly to the right of the edge still hits it
+    shader_.setObjectId(3)
+        .setTransformationProjectionMatrix(Matrix4::translation({-0.5f, 0.0f, 0.0f}) *
+                                           Matrix4::scaling({0.5f, 1.0f, 1.0f}))
+        .draw(plane_);
+    target.resolve();
+
+    CORRADE_COMPARE(pick(target, {129, 128}), 3);
+    CORRADE_COMPARE(pick(target, {140, 128}), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ObjectIdPickingGLTest::PickPoint()
+{
+    struct Vertex
+    {
+        Vector3     position;
+        UnsignedInt index;
+    };
+    // Like PointCloud, every point adds its index to the base ID of the drawable
+    const Vertex vertices[]{{{-0.5f, 0.0f, 0.0f}, 0}, {{0.5f, 0.5f, 0.0f}, 1}};
+
+    GL::Mesh points{GL::MeshPrimitive::Points};
+    points.setCount(Int(Containers::arraySize(vertices)))
+        .addVertexBuffer(GL::Buffer{vertices}, 0, Shaders::FlatGL3D::Position{}, Shaders::FlatGL3D::ObjectId{});
+
+    Shaders::FlatGL3D shader{Shaders::FlatGL3D::Configuration{}.setFlags(Shaders::FlatGL3D::Flag::InstancedObjectId)};
+    RenderTarget target{TargetSize};
+    target.clear().framebuffer().bind();
+    GL::Renderer::setPointSize(8.0f);
+    shader.setObjectId(100).draw(points);
+    GL::Renderer::setPointSize(1.0f);
+    target.resolve();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(pick(target, {64, 128}), 100);
+    CORRADE_COMPARE(pick(target, {192, 192}), 101);
+    CORRADE_COMPARE(pick(target, {192, 64}), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::ObjectIdPickingGLTest)
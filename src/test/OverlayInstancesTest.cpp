@@ -0,0 +1,98 @@
+#include "../render/OverlayInstances.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix3.h>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct OverlayInstancesTest : Corrade::TestSuite::Tester
+{
+    explicit OverlayInstancesTest();
+
+    void Rectangle();
+    void Border();
+    void Edge();
+    void Layout();
+};
+
+OverlayInstancesTest::OverlayInstancesTest()
+{
+    addTests({&OverlayInstancesTest::Rectangle});
+    addTests({&OverlayInstancesTest::Border});
+    addTests({&OverlayInstancesTest::Edge});
+    addTests({&OverlayInstancesTest::Layout});
+}
+
+// Where the corners of the unit square end up, in window coordinates
+Range2D windowRange(const OverlayInstances::Instance& instance, const Vector2i& windowSize)
+{
+    const auto toWindow = [&](const Vector2& clip)
+    { return Vector2{clip.x() + 1.0f, 1.0f - clip.y()} * Vector2{windowSize} / 2.0f; };
+
+    const Vector2 a = toWindow(instance.transformationMatrix.transformPoint({-1.0f, -1.0f}));
+    const Vector2 b = toWindow(instance.transformationMatrix.transformPoint({1.0f, 1.0f}));
+    return {Math::min(a, b), Math::max(a, b)};
+}
+
+void OverlayInstancesTest::Rectangle()
+{
+    OverlayInstances instances{{800, 600}};
+    instances.addRectangle({{100.0f, 50.0f}, {300.0f, 450.0f}}, Color4{1.0f});
+
+    CORRADE_COMPARE(instances.size(), 1);
+    CORRADE_COMPARE(windowRange(instances.instances()[0], {800, 600}), (Range2D{{100.0f, 50.0f}, {300.0f, 450.0f}}));
+
+    // The whole window covers the whole clip space
+    instances.clear();
+    instances.addRectangle({{}, {800.0f, 600.0f}}, Color4{1.0f});
+    CORRADE_COMPARE(instances.instances()[0].transformationMatrix, Matrix3{});
+}
+
+void OverlayInstancesTest::Border()
+{
+    OverlayInstances instances{{800, 600}};
+    instances.addBorder({{0.0f, 0.0f}, {400.0f, 300.0f}}, Color4{1.0f}, 2.0f);
+
+    CORRADE_COMPARE(instances.size(), 4);
+    CORRADE_COMPARE(windowRange(instances.instances()[0], {800, 600}), (Range2D{{0.0f, 0.0f}, {400.0f, 2.0f}}));
+    CORRADE_COMPARE(windowRange(instances.instances()[1], {800, 600}), (Range2D{{0.0f, 298.0f}, {400.0f, 300.0f}}));
+    CORRADE_COMPARE(windowRange(instances.instances()[2], {800, 600}), (Range2D{{0.0f, 2.0f}, {2.0f, 298.0f}}));
+    CORRADE_COMPARE(windowRange(instances.instances()[3], {800, 600}), (Range2D{{398.0f, 2.0f}, {400.0f, 298.0f}}));
+}
+
+void OverlayInstancesTest::Edge()
+{
+    OverlayInstances instances{{800, 600}};
+    instances.addEdge({{400.0f, 0.0f}, {400.0f, 600.0f}}, Color4{1.0f}, 4.0f);
+
+    CORRADE_COMPARE(instances.size(), 1);
+    CORRADE_COMPARE(windowRange(instances.instances()[0], {800, 600}), (Range2D{{398.0f, -2.0f}, {402.0f, 602.0f}}));
+}
+
+void OverlayInstancesTest::Layout()
+{
+    // A 4x4 grid of panes plus a highlighted edge is still a single batch, i.e. a single draw call
+    OverlayInstances instances{{1600, 1200}};
+    for (Int y = 0; y != 4; ++y)
+        for (Int x = 0; x != 4; ++x)
+            instances.addBorder(Range2D::fromSize({x * 400.0f, y * 300.0f}, {400.0f, 300.0f}), Color4{1.0f});
+    instances.addEdge({{400.0f, 0.0f}, {400.0f, 1200.0f}}, Color4{0.5f}, 4.0f);
+
+    CORRADE_COMPARE(instances.size(), 16 * 4 + 1);
+
+    // Resizing the window keeps nothing around
+    instances.clear({800, 600});
+    CORRADE_COMPARE(instances.size(), 0);
+    CORRADE_COMPARE(instances.windowSize(), (Vector2i{800, 600}));
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::OverlayInstancesTest)
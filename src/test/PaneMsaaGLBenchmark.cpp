@@ -0,0 +1,167 @@
+#include "../render/RenderTarget.h"
+
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Primitives/Icosphere.h>
+#include <Magnum/Shaders/FlatGL.h>
+#include <Magnum/Trade/MeshData.h>
+#include <memory>
+#include <vector>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+// A 1920x1080 window split into four panes
+constexpr Vector2i WindowSize{1920, 1080};
+constexpr Vector2i PaneSize{960, 540};
+constexpr Int      Panes = 4;
+// Enough geometry to make the sample count matter
+constexpr Int DrawsPerPane = 64;
+
+const struct
+{
+    Int samples;
+} SampleData[]{{0}, {2}, {4}, {8}};
+
+struct PaneMsaaGLBenchmark : GL::OpenGLTester
+{
+    explicit PaneMsaaGLBenchmark();
+
+    void ChangeSamples();
+
+    void RenderAll();
+    void RenderChanged();
+
+private:
+    void renderPane(RenderTarget& target);
+    void composite();
+
+    GL::Renderbuffer  windowColor_;
+    GL::Framebuffer   window_{{{}, WindowSize}};
+    GL::Mesh          sphere_;
+    Shaders::FlatGL3D shader_;
+
+    std::vector<std::unique_ptr<RenderTarget>> targets_;
+};
+
+PaneMsaaGLBenchmark::PaneMsaaGLBenchmark()
+{
+    addTests({&PaneMsaaGLBenchmark::ChangeSamples});
+
+    // Each iteration is one frame of four panes, measured on the GPU, with the sample count as the instance
+    addInstancedBenchmarks({&PaneMsaaGLBenchmark::RenderAll, &PaneMsaaGLBenchmark::RenderChanged}, 10,
+                           Containers::arraySize(SampleData), BenchmarkType::GpuTime);
+
+    windowColor_.setStorage(GL::RenderbufferFormat::RGBA8, WindowSize);
+    window_.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, windowColor_);
+
+    sphere_ = MeshTools::compile(Primitives::icosphereSolid(4));
+    for (Int i = 0; i != Panes; ++i)
+        targets_.push_back(std::make_unique<RenderTarget>(PaneSize));
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void PaneMsaaGLBenchmark::renderPane(RenderTarget& target)
+{
+    using namespace Math::Literals;
+
+    target.clear().framebuffer().bind();
+    for (Int i = 0; i != DrawsPerPane; ++i)
+    {
+        const Vector3 position{Float(i % 8) * 0.25f - 0.875f, Float(i / 8) * 0.25f - 0.875f, 0.0f};
+        shader_.setColor(Color3::fromHsv({Deg(Float(i) * 5.0f), 0.8f, 0.9f}))
+            .setTransformationProjectionMatrix(Matrix4::translation(position) * Matrix4::scaling(Vector3{0.2f}))
+            .draw(sphere_);
+    }
+    target.resolve();
+}
+
+void PaneMsaaGLBenchmark::composite()
+{
+    for (std::size_t i = 0; i != targets_.size(); ++i)
+    {
+        const Vector2i offset{Int(i % 2) * PaneSize.x(), Int(i / 2) * PaneSize.y()};
+        GL::AbstractFramebuffer::blit(targets_[i]->resolvedFramebuffer(), window_, targets_[i]->viewport(),
+                                      Range2Di::fromSize(offset, PaneSize), GL::FramebufferBlit::Color,
+                                      GL::FramebufferBlitFilter::Nearest);
+    }
+}
+
+void PaneMsaaGLBenchmark::ChangeSamples()
+{
+    const Int maxSamples = GL::Renderbuffer::maxSamples();
+    if (maxSamples < 2)
+        CORRADE_SKIP("Multisampling is not supported.");
+
+    RenderTarget target{PaneSize};
+    for (const Int samples : {2, 0, Math::min(8, maxSamples), 0})
+    {
+        CORRADE_ITERATION(samples);
+        target.setSamples(samples);
+        CORRADE_COMPARE(target.samples(), samples);
+        CORRADE_COMPARE(&target.framebuffer() == &target.resolvedFramebuffer(), samples == 0);
+
+        // Renders and resolves the same as before the change
+        renderPane(target);
+        const Image2D image = target.resolvedFramebuffer().read({PaneSize / 2, PaneSize / 2 + Vector2i{1}},
+                                                                {PixelFormat::RGBA8Unorm});
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(image.pixels<Color4ub>()[0][0] != Color4ub{});
+    }
+}
+
+void PaneMsaaGLBenchmark::RenderAll()
+{
+    const Int samples = Math::min(SampleData[testCaseInstanceId()].samples, GL::Renderbuffer::maxSamples());
+    setTestCaseDescription(Utility::format("{}x MSAA", samples));
+    for (auto& target : targets_)
+        target->setSamples(samples);
+
+    CORRADE_BENCHMARK(10)
+    {
+        for (auto& target : targets_)
+            renderPane(*target);
+        composite();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PaneMsaaGLBenchmark::RenderChanged()
+{
+    const Int samples = Math::min(SampleData[testCaseInstanceId()].samples, GL::Renderbuffer::maxSamples());
+    setTestCaseDescription(Utility::format("{}x MSAA", samples));
+    for (auto& target : targets_)
+        target->setSamples(samples);
+
+    // Only the pane that is being interacted with changes, the others composite their cached image
+    CORRADE_BENCHMARK(10)
+    {
+        renderPane(*targets_.front());
+        composite();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::PaneMsaaGLBenchmark)
@@ -0,0 +1,107 @@
+#include "../objects/SceneDrawable.h"
+#include "../render/PickingRegistry.h"
+
+#include <Corrade/TestSuite/Tester.h>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct PickingRegistryTest : Corrade::TestSuite::Tester
+{
+    explicit PickingRegistryTest();
+
+    void Ranges();
+    void Background();
+    void Remove();
+};
+
+PickingRegistryTest::PickingRegistryTest()
+{
+    addTests({&PickingRegistryTest::Ranges});
+    addTests({&PickingRegistryTest::Background});
+    addTests({&PickingRegistryTest::Remove});
+}
+
+class Drawable : public Object3D, public SceneDrawable
+{
+public:
+    explicit Drawable(Object3D* parent, SceneGraph::DrawableGroup3D& drawables)
+    : Object3D(parent)
+    , SceneDrawable(static_cast<Object3D&>(*this), &drawables)
+    {
+    }
+
+    void draw(const Matrix4&, SceneGraph::Camera3D&) override {}
+};
+
+void PickingRegistryTest::Ranges()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    Drawable                    mesh{&scene, drawables};
+    Drawable                    cloud{&scene, drawables};
+
+    // One ID per triangle of the mesh and per point of the cloud
+    PickingRegistry   registry;
+    const UnsignedInt meshBase  = registry.add(mesh, 12);
+    const UnsignedInt cloudBase = registry.add(cloud, 1000);
+    CORRADE_COMPARE(meshBase, 1);
+    CORRADE_COMPARE(cloudBase, 13);
+    CORRADE_COMPARE(registry.size(), 2);
+
+    const auto triangle = registry.find(meshBase + 11);
+    CORRADE_VERIFY(triangle);
+    CORRADE_COMPARE(triangle->drawable, &mesh);
+    CORRADE_COMPARE(triangle->index, 11);
+
+    const auto point = registry.find(cloudBase + 500);
+    CORRADE_VERIFY(point);
+    CORRADE_COMPARE(point->drawable, &cloud);
+    CORRADE_COMPARE(point->index, 500);
+
+    CORRADE_VERIFY(!registry.find(cloudBase + 1000));
+}
+
+void PickingRegistryTest::Background()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    Drawable                    drawable{&scene, drawables};
+
+    PickingRegistry registry;
+    CORRADE_VERIFY(!registry.find(0));
+
+    // The object ID buffer is cleared to zero, which never resolves to a drawable
+    registry.add(drawable);
+    CORRADE_VERIFY(!registry.find(0));
+    CORRADE_VERIFY(registry.find(1));
+}
+
+void PickingRegistryTest::Remove()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    Drawable                    a{&scene, drawables};
+    Drawable                    b{&scene, drawables};
+
+    PickingRegistry   registry;
+    const UnsignedInt base = registry.add(a, 4);
+    registry.remove(base);
+    CORRADE_COMPARE(registry.size(), 0);
+    CORRADE_VERIFY(!registry.find(base + 2));
+
+    // A pick issued before the removal doesn't resolve to the drawable added after it
+    const UnsignedInt next = registry.add(b, 4);
+    CORRADE_COMPARE(next, base + 4);
+    CORRADE_VERIFY(!registry.find(base + 2));
+    CORRADE_COMPARE(registry.find(next)->drawable, &b);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::PickingRegistryTest)
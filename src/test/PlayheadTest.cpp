@@ -0,0 +1,155 @@
+#include "../render/Playhead.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+struct PlayheadTest : Corrade::TestSuite::Tester
+{
+    explicit PlayheadTest();
+
+    void Advance();
+    void Backward();
+    void End();
+    void Stall();
+    void PrefetchOrder();
+    void PrefetchShortSequence();
+};
+
+PlayheadTest::PlayheadTest()
+{
+    addTests({&PlayheadTest::Advance});
+    addTests({&PlayheadTest::Backward});
+    addTests({&PlayheadTest::End});
+    addTests({&PlayheadTest::Stall});
+    addTests({&PlayheadTest::PrefetchOrder});
+    addTests({&PlayheadTest::PrefetchShortSequence});
+}
+
+const auto Ready = [](std::size_t) { return true; };
+
+void PlayheadTest::Advance()
+{
+    Playhead playhead{100, 50.0f};
+
+    // Paused, time doesn't move it
+    CORRADE_COMPARE(playhead.advance(1s, Ready), 0);
+    CORRADE_COMPARE(playhead.frame(), 0);
+
+    // 20 ms per frame, the remainder is carried over to the next call
+    playhead.play();
+    CORRADE_COMPARE(playhead.advance(50ms, Ready), 2);
+    CORRADE_COMPARE(playhead.frame(), 2);
+    CORRADE_COMPARE(playhead.advance(10ms, Ready), 1);
+    CORRADE_COMPARE(playhead.frame(), 3);
+    CORRADE_COMPARE(playhead.advance(10ms, Ready), 0);
+
+    playhead.seek(40);
+    CORRADE_COMPARE(playhead.frame(), 40);
+    playhead.seek(1000);
+    CORRADE_COMPARE(playhead.frame(), 99);
+    CORRADE_VERIFY(playhead.isPlaying());
+}
+
+void PlayheadTest::Backward()
+{
+    Playhead playhead{10, 10.0f};
+    playhead.setDirection(Playhead::Direction::BACKWARD);
+    playhead.seek(1);
+    playhead.play();
+
+    // Looping wraps around from the first frame to the last one
+    CORRADE_COMPARE(playhead.advance(300ms, Ready), 3);
+    CORRADE_COMPARE(playhead.frame(), 8);
+    CORRADE_COMPARE(playhead.frameAt(2), 0);
+    CORRADE_COMPARE(playhead.frameAt(-9), 9);
+}
+
+void PlayheadTest::End()
+{
+    Playhead playhead{10, 10.0f};
+    playhead.setLooping(false);
+    playhead.seek(7);
+    playhead.play();
+
+    // Stops on the last frame
+    CORRADE_COMPARE(playhead.advance(1s, Ready), 2);
+    CORRADE_COMPARE(playhead.frame(), 9);
+    CORRADE_VERIFY(!playhead.isPlaying());
+    CORRADE_VERIFY(!playhead.frameAt(1));
+    CORRADE_VERIFY(!playhead.frameAt(-10));
+
+    // ... and playing again starts over
+    playhead.play();
+    CORRADE_COMPARE(playhead.frame(), 0);
+}
+
+void PlayheadTest::Stall()
+{
+    Playhead playhead{100, 10.0f};
+    playhead.play();
+
+    // Frame 3 isn't ready, so playback holds frame 2 instead of skipping to 4
+    std::size_t ready = 2;
+    const auto  isReady = [&](std::size_t frame) { return frame <= ready; };
+    CORRADE_COMPARE(playhead.advance(500ms, isReady), 2);
+    CORRADE_COMPARE(playhead.frame(), 2);
+    CORRADE_COMPARE(playhead.stallCount(), 1);
+    CORRADE_COMPARE(playhead.advance(500ms, isReady), 0);
+    CORRADE_COMPARE(playhead.stallCount(), 2);
+
+    // Once it's there it's shown right away, but the waiting doesn't have to be made up for
+    ready = 100;
+    CORRADE_COMPARE(playhead.advance(0ms, isReady), 1);
+    CORRADE_COMPARE(playhead.frame(), 3);
+    CORRADE_COMPARE(playhead.advance(50ms, isReady), 0);
+    CORRADE_COMPARE(playhead.advance(50ms, isReady), 1);
+}
+
+void PlayheadTest::PrefetchOrder()
+{
+    Playhead                 playhead{100};
+    std::vector<std::size_t> frames;
+
+    playhead.seek(50);
+    playhead.prefetchOrder(3, 2, frames);
+    CORRADE_COMPARE(frames, (std::vector<std::size_t>{50, 51, 52, 53, 49, 48}));
+
+    // Ahead is the other way when playing backward
+    playhead.setDirection(Playhead::Direction::BACKWARD);
+    playhead.prefetchOrder(3, 2, frames);
+    CORRADE_COMPARE(frames, (std::vector<std::size_t>{50, 49, 48, 47, 51, 52}));
+
+    // Across the end if looping, cut off there otherwise
+    playhead.setDirection(Playhead::Direction::FORWARD);
+    playhead.seek(98);
+    playhead.prefetchOrder(3, 1, frames);
+    CORRADE_COMPARE(frames, (std::vector<std::size_t>{98, 99, 0, 1, 97}));
+    playhead.setLooping(false);
+    playhead.prefetchOrder(3, 1, frames);
+    CORRADE_COMPARE(frames, (std::vector<std::size_t>{98, 99, 97}));
+}
+
+void PlayheadTest::PrefetchShortSequence()
+{
+    // A window larger than the sequence lists every frame once
+    Playhead                 playhead{4};
+    std::vector<std::size_t> frames;
+    playhead.seek(1);
+    playhead.prefetchOrder(10, 10, frames);
+    CORRADE_COMPARE(frames, (std::vector<std::size_t>{1, 2, 3, 0}));
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::PlayheadTest)
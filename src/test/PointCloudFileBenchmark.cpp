@@ -0,0 +1,131 @@
+#include "../io/PointCloudFile.h"
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Path.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+// 64 MB of points: float positions and uchar colors with alpha, 16 bytes each
+constexpr std::size_t PointCount = 4 << 20;
+constexpr std::size_t Iterations = 5;
+
+struct PointCloudFileBenchmark : Corrade::TestSuite::Tester
+{
+    explicit PointCloudFileBenchmark();
+    ~PointCloudFileBenchmark();
+
+    void MapAndView();
+    void ReadAndCopy();
+
+private:
+    void printThroughput(const char* name, std::chrono::steady_clock::duration time) const;
+
+    Containers::String filename_;
+    std::size_t        fileSize_{0};
+};
+
+PointCloudFileBenchmark::PointCloudFileBenchmark()
+{
+    /* Each iteration loads the whole file and touches every position. The file was just written, so it's served from
+       the page cache and the difference is the parsing and copying, not the disk. */
+    addBenchmarks({&PointCloudFileBenchmark::MapAndView}, Iterations);
+    addBenchmarks({&PointCloudFileBenchmark::ReadAndCopy}, Iterations);
+
+    filename_ = Utility::Path::join(std::filesystem::temp_directory_path().string(), "PointCloudFileBenchmark.ply");
+
+    std::string data = "ply\n"
+                       "format binary_little_endian 1.0\n"
+                       "element vertex " +
+                       std::to_string(PointCount) +
+                       "\n"
+                       "property float x\n"
+                       "property float y\n"
+                       "property float z\n"
+                       "property uchar red\n"
+                       "property uchar green\n"
+                       "property uchar blue\n"
+                       "property uchar alpha\n"
+                       "end_header\n";
+    const std::size_t header = data.size();
+    data.resize(header + PointCount * 16);
+    for (std::size_t i = 0; i != PointCount; ++i)
+    {
+        const Float position[]{Float(i % 1024), Float(i / 1024), 0.0f};
+        std::memcpy(data.data() + header + i * 16, position, sizeof(position));
+        std::memset(data.data() + header + i * 16 + 12, 0xff, 4);
+    }
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(
+        Utility::Path::write(filename_, Containers::ArrayView<const char>{data.data(), data.size()}));
+    fileSize_ = data.size();
+}
+
+PointCloudFileBenchmark::~PointCloudFileBenchmark()
+{
+    Utility::Path::remove(filename_);
+}
+
+void PointCloudFileBenchmark::printThroughput(const char* name, std::chrono::steady_clock::duration time) const
+{
+    const double seconds = std::chrono::duration<double>{time}.count();
+    Utility::Debug{} << name << Float(double(fileSize_ * Iterations) / seconds / 1.0e9) << "GB/s";
+}
+
+void PointCloudFileBenchmark::MapAndView()
+{
+    Float      sum   = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    CORRADE_BENCHMARK(Iterations)
+    {
+        const std::optional<PointCloudFile> cloud = PointCloudFile::open(filename_);
+        CORRADE_INTERNAL_ASSERT(cloud && cloud->size() == PointCount);
+        for (const Vector3& position : cloud->positions())
+            sum += position.x();
+    }
+    printThroughput("Mapped and viewed:", std::chrono::steady_clock::now() - start);
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void PointCloudFileBenchmark::ReadAndCopy()
+{
+    Float      sum   = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    CORRADE_BENCHMARK(Iterations)
+    {
+        /* What loading through intermediate buffers costs: the whole file read into memory, then the positions copied
+           out of it */
+        const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename_);
+        CORRADE_INTERNAL_ASSERT(data);
+        const std::optional<PointCloudFile> cloud = PointCloudFile::parse(*data);
+        CORRADE_INTERNAL_ASSERT(cloud && cloud->size() == PointCount);
+
+        std::vector<Vector3> copy;
+        copy.reserve(cloud->size());
+        for (const Vector3& position : cloud->positions())
+            copy.push_back(position);
+        for (const Vector3& position : copy)
+            sum += position.x();
+    }
+    printThroughput("Read and copied:", std::chrono::steady_clock::now() - start);
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::PointCloudFileBenchmark)
@@ -0,0 +1,265 @@
+#include "../io/PointCloudFile.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct PointCloudFileTest : Corrade::TestSuite::Tester
+{
+    explicit PointCloudFileTest();
+
+    void Ply();
+    void PlyElementsBeforeVertices();
+    void Pcd();
+    void PcdFieldCount();
+    void Refused();
+    void Map();
+};
+
+PointCloudFileTest::PointCloudFileTest()
+{
+    addTests({&PointCloudFileTest::Ply});
+    addTests({&PointCloudFileTest::PlyElementsBeforeVertices});
+    addTests({&PointCloudFileTest::Pcd});
+    addTests({&PointCloudFileTest::PcdFieldCount});
+    addTests({&PointCloudFileTest::Refused});
+    addTests({&PointCloudFileTest::Map});
+}
+
+template <class T>
+void append(std::string& out, const T& value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Three points with float positions and uchar colors, followed by faces that the loader ignores
+std::string plyFile()
+{
+    std::string file = "ply\n"
+                       "format binary_little_endian 1.0\n"
+                       "comment generated\n"
+                       "element vertex 3\n"
+                       "property float x\n"
+                       "property float y\n"
+                       "property float z\n"
+                       "property uchar red\n"
+                       "property uchar green\n"
+                       "property uchar blue\n"
+                       "element face 1\n"
+                       "property list uchar int vertex_indices\n"
+                       "end_header\n";
+    for (Int i = 0; i != 3; ++i)
+    {
+        append(file, Vector3{Float(i), Float(i) * 2.0f, Float(i) * 3.0f});
+        append(file, Vector3ub{UnsignedByte(10 + i), UnsignedByte(20 + i), UnsignedByte(30 + i)});
+    }
+    append(file, UnsignedByte{3});
+    append(file, Vector3i{0, 1, 2});
+    return file;
+}
+
+void PointCloudFileTest::Ply()
+{
+    const std::string                   data   = plyFile();
+    const std::optional<PointCloudFile> cloud  = PointCloudFile::parse({data.data(), data.size()});
+    const std::size_t                   header = data.find("end_header\n") + 11;
+    CORRADE_VERIFY(cloud);
+
+    CORRADE_COMPARE(cloud->format(), PointCloudFile::Format::PLY);
+    CORRADE_COMPARE(cloud->size(), 3);
+    CORRADE_COMPARE(cloud->stride(), 15);
+    CORRADE_COMPARE(cloud->attributes().size(), 6);
+    CORRADE_VERIFY(!cloud->isMapped());
+
+    // Nothing is copied, the points are viewed where they are
+    CORRADE_COMPARE(static_cast<const void*>(cloud->data().data()), static_cast<const void*>(data.data() + header));
+    CORRADE_COMPARE(cloud->data().size(), 45);
+
+    const auto positions = cloud->positions();
+    CORRADE_COMPARE(positions.size(), 3);
+    CORRADE_COMPARE(positions[2], (Vector3{2.0f, 4.0f, 6.0f}));
+
+    const auto colors = cloud->colors();
+    CORRADE_COMPARE(colors.size()[0], 3);
+    CORRADE_COMPARE(colors[1][0], 11);
+    CORRADE_COMPARE(colors[1][1], 21);
+    CORRADE_COMPARE(colors[1][2], 31);
+
+    const auto green = cloud->view<UnsignedByte>("green");
+    CORRADE_COMPARE(green[2], 22);
+    CORRADE_VERIFY(!cloud->attribute("nx"));
+}
+
+void PointCloudFileTest::PlyElementsBeforeVertices()
+{
+    std::string data = "ply\r\n"
+                       "format binary_little_endian 1.0\r\n"
+                       "element camera 2\r\n"
+                       "property double view_px\r\n"
+                       "property int id\r\n"
+                       "element vertex 2\r\n"
+                       "property double x\r\n"
+                       "property float y\r\n"
+                       "end_header\r\n";
+    for (Int i = 0; i != 2; ++i)
+    {
+        append(data, Double{-1.0});
+        append(data, Int{-1});
+    }
+    append(data, Double{5.0});
+    append(data, Float{6.0f});
+    append(data, Double{7.0});
+    append(data, Float{8.0f});
+
+    const std::optional<PointCloudFile> cloud = PointCloudFile::parse({data.data(), data.size()});
+    CORRADE_VERIFY(cloud);
+    CORRADE_COMPARE(cloud->size(), 2);
+    CORRADE_COMPARE(cloud->stride(), 12);
+    CORRADE_COMPARE(cloud->view<Double>("x")[1], 7.0);
+    CORRADE_COMPARE(cloud->view<Float>("y")[0], 6.0f);
+
+    // Not three floats
+    CORRADE_COMPARE(cloud->positions().size(), 0);
+    CORRADE_COMPARE(cloud->colors().size()[0], 0);
+}
+
+void PointCloudFileTest::Pcd()
+{
+    std::string data = "# .PCD v0.7 - Point Cloud Data file format\n"
+                       "VERSION 0.7\n"
+                       "FIELDS x y z rgb\n"
+                       "SIZE 4 4 4 4\n"
+                       "TYPE F F F U\n"
+                       "COUNT 1 1 1 1\n"
+                       "WIDTH 2\n"
+                       "HEIGHT 1\n"
+                       "VIEWPOINT 0 0 0 1 0 0 0\n"
+                       "POINTS 2\n"
+                       "DATA binary\n";
+    append(data, Vector3{1.0f, 2.0f, 3.0f});
+    append(data, UnsignedInt{0x00112233});
+    append(data, Vector3{4.0f, 5.0f, 6.0f});
+    append(data, UnsignedInt{0x00aabbcc});
+
+    const std::optional<PointCloudFile> cloud = PointCloudFile::parse({data.data(), data.size()});
+    CORRADE_VERIFY(cloud);
+    CORRADE_COMPARE(cloud->format(), PointCloudFile::Format::PCD);
+    CORRADE_COMPARE(cloud->size(), 2);
+    CORRADE_COMPARE(cloud->stride(), 16);
+    CORRADE_COMPARE(cloud->positions()[1], (Vector3{4.0f, 5.0f, 6.0f}));
+
+    // Packed as 0x00RRGGBB, viewed as R, G, B
+    const auto colors = cloud->colors();
+    CORRADE_COMPARE(colors[0][0], 0x11);
+    CORRADE_COMPARE(colors[0][1], 0x22);
+    CORRADE_COMPARE(colors[0][2], 0x33);
+    CORRADE_COMPARE(colors[1][0], 0xaa);
+    CORRADE_COMPARE(colors[1][2], 0xcc);
+}
+
+void PointCloudFileTest::PcdFieldCount()
+{
+    // Without POINTS the size is WIDTH × HEIGHT
+    std::string data = "FIELDS x normal\n"
+                       "SIZE 4 2\n"
+                       "TYPE F I\n"
+                       "COUNT 1 3\n"
+                       "WIDTH 2\n"
+                       "HEIGHT 2\n"
+                       "DATA binary\n";
+    for (Int i = 0; i != 4; ++i)
+    {
+        append(data, Float(i));
+        append(data, Vector3s{Short(i), Short(-i), Short(2 * i)});
+    }
+
+    const std::optional<PointCloudFile> cloud = PointCloudFile::parse({data.data(), data.size()});
+    CORRADE_VERIFY(cloud);
+    CORRADE_COMPARE(cloud->size(), 4);
+    CORRADE_COMPARE(cloud->stride(), 10);
+
+    const PointCloudFile::Attribute* normal = cloud->attribute("normal");
+    CORRADE_VERIFY(normal);
+    CORRADE_COMPARE(normal->type, PointCloudFile::Type::INT16);
+    CORRADE_COMPARE(normal->count, 3);
+    CORRADE_COMPARE(normal->offset, 4);
+    CORRADE_COMPARE(cloud->view<Float>("x")[3], 3.0f);
+}
+
+void PointCloudFileTest::Refused()
+{
+    const std::string ply = "ply\nformat binary_little_endian 1.0\nelement vertex 2\nproperty float x\n";
+    const std::string pcd = "FIELDS x\nSIZE 4\nTYPE F\nPOINTS 2\n";
+
+    const struct
+    {
+        const char* name;
+        std::string data;
+        const char* message;
+    } cases[]{
+        {"ascii PLY", "ply\nformat ascii 1.0\nend_header\n", "PointCloudFile: text PLY files are not supported\n"},
+        {"big-endian PLY", "ply\nformat binary_big_endian 1.0\nend_header\n",
+         "PointCloudFile: big-endian PLY files are not supported\n"},
+        {"vertex list", ply + "property list uchar int i\nend_header\n",
+         "PointCloudFile: PLY vertex lists are not supported\n"},
+        {"unknown type", ply + "property int128 y\nend_header\n", "PointCloudFile: unknown PLY type int128\n"},
+        {"no vertices", "ply\nformat binary_little_endian 1.0\nend_header\n",
+         "PointCloudFile: no vertices in the PLY file\n"},
+        {"incomplete PLY", ply, "PointCloudFile: incomplete PLY header\n"},
+        {"truncated PLY", ply + "end_header\n1234567", "PointCloudFile: truncated PLY file\n"},
+        {"ascii PCD", pcd + "DATA ascii\n", "PointCloudFile: text PCD files are not supported\n"},
+        {"compressed PCD", pcd + "DATA binary_compressed\n",
+         "PointCloudFile: compressed PCD files are not supported\n"},
+        {"PCD type", "FIELDS x\nSIZE 3\nTYPE F\nDATA binary\n", "PointCloudFile: unknown PCD type of field x\n"},
+        {"PCD fields", "FIELDS x y\nSIZE 4\nTYPE F F\nDATA binary\n",
+         "PointCloudFile: PCD fields, sizes, types and counts don't match\n"},
+        {"truncated PCD", pcd + "DATA binary\n1234567", "PointCloudFile: truncated PCD file\n"},
+        {"garbage", "\x89PNG\r\n", "PointCloudFile: unexpected PCD header line \x89PNG\n"},
+    };
+
+    for (const auto& data : cases)
+    {
+        CORRADE_ITERATION(data.name);
+
+        std::ostringstream out;
+        Error              redirectError{&out};
+        CORRADE_VERIFY(!PointCloudFile::parse({data.data.data(), data.data.size()}));
+        CORRADE_COMPARE(out.str(), data.message);
+    }
+}
+
+void PointCloudFileTest::Map()
+{
+    const std::string data     = plyFile();
+    const auto        filename = Utility::Path::join(*Utility::Path::currentDirectory(), "PointCloudFileTest.ply");
+    CORRADE_VERIFY(Utility::Path::write(filename, Containers::ArrayView<const char>{data.data(), data.size()}));
+
+    {
+        const std::optional<PointCloudFile> cloud = PointCloudFile::open(filename);
+        CORRADE_VERIFY(cloud);
+        CORRADE_VERIFY(cloud->isMapped());
+        CORRADE_COMPARE(cloud->positions()[1], (Vector3{1.0f, 2.0f, 3.0f}));
+        CORRADE_COMPARE(cloud->colors()[2][2], 32);
+    }
+    CORRADE_VERIFY(Utility::Path::remove(filename));
+
+    std::ostringstream out;
+    Error              redirectError{&out};
+    CORRADE_VERIFY(!PointCloudFile::open(filename));
+    CORRADE_VERIFY(out.str().find("PointCloudFile: can't map") != std::string::npos);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::PointCloudFileTest)
@@ -0,0 +1,252 @@
+#include "../render/PointOctree.h"
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/Math/Angle.h>
+#include <algorithm>
+#include <array>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct PointOctreeTest : Corrade::TestSuite::Tester
+{
+    explicit PointOctreeTest();
+
+    void Build();
+    void Duplicates();
+    void StridedPositions();
+    void Empty();
+    void Budget();
+    void EverythingVisible();
+    void PreferNear();
+    void FrustumCulling();
+};
+
+PointOctreeTest::PointOctreeTest()
+{
+    addTests({&PointOctreeTest::Build});
+    addTests({&PointOctreeTest::Duplicates});
+    addTests({&PointOctreeTest::StridedPositions});
+    addTests({&PointOctreeTest::Empty});
+    addTests({&PointOctreeTest::Budget});
+    addTests({&PointOctreeTest::EverythingVisible});
+    addTests({&PointOctreeTest::PreferNear});
+    addTests({&PointOctreeTest::FrustumCulling});
+}
+
+// Same points on every run, uniformly spread over @p box
+std::vector<Vector3> randomPoints(std::size_t count, const Range3D& box)
+{
+    UnsignedInt state = 1;
+    const auto  next  = [&]
+    {
+        state = state * 1664525u + 1013904223u;
+        return Float(state >> 8) / Float(1u << 24);
+    };
+
+    std::vector<Vector3> points(count);
+    for (Vector3& point : points)
+        point = box.min() + Vector3{next(), next(), next()} * box.size();
+    return points;
+}
+
+PointOctree octreeOf(const std::vector<Vector3>& points, const std::size_t nodeCapacity)
+{
+    return PointOctree{Containers::arrayView(points.data(), points.size()), nodeCapacity};
+}
+
+// Looks down -Z from the origin
+Matrix4 perspective()
+{
+    using namespace Math::Literals;
+    return Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 1000.0f);
+}
+
+void PointOctreeTest::Build()
+{
+    const std::vector<Vector3> points = randomPoints(20000, {{-1.0f, -2.0f, -3.0f}, {4.0f, 2.0f, 1.0f}});
+    const PointOctree          octree = octreeOf(points, 512);
+
+    // Every point ends up in exactly one node, inside of its cube
+    CORRADE_COMPARE(octree.indices().size(), points.size());
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != octree.nodes().size(); ++i)
+    {
+        const PointOctree::Node& node = octree.nodes()[i];
+        CORRADE_COMPARE(node.first, count);
+        CORRADE_COMPARE_AS(node.count, 512, TestSuite::Compare::LessOrEqual);
+        count += node.count;
+
+        for (const UnsignedInt index : octree.indices(i))
+            CORRADE_VERIFY(node.bounds.contains(points[index]));
+        for (const Int child : node.children)
+        {
+            if (child == -1)
+                continue;
+            CORRADE_COMPARE_AS(std::size_t(child), i, TestSuite::Compare::Greater);
+            CORRADE_COMPARE(octree.nodes()[child].depth, node.depth + 1);
+            CORRADE_COMPARE(octree.nodes()[child].bounds.size(), node.bounds.size() * 0.5f);
+        }
+    }
+    CORRADE_COMPARE(count, points.size());
+
+    // Every point is referenced once, the positions themselves aren't copied
+    std::vector<UnsignedInt> indices = octree.indices();
+    std::sort(indices.begin(), indices.end());
+    for (std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_COMPARE(indices[i], i);
+
+    // The root is a coarse subsample of everything, full up to the grid it's sampled on (8x8x8)
+    CORRADE_COMPARE_AS(octree.nodes().front().count, 256, TestSuite::Compare::Greater);
+    CORRADE_VERIFY(octree.nodes().size() > 1);
+}
+
+void PointOctreeTest::Duplicates()
+{
+    // All the points fall into the same grid cell at every level, so only the depth limit stops the subdivision
+    const PointOctree octree = octreeOf(std::vector<Vector3>(1000, Vector3{0.0f}), 16);
+
+    CORRADE_COMPARE(octree.nodes().size(), PointOctree::MaxDepth + 1);
+    CORRADE_COMPARE(octree.nodes().back().depth, PointOctree::MaxDepth);
+    CORRADE_COMPARE(octree.nodes().back().count, 1000 - PointOctree::MaxDepth);
+}
+
+void PointOctreeTest::StridedPositions()
+{
+    // Interleaved with other attributes, like in a file
+    struct Vertex
+    {
+        Vector3     position;
+        UnsignedInt color;
+    };
+    const std::vector<Vector3> points = randomPoints(5000, {Vector3{-1.0f}, Vector3{1.0f}});
+    std::vector<Vertex>        vertices;
+    for (const Vector3& point : points)
+        vertices.push_back({point, 0xffffffffu});
+
+    const PointOctree contiguous = octreeOf(points, 64);
+    const PointOctree interleaved{Containers::StridedArrayView1D<const Vector3>{
+                                      Containers::arrayView(vertices.data(), vertices.size()), &vertices[0].position,
+                                      vertices.size(), std::ptrdiff_t(sizeof(Vertex))},
+                                  64};
+    CORRADE_COMPARE(interleaved.nodes().size(), contiguous.nodes().size());
+    CORRADE_VERIFY(interleaved.indices() == contiguous.indices());
+}
+
+void PointOctreeTest::Empty()
+{
+    const PointOctree octree{{}};
+    CORRADE_VERIFY(octree.indices().empty());
+    CORRADE_COMPARE(octree.nodes().size(), 1);
+    CORRADE_COMPARE(octree.nodes().front().count, 0);
+
+    std::vector<UnsignedInt> nodes;
+    CORRADE_COMPARE(octree.select(Matrix4::translation(Vector3::zAxis(-5.0f)), perspective(), 1000.0f, 100, nodes), 0);
+}
+
+void PointOctreeTest::Budget()
+{
+    const PointOctree        octree = octreeOf(randomPoints(50000, {Vector3{-5.0f}, Vector3{5.0f}}), 256);
+    const Matrix4            transformation = Matrix4::translation(Vector3::zAxis(-12.0f));
+    std::vector<UnsignedInt> nodes;
+
+    for (const std::size_t budget : {std::size_t{0}, std::size_t{300}, std::size_t{5000}, std::size_t{20000}})
+    {
+        CORRADE_ITERATION(budget);
+
+        const std::size_t count = octree.select(transformation, perspective(), 1000.0f, budget, nodes, 0.0f);
+        CORRADE_COMPARE_AS(count, budget, TestSuite::Compare::LessOrEqual);
+
+        // Picked top-down, each node after its parent
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i != nodes.size(); ++i)
+        {
+            sum += octree.nodes()[nodes[i]].count;
+            if (i == 0)
+            {
+                CORRADE_COMPARE(nodes[i], 0);
+                continue;
+            }
+
+            const auto isParent = [&](UnsignedInt node)
+            {
+                const std::array<Int, 8>& children = octree.nodes()[node].children;
+                return std::find(children.begin(), children.end(), Int(nodes[i])) != children.end();
+            };
+            CORRADE_VERIFY(std::any_of(nodes.begin(), nodes.begin() + std::ptrdiff_t(i), isParent));
+        }
+        CORRADE_COMPARE(sum, count);
+    }
+
+    // A budget smaller than the root picks nothing at all
+    CORRADE_COMPARE(octree.select(transformation, perspective(), 1000.0f, 10, nodes), 0);
+    CORRADE_VERIFY(nodes.empty());
+}
+
+void PointOctreeTest::EverythingVisible()
+{
+    const PointOctree        octree = octreeOf(randomPoints(20000, {Vector3{-1.0f}, Vector3{1.0f}}), 128);
+    std::vector<UnsignedInt> nodes;
+
+    const Matrix4     transformation = Matrix4::translation(Vector3::zAxis(-10.0f));
+    const std::size_t count          =
+        octree.select(transformation, perspective(), 1000.0f, ~std::size_t{}, nodes, 0.0f);
+    CORRADE_COMPARE(count, octree.indices().size());
+    CORRADE_COMPARE(nodes.size(), octree.nodes().size());
+
+    // With a minimal size the details too small to see are left out, but never the root (150 px here)
+    CORRADE_COMPARE(octree.select(transformation, perspective(), 1000.0f, ~std::size_t{}, nodes, 200.0f),
+                    octree.nodes().front().count);
+    CORRADE_COMPARE(nodes, std::vector<UnsignedInt>{0});
+}
+
+void PointOctreeTest::PreferNear()
+{
+    // A long strip going away from the camera
+    const std::vector<Vector3> points = randomPoints(100000, {{-1.0f, -1.0f, -100.0f}, {1.0f, 1.0f, -1.0f}});
+    const PointOctree          octree = octreeOf(points, 256);
+    std::vector<UnsignedInt>   nodes;
+    octree.select(Matrix4{}, perspective(), 1000.0f, 20000, nodes);
+
+    // The near half gets finer detail
+    UnsignedInt nearDepth = 0;
+    UnsignedInt farDepth  = 0;
+    for (const UnsignedInt node : nodes)
+    {
+        UnsignedInt& depth = octree.nodes()[node].bounds.center().z() > -50.0f ? nearDepth : farDepth;
+        depth              = Math::max(depth, octree.nodes()[node].depth);
+    }
+    CORRADE_COMPARE_AS(nearDepth, farDepth, TestSuite::Compare::Greater);
+}
+
+void PointOctreeTest::FrustumCulling()
+{
+    using namespace Math::Literals;
+
+    const PointOctree        octree = octreeOf(randomPoints(20000, {Vector3{-1.0f}, Vector3{1.0f}}), 128);
+    std::vector<UnsignedInt> nodes;
+
+    // Behind the camera
+    CORRADE_COMPARE(octree.select(Matrix4::translation(Vector3::zAxis(10.0f)), perspective(), 1000.0f, ~std::size_t{},
+                                  nodes, 0.0f),
+                    0);
+    CORRADE_VERIFY(nodes.empty());
+
+    // Half of the cloud is left of the frustum, so are its nodes
+    const std::size_t count = octree.select(Matrix4::translation({-3.5f, 0.0f, -4.0f}), perspective(), 1000.0f,
+                                            ~std::size_t{}, nodes, 0.0f);
+    CORRADE_COMPARE_AS(count, 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(count, octree.indices().size(), TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(nodes.size(), octree.nodes().size(), TestSuite::Compare::Less);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::PointOctreeTest)
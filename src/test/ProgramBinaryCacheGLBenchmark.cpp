@@ -0,0 +1,178 @@
+#include "../render/ProgramBinaryCache.h"
+#include "../shaders/InfiniteGridShader.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Math/Matrix4.h>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+struct ProgramBinaryCacheGLBenchmark : GL::OpenGLTester
+{
+    explicit ProgramBinaryCacheGLBenchmark();
+
+    void ColdAndWarm();
+    void OtherDriver();
+    void Corrupted();
+
+    void CompileFromSource();
+    void LoadFromCache();
+
+private:
+    void clearCache();
+    void drawWith(InfiniteGridShader& shader);
+
+    Containers::String directory_;
+};
+
+ProgramBinaryCacheGLBenchmark::ProgramBinaryCacheGLBenchmark()
+{
+    addTests({&ProgramBinaryCacheGLBenchmark::ColdAndWarm}, &ProgramBinaryCacheGLBenchmark::clearCache,
+             &ProgramBinaryCacheGLBenchmark::clearCache);
+    addTests({&ProgramBinaryCacheGLBenchmark::OtherDriver}, &ProgramBinaryCacheGLBenchmark::clearCache,
+             &ProgramBinaryCacheGLBenchmark::clearCache);
+    addTests({&ProgramBinaryCacheGLBenchmark::Corrupted}, &ProgramBinaryCacheGLBenchmark::clearCache,
+             &ProgramBinaryCacheGLBenchmark::clearCache);
+
+    // Each iteration creates the program once, i.e. what a shader adds to the time to the first frame
+    addBenchmarks({&ProgramBinaryCacheGLBenchmark::CompileFromSource}, 10);
+    addBenchmarks({&ProgramBinaryCacheGLBenchmark::LoadFromCache}, 10, &ProgramBinaryCacheGLBenchmark::clearCache,
+                  &ProgramBinaryCacheGLBenchmark::clearCache);
+
+    directory_ = Utility::Path::join(*Utility::Path::currentDirectory(), "ProgramBinaryCacheGLBenchmarkFiles");
+}
+
+void ProgramBinaryCacheGLBenchmark::clearCache()
+{
+    if (!Utility::Path::exists(directory_))
+        return;
+
+    const auto files = Utility::Path::list(
+        directory_, Utility::Path::ListFlag::SkipDirectories | Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_INTERNAL_ASSERT(files);
+    for (const Containers::String& file : *files)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::remove(Utility::Path::join(directory_, file)));
+}
+
+void ProgramBinaryCacheGLBenchmark::drawWith(InfiniteGridShader& shader)
+{
+    GL::Mesh triangle = InfiniteGridShader::fullScreenTriangle();
+    shader.setTransformationProjectionMatrix(Matrix4::perspectiveProjection(Deg{90.0f}, 1.0f, 0.01f, 100.0f) *
+                                             Matrix4::translation(Vector3::zAxis(-10.0f)))
+        .draw(triangle);
+}
+
+void ProgramBinaryCacheGLBenchmark::ColdAndWarm()
+{
+    if (!ProgramBinaryCache::isSupported())
+        CORRADE_SKIP("GL_ARB_get_program_binary is not supported.");
+
+    {
+        ProgramBinaryCache cache{directory_};
+        InfiniteGridShader shader{&cache};
+        CORRADE_COMPARE(cache.loadedCount(), 0);
+        CORRADE_COMPARE(cache.savedCount(), 1);
+        drawWith(shader);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    // A second start with the same driver doesn't compile anything
+    ProgramBinaryCache cache{directory_};
+    InfiniteGridShader shader{&cache};
+    CORRADE_COMPARE(cache.loadedCount(), 1);
+    CORRADE_COMPARE(cache.savedCount(), 0);
+    CORRADE_COMPARE(cache.rejectedCount(), 0);
+    drawWith(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ProgramBinaryCacheGLBenchmark::OtherDriver()
+{
+    if (!ProgramBinaryCache::isSupported())
+        CORRADE_SKIP("GL_ARB_get_program_binary is not supported.");
+
+    {
+        ProgramBinaryCache cache{directory_, "driver 1.0"};
+        InfiniteGridShader shader{&cache};
+        CORRADE_COMPARE(cache.savedCount(), 1);
+    }
+
+    // After a driver update the binary is compiled again and replaced
+    ProgramBinaryCache cache{directory_, "driver 2.0"};
+    InfiniteGridShader shader{&cache};
+    CORRADE_COMPARE(cache.loadedCount(), 0);
+    CORRADE_COMPARE(cache.rejectedCount(), 1);
+    CORRADE_COMPARE(cache.savedCount(), 1);
+    drawWith(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ProgramBinaryCache updated{directory_, "driver 2.0"};
+    InfiniteGridShader loaded{&updated};
+    CORRADE_COMPARE(updated.loadedCount(), 1);
+}
+
+void ProgramBinaryCacheGLBenchmark::Corrupted()
+{
+    if (!ProgramBinaryCache::isSupported())
+        CORRADE_SKIP("GL_ARB_get_program_binary is not supported.");
+
+    {
+        ProgramBinaryCache cache{directory_};
+        InfiniteGridShader shader{&cache};
+        CORRADE_COMPARE(cache.savedCount(), 1);
+    }
+
+    // Whatever is in the cache directory, the shader still gets compiled
+    const auto files = Utility::Path::list(
+        directory_, Utility::Path::ListFlag::SkipDirectories | Utility::Path::ListFlag::SkipDotAndDotDot);
+    CORRADE_VERIFY(files);
+    for (const Containers::String& file : *files)
+        CORRADE_VERIFY(Utility::Path::write(Utility::Path::join(directory_, file), Containers::arrayView("garbage")));
+
+    ProgramBinaryCache cache{directory_};
+    InfiniteGridShader shader{&cache};
+    CORRADE_COMPARE(cache.loadedCount(), 0);
+    CORRADE_COMPARE(cache.rejectedCount(), 1);
+    drawWith(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ProgramBinaryCacheGLBenchmark::CompileFromSource()
+{
+    CORRADE_BENCHMARK(10)
+    {
+        InfiniteGridShader shader;
+    }
+}
+
+void ProgramBinaryCacheGLBenchmark::LoadFromCache()
+{
+    if (!ProgramBinaryCache::isSupported())
+        CORRADE_SKIP("GL_ARB_get_program_binary is not supported.");
+
+    ProgramBinaryCache       cache{directory_};
+    const InfiniteGridShader cold{&cache};
+
+    CORRADE_BENCHMARK(10)
+    {
+        InfiniteGridShader shader{&cache};
+    }
+
+    CORRADE_COMPARE(cache.loadedCount(), 10);
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::ProgramBinaryCacheGLBenchmark)
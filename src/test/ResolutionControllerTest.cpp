@@ -0,0 +1,121 @@
+#include "../render/ResolutionController.h"
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Tester.h>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+struct ResolutionControllerTest : Corrade::TestSuite::Tester
+{
+    explicit ResolutionControllerTest();
+
+    void Disabled();
+    void HoldsBudget();
+    void RecoversWithHeadroom();
+    void Interaction();
+};
+
+ResolutionControllerTest::ResolutionControllerTest()
+{
+    addTests({&ResolutionControllerTest::Disabled});
+    addTests({&ResolutionControllerTest::HoldsBudget});
+    addTests({&ResolutionControllerTest::RecoversWithHeadroom});
+    addTests({&ResolutionControllerTest::Interaction});
+}
+
+// A pane whose GPU time grows with its pixel count
+std::chrono::nanoseconds render(const std::chrono::nanoseconds fullResolutionTime, const Float scale)
+{
+    return std::chrono::nanoseconds{Long(Float(fullResolutionTime.count()) * scale * scale)};
+}
+
+void ResolutionControllerTest::Disabled()
+{
+    ResolutionController controller{8ms};
+    controller.setEnabled(false);
+
+    for (Int frame = 0; frame != 10; ++frame)
+        controller.addSample(render(40ms, controller.scale()), controller.scale());
+    controller.interact();
+
+    CORRADE_COMPARE(controller.scale(), 1.0f);
+    // It still keeps track of the GPU time
+    CORRADE_COMPARE_WITH(Float(controller.estimatedFullResolutionTime().count()), 40.0e6f,
+                         TestSuite::Compare::around(1.0e3f));
+}
+
+void ResolutionControllerTest::HoldsBudget()
+{
+    // A heavy point cloud taking 32 ms at full resolution needs half the resolution to fit into 8 ms
+    ResolutionController controller{8ms};
+    for (Int frame = 0; frame != 30; ++frame)
+    {
+        controller.addSample(render(32ms, controller.scale()), controller.scale());
+        controller.nextFrame();
+    }
+
+    CORRADE_COMPARE(controller.scale(), 0.5f);
+    CORRADE_COMPARE_AS(render(32ms, controller.scale()).count(), (8ms).count(), TestSuite::Compare::LessOrEqual);
+
+    // ... and never goes below the minimum, even if nothing fits
+    for (Int frame = 0; frame != 30; ++frame)
+        controller.addSample(render(10s, controller.scale()), controller.scale());
+    CORRADE_COMPARE(controller.scale(), ResolutionController::MinScale);
+}
+
+void ResolutionControllerTest::RecoversWithHeadroom()
+{
+    ResolutionController controller{8ms};
+    for (Int frame = 0; frame != 30; ++frame)
+        controller.addSample(render(32ms, controller.scale()), controller.scale());
+    CORRADE_COMPARE(controller.scale(), 0.5f);
+
+    // Slightly cheaper content would fit a step more, but not with the headroom, so the scale stays
+    for (Int frame = 0; frame != 30; ++frame)
+        controller.addSample(render(24ms, controller.scale()), controller.scale());
+    CORRADE_COMPARE(controller.scale(), 0.5f);
+
+    // Once the content gets light, it goes back to full resolution
+    for (Int frame = 0; frame != 30; ++frame)
+        controller.addSample(render(2ms, controller.scale()), controller.scale());
+    CORRADE_COMPARE(controller.scale(), 1.0f);
+}
+
+void ResolutionControllerTest::Interaction()
+{
+    ResolutionController controller{8ms};
+    controller.setInteractionScale(0.5f);
+    controller.addSample(2ms, 1.0f);
+    CORRADE_COMPARE(controller.scale(), 1.0f);
+
+    // Moving the camera drops the resolution right away ...
+    controller.interact();
+    CORRADE_VERIFY(controller.isInteracting());
+    CORRADE_COMPARE(controller.scale(), 0.5f);
+
+    // ... and it stays dropped until the movement stopped for a while
+    for (Int frame = 0; frame != ResolutionController::InteractionFrames - 1; ++frame)
+        controller.nextFrame();
+    CORRADE_COMPARE(controller.scale(), 0.5f);
+    controller.nextFrame();
+    CORRADE_VERIFY(!controller.isInteracting());
+    CORRADE_COMPARE(controller.scale(), 1.0f);
+
+    // An interaction scale above the budget scale doesn't raise the resolution
+    for (Int frame = 0; frame != 30; ++frame)
+        controller.addSample(render(128ms, controller.scale()), controller.scale());
+    controller.interact();
+    CORRADE_COMPARE(controller.scale(), 0.25f);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::ResolutionControllerTest)
@@ -0,0 +1,150 @@
+#include "../render/RingAllocator.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct RingAllocatorTest : Corrade::TestSuite::Tester
+{
+    explicit RingAllocatorTest();
+
+    void Alignment();
+    void WrapAround();
+    void Full();
+    void TooLarge();
+    void Streaming();
+};
+
+RingAllocatorTest::RingAllocatorTest()
+{
+    addTests({&RingAllocatorTest::Alignment});
+    addTests({&RingAllocatorTest::WrapAround});
+    addTests({&RingAllocatorTest::Full});
+    addTests({&RingAllocatorTest::TooLarge});
+    addTests({&RingAllocatorTest::Streaming});
+}
+
+void RingAllocatorTest::Alignment()
+{
+    RingAllocator ring{1024};
+    CORRADE_COMPARE(ring.allocate(10), 0);
+    // Uniform buffer ranges have to start at a multiple of the offset alignment
+    CORRADE_COMPARE(ring.allocate(16, 256), 256);
+    CORRADE_COMPARE(ring.allocate(4, 4), 272);
+    CORRADE_COMPARE(ring.used(), 276);
+}
+
+void RingAllocatorTest::WrapAround()
+{
+    RingAllocator ring{1000};
+    CORRADE_COMPARE(ring.allocate(600), 0);
+    ring.finishFrame();
+    CORRADE_COMPARE(ring.allocate(300), 600);
+    ring.finishFrame();
+
+    // Doesn't fit at the end and the beginning is still in use by the first frame
+    CORRADE_VERIFY(!ring.allocate(200));
+
+    // Once the GPU is done with it, the allocation wraps around and the last 100 bytes are skipped
+    ring.releaseFrame();
+    CORRADE_COMPARE(ring.allocate(200), 0);
+    CORRADE_COMPARE(ring.used(), 300 + 100 + 200);
+    ring.finishFrame();
+    CORRADE_COMPARE(ring.pendingFrameCount(), 2);
+
+    // The second frame ends right before the skipped bytes, which are released with the third
+    ring.releaseFrame();
+    CORRADE_COMPARE(ring.used(), 300);
+    CORRADE_COMPARE(ring.allocate(400), 200);
+    CORRADE_VERIFY(!ring.allocate(500));
+    ring.finishFrame();
+    ring.releaseFrame();
+    ring.releaseFrame();
+    CORRADE_COMPARE(ring.used(), 0);
+}
+
+void RingAllocatorTest::Full()
+{
+    RingAllocator ring{256};
+    CORRADE_COMPARE(ring.allocate(256), 0);
+    CORRADE_VERIFY(!ring.allocate(1));
+    ring.finishFrame();
+    CORRADE_VERIFY(!ring.allocate(1));
+
+    ring.releaseFrame();
+    CORRADE_COMPARE(ring.allocate(1), 0);
+}
+
+void RingAllocatorTest::TooLarge()
+{
+    RingAllocator ring{1000};
+    CORRADE_VERIFY(!ring.allocate(1001));
+    CORRADE_COMPARE(ring.used(), 0);
+}
+
+void RingAllocatorTest::Streaming()
+{
+    // A point cloud that changes size every frame, with up to three frames in flight on the GPU. No allocation may
+    // overlap a range a frame in flight still uses.
+    constexpr std::size_t capacity       = 64 * 1024;
+    constexpr std::size_t framesInFlight = 3;
+
+    RingAllocator                                                 ring{capacity};
+    std::deque<std::vector<std::pair<std::size_t, std::size_t>>> inFlight;
+    std::vector<std::pair<std::size_t, std::size_t>>              current;
+
+    std::size_t allocations = 0;
+    for (std::size_t frame = 0; frame != 500; ++frame)
+    {
+        for (std::size_t draw = 0; draw != 4; ++draw)
+        {
+            const std::size_t size = 1000 + (frame * 7919 + draw * 104729) % 4000;
+
+            // The GPU is slow, so the oldest frame is only waited for if there is no room
+            std::optional<std::size_t> offset;
+            while (!(offset = ring.allocate(size, 256)))
+            {
+                CORRADE_VERIFY(!inFlight.empty());
+                inFlight.pop_front();
+                ring.releaseFrame();
+            }
+
+            CORRADE_COMPARE(*offset % 256, 0);
+            CORRADE_VERIFY(*offset + size <= capacity);
+            for (const auto& ranges : inFlight)
+                for (const auto& [begin, end] : ranges)
+                    CORRADE_VERIFY(*offset + size <= begin || *offset >= end);
+            for (const auto& [begin, end] : current)
+                CORRADE_VERIFY(*offset + size <= begin || *offset >= end);
+
+            current.emplace_back(*offset, *offset + size);
+            ++allocations;
+        }
+
+        ring.finishFrame();
+        inFlight.push_back(std::move(current));
+        current.clear();
+        if (inFlight.size() > framesInFlight)
+        {
+            inFlight.pop_front();
+            ring.releaseFrame();
+        }
+        CORRADE_COMPARE(ring.pendingFrameCount(), inFlight.size());
+    }
+
+    CORRADE_COMPARE(allocations, 2000);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::RingAllocatorTest)
@@ -0,0 +1,122 @@
+#include "../containers/SpscQueue.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <memory>
+#include <thread>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct SpscQueueTest : Corrade::TestSuite::Tester
+{
+    explicit SpscQueueTest();
+
+    void Order();
+    void Full();
+    void MoveOnly();
+    void TwoThreads();
+};
+
+SpscQueueTest::SpscQueueTest()
+{
+    addTests({&SpscQueueTest::Order});
+    addTests({&SpscQueueTest::Full});
+    addTests({&SpscQueueTest::MoveOnly});
+    addTests({&SpscQueueTest::TwoThreads});
+}
+
+void SpscQueueTest::Order()
+{
+    SpscQueue<int> queue{4};
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_VERIFY(!queue.pop());
+
+    // Going around the end of the slots more than once
+    for (int round = 0; round != 3; ++round)
+    {
+        CORRADE_VERIFY(queue.push(round * 10 + 1));
+        CORRADE_VERIFY(queue.push(round * 10 + 2));
+        CORRADE_VERIFY(queue.push(round * 10 + 3));
+        CORRADE_VERIFY(!queue.isEmpty());
+        CORRADE_COMPARE(queue.pop(), round * 10 + 1);
+        CORRADE_COMPARE(queue.pop(), round * 10 + 2);
+        CORRADE_COMPARE(queue.pop(), round * 10 + 3);
+        CORRADE_VERIFY(queue.isEmpty());
+    }
+}
+
+void SpscQueueTest::Full()
+{
+    SpscQueue<int> queue{2};
+    CORRADE_COMPARE(queue.capacity(), 2);
+    CORRADE_VERIFY(queue.push(1));
+    CORRADE_VERIFY(queue.push(2));
+    CORRADE_VERIFY(!queue.push(3));
+
+    // Popping one makes room for exactly one
+    CORRADE_COMPARE(queue.pop(), 1);
+    CORRADE_VERIFY(queue.push(3));
+    CORRADE_VERIFY(!queue.push(4));
+    CORRADE_COMPARE(queue.pop(), 2);
+    CORRADE_COMPARE(queue.pop(), 3);
+    CORRADE_VERIFY(!queue.pop());
+}
+
+void SpscQueueTest::MoveOnly()
+{
+    SpscQueue<std::unique_ptr<int>> queue{1};
+    CORRADE_VERIFY(queue.push(std::make_unique<int>(7)));
+
+    // A value that doesn't fit stays with the caller
+    auto rejected = std::make_unique<int>(8);
+    CORRADE_VERIFY(!queue.push(std::move(rejected)));
+    CORRADE_VERIFY(rejected);
+    CORRADE_COMPARE(*rejected, 8);
+
+    std::optional<std::unique_ptr<int>> popped = queue.pop();
+    CORRADE_VERIFY(popped && *popped);
+    CORRADE_COMPARE(**popped, 7);
+}
+
+void SpscQueueTest::TwoThreads()
+{
+    // A small queue, so that the producer keeps running into a full one and the consumer into an empty one. Both yield
+    // then, so that the test doesn't crawl on a single core.
+    constexpr int  count = 200000;
+    SpscQueue<int> queue{8};
+
+    std::thread producer{[&]
+                         {
+                             for (int i = 0; i != count;)
+                             {
+                                 if (queue.push(int{i}))
+                                     ++i;
+                                 else
+                                     std::this_thread::yield();
+                             }
+                         }};
+
+    int  expected = 0;
+    bool inOrder  = true;
+    while (expected != count)
+    {
+        if (const std::optional<int> value = queue.pop())
+            inOrder &= *value == expected++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    CORRADE_VERIFY(inOrder);
+    CORRADE_VERIFY(queue.isEmpty());
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::SpscQueueTest)
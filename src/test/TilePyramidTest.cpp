@@ -0,0 +1,135 @@
+#include "../render/TilePyramid.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/Math/Range.h>
+#include <set>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+using Tile = TilePyramid::Tile;
+
+struct TilePyramidTest : Corrade::TestSuite::Tester
+{
+    explicit TilePyramidTest();
+
+    void Levels();
+    void Tiles();
+    void Level();
+    void VisibleTiles();
+    void Keys();
+};
+
+TilePyramidTest::TilePyramidTest()
+{
+    addTests({&TilePyramidTest::Levels});
+    addTests({&TilePyramidTest::Tiles});
+    addTests({&TilePyramidTest::Level});
+    addTests({&TilePyramidTest::VisibleTiles});
+    addTests({&TilePyramidTest::Keys});
+}
+
+void TilePyramidTest::Levels()
+{
+    // 1000 x 600 -> 500 x 300 -> 250 x 150, which fits one tile
+    const TilePyramid pyramid{{1000, 600}};
+    CORRADE_COMPARE(pyramid.levelCount(), 3);
+    CORRADE_COMPARE(pyramid.levelSize(0), Vector2i(1000, 600));
+    CORRADE_COMPARE(pyramid.levelSize(1), Vector2i(500, 300));
+    CORRADE_COMPARE(pyramid.levelSize(2), Vector2i(250, 150));
+    CORRADE_COMPARE(pyramid.tileCount(0), Vector2i(4, 3));
+    CORRADE_COMPARE(pyramid.tileCount(2), Vector2i(1, 1));
+
+    // Odd sizes round up
+    const TilePyramid odd{{1001, 257}};
+    CORRADE_COMPARE(odd.levelCount(), 3);
+    CORRADE_COMPARE(odd.levelSize(1), Vector2i(501, 129));
+    CORRADE_COMPARE(odd.levelSize(2), Vector2i(251, 65));
+
+    // A gigapixel image needs only a handful of levels
+    const TilePyramid giga{{65536, 32768}};
+    CORRADE_COMPARE(giga.levelCount(), 9);
+    CORRADE_COMPARE(giga.tileCount(0), Vector2i(256, 128));
+    CORRADE_COMPARE(giga.levelSize(8), Vector2i(256, 128));
+}
+
+void TilePyramidTest::Tiles()
+{
+    const TilePyramid pyramid{{1000, 600}};
+
+    // Tiles at the right and bottom edges are smaller
+    CORRADE_COMPARE(pyramid.tilePixels({0, {1, 1}}), Range2Di({256, 256}, {512, 512}));
+    CORRADE_COMPARE(pyramid.tilePixels({0, {3, 2}}), Range2Di({768, 512}, {1000, 600}));
+    CORRADE_COMPARE(pyramid.tilePixels({1, {1, 1}}), Range2Di({256, 256}, {500, 300}));
+
+    // Areas are in full resolution pixels
+    CORRADE_COMPARE(pyramid.tileArea({1, {1, 0}}), Range2D({512.0f, 0.0f}, {1000.0f, 512.0f}));
+    CORRADE_COMPARE(pyramid.tileArea({2, {0, 0}}), Range2D({0.0f, 0.0f}, {1000.0f, 600.0f}));
+
+    CORRADE_VERIFY(pyramid.parent({0, {3, 2}}) == (Tile{1, {1, 1}}));
+    CORRADE_VERIFY(pyramid.parent({1, {1, 1}}) == (Tile{2, {0, 0}}));
+}
+
+void TilePyramidTest::Level()
+{
+    const TilePyramid pyramid{{65536, 32768}};
+
+    // Zoomed in, the full resolution is shown
+    CORRADE_COMPARE(pyramid.level(4.0f), 0);
+    CORRADE_COMPARE(pyramid.level(1.0f), 0);
+    // Tiles never have fewer pixels than they cover on the screen
+    CORRADE_COMPARE(pyramid.level(0.75f), 0);
+    CORRADE_COMPARE(pyramid.level(0.5f), 1);
+    CORRADE_COMPARE(pyramid.level(0.3f), 1);
+    CORRADE_COMPARE(pyramid.level(0.25f), 2);
+    // Zoomed out beyond the coarsest level
+    CORRADE_COMPARE(pyramid.level(1.0f / 4096.0f), 8);
+    CORRADE_COMPARE(pyramid.level(0.0f), 8);
+}
+
+void TilePyramidTest::VisibleTiles()
+{
+    const TilePyramid pyramid{{1000, 600}};
+    std::vector<Tile> tiles;
+
+    pyramid.visibleTiles({{300.0f, 100.0f}, {600.0f, 300.0f}}, 0, tiles);
+    CORRADE_COMPARE(tiles.size(), 4);
+    CORRADE_VERIFY(tiles.front() == (Tile{0, {1, 0}}));
+    CORRADE_VERIFY(tiles.back() == (Tile{0, {2, 1}}));
+
+    // Areas reaching out of the image are clipped to it
+    pyramid.visibleTiles({{-500.0f, -500.0f}, {2000.0f, 2000.0f}}, 1, tiles);
+    CORRADE_COMPARE(tiles.size(), 4);
+    pyramid.visibleTiles({{-500.0f, -500.0f}, {2000.0f, 2000.0f}}, 2, tiles);
+    CORRADE_COMPARE(tiles.size(), 1);
+
+    // ... and there's nothing to see next to it
+    pyramid.visibleTiles({{1200.0f, 0.0f}, {1500.0f, 300.0f}}, 0, tiles);
+    CORRADE_VERIFY(tiles.empty());
+}
+
+void TilePyramidTest::Keys()
+{
+    const TilePyramid pyramid{{65536, 32768}};
+
+    std::set<UnsignedLong> keys;
+    std::size_t            count = 0;
+    for (UnsignedInt level = 0; level != pyramid.levelCount(); level += 4)
+        for (Int y = 0; y < pyramid.tileCount(level).y(); y += 7)
+            for (Int x = 0; x < pyramid.tileCount(level).x(); x += 7)
+            {
+                keys.insert(TilePyramid::key({level, {x, y}}));
+                ++count;
+            }
+    CORRADE_COMPARE(keys.size(), count);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::TilePyramidTest)
@@ -0,0 +1,238 @@
+#include "../render/RenderTarget.h"
+#include "../render/TiledImage.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Image.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/PixelFormat.h>
+#include <memory>
+
+using namespace Corrade;
+using namespace Magnum;
+
+namespace Test
+{
+namespace
+{
+
+// 1024 x 512 -> 512 x 256 -> 256 x 128 -> 128 x 64 -> 64 x 32
+constexpr Vector2i ImageSize{1024, 512};
+constexpr Int      TileSize = 64;
+
+struct TiledImageGLTest : GL::OpenGLTester
+{
+    explicit TiledImageGLTest();
+
+    void CoarsestFirst();
+    void SeveralPanes();
+    void BoundedCache();
+    void NotLoadedYet();
+    void FromImage();
+
+private:
+    TiledImage::Loader loader();
+    Color4ub           colorAt(RenderTarget& target, const Vector2i& position);
+
+    GpuResources resources_;
+    std::size_t  loadCount_{0};
+};
+
+TiledImageGLTest::TiledImageGLTest()
+{
+    addTests({&TiledImageGLTest::CoarsestFirst});
+    addTests({&TiledImageGLTest::SeveralPanes});
+    addTests({&TiledImageGLTest::BoundedCache});
+    addTests({&TiledImageGLTest::NotLoadedYet});
+    addTests({&TiledImageGLTest::FromImage});
+}
+
+// Every tile is filled with a color telling its level and index apart
+TiledImage::Loader TiledImageGLTest::loader()
+{
+    return [this, pyramid = TilePyramid{ImageSize, TileSize}](const TilePyramid::Tile& tile)
+    {
+        ++loadCount_;
+        const Vector2i size = pyramid.tilePixels(tile).size();
+        const Color4ub color{UnsignedByte(tile.level * 50), UnsignedByte(tile.index.x() * 16),
+                             UnsignedByte(tile.index.y() * 16), 255};
+        Containers::Array<char> data{NoInit, std::size_t(size.product()) * 4};
+        for (Color4ub& pixel : Containers::arrayCast<Color4ub>(data))
+            pixel = color;
+        return std::optional<Image2D>{Image2D{PixelFormat::RGBA8Unorm, size, std::move(data)}};
+    };
+}
+
+Color4ub TiledImageGLTest::colorAt(RenderTarget& target, const Vector2i& position)
+{
+    const Image2D image = target.resolvedFramebuffer().read(Range2Di::fromSize(position, Vector2i{1}),
+                                                            {PixelFormat::RGBA8Unorm});
+    return image.pixels<Color4ub>()[0][0];
+}
+
+void TiledImageGLTest::CoarsestFirst()
+{
+    // The whole image in 128 x 64 pixels is level 3, which is two tiles
+    constexpr Vector2i targetSize{128, 64};
+    RenderTarget       target{targetSize};
+    TiledImage         image{resources_, ImageSize, loader(), TileSize};
+    image.setUploadBudget(1);
+    CORRADE_COMPARE(image.pyramid().levelCount(), 5);
+
+    // First only the coarsest tile is there, which everything is drawn from
+    target.clear().framebuffer().bind();
+    image.update();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.stats().drawnTiles, 0);
+    CORRADE_COMPARE(image.stats().fallbackTiles, 2);
+    CORRADE_COMPARE(image.stats().pendingTiles, 2);
+    CORRADE_VERIFY(image.isStreaming());
+    CORRADE_COMPARE(colorAt(target, {32, 32}), (Color4ub{200, 0, 0, 255}));
+    CORRADE_COMPARE(colorAt(target, {96, 32}), (Color4ub{200, 0, 0, 255}));
+
+    // ... then a tile per draw, nearest to the center first
+    target.clear().framebuffer().bind();
+    image.update();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    CORRADE_COMPARE(image.stats().drawnTiles, 1);
+    CORRADE_COMPARE(image.stats().fallbackTiles, 1);
+
+    target.clear().framebuffer().bind();
+    image.update();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.stats().drawnTiles, 2);
+    CORRADE_VERIFY(!image.isStreaming());
+    CORRADE_COMPARE(image.uploadCount(), 3);
+    CORRADE_COMPARE(colorAt(target, {32, 32}), (Color4ub{150, 0, 0, 255}));
+    CORRADE_COMPARE(colorAt(target, {96, 32}), (Color4ub{150, 16, 0, 255}));
+}
+
+void TiledImageGLTest::SeveralPanes()
+{
+    constexpr Vector2i targetSize{128, 64};
+    RenderTarget       target{targetSize};
+    TiledImage         image{resources_, ImageSize, loader(), TileSize};
+    image.setUploadBudget(1);
+
+    // Two panes showing the image in one frame, the second one uploads a tile in addition to what the first one did
+    image.update();
+    target.clear().framebuffer().bind();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.uploadCount(), 2);
+    CORRADE_COMPARE(image.stats().drawnTiles, 1);
+    CORRADE_COMPARE(image.stats().fallbackTiles, 3);
+    CORRADE_COMPARE(image.stats().pendingTiles, 3);
+    CORRADE_VERIFY(image.isStreaming());
+
+    image.update();
+    target.clear().framebuffer().bind();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    CORRADE_COMPARE(image.stats().drawnTiles, 2);
+    CORRADE_VERIFY(!image.isStreaming());
+}
+
+void TiledImageGLTest::BoundedCache()
+{
+    // 128 x 128 image pixels in as many screen pixels are 2 x 2 tiles of the full resolution
+    constexpr Vector2i targetSize{128, 128};
+    constexpr Int      capacity = 8;
+    RenderTarget       target{targetSize};
+    TiledImage         image{resources_, ImageSize, loader(), TileSize, capacity};
+    CORRADE_COMPARE(image.cacheCapacity(), capacity);
+    CORRADE_COMPARE(resources_.memory().used(GpuMemoryRegistry::Kind::TEXTURE),
+                    std::size_t(TileSize * TileSize * capacity * 4));
+
+    // Panning along the top of the image goes through far more tiles than fit the cache
+    for (Int x = 0; x != ImageSize.x(); x += 2 * TileSize)
+    {
+        const Range2D area = Range2D::fromSize({Float(x), 0.0f}, Vector2{targetSize});
+        for (Int i = 0; i != 8 && (i == 0 || image.isStreaming()); ++i)
+        {
+            target.clear().framebuffer().bind();
+            image.update();
+            image.draw(area, targetSize);
+        }
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_ITERATION(x);
+        CORRADE_COMPARE(image.stats().drawnTiles, 4);
+        CORRADE_VERIFY(image.residentTileCount() <= std::size_t(capacity));
+        // Y is up in the target and down in the image
+        CORRADE_COMPARE(colorAt(target, {10, 118}), (Color4ub{0, UnsignedByte(x / TileSize * 16), 0, 255}));
+        CORRADE_COMPARE(colorAt(target, {74, 10}), (Color4ub{0, UnsignedByte((x / TileSize + 1) * 16), 16, 255}));
+    }
+
+    CORRADE_VERIFY(image.uploadCount() > std::size_t(capacity));
+    CORRADE_COMPARE(resources_.memory().used(GpuMemoryRegistry::Kind::TEXTURE),
+                    std::size_t(TileSize * TileSize * capacity * 4));
+}
+
+void TiledImageGLTest::NotLoadedYet()
+{
+    constexpr Vector2i targetSize{128, 64};
+    RenderTarget       target{targetSize};
+
+    // A loader that doesn't have the pixels yet, e.g. because they're still being decoded
+    bool       ready = false;
+    TiledImage image{resources_, ImageSize,
+                     [&, load = loader()](const TilePyramid::Tile& tile)
+                     { return ready ? load(tile) : std::nullopt; },
+                     TileSize};
+
+    target.clear().framebuffer().bind();
+    image.update();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.stats().drawnTiles, 0);
+    CORRADE_COMPARE(image.stats().fallbackTiles, 0);
+    CORRADE_VERIFY(image.isStreaming());
+    CORRADE_COMPARE(image.uploadCount(), 0);
+    CORRADE_COMPARE(colorAt(target, {32, 32}), (Color4ub{0, 0, 0, 0}));
+
+    ready = true;
+    target.clear().framebuffer().bind();
+    image.update();
+    image.draw({{}, Vector2{ImageSize}}, targetSize);
+    CORRADE_COMPARE(image.stats().drawnTiles, 2);
+    CORRADE_VERIFY(!image.isStreaming());
+}
+
+void TiledImageGLTest::FromImage()
+{
+    // Every pixel tells its column and its row from the top apart
+    constexpr Vector2i      size{300, 200};
+    Containers::Array<char> data{NoInit, std::size_t(size.product()) * 4};
+    auto                    image = std::make_shared<Image2D>(PixelFormat::RGBA8Unorm, size, std::move(data));
+
+    const Containers::StridedArrayView2D<Color4ub> pixels = image->pixels<Color4ub>();
+    for (Int y = 0; y != size.y(); ++y)
+        for (Int x = 0; x != size.x(); ++x)
+            pixels[std::size_t(y)][std::size_t(x)] = {UnsignedByte(x), UnsignedByte(size.y() - 1 - y), 0, 255};
+
+    // 300 x 200 -> 150 x 100, in tiles of 256
+    const TiledImage::Loader load = TiledImage::imageLoader(image, 256);
+
+    // The right tile of the full resolution, which is cut by the image edge. Its rows are bottom-up too.
+    const std::optional<Image2D> right = load({0, {1, 0}});
+    CORRADE_VERIFY(right);
+    CORRADE_COMPARE(right->size(), (Vector2i{44, 200}));
+    CORRADE_COMPARE(right->pixels<Color4ub>()[0][0], (Color4ub{0, 199, 0, 255}));
+    CORRADE_COMPARE(right->pixels<Color4ub>()[199][43], (Color4ub{43, 0, 0, 255}));
+
+    // The coarser level takes the pixel in the middle of every 2 x 2, clamped to the image at the edge
+    const std::optional<Image2D> coarse = load({1, {0, 0}});
+    CORRADE_VERIFY(coarse);
+    CORRADE_COMPARE(coarse->size(), (Vector2i{150, 100}));
+    CORRADE_COMPARE(coarse->pixels<Color4ub>()[99][0], (Color4ub{1, 1, 0, 255}));
+    CORRADE_COMPARE(coarse->pixels<Color4ub>()[0][149], (Color4ub{43, 199, 0, 255}));
+}
+
+} // namespace
+} // namespace Test
+
+MAGNUM_GL_TEST_MAIN(Test::TiledImageGLTest)
@@ -0,0 +1,209 @@
+#include "../render/TransformCache.h"
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Matrix4.h>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace Corrade;
+
+namespace Test
+{
+namespace
+{
+
+struct TransformCacheTest : Corrade::TestSuite::Tester
+{
+    explicit TransformCacheTest();
+
+    void OnlyDirtyObjects();
+    void Hierarchy();
+    void SharedAcrossCameras();
+    void FrustumCulling();
+    void RenderStates();
+};
+
+TransformCacheTest::TransformCacheTest()
+{
+    addTests({&TransformCacheTest::OnlyDirtyObjects});
+    addTests({&TransformCacheTest::Hierarchy});
+    addTests({&TransformCacheTest::SharedAcrossCameras});
+    addTests({&TransformCacheTest::FrustumCulling});
+    addTests({&TransformCacheTest::RenderStates});
+}
+
+class RecordingDrawable : public Object3D, public SceneDrawable
+{
+public:
+    explicit RecordingDrawable(Object3D* parent, SceneGraph::DrawableGroup3D& drawables)
+    : Object3D(parent)
+    , SceneDrawable(static_cast<Object3D&>(*this), &drawables)
+    {
+    }
+
+    void draw(const Matrix4& transformation, SceneGraph::Camera3D&) override
+    {
+        transformations.push_back(transformation);
+    }
+
+    RenderState renderState() const override { return state ? *state : SceneDrawable::renderState(); }
+
+    std::vector<Matrix4>       transformations;
+    std::optional<RenderState> state;
+};
+
+void TransformCacheTest::OnlyDirtyObjects()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    RecordingDrawable           a{&scene, drawables};
+    RecordingDrawable           b{&scene, drawables};
+    RecordingDrawable           c{&scene, drawables};
+
+    TransformCache cache;
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.size(), 3);
+    CORRADE_COMPARE(cache.updatedCount(), 3);
+
+    // Nothing moved
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.updatedCount(), 0);
+
+    b.translate(Vector3::xAxis(2.0f));
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.updatedCount(), 1);
+    CORRADE_COMPARE(b.worldTransformation(), Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(a.worldTransformation(), Matrix4{});
+}
+
+void TransformCacheTest::Hierarchy()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    RecordingDrawable           parent{&scene, drawables};
+    RecordingDrawable           child{&parent, drawables};
+    RecordingDrawable           other{&scene, drawables};
+
+    TransformCache cache;
+    cache.update(drawables);
+
+    // Moving the parent moves the child as well, but not the unrelated object
+    parent.translate(Vector3::yAxis(1.0f));
+    child.translate(Vector3::xAxis(1.0f));
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.updatedCount(), 2);
+    CORRADE_COMPARE(child.worldTransformation(), Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
+void TransformCacheTest::SharedAcrossCameras()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    RecordingDrawable           drawable{&scene, drawables};
+    drawable.translate(Vector3::zAxis(-5.0f));
+
+    std::vector<std::unique_ptr<Object3D>>             cameraObjects;
+    std::vector<std::unique_ptr<SceneGraph::Camera3D>> cameras;
+    for (Int i = 0; i != 4; ++i)
+    {
+        auto& object = *cameraObjects.emplace_back(std::make_unique<Object3D>(&scene));
+        object.translate(Vector3::xAxis(Float(i)));
+        cameras.push_back(std::make_unique<SceneGraph::Camera3D>(object));
+    }
+
+    TransformCache cache;
+    cache.update(drawables);
+    for (auto& camera : cameras)
+        cache.draw(*camera);
+
+    // One world transformation, combined with each camera
+    CORRADE_COMPARE(cache.updatedCount(), 1);
+    CORRADE_COMPARE(drawable.transformations.size(), 4);
+    for (std::size_t i = 0; i != cameras.size(); ++i)
+    {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(drawable.transformations[i], Matrix4::translation({-Float(i), 0.0f, -5.0f}));
+    }
+}
+
+void TransformCacheTest::FrustumCulling()
+{
+    using namespace Math::Literals;
+
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+
+    // A row of unit cubes along X, and one drawable without bounds
+    std::vector<std::unique_ptr<RecordingDrawable>> cubes;
+    for (Int i = 0; i != 100; ++i)
+    {
+        auto& cube = *cubes.emplace_back(std::make_unique<RecordingDrawable>(&scene, drawables));
+        cube.setBoundingBox({{-0.5f}, {0.5f}});
+        cube.translate({Float(i) * 2.0f, 0.0f, -10.0f});
+    }
+    RecordingDrawable unbounded{&scene, drawables};
+
+    // A narrow camera looking down -Z at the first cubes only
+    Object3D             cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(10.0_degf, 1.0f, 0.01f, 100.0f));
+
+    TransformCache cache;
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.bvhBuildCount(), 1);
+
+    const TransformCache::CullingStats stats = cache.draw(camera);
+    CORRADE_COMPARE(stats.drawn + stats.culled, 101);
+    CORRADE_COMPARE(stats.drawn, 2); // The first cube and the unbounded drawable
+    CORRADE_COMPARE(cubes[0]->transformations.size(), 1);
+    CORRADE_VERIFY(cubes[50]->transformations.empty());
+    CORRADE_COMPARE(unbounded.transformations.size(), 1);
+
+    // Moving a cube into view refits the tree instead of rebuilding it
+    cubes[50]->translate({-100.0f, 0.0f, 0.0f});
+    cache.update(drawables);
+    CORRADE_COMPARE(cache.bvhBuildCount(), 1);
+    CORRADE_COMPARE(cache.draw(camera).drawn, 3);
+    CORRADE_COMPARE(cubes[50]->transformations.size(), 1);
+
+    // Without culling everything is drawn
+    cache.setCullingEnabled(false);
+    CORRADE_COMPARE(cache.draw(camera).drawn, 101);
+}
+
+void TransformCacheTest::RenderStates()
+{
+    Scene3D                     scene;
+    SceneGraph::DrawableGroup3D drawables;
+    RecordingDrawable           grid{&scene, drawables};
+    RecordingDrawable           points{&scene, drawables};
+    RecordingDrawable           mesh{&scene, drawables};
+    grid.state   = RenderState{RenderFeature::DEPTH_TEST | RenderFeature::BLENDING};
+    points.state = RenderState{RenderFeature::DEPTH_TEST, 3.0f};
+
+    Object3D             cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+
+    std::vector<Float> pointSizes;
+    StateTracker       state{[](RenderFeature, bool) {}, [&](const Float size) { pointSizes.push_back(size); }};
+
+    // Every drawable is drawn with its own state, set right before it
+    TransformCache cache;
+    cache.update(drawables);
+    cache.draw(camera, &state);
+    CORRADE_COMPARE(state.features(), RenderFeature::DEPTH_TEST | RenderFeature::FACE_CULLING);
+    CORRADE_COMPARE(pointSizes.size(), 3);
+    CORRADE_COMPARE(pointSizes[1], 3.0f);
+    CORRADE_COMPARE(state.pointSize(), 1.0f);
+
+    // Without a tracker the state is left alone
+    cache.draw(camera);
+    CORRADE_COMPARE(pointSizes.size(), 3);
+    CORRADE_COMPARE(mesh.transformations.size(), 2);
+}
+
+} // namespace
+} // namespace Test
+
+CORRADE_TEST_MAIN(Test::TransformCacheTest)
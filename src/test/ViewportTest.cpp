@@ -1,4 +1,5 @@
 #include "../viewports/AbstractViewport.h"
+#include "../viewports/Panel.h"
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -18,35 +19,46 @@ struct ViewportTest : Corrade::TestSuite::Tester
     explicit ViewportTest();
 
     void ViewportSize();
+    void PanelDispatch();
 };
 
 ViewportTest::ViewportTest()
 {
     addTests({&ViewportTest::ViewportSize});
+    addTests({&ViewportTest::PanelDispatch});
 }
 
 class DummyViewport : public AbstractViewport
 {
 public:
-    virtual void handlePointerPressEvent(Platform::Application::PointerEvent&) override
+    static constexpr RenderFeatures Features{};
+
+    void handlePointerPressEvent(Platform::Application::PointerEvent&)
     {
         Utility::Debug{} << "handlePointerPressEvent";
     }
-    virtual void handlePointerReleaseEvent(Platform::Application::PointerEvent&) override
+    void handlePointerReleaseEvent(Platform::Application::PointerEvent&)
     {
         Utility::Debug{} << "handlePointerReleaseEvent";
     }
-    virtual void handlePointerMoveEvent(Platform::Application::PointerMoveEvent&) override
+    void handlePointerMoveEvent(Platform::Application::PointerMoveEvent&)
     {
         Utility::Debug{} << "handlePointerMoveEvent";
     }
-    virtual void handleScrollEvent(Platform::Application::ScrollEvent&) override
-    {
-        Utility::Debug{} << "handleScrollEvent";
-    }
-    virtual void draw(SceneGraph::DrawableGroup3D&) override { Utility::Debug{} << "draw"; }
+    void handleScrollEvent(Platform::Application::ScrollEvent&) { Utility::Debug{} << "handleScrollEvent"; }
+    void draw(const TransformCache&) { Utility::Debug{} << "draw"; }
+};
+
+// Same as DummyViewport but without the event handlers, so it is not a panel
+class IncompleteViewport : public AbstractViewport
+{
+public:
+    void draw(const TransformCache&) {}
 };
 
+static_assert(Panel<DummyViewport>);
+static_assert(!Panel<IncompleteViewport>);
+
 void ViewportTest::ViewportSize()
 {
     DummyViewport viewport;
@@ -73,6 +85,21 @@ void ViewportTest::ViewportSize()
                         .getViewport());
 }
 
+void ViewportTest::PanelDispatch()
+{
+    PanelVariant<DummyViewport> panel;
+
+    std::visit([](auto& p) { p.setWindowSize(Vector2i{800, 600}).setRelativeViewport(Range2D({}, {0.5, 1.0})); },
+               panel);
+    CORRADE_COMPARE(std::visit([](const auto& p) { return p.getViewport(); }, panel),
+                    Range2Di(Vector2i(0, 0), Vector2i(400, 600)));
+
+    // The relative viewport is kept when the window is resized
+    std::visit([](auto& p) { p.setWindowSize(Vector2i{1000, 500}); }, panel);
+    CORRADE_COMPARE(std::visit([](const auto& p) { return p.getViewport(); }, panel),
+                    Range2Di(Vector2i(0, 0), Vector2i(500, 500)));
+}
+
 } // namespace
 } // namespace Test
 
@@ -14,6 +14,11 @@ AbstractViewport& AbstractViewport::setWindowSize(const Vector2i& size)
     return *this;
 }
 
+Vector2i AbstractViewport::getWindowSize() const
+{
+    return windowSize_;
+}
+
 AbstractViewport& AbstractViewport::setRelativeViewport(const Range2D& relativeViewport)
 {
     CORRADE_INTERNAL_ASSERT((relativeViewport.min() >= Vector2{0.0f}).all());
@@ -25,6 +30,11 @@ AbstractViewport& AbstractViewport::setRelativeViewport(const Range2D& relativeV
     return *this;
 }
 
+Range2D AbstractViewport::getRelativeViewport() const
+{
+    return relativeViewport_;
+}
+
 AbstractViewport& AbstractViewport::setViewport(const Range2Di& viewport)
 {
     CORRADE_INTERNAL_ASSERT((viewport.min() >= Vector2i{0}).all());
@@ -58,3 +68,12 @@ Range2Di AbstractViewport::calculateViewport(const Range2D& relativeViewport, co
 
     return Range2Di{relativeViewport.min() * windowSize, relativeViewport.max() * windowSize};
 }
+
+Range2Di AbstractViewport::calculateFramebufferViewport(const Vector2i& framebufferSize) const
+{
+    // Convert between TL origin to BL origin (default clip space in OpenGL)
+    const auto newCenter               = Vector2(relativeViewport_.center().x(), 1.0f - relativeViewport_.center().y());
+    const auto flippedRelativeViewport = Range2D::fromCenter(newCenter, relativeViewport_.size() / 2.0f);
+
+    return calculateViewport(flippedRelativeViewport, framebufferSize);
+}
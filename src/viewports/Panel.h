@@ -0,0 +1,46 @@
+#ifndef VIEWPORTS_PANEL_H
+#define VIEWPORTS_PANEL_H
+
+#include "../render/RenderState.h"
+
+#include <Magnum/Math/Range.h>
+#include <Magnum/Platform/GlfwApplication.h>
+#include <concepts>
+#include <variant>
+
+using namespace Magnum;
+
+class TransformCache;
+
+/**
+ * Interface every pane of the ViewportManager has to provide.
+ *
+ * Panels are not polymorphic: the set of panel types is closed (see PanelVariant) and events are dispatched with
+ * std::visit, so each call resolves to a direct, inlinable member function call instead of a virtual one.
+ *
+ * Features are the render features the pane is drawn with.
+ */
+template <class T>
+concept Panel = requires(T& panel, const T& constPanel, Platform::Application::PointerEvent& pointerEvent,
+                         Platform::Application::PointerMoveEvent& pointerMoveEvent,
+                         Platform::Application::ScrollEvent& scrollEvent, const TransformCache& frame,
+                         const Vector2i& windowSize, const Range2Di& viewport) {
+    panel.handlePointerPressEvent(pointerEvent);
+    panel.handlePointerReleaseEvent(pointerEvent);
+    panel.handlePointerMoveEvent(pointerMoveEvent);
+    panel.handleScrollEvent(scrollEvent);
+    panel.draw(frame);
+
+    panel.setWindowSize(windowSize);
+    panel.setViewport(viewport);
+    { constPanel.getViewport() } -> std::same_as<Range2Di>;
+    { T::Features } -> std::convertible_to<RenderFeatures>;
+};
+
+/**
+ * Closed set of panel types. Only types satisfying Panel can be part of it.
+ */
+template <Panel... Panels>
+using PanelVariant = std::variant<Panels...>;
+
+#endif // VIEWPORTS_PANEL_H
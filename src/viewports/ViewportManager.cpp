@@ -2,27 +2,76 @@
 
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/GL/Renderbuffer.h>
 #include <algorithm>
+#include <type_traits>
 
-ViewportManager::ViewportManager(const Platform::Application& applicationContext, const std::shared_ptr<Scene3D> scene)
+namespace
+{
+
+Range2Di viewportOf(const AnyPanel& panel)
+{
+    return std::visit([](const auto& p) { return p.getViewport(); }, panel);
+}
+
+// The edge of the viewport as a degenerate range, i.e. a line segment
+Range2D edgeOf(const Range2Di& viewport, const ThreeDView::EBorder border)
+{
+    const Range2D range{viewport};
+    switch (border)
+    {
+        case ThreeDView::EBorder::LEFT:   return {range.bottomLeft(), {range.left(), range.top()}};
+        case ThreeDView::EBorder::RIGHT:  return {{range.right(), range.bottom()}, range.topRight()};
+        case ThreeDView::EBorder::TOP:    return {{range.left(), range.top()}, range.topRight()};
+        case ThreeDView::EBorder::BOTTOM: return {range.bottomLeft(), {range.right(), range.bottom()}};
+    }
+
+    return {};
+}
+
+bool rendersIntoSharedTarget(const AnyPanel& panel)
+{
+    return std::visit([](const auto& p) { return requires { p.hasSharedRenderTarget(); }; }, panel);
+}
+
+} // namespace
+
+ViewportManager::ViewportManager(const Platform::Application& applicationContext, GpuResources& resources,
+                                 const std::shared_ptr<Scene3D> scene, const Int samples)
 : applicationContext_(applicationContext)
+, resources_(resources)
 , scene_(scene)
+, samples_(samples)
+, renderTargets_(Vector2i{256}, [this](const Vector2i& capacity) { return createRenderTarget(capacity); })
+, overlay_(resources)
 {
+    setSampleCounts(samples, 2);
     createNewViewport(Vector2(applicationContext_.windowSize() / 2));
 
     CORRADE_INTERNAL_ASSERT(viewports_.size() == 1);
 }
 
+std::unique_ptr<RenderTarget> ViewportManager::createRenderTarget(const Vector2i& capacity)
+{
+    auto target = std::make_unique<RenderTarget>(capacity, samples_, &resources_.memory());
+
+    // Targets left behind in the pool are only kept to be picked up again, so they can go when memory gets tight
+    resources_.memory().setEvict(target->memoryId(),
+                                 [this, target = target.get()] { return renderTargets_.erase(*target); });
+    return target;
+}
+
 void ViewportManager::handlePointerPressEvent(Platform::Application::PointerEvent& event)
 {
     // Check if you are close to the borders, if so, we want to move the edge of the viewport
     const auto activeViewport = std::find_if(viewports_.begin(), viewports_.end(), [&](const auto& v)
-                                             { return Range2D(v.getViewport()).contains(event.position()); });
+                                             { return Range2D(viewportOf(v)).contains(event.position()); });
 
     if (activeViewport == viewports_.end())
         return;
 
-    const auto viewport = activeViewport->getViewport();
+    const auto viewport = viewportOf(*activeViewport);
 
     activatedBorder_ = findBorder(viewport, event.position());
     if (activatedBorder_)
@@ -32,7 +81,7 @@ void ViewportManager::handlePointerPressEvent(Platform::Application::PointerEven
 
     for (auto& viewport : viewports_)
     {
-        viewport.handlePointerPressEvent(event);
+        std::visit([&](auto& p) { p.handlePointerPressEvent(event); }, viewport);
     }
 }
 
@@ -69,7 +118,7 @@ void ViewportManager::handlePointerReleaseEvent(Platform::Application::PointerEv
 
     for (auto& viewport : viewports_)
     {
-        viewport.handlePointerReleaseEvent(event);
+        std::visit([&](auto& p) { p.handlePointerReleaseEvent(event); }, viewport);
     }
 }
 
@@ -80,7 +129,7 @@ void ViewportManager::handlePointerMoveEvent(Platform::Application::PointerMoveE
         CORRADE_INTERNAL_ASSERT(borderInteractionViewport_ != nullptr);
         // Resize the viewport accordingly
         // TODO: what would happen if we go over to another viewport?
-        const auto originalViewport = borderInteractionViewport_->getViewport();
+        const auto originalViewport = viewportOf(*borderInteractionViewport_);
         // Move the the edge e.g., by selecting the min
         auto newRange = originalViewport;
         // TODO: remember which edge is selected and drag that one
@@ -94,14 +143,28 @@ void ViewportManager::handlePointerMoveEvent(Platform::Application::PointerMoveE
         else if (border == ThreeDView::EBorder::BOTTOM)
             newRange.bottom() = event.position().y();
         Debug{} << newRange;
-        borderInteractionViewport_->setViewport(newRange);
+        std::visit([&](auto& p) { p.setViewport(newRange); }, *borderInteractionViewport_);
 
         return;
     }
 
+    // Highlight the edge that would be dragged
+    hoveredViewport_ = nullptr;
+    hoveredBorder_   = std::nullopt;
+    for (const auto& viewport : viewports_)
+    {
+        if (!Range2D(viewportOf(viewport)).contains(event.position()))
+            continue;
+
+        hoveredBorder_ = findBorder(viewportOf(viewport), event.position());
+        if (hoveredBorder_)
+            hoveredViewport_ = &viewport;
+        break;
+    }
+
     for (auto& viewport : viewports_)
     {
-        viewport.handlePointerMoveEvent(event);
+        std::visit([&](auto& p) { p.handlePointerMoveEvent(event); }, viewport);
     }
 }
 
@@ -109,13 +172,23 @@ void ViewportManager::handleScrollEvent(Platform::Application::ScrollEvent& even
 {
     for (auto& viewport : viewports_)
     {
-        viewport.handleScrollEvent(event);
+        std::visit([&](auto& p) { p.handleScrollEvent(event); }, viewport);
     }
 }
 
-void ViewportManager::createNewViewport(const Vector2& position, const ThreeDView::EBorder& direction)
+void ViewportManager::setWindowSize(const Vector2i& windowSize)
+{
+    for (auto& viewport : viewports_)
+    {
+        std::visit([&](auto& p) { p.setWindowSize(windowSize); }, viewport);
+    }
+}
+
+Range2Di ViewportManager::splitViewport(const Vector2& position, const ThreeDView::EBorder& direction)
 {
     viewports_.reserve(viewports_.capacity() + 1);
+    hoveredViewport_ = nullptr;
+    hoveredBorder_   = std::nullopt;
 
     Range2Di newViewport;
     if (viewports_.empty())
@@ -129,11 +202,11 @@ void ViewportManager::createNewViewport(const Vector2& position, const ThreeDVie
         // There should be an active viewport that has to be subdivided in two and then each
         // scaled/translated to their new position.
         const auto activeViewport = std::find_if(viewports_.begin(), viewports_.end(), [&](const auto& v)
-                                                 { return Range2D(v.getViewport()).contains(position); });
+                                                 { return Range2D(viewportOf(v)).contains(position); });
 
         CORRADE_INTERNAL_ASSERT(activeViewport != viewports_.end());
 
-        const auto activeViewportRange = Range2D(activeViewport->getViewport());
+        const auto activeViewportRange = Range2D(viewportOf(*activeViewport));
 
         Vector2 newViewportSize;
         Vector2 newViewportTranslationFactor;
@@ -148,23 +221,513 @@ void ViewportManager::createNewViewport(const Vector2& position, const ThreeDVie
             newViewportTranslationFactor = Vector2{0.0, 1.0};
         }
 
-        activeViewport->setViewport(Range2Di(Range2D::fromSize(activeViewportRange.min(), newViewportSize)));
+        std::visit([&](auto& p)
+                   { p.setViewport(Range2Di(Range2D::fromSize(activeViewportRange.min(), newViewportSize))); },
+                   *activeViewport);
         newViewport = Range2Di(Range2D::fromSize(
             activeViewportRange.translated(newViewportSize * newViewportTranslationFactor).min(), newViewportSize));
     }
 
     Debug{} << "New viewport: " << newViewport << ", direction: " << ThreeDView::to_string(direction);
+    return newViewport;
+}
+
+void ViewportManager::createNewViewport(const Vector2& position, const ThreeDView::EBorder& direction)
+{
+    const Range2Di newViewport = splitViewport(position, direction);
 
-    auto newView = ThreeDView(applicationContext_, scene_);
+    auto& newView =
+        std::get<ThreeDView>(viewports_.emplace_back(std::in_place_type<ThreeDView>, applicationContext_, scene_));
     newView.setViewport(newViewport);
+}
+
+void ViewportManager::createImageViewport(const Vector2& position, std::shared_ptr<TiledImage> image,
+                                          const ThreeDView::EBorder& direction)
+{
+    const Range2Di newViewport = splitViewport(position, direction);
+
+    auto& newView = std::get<ImagePreview>(
+        viewports_.emplace_back(std::in_place_type<ImagePreview>, applicationContext_.windowSize(), std::move(image)));
+    newView.setViewport(newViewport);
+}
+
+void ViewportManager::createPlaybackViewport(const Vector2& position, std::shared_ptr<FramePlayer> player,
+                                             const ThreeDView::EBorder& direction)
+{
+    const Range2Di newViewport = splitViewport(position, direction);
+
+    auto& newView = std::get<PlaybackView>(
+        viewports_.emplace_back(std::in_place_type<PlaybackView>, applicationContext_.windowSize(), std::move(player)));
+    newView.setViewport(newViewport);
+}
+
+void ViewportManager::showImage(const std::shared_ptr<TiledImage>& image)
+{
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.setImage(image); })
+                    p.setImage(image);
+            },
+            viewport);
+    }
+}
+
+void ViewportManager::updateRenderTargets()
+{
+    if (multiViewEnabled_)
+    {
+        updateSharedRenderTarget();
+        return;
+    }
+
+    // Panes are laid out in window coordinates but render in framebuffer pixels, which differ on HiDPI systems
+    const Vector2 framebufferScale =
+        Vector2{applicationContext_.framebufferSize()} / Vector2{applicationContext_.windowSize()};
+
+    const Float windowArea = Float(Math::max(applicationContext_.windowSize(), Vector2i{1}).product());
+
+    bool resized = false;
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.renderTarget(); })
+                {
+                    Float scale = 1.0f;
+                    if constexpr (requires { p.resolution(); })
+                    {
+                        // Every pane gets the share of the budget its area is of the window
+                        const Float share = Float(p.getViewport().size().product()) / windowArea;
+                        const auto  budget =
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(gpuTimeBudget_ * share);
+                        p.resolution()
+                            .setEnabled(dynamicResolution_)
+                            .setBudget(std::max(budget, std::chrono::nanoseconds{1}));
+                        scale = p.resolution().scale();
+                    }
+
+                    const Vector2i size =
+                        Math::max(Vector2i{Vector2{p.getViewport().size()} * framebufferScale * scale}, Vector2i{1});
+                    if (!p.renderTarget())
+                    {
+                        p.setRenderTarget(renderTargets_.acquire(size));
+                        resized = true;
+                    }
+                    else if (p.renderTarget()->size() != size)
+                    {
+                        p.setRenderTarget(renderTargets_.resize(*p.renderTarget(), size));
+                        resized = true;
+                    }
+
+                    Int samples = samples_;
+                    if constexpr (requires { p.isInteracting(); })
+                        samples = p.isInteracting() ? interactingSamples_ : samples_;
+                    p.renderTarget()->setSamples(samples);
+                }
+            },
+            viewport);
+    }
+
+    // Keep the targets that were left behind while something is being resized so that they can be picked up again,
+    // and free them once the layout settles.
+    if (!resized)
+        renderTargets_.trim();
+}
+
+void ViewportManager::updateSharedRenderTarget()
+{
+    const Vector2i framebufferSize = Math::max(applicationContext_.framebufferSize(), Vector2i{1});
+    const Vector2  windowSize{Math::max(applicationContext_.windowSize(), Vector2i{1})};
+    const Vector2  framebufferScale = Vector2{framebufferSize} / windowSize;
+
+    bool resized = false;
+    if (!sharedTarget_)
+    {
+        sharedTarget_ = &renderTargets_.acquire(framebufferSize);
+        resized       = true;
+    }
+    else if (sharedTarget_->size() != framebufferSize)
+    {
+        sharedTarget_ = &renderTargets_.resize(*sharedTarget_, framebufferSize);
+        resized       = true;
+    }
+    // The pooled target may have been used by a pane that was interacting
+    sharedTarget_->setSamples(samples_);
+
+    // Every pane renders into its own area of the shared target, which has the GL origin at the bottom left
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.setSharedRenderTarget(*sharedTarget_, Range2Di{}); })
+                {
+                    const Range2D pane{p.getViewport()};
+                    const Vector2 min{pane.min().x(), windowSize.y() - pane.max().y()};
+                    const Vector2 max{pane.max().x(), windowSize.y() - pane.min().y()};
+                    p.setSharedRenderTarget(*sharedTarget_,
+                                            {Vector2i{min * framebufferScale}, Vector2i{max * framebufferScale}});
+                }
+            },
+            viewport);
+    }
+
+    if (!resized)
+        renderTargets_.trim();
+}
+
+bool ViewportManager::setMultiViewEnabled(bool enabled)
+{
+    enabled = enabled && isMultiViewSupported();
+    if (enabled == multiViewEnabled_)
+        return multiViewEnabled_;
+
+    if (enabled && !multiView_)
+        multiView_.emplace(resources_.programBinaryCache());
+    multiViewEnabled_ = enabled;
+
+    // Hand all the targets back, updateRenderTargets() assigns new ones in the next draw()
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.resetRenderTarget(); })
+                {
+                    if (p.renderTarget() && !p.hasSharedRenderTarget())
+                        renderTargets_.release(*p.renderTarget());
+                    p.resetRenderTarget();
+                }
+            },
+            viewport);
+    }
+    if (sharedTarget_)
+    {
+        renderTargets_.release(*sharedTarget_);
+        sharedTarget_ = nullptr;
+    }
+
+    markDirty();
+    return multiViewEnabled_;
+}
+
+void ViewportManager::drawMultiView()
+{
+    CORRADE_INTERNAL_ASSERT(multiView_ && sharedTarget_);
+
+    multiViews_.clear();
+    bool dirty = false;
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.markRendered(TransformCache::CullingStats{}); })
+                {
+                    dirty = dirty || p.isDirty();
+                    multiViews_.push_back({p.targetRegion(), p.camera().projectionMatrix(), p.camera().cameraMatrix()});
+                }
+            },
+            viewport);
+    }
+
+    // All the panes are rendered at once, so if one of them changed, all of them are rendered again
+    if (dirty)
+    {
+        sharedTarget_->clear().framebuffer().bind();
+        const TransformCache::CullingStats stats =
+            multiView_->draw(sharedTarget_->framebuffer(), transformCache_, multiViews_);
+        sharedTarget_->resolve();
+
+        for (auto& viewport : viewports_)
+        {
+            std::visit(
+                [&](auto& p)
+                {
+                    if constexpr (requires { p.markRendered(stats); })
+                        p.markRendered(stats);
+                },
+                viewport);
+        }
+    }
+
+    // The panes tile the window, so compositing is a single blit
+    GL::AbstractFramebuffer::blit(sharedTarget_->resolvedFramebuffer(), GL::defaultFramebuffer,
+                                  sharedTarget_->viewport(), GL::defaultFramebuffer.viewport(),
+                                  GL::FramebufferBlit::Color, GL::FramebufferBlitFilter::Nearest);
+}
+
+void ViewportManager::markDirty()
+{
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [](auto& p)
+            {
+                if constexpr (requires { p.markDirty(); })
+                    p.markDirty();
+            },
+            viewport);
+    }
+}
+
+bool ViewportManager::needsRedraw() const
+{
+    return std::any_of(viewports_.begin(), viewports_.end(),
+                       [](const AnyPanel& viewport)
+                       {
+                           return std::visit(
+                               [](const auto& p)
+                               {
+                                   if constexpr (requires { p.needsRedraw(); })
+                                       return p.needsRedraw();
+                                   else
+                                       return false;
+                               },
+                               viewport);
+                       });
+}
+
+std::optional<UnsignedInt> ViewportManager::takePick()
+{
+    std::optional<UnsignedInt> pick;
+    for (auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](auto& p)
+            {
+                if constexpr (requires { p.takePick(); })
+                {
+                    // Only one pane can be clicked at a time, but take the picks of all of them so none is left over
+                    if (const auto picked = p.takePick())
+                        pick = picked;
+                }
+            },
+            viewport);
+    }
+    return pick;
+}
+
+bool ViewportManager::setBatchingEnabled(bool enabled)
+{
+    enabled = enabled && isBatchingSupported();
+    if (enabled == batch_.has_value())
+        return enabled;
+
+    if (enabled)
+        batch_.emplace(&resources_.memory());
+    else
+        batch_.reset();
+
+    markDirty();
+    return enabled;
+}
+
+void ViewportManager::setLabels(const std::vector<Label>& labels, const GlyphAtlas& atlas, GL::Texture2D& glyphs)
+{
+    labelRenderer_.emplace(resources_, atlas, glyphs);
+    labels_ = &labels;
+    markDirty();
+}
+
+void ViewportManager::resetLabels()
+{
+    labelRenderer_.reset();
+    labels_ = nullptr;
+    markDirty();
+}
+
+void ViewportManager::setDynamicResolution(const bool enabled)
+{
+    dynamicResolution_ = enabled;
+}
+
+void ViewportManager::setGpuTimeBudget(const std::chrono::nanoseconds budget)
+{
+    gpuTimeBudget_ = budget;
+}
+
+std::vector<Float> ViewportManager::resolutionScales() const
+{
+    std::vector<Float> scales;
+    for (const auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](const auto& p)
+            {
+                if constexpr (requires { p.resolution(); })
+                    scales.push_back(p.resolution().scale());
+            },
+            viewport);
+    }
 
-    viewports_.emplace_back(std::move(newView));
+    return scales;
 }
 
-void ViewportManager::draw(SceneGraph::DrawableGroup3D& drawables)
+void ViewportManager::setSampleCounts(const Int idle, const Int interacting)
 {
+    const Int maxSamples = GL::Renderbuffer::maxSamples();
+    samples_             = Math::clamp(idle, 0, maxSamples);
+    interactingSamples_  = Math::clamp(interacting, 0, samples_);
+}
+
+std::vector<Int> ViewportManager::sampleCounts() const
+{
+    std::vector<Int> samples;
+    for (const auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](const auto& p)
+            {
+                if constexpr (requires { p.renderTarget(); })
+                    samples.push_back(p.renderTarget() ? p.renderTarget()->samples() : 0);
+            },
+            viewport);
+    }
+
+    return samples;
+}
+
+void ViewportManager::setFrustumCulling(const bool enabled)
+{
+    if (enabled == transformCache_.isCullingEnabled())
+        return;
+
+    transformCache_.setCullingEnabled(enabled);
+    markDirty();
+}
+
+std::vector<TransformCache::CullingStats> ViewportManager::cullingStats() const
+{
+    std::vector<TransformCache::CullingStats> stats;
+    for (const auto& viewport : viewports_)
+    {
+        std::visit(
+            [&](const auto& p)
+            {
+                if constexpr (requires { p.cullingStats(); })
+                    stats.push_back(p.cullingStats());
+            },
+            viewport);
+    }
+
+    return stats;
+}
+
+std::size_t ViewportManager::scenePaneCount() const
+{
+    return std::size_t(std::count_if(viewports_.begin(), viewports_.end(),
+                                     [](const auto& viewport)
+                                     {
+                                         return std::visit([](const auto& p)
+                                                           { return requires { p.cullingStats(); }; },
+                                                           viewport);
+                                     }));
+}
+
+Int ViewportManager::imagePaneArea() const
+{
+    Int area = 0;
+    for (const auto& viewport : viewports_)
+        if (const auto* image = std::get_if<ImagePreview>(&viewport))
+            area += Math::max(image->getViewport().size(), Vector2i{0}).product();
+    return area;
+}
+
+void ViewportManager::draw(SceneGraph::DrawableGroup3D& drawables, CommandList& commands, StateTracker& state)
+{
+    updateRenderTargets();
+
+    // The targets of the panes are in use, the least recently used ones left behind in the pool are evicted first
     for (auto& viewport : viewports_)
     {
-        viewport.draw(drawables);
+        std::visit(
+            [&](const auto& p)
+            {
+                if constexpr (requires { p.renderTarget(); })
+                    if (p.renderTarget())
+                        resources_.memory().touch(p.renderTarget()->memoryId());
+            },
+            viewport);
+    }
+
+    // Something in the scene moved, so every pane shows a stale image
+    transformCache_.update(drawables);
+    if (transformCache_.updatedCount() != 0 || !resolveOnlyChanged_)
+        markDirty();
+
+    // Every pane is its own target, the shared multi-view target comes after all of them
+    BatchRenderer* const batch         = batch_ ? &*batch_ : nullptr;
+    LabelRenderer* const labelRenderer = labelRenderer_ ? &*labelRenderer_ : nullptr;
+    for (std::size_t i = 0; i != viewports_.size(); ++i)
+    {
+        // The multi-view target is blitted over the whole window, panes that don't render into it go on top
+        UnsignedInt order = UnsignedInt(i);
+        if (multiViewEnabled_ && !rendersIntoSharedTarget(viewports_[i]))
+            order += UnsignedInt(viewports_.size()) + 1;
+
+        const RenderFeatures features =
+            std::visit([](const auto& p) -> RenderFeatures { return std::decay_t<decltype(p)>::Features; },
+                       viewports_[i]);
+        commands.submit(CommandList::key(CommandList::Pass::SCENE, order), features,
+                        [this, batch, labelRenderer, &state, &viewport = viewports_[i]]
+                        {
+                            std::visit(
+                                [&](auto& p)
+                                {
+                                    if constexpr (requires { p.setStateTracker(&state); })
+                                        p.setStateTracker(&state);
+                                    if constexpr (requires { p.setBatchRenderer(batch); })
+                                        p.setBatchRenderer(batch);
+                                    if constexpr (requires { p.setLabels(labelRenderer, labels_); })
+                                        p.setLabels(labelRenderer, labels_);
+                                    p.draw(transformCache_);
+                                },
+                                viewport);
+                        });
+    }
+
+    if (multiViewEnabled_)
+        commands.submit(CommandList::key(CommandList::Pass::SCENE, UnsignedInt(viewports_.size())),
+                        ThreeDView::Features, [this] { drawMultiView(); });
+
+    updateOverlay();
+    commands.submit(CommandList::key(CommandList::Pass::OVERLAY), {},
+                    [this]
+                    {
+                        // Whatever comes next (e.g., ImGui) draws on top of the composited panes
+                        GL::defaultFramebuffer.bind();
+                        overlay_.draw(overlayInstances_);
+                    });
+}
+
+void ViewportManager::updateOverlay()
+{
+    using namespace Math::Literals;
+
+    constexpr Float borderThickness    = 1.0f; // px
+    constexpr Float highlightThickness = 4.0f; // px
+
+    overlayInstances_.clear(Math::max(applicationContext_.windowSize(), Vector2i{1}));
+
+    for (const auto& viewport : viewports_)
+    {
+        overlayInstances_.addBorder(Range2D(viewportOf(viewport)), Color3::fromHsv({35.0_degf, 1.0f, 1.0f}),
+                                    borderThickness);
+    }
+
+    if (activatedBorder_ && borderInteractionViewport_)
+    {
+        overlayInstances_.addEdge(edgeOf(viewportOf(*borderInteractionViewport_), *activatedBorder_), 0xffffff_rgbf,
+                                  highlightThickness);
+    }
+    else if (hoveredBorder_ && hoveredViewport_)
+    {
+        overlayInstances_.addEdge(edgeOf(viewportOf(*hoveredViewport_), *hoveredBorder_), 0xb0b0b0_rgbf,
+                                  highlightThickness);
     }
 }
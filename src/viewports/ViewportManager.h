@@ -2,13 +2,22 @@
 #define VIEWPORTS_VIEWPORTMANAGER_H
 
 #include "../containers/BinaryTree.h"
-#include "../panels/3DView.h"
+#include "../containers/BucketedPool.h"
+#include "../panels/Panels.h"
+#include "../render/BatchRenderer.h"
+#include "../render/CommandList.h"
+#include "../render/GpuResources.h"
+#include "../render/LabelRenderer.h"
+#include "../render/LayoutOverlay.h"
+#include "../render/MultiViewRenderer.h"
+#include "../render/OverlayInstances.h"
+#include "../render/RenderTarget.h"
+#include "../render/TransformCache.h"
 
-#include <Magnum/GL/Mesh.h>
 #include <Magnum/Math/Range.h>
 #include <Magnum/Platform/GlfwApplication.h>
 #include <Magnum/SceneGraph/Drawable.h>
-#include <Magnum/Shaders/FlatGL.h>
+#include <chrono>
 #include <memory>
 #include <optional>
 
@@ -16,25 +25,159 @@ using namespace Magnum;
 class ViewportManager
 {
 public:
-    explicit ViewportManager(const Platform::Application&   applicationContext,
-                             const std::shared_ptr<Scene3D> scene = std::make_shared<Scene3D>());
+    explicit ViewportManager(const Platform::Application& applicationContext, GpuResources& resources,
+                             const std::shared_ptr<Scene3D> scene = std::make_shared<Scene3D>(), Int samples = 0);
 
     void handlePointerPressEvent(Platform::Application::PointerEvent& event);
     void handlePointerReleaseEvent(Platform::Application::PointerEvent& event);
     void handlePointerMoveEvent(Platform::Application::PointerMoveEvent& event);
     void handleScrollEvent(Platform::Application::ScrollEvent& event);
 
+    void setWindowSize(const Vector2i& windowSize);
+
     void createNewViewport(const Vector2& position, const ThreeDView::EBorder& direction = ThreeDView::EBorder::LEFT);
+    /// Like createNewViewport(), but the new pane shows @p image, which can be shared with other panes.
+    void createImageViewport(const Vector2& position, std::shared_ptr<TiledImage> image,
+                             const ThreeDView::EBorder& direction = ThreeDView::EBorder::LEFT);
+    /// Shows @p image in all the image panes.
+    void showImage(const std::shared_ptr<TiledImage>& image);
+    /// Like createNewViewport(), but the new pane plays back @p player.
+    void createPlaybackViewport(const Vector2& position, std::shared_ptr<FramePlayer> player,
+                                const ThreeDView::EBorder& direction = ThreeDView::EBorder::LEFT);
+
+    /**
+     * Submits commands to @p commands that render the dirty panes into their render targets and composite all of them
+     * into the default framebuffer, followed by the layout overlay. The panes and @p drawables have to stay as they
+     * are until the commands are executed.
+     *
+     * The world transformations of @p drawables are computed once and shared by all the panes. Every drawable has to
+     * be a SceneDrawable. Drawables that need more than the features of the pane command set their state through
+     * @p state, which the commands have to be executed with.
+     */
+    void draw(SceneGraph::DrawableGroup3D& drawables, CommandList& commands, StateTracker& state);
+
+    /// Re-renders all the panes in the next draw(), e.g. because the scene changed.
+    void markDirty();
+
+    /// Whether any pane needs another frame on its own, i.e. without further input.
+    bool needsRedraw() const;
+
+    /**
+     * Object ID a pane was clicked at, once its readback finished, see ThreeDView::takePick(). Zero if nothing was
+     * hit. Call after the commands of draw() were executed.
+     */
+    std::optional<UnsignedInt> takePick();
+
+    /**
+     * Renders all the panes into one shared target in a single pass over the scene (see MultiViewRenderer) instead of
+     * one pass per pane. Stays disabled if the driver doesn't support it. Returns whether it's enabled.
+     */
+    bool        setMultiViewEnabled(bool enabled);
+    bool        isMultiViewEnabled() const { return multiViewEnabled_; }
+    static bool isMultiViewSupported() { return MultiViewRenderer::isSupported(); }
+
+    /**
+     * Draws the scene of every pane with a few multidraw calls over uniform buffers (see BatchRenderer) instead of one
+     * draw call per drawable. Stays disabled if the driver doesn't support it. Returns whether it's enabled.
+     */
+    bool        setBatchingEnabled(bool enabled);
+    bool        isBatchingEnabled() const { return batch_.has_value(); }
+    static bool isBatchingSupported() { return BatchRenderer::isSupported(); }
+    /// The renderer used for batching, null if batching is disabled.
+    const BatchRenderer* batchRenderer() const { return batch_ ? &*batch_ : nullptr; }
+
+    /**
+     * Draws @p labels on top of the scene of every 3D pane with one instanced draw call per pane, see LabelRenderer.
+     * The glyphs are the ones of @p atlas in @p glyphs. @p labels and @p glyphs have to stay alive until resetLabels();
+     * call markDirty() when the labels change. Not drawn in multi-view mode.
+     */
+    void setLabels(const std::vector<Label>& labels, const GlyphAtlas& atlas, GL::Texture2D& glyphs);
+    void resetLabels();
+    /// The renderer used for labels, null if there are none.
+    const LabelRenderer* labelRenderer() const { return labelRenderer_ ? &*labelRenderer_ : nullptr; }
+
+    /**
+     * Lets the 3D panes render at a lower resolution to keep their GPU time within a budget, see ResolutionController.
+     * The panes share the budget by area, and drop their resolution while their camera moves. Doesn't apply to
+     * multi-view rendering.
+     */
+    void                     setDynamicResolution(bool enabled);
+    bool                     isDynamicResolutionEnabled() const { return dynamicResolution_; }
+    void                     setGpuTimeBudget(std::chrono::nanoseconds budget);
+    std::chrono::nanoseconds gpuTimeBudget() const { return gpuTimeBudget_; }
+
+    /// Fraction of the pane size every 3D pane renders at, in layout order.
+    std::vector<Float> resolutionScales() const;
 
-    void draw(SceneGraph::DrawableGroup3D& drawables);
+    /**
+     * MSAA sample counts of the pane render targets, @p interacting while the camera of a pane moves and @p idle
+     * otherwise. Clamped to what the driver supports.
+     */
+    void setSampleCounts(Int idle, Int interacting);
+    Int  idleSampleCount() const { return samples_; }
+    Int  interactingSampleCount() const { return interactingSamples_; }
+    /// Sample count every 3D pane currently renders with, in layout order.
+    std::vector<Int> sampleCounts() const;
+
+    /**
+     * Re-renders and resolves only the panes whose contents changed, which is the default. Otherwise all of them are
+     * rendered every frame, e.g. to compare frame times.
+     */
+    void setResolveOnlyChanged(bool enabled) { resolveOnlyChanged_ = enabled; }
+    bool isResolveOnlyChanged() const { return resolveOnlyChanged_; }
+
+    void setFrustumCulling(bool enabled);
+    bool isFrustumCullingEnabled() const { return transformCache_.isCullingEnabled(); }
+
+    /// Drawn and culled drawables of every 3D pane, in layout order.
+    std::vector<TransformCache::CullingStats> cullingStats() const;
+
+    /// Number of 3D panes, i.e. the ones drawing the scene.
+    std::size_t scenePaneCount() const;
+    /// Window pixels the image panes cover, zero if there are none or the window is minimized.
+    Int imagePaneArea() const;
+
+    const BucketedPool<RenderTarget>& renderTargets() const { return renderTargets_; }
+    const LayoutOverlay&              overlay() const { return overlay_; }
+    const TransformCache&             transformCache() const { return transformCache_; }
 
 private:
+    std::unique_ptr<RenderTarget> createRenderTarget(const Vector2i& capacity);
+
+    /// Halves the pane at @p position towards @p direction and returns the area of the new pane next to it.
+    Range2Di splitViewport(const Vector2& position, const ThreeDView::EBorder& direction);
+
+    void updateRenderTargets();
+    void updateSharedRenderTarget();
+    void drawMultiView();
+    void updateOverlay();
+
     std::optional<ThreeDView::EBorder> findBorder(const Range2Di& viewport, const Vector2& position) const;
     const Platform::Application&       applicationContext_;
+    GpuResources&                      resources_;
     std::shared_ptr<Scene3D>           scene_;
-    std::vector<ThreeDView>            viewports_;
+    std::vector<AnyPanel>              viewports_;
     std::optional<ThreeDView::EBorder> activatedBorder_{std::nullopt};
-    ThreeDView*                        borderInteractionViewport_{nullptr};
+    AnyPanel*                          borderInteractionViewport_{nullptr};
+    std::optional<ThreeDView::EBorder> hoveredBorder_{std::nullopt};
+    const AnyPanel*                    hoveredViewport_{nullptr};
+    Int                                samples_;
+    BucketedPool<RenderTarget>         renderTargets_;
+    TransformCache                     transformCache_;
+    OverlayInstances                   overlayInstances_;
+    LayoutOverlay                      overlay_;
+
+    std::optional<MultiViewRenderer>     multiView_;
+    std::vector<MultiViewRenderer::View> multiViews_;
+    RenderTarget*                        sharedTarget_{nullptr}; ///< Target of all the panes in multi-view mode.
+    bool                                 multiViewEnabled_{false};
+    std::optional<BatchRenderer>         batch_;
+    std::optional<LabelRenderer>         labelRenderer_;
+    const std::vector<Label>*            labels_{nullptr};
+    std::chrono::nanoseconds             gpuTimeBudget_{std::chrono::milliseconds{10}};
+    bool                                 dynamicResolution_{true};
+    Int                                  interactingSamples_;
+    bool                                 resolveOnlyChanged_{true};
 };
 
 #endif // VIEWPORTS_VIEWPORTMANAGER_H